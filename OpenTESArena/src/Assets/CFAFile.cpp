@@ -10,6 +10,43 @@
 #include "components/utilities/Bytes.h"
 #include "components/vfs/manager.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CFA_FILE_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define CFA_FILE_NEON
+#endif
+
+namespace
+{
+	// Demuxes eight pixels at a time from a big-endian bit group, starting at a multiple of eight.
+	// Returns the first pixel that wasn't demuxed.
+	template <int BitsPerPixel>
+	int DemuxGroups(const uint8_t *src, int x, int count, const uint8_t *lookUpTable, uint8_t *dst)
+	{
+		static_assert((BitsPerPixel >= 1) && (BitsPerPixel <= 7));
+		constexpr uint64_t mask = (1 << BitsPerPixel) - 1;
+
+		for (; (x + 8) <= count; x += 8)
+		{
+			const uint8_t *groupPtr = src + ((x / 8) * BitsPerPixel);
+			uint64_t bits = 0;
+			for (int i = 0; i < BitsPerPixel; i++)
+			{
+				bits = (bits << 8) | groupPtr[i];
+			}
+
+			for (int i = 0; i < 8; i++)
+			{
+				dst[x + i] = lookUpTable[(bits >> ((7 - i) * BitsPerPixel)) & mask];
+			}
+		}
+
+		return x;
+	}
+}
+
 bool CFAFile::init(const char *filename)
 {
 	Buffer<std::byte> src;
@@ -41,10 +78,6 @@ bool CFAFile::init(const char *filename)
 	Buffer<uint8_t> encoded(widthUncompressed + 16);
 	encoded.fill(0);
 
-	// Index values from demuxing are stored here each pass, and are
-	// eventually translated into color indices.
-	std::array<uint8_t, 8> translate;
-
 	// Worse-case buffer for decompressed data (due to possible padding
 	// with demux alignment).
 	std::vector<uint8_t> decomp(widthCompressed * height * frameCount *
@@ -74,73 +107,24 @@ bool CFAFile::init(const char *filename)
 
 		for (uint32_t y = 0; y < height; y++)
 		{
-			uint32_t count = widthUncompressed;
-
 			// Copy the current line to the scratch buffer.
 			const uint8_t *decompPtr = decomp.data() + offset;
 			std::copy(decompPtr, decompPtr + widthCompressed, encoded.get());
 
-			// Lambda for which demux routine to do, based on bits per pixel.
-			auto runDemux = [&dst, dstOffset, &count, &encoded, &translate, lookUpTable](
-				uint32_t end, void(*demux)(const uint8_t*, uint8_t*),
-				uint32_t demuxMultiplier, uint32_t upToMin)
-			{
-				for (uint32_t x = 0; x < end; x++)
-				{
-					demux(encoded.get() + (x * demuxMultiplier), translate.data());
-
-					uint32_t upTo = std::min(upToMin, count);
-					count -= upTo;
-
-					uint8_t *dstPtr = dst.get();
-					for (uint32_t i = 0; i < upTo; i++)
-					{
-						const int dstIndex = (x * upToMin) + i + dstOffset;
-						const uint8_t translateVal = translate[i];
-						dstPtr[dstIndex] = lookUpTable[translateVal];
-					}
-				}
-			};
-
-			// Choose the demuxing routine.
+			uint8_t *dstPtr = dst.get() + dstOffset;
 			if (bitsPerPixel == 8)
 			{
 				// No demuxing needed.
-				const uint8_t *encodedPtr = encoded.get();
-				uint8_t *dstPtr = dst.get();
-				for (uint32_t x = 0; x < widthCompressed; x++)
-				{
-					const int dstIndex = x + dstOffset;
-					dstPtr[dstIndex] = encodedPtr[x];
-				}
-			}
-			else if (bitsPerPixel == 7)
-			{
-				runDemux((widthCompressed + 6) / 7, CFAFile::demux7, 7, 8);
-			}
-			else if (bitsPerPixel == 6)
-			{
-				runDemux((widthCompressed + 2) / 3, CFAFile::demux6, 3, 4);
-			}
-			else if (bitsPerPixel == 5)
-			{
-				runDemux((widthCompressed + 4) / 5, CFAFile::demux5, 5, 8);
-			}
-			else if (bitsPerPixel == 4)
-			{
-				runDemux((widthCompressed + 1) / 2, CFAFile::demux4, 2, 4);
+				std::copy(encoded.get(), encoded.get() + widthCompressed, dstPtr);
 			}
-			else if (bitsPerPixel == 3)
+			else if ((bitsPerPixel >= 1) && (bitsPerPixel <= 7))
 			{
-				runDemux((widthCompressed + 2) / 3, CFAFile::demux3, 3, 8);
-			}
-			else if (bitsPerPixel == 2)
-			{
-				runDemux(widthCompressed, CFAFile::demux2, 1, 4);
-			}
-			else if (bitsPerPixel == 1)
-			{
-				runDemux(widthCompressed, CFAFile::demux1, 1, 8);
+				// Only as many pixels as the compressed line holds, like the per-group demuxing.
+				const int groupPixelCount = ((bitsPerPixel == 2) || (bitsPerPixel == 4) || (bitsPerPixel == 6)) ? 4 : 8;
+				const int groupByteCount = (groupPixelCount * bitsPerPixel) / 8;
+				const int groupCount = (widthCompressed + groupByteCount - 1) / groupByteCount;
+				const int pixelCount = std::min(static_cast<int>(widthUncompressed), groupCount * groupPixelCount);
+				CFAFile::demuxLine(encoded.get(), bitsPerPixel, pixelCount, lookUpTable, dstPtr);
 			}
 
 			// Move offsets to the next compressed line of data.
@@ -189,6 +173,134 @@ const uint8_t *CFAFile::getPixels(int index) const
 	return image.get();
 }
 
+void CFAFile::demuxLine(const uint8_t *src, int bitsPerPixel, int count, const uint8_t *lookUpTable,
+	uint8_t *dst)
+{
+	DebugAssert(bitsPerPixel >= 1);
+	DebugAssert(bitsPerPixel <= 7);
+
+	int x = 0;
+
+	// Four bits per pixel splits evenly into nibbles, 32 pixels at a time.
+	if (bitsPerPixel == 4)
+	{
+		alignas(16) uint8_t indices[32];
+		for (; (x + 32) <= count; x += 32)
+		{
+			const uint8_t *srcPtr = src + (x / 2);
+#if defined(CFA_FILE_SSE2)
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcPtr));
+			const __m128i lowMask = _mm_set1_epi8(0x0F);
+			const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask);
+			const __m128i lowNibbles = _mm_and_si128(bytes, lowMask);
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_unpacklo_epi8(highNibbles, lowNibbles));
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices + 16), _mm_unpackhi_epi8(highNibbles, lowNibbles));
+#elif defined(CFA_FILE_NEON)
+			const uint8x16_t bytes = vld1q_u8(srcPtr);
+			const uint8x16x2_t nibbles = vzipq_u8(vshrq_n_u8(bytes, 4), vandq_u8(bytes, vdupq_n_u8(0x0F)));
+			vst1q_u8(indices, nibbles.val[0]);
+			vst1q_u8(indices + 16, nibbles.val[1]);
+#else
+			for (int i = 0; i < 16; i++)
+			{
+				indices[i * 2] = srcPtr[i] >> 4;
+				indices[(i * 2) + 1] = srcPtr[i] & 0x0F;
+			}
+#endif
+
+			for (int i = 0; i < 32; i++)
+			{
+				dst[x + i] = lookUpTable[indices[i]];
+			}
+		}
+	}
+
+	// Whole groups of eight pixels, which always take exactly bitsPerPixel bytes.
+	switch (bitsPerPixel)
+	{
+	case 1:
+		x = DemuxGroups<1>(src, x, count, lookUpTable, dst);
+		break;
+	case 2:
+		x = DemuxGroups<2>(src, x, count, lookUpTable, dst);
+		break;
+	case 3:
+		x = DemuxGroups<3>(src, x, count, lookUpTable, dst);
+		break;
+	case 4:
+		x = DemuxGroups<4>(src, x, count, lookUpTable, dst);
+		break;
+	case 5:
+		x = DemuxGroups<5>(src, x, count, lookUpTable, dst);
+		break;
+	case 6:
+		x = DemuxGroups<6>(src, x, count, lookUpTable, dst);
+		break;
+	case 7:
+		x = DemuxGroups<7>(src, x, count, lookUpTable, dst);
+		break;
+	}
+
+	// The rest of the line: each index is within a big-endian 16-bit window.
+	const int mask = (1 << bitsPerPixel) - 1;
+	for (; x < count; x++)
+	{
+		const int bitIndex = x * bitsPerPixel;
+		const uint8_t *srcPtr = src + (bitIndex / 8);
+		const int window = (srcPtr[0] << 8) | srcPtr[1];
+		const int shift = 16 - (bitIndex % 8) - bitsPerPixel;
+		dst[x] = lookUpTable[(window >> shift) & mask];
+	}
+}
+
+void CFAFile::demuxLineReference(const uint8_t *src, int bitsPerPixel, int count, const uint8_t *lookUpTable,
+	uint8_t *dst)
+{
+	DebugAssert(bitsPerPixel >= 1);
+	DebugAssert(bitsPerPixel <= 7);
+
+	// Demux routine, source bytes and pixels per group, based on bits per pixel.
+	struct DemuxGroup
+	{
+		void(*demux)(const uint8_t*, uint8_t*);
+		int byteCount;
+		int pixelCount;
+	};
+
+	const std::array<DemuxGroup, 7> groups =
+	{
+		{
+			{ CFAFile::demux1, 1, 8 },
+			{ CFAFile::demux2, 1, 4 },
+			{ CFAFile::demux3, 3, 8 },
+			{ CFAFile::demux4, 2, 4 },
+			{ CFAFile::demux5, 5, 8 },
+			{ CFAFile::demux6, 3, 4 },
+			{ CFAFile::demux7, 7, 8 }
+		}
+	};
+
+	const DemuxGroup &group = groups[bitsPerPixel - 1];
+
+	// Index values from demuxing are stored here each pass, and are
+	// eventually translated into color indices.
+	std::array<uint8_t, 8> translate;
+
+	int remaining = count;
+	for (int x = 0; remaining > 0; x++)
+	{
+		group.demux(src + (x * group.byteCount), translate.data());
+
+		const int upTo = std::min(group.pixelCount, remaining);
+		for (int i = 0; i < upTo; i++)
+		{
+			dst[(x * group.pixelCount) + i] = lookUpTable[translate[i]];
+		}
+
+		remaining -= upTo;
+	}
+}
+
 void CFAFile::demux1(const uint8_t *src, uint8_t *dst)
 {
 	dst[0] = (src[0] & 0x80) >> 7;
@@ -14,8 +14,7 @@ private:
 	Buffer<Buffer2D<uint8_t>> images;
 	int width, height, xOffset, yOffset;
 
-	// CFA files have their palette indices compressed into fewer bits depending
-	// on the total number of colors in the file. These demuxing functions
+	// Per-group reference versions of line demuxing for verifying demuxLine(). These
 	// uncompress those bits into bytes. Adapted from WinArena.
 	static void demux1(const uint8_t *src, uint8_t *dst);
 	static void demux2(const uint8_t *src, uint8_t *dst);
@@ -25,6 +24,18 @@ private:
 	static void demux6(const uint8_t *src, uint8_t *dst);
 	static void demux7(const uint8_t *src, uint8_t *dst);
 public:
+	// CFA files have their palette indices compressed into fewer bits depending
+	// on the total number of colors in the file. Each line is an MSB-first bitstream of
+	// look-up table indices. Writes the line's palette indices to the destination. The source
+	// must be readable for one byte past the last index.
+	static void demuxLine(const uint8_t *src, int bitsPerPixel, int count, const uint8_t *lookUpTable,
+		uint8_t *dst);
+
+	// Group-at-a-time version of demuxLine() built on the per-group demuxers, for verifying it.
+	// The source must be readable up to the end of the last group.
+	static void demuxLineReference(const uint8_t *src, int bitsPerPixel, int count, const uint8_t *lookUpTable,
+		uint8_t *dst);
+
 	bool init(const char *filename);
 
 	// Gets the number of images.
@@ -1,9 +1,41 @@
+#include <cstring>
+#include <string>
+
 #include "Compression.h"
 
 #include "components/debug/Debug.h"
 #include "components/utilities/Bytes.h"
 
 void Compression::decodeRLE(const uint8_t *src, int stopCount, uint8_t *dst, int dstSize)
+{
+	// Adapted from WinArena.
+	int o = 0;
+	while (o < stopCount)
+	{
+		const uint8_t sample = *src;
+		src++;
+
+		// Is the selected byte part of a compressed packet?
+		if ((sample & 0x80) != 0)
+		{
+			const int count = static_cast<int>(sample) - 0x7F;
+			DebugAssert((o + count) <= dstSize);
+			std::memset(dst + o, *src, count);
+			src++;
+			o += count;
+		}
+		else
+		{
+			const int count = static_cast<int>(sample) + 1;
+			DebugAssert((o + count) <= dstSize);
+			std::memcpy(dst + o, src, count);
+			src += count;
+			o += count;
+		}
+	}
+}
+
+void Compression::decodeRLEReference(const uint8_t *src, int stopCount, uint8_t *dst, int dstSize)
 {
 	// Adapted from WinArena.
 	int i = 0;
@@ -48,6 +80,65 @@ void Compression::decodeRLE(const uint8_t *src, int stopCount, uint8_t *dst, int
 
 void Compression::decodeRLEWords(const uint8_t *src, int stopCount, 
 	std::vector<uint8_t> &out)
+{
+	uint8_t *dst = out.data();
+	const int dstWordCount = static_cast<int>(out.size() / 2);
+	int o = 0;
+
+	while (o < stopCount)
+	{
+		const int16_t sample = Bytes::getLE16(src);
+		src += 2;
+
+		// If "sample" is positive, then "sample" literal words follow. Otherwise,
+		// repeat the next word "sample" times. Words are little-endian in and out.
+		if (sample > 0)
+		{
+			const int count = sample;
+			if ((o + count) > dstWordCount)
+			{
+				DebugLogError("RLE literal run of " + std::to_string(count) + " words at " + std::to_string(o) +
+					" overflows " + std::to_string(dstWordCount) + " words.");
+				return;
+			}
+
+			std::memcpy(dst + (o * 2), src, count * 2);
+			src += count * 2;
+			o += count;
+		}
+		else
+		{
+			const uint8_t lowByte = src[0];
+			const uint8_t highByte = src[1];
+			src += 2;
+
+			const int count = -sample;
+			if ((o + count) > dstWordCount)
+			{
+				DebugLogError("RLE repeat run of " + std::to_string(count) + " words at " + std::to_string(o) +
+					" overflows " + std::to_string(dstWordCount) + " words.");
+				return;
+			}
+
+			if (lowByte == highByte)
+			{
+				std::memset(dst + (o * 2), lowByte, count * 2);
+			}
+			else
+			{
+				for (int j = 0; j < count; j++)
+				{
+					dst[(o + j) * 2] = lowByte;
+					dst[((o + j) * 2) + 1] = highByte;
+				}
+			}
+
+			o += count;
+		}
+	}
+}
+
+void Compression::decodeRLEWordsReference(const uint8_t *src, int stopCount, std::vector<uint8_t> &out)
 {
 	int i = 0;
 	int o = 0;
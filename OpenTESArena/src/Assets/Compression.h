@@ -14,17 +14,25 @@
 
 namespace Compression
 {
-	// Uncompresses an RLE run of bytes.
+	// Uncompresses an RLE run of bytes. Runs are written with memset and literals with memcpy.
 	void decodeRLE(const uint8_t *src, int stopCount, uint8_t *dst, int dstSize);
 
+	// Byte-by-byte version of decodeRLE() for verifying it.
+	void decodeRLEReference(const uint8_t *src, int stopCount, uint8_t *dst, int dstSize);
+
 	// Uncompresses an RLE run of words. Used with .RMD files.
+	// Bails with an error if a run would overflow the output.
 	void decodeRLEWords(const uint8_t *src, int stopCount, std::vector<uint8_t> &out);
 
+	// Word-by-word version of decodeRLEWords() for verifying it.
+	void decodeRLEWordsReference(const uint8_t *src, int stopCount, std::vector<uint8_t> &out);
+
 	// Works with .IMG and .CIF type 4 files.
 	template <typename T>
 	void decodeType04(T src, T srcend, std::vector<uint8_t> &out)
 	{
-		auto dst = out.begin();
+		uint8_t *dst = out.data();
+		uint8_t *dstEnd = dst + out.size();
 
 		std::array<uint8_t, 4096> history;
 		history.fill(0x20);
@@ -52,7 +60,7 @@ namespace Compression
 			if ((mask & 1))
 			{
 				DebugAssertMsg(src != srcend, "Unexpected end of image.");
-				DebugAssertMsg(dst != out.end(), "Decoded image overflow.");
+				DebugAssertMsg(dst != dstEnd, "Decoded image overflow.");
 
 				history[historypos++ & 0x0FFF] = *src;
 				*(dst++) = *(src++);
@@ -66,7 +74,7 @@ namespace Compression
 				int tocopy = (byte2 & 0x0F) + 3;
 				int copypos = (((byte2 & 0xF0) << 4) | byte1) + 18;
 
-				DebugAssertMsg(std::distance(dst, out.end()) >= tocopy, "Decoded image overflow.");
+				DebugAssertMsg(std::distance(dst, dstEnd) >= tocopy, "Decoded image overflow.");
 
 				for (int i = 0; i < tocopy; i++)
 				{
@@ -78,7 +86,7 @@ namespace Compression
 			bitcount--;
 		}
 
-		std::fill(dst, out.end(), 0);
+		std::fill(dst, dstEnd, 0);
 	}
 
 	// Works with type 8 .IMG and .CIF files, and voxel data in .MIF files.
@@ -162,8 +170,9 @@ namespace Compression
 
 		// This feels like some form of adaptive Huffman coding, with a form of LZ
 		// compression. DEFLATE?
-		auto dst = out.begin();
-		while (dst != out.end())
+		uint8_t *dst = out.data();
+		uint8_t *dstEnd = dst + out.size();
+		while (dst != dstEnd)
 		{
 			// Starting with the root, append bits from the input while traversing
 			// the tree until a leaf node is found (indicated by being >= 627).
@@ -180,16 +189,16 @@ namespace Compression
 					validbits += 8;
 				}
 
-				node = NodeTree.at(node + ((bitmask >> 15) & 1));
+				node = NodeTree[node + ((bitmask >> 15) & 1)];
 				bitmask <<= 1;
 				validbits--;
 			}
 
 			// Increment the use count (frequency) of this node, and ensure the
 			// tree remains sorted.
-			uint16_t freqidx = NodeIdxMap.at(node);
+			uint16_t freqidx = NodeIdxMap[node];
 			do {
-				NodeFreq.at(freqidx) += 1;
+				NodeFreq[freqidx] += 1;
 				uint16_t freq = NodeFreq[freqidx];
 				uint16_t nextidx = freqidx + 1;
 				if (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq)
@@ -210,14 +219,14 @@ namespace Compression
 
 					// Update the index mappings
 					uint16_t mapidx = NodeTree[nextidx];
-					NodeIdxMap.at(mapidx) = nextidx;
+					NodeIdxMap[mapidx] = nextidx;
 					if (mapidx < 627)
 					{
 						NodeIdxMap[mapidx + 1] = nextidx;
 					}
 
 					mapidx = NodeTree[freqidx];
-					NodeIdxMap.at(mapidx) = freqidx;
+					NodeIdxMap[mapidx] = freqidx;
 					if (mapidx < 627)
 					{
 						NodeIdxMap[mapidx + 1] = freqidx;
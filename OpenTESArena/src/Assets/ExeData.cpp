@@ -984,8 +984,17 @@ bool ExeData::init(bool floppyVersion)
 	// Load executable.
 	const std::string &exeFilename = floppyVersion ?
 		ExeData::FLOPPY_VERSION_EXE_FILENAME : ExeData::CD_VERSION_EXE_FILENAME;
+
+	// Decompressing the executable is slow enough to keep a decompressed copy around.
+	const std::string cachePath = Platform::getCachePath();
+	if (!Platform::directoryExists(cachePath))
+	{
+		Platform::createDirectoryRecursively(cachePath);
+	}
+
+	const std::string exeCacheFilename = cachePath + exeFilename + ".unpacked";
 	ExeUnpacker exe;
-	if (!exe.init(exeFilename.c_str()))
+	if (!exe.init(exeFilename.c_str(), exeCacheFilename.c_str()))
 	{
 		DebugLogError("Couldn't init .EXE unpacker for \"" + exeFilename + "\".");
 		return false;
@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <array>
-#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <string>
 
 #include "ExeUnpacker.h"
@@ -12,129 +15,6 @@
 
 namespace
 {
-	// Performance optimization for bit reading (replaces the unnecessary heap 
-	// allocation of std::vector<bool>). Use BitVector::bitsUsed instead of 
-	// BitVector::bits.size().
-	struct BitVector
-	{
-		std::array<bool, 9> bits;
-		int count;
-
-		BitVector()
-		{
-			this->bits.fill(false);
-			this->count = 0;
-		}
-	};
-
-	// A simple binary tree for retrieving a decoded value, given a vector of bits.
-	class BitTree
-	{
-	private:
-		struct Node
-		{
-			// Only leaves will have non-null values.
-			std::unique_ptr<int> value;
-			std::unique_ptr<Node> left;
-			std::unique_ptr<Node> right;
-
-			bool isLeaf() const
-			{
-				return (this->left.get() == nullptr) && (this->right.get() == nullptr);
-			}
-		};
-
-		BitTree::Node root;
-	public:
-		// Inserts a node into the tree, overwriting any existing entry.
-		void insert(const std::vector<bool> &bits, int value)
-		{
-			BitTree::Node *node = &this->root;
-
-			// Walk the tree, creating new nodes as necessary. Internal nodes have null values.
-			for (size_t i = 0; i < bits.size(); i++)
-			{
-				const bool bit = bits[i];
-
-				// Decide which branch to use.
-				if (bit)
-				{
-					// Right.
-					if (node->right.get() == nullptr)
-					{
-						// Make a new node.
-						node->right = std::make_unique<BitTree::Node>();
-					}
-
-					node = node->right.get();
-				}
-				else
-				{
-					// Left.
-					if (node->left.get() == nullptr)
-					{
-						// Make a new node.
-						node->left = std::make_unique<BitTree::Node>();
-					}
-
-					node = node->left.get();
-				}
-				
-				// Set the node's value if it's the desired leaf.
-				if (i == (bits.size() - 1))
-				{
-					node->value = std::make_unique<int>(value);
-				}
-			}
-		}
-
-		// Returns a pointer to a decoded value in the tree, or null if no entry exists.
-		const int *get(const BitVector &bitVector)
-		{
-			const int *value = nullptr;
-			const BitTree::Node *left = this->root.left.get();
-			const BitTree::Node *right = this->root.right.get();
-
-			// Walk the tree.
-			for (int i = 0; i < bitVector.count; i++)
-			{
-				const bool bit = bitVector.bits.at(i);
-
-				// Decide which branch to use.
-				if (bit)
-				{
-					// Right.
-					DebugAssert(right != nullptr);
-
-					// Check if it's a leaf.
-					if (right->isLeaf())
-					{
-						value = right->value.get();
-					}
-
-					left = right->left.get();
-					right = right->right.get();
-				}
-				else
-				{
-					// Left.
-					DebugAssert(left != nullptr);
-
-					// Check if it's a leaf.
-					if (left->isLeaf())
-					{
-						value = left->value.get();
-					}
-
-					right = left->right.get();
-					left = left->left.get();
-				}
-			}
-
-			return value;
-		}
-	};
-
 	// Bit table from pklite_specification.md, section 4.3.1 "Number of bytes".
 	// The decoded value for a given vector is (index + 2) before index 11, and
 	// (index + 1) after index 11.
@@ -203,43 +83,260 @@ namespace
 		{ false, true, true, true, true, true, false }, // 30
 		{ false, true, true, true, true, true, true } // 31
 	};
-}
 
-bool ExeUnpacker::init(const char *filename)
-{
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	// Value decoded from the special "011100" vector in the first bit table.
+	constexpr int DUPLICATION1_SPECIAL_CASE = -1;
+
+	// Lookup table for decoding a bit vector from a bit table in one step instead of walking it
+	// bit by bit. Indexed by the next MaxBits bits in the stream, with the first bit in the lowest
+	// position. Every index whose low bits match a vector holds that vector's value and length.
+	template <int MaxBits>
+	class DecodeTable
 	{
-		DebugLogError("Could not read \"" + std::string(filename) + "\".");
-		return false;
+	private:
+		struct Entry
+		{
+			int value;
+			int length; // Zero if no vector matches.
+		};
+
+		std::array<Entry, 1 << MaxBits> entries;
+	public:
+		DecodeTable()
+		{
+			this->entries.fill(Entry { 0, 0 });
+		}
+
+		void insert(const std::vector<bool> &bits, int value)
+		{
+			const int length = static_cast<int>(bits.size());
+			DebugAssert(length <= MaxBits);
+
+			int code = 0;
+			for (int i = 0; i < length; i++)
+			{
+				code |= (bits[i] ? 1 : 0) << i;
+			}
+
+			// Fill every index that starts with this vector.
+			for (int i = code; i < static_cast<int>(this->entries.size()); i += 1 << length)
+			{
+				this->entries[i] = Entry { value, length };
+			}
+		}
+
+		static constexpr int getMaxBits()
+		{
+			return MaxBits;
+		}
+
+		// Returns whether the given bits start with a vector in the table.
+		bool tryDecode(int bits, int *outValue, int *outLength) const
+		{
+			const Entry &entry = this->entries[bits];
+			*outValue = entry.value;
+			*outLength = entry.length;
+			return entry.length > 0;
+		}
+	};
+
+	using DecodeTable1 = DecodeTable<9>;
+	using DecodeTable2 = DecodeTable<7>;
+
+	const DecodeTable1 &GetDuplication1Table()
+	{
+		static const DecodeTable1 table = []()
+		{
+			// Since the Duplication1 table has a special case at index 11, split the insertions up.
+			DecodeTable1 newTable;
+			for (int i = 0; i < 11; i++)
+			{
+				newTable.insert(Duplication1[i], i + 2);
+			}
+
+			newTable.insert(Duplication1[11], DUPLICATION1_SPECIAL_CASE);
+
+			for (int i = 12; i < static_cast<int>(Duplication1.size()); i++)
+			{
+				newTable.insert(Duplication1[i], i + 1);
+			}
+
+			return newTable;
+		}();
+
+		return table;
 	}
 
-	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+	const DecodeTable2 &GetDuplication2Table()
+	{
+		static const DecodeTable2 table = []()
+		{
+			DecodeTable2 newTable;
+			for (int i = 0; i < static_cast<int>(Duplication2.size()); i++)
+			{
+				newTable.insert(Duplication2[i], i);
+			}
+
+			return newTable;
+		}();
+
+		return table;
+	}
+
+	// Reads PKLITE's stream of 16-bit little endian bit arrays interleaved with whole bytes. A new
+	// bit array is read from the byte stream as soon as the last bit of the current one is used,
+	// so peeking ahead never changes which bytes the byte reads get.
+	class BitReader
+	{
+	private:
+		const uint8_t *data;
+		size_t byteIndex;
+		uint16_t bitArray;
+		int bitsRead; // Number of bits consumed in the current bit array.
+	public:
+		BitReader(const uint8_t *data)
+		{
+			this->data = data;
+			this->bitArray = Bytes::getLE16(data);
+			this->byteIndex = 2;
+			this->bitsRead = 0;
+		}
+
+		size_t getByteIndex() const
+		{
+			return this->byteIndex;
+		}
+
+		int getBitsRead() const
+		{
+			return this->bitsRead;
+		}
+
+		// Gets the next 'count' bits (up to 16) without consuming them.
+		int peekBits(int count) const
+		{
+			uint32_t bits = this->bitArray >> this->bitsRead;
+			const int bitsAvailable = 16 - this->bitsRead;
+			if (bitsAvailable < count)
+			{
+				// The next bit array is always the next two bytes since no byte is read mid-vector.
+				bits |= static_cast<uint32_t>(Bytes::getLE16(this->data + this->byteIndex)) << bitsAvailable;
+			}
+
+			return static_cast<int>(bits & ((1u << count) - 1));
+		}
+
+		void skipBits(int count)
+		{
+			this->bitsRead += count;
+
+			// Advance the bit array if done with the current one.
+			if (this->bitsRead >= 16)
+			{
+				this->bitsRead -= 16;
+				this->bitArray = Bytes::getLE16(this->data + this->byteIndex);
+				this->byteIndex += 2;
+			}
+		}
+
+		bool getNextBit()
+		{
+			const bool bit = (this->bitArray & (1 << this->bitsRead)) != 0;
+			this->skipBits(1);
+			return bit;
+		}
+
+		uint8_t getNextByte()
+		{
+			const uint8_t byte = this->data[this->byteIndex];
+			this->byteIndex++;
+			return byte;
+		}
+
+		// Decodes the next bit vector with the given table.
+		template <typename TableType>
+		bool tryDecode(const TableType &table, int *outValue)
+		{
+			const int bits = this->peekBits(TableType::getMaxBits());
+			int length;
+			if (!table.tryDecode(bits, outValue, &length))
+			{
+				return false;
+			}
+
+			this->skipBits(length);
+			return true;
+		}
+	};
 
-	// Generate the bit trees for "duplication mode". Since the Duplication1 table has 
-	// a special case at index 11, split the insertions up for the first bit tree.
-	BitTree bitTree1, bitTree2;
+	// Header for the cached decompressed executable.
+	constexpr char CACHE_MAGIC[4] = { 'O', 'T', 'E', 'X' };
+	constexpr uint32_t CACHE_VERSION = 1;
 
-	for (int i = 0; i < 11; i++)
+	struct CacheHeader
 	{
-		bitTree1.insert(Duplication1[i], i + 2);
+		char magic[4];
+		uint32_t version;
+		uint64_t sourceHash; // Hash of the compressed executable.
+		uint64_t sourceSize;
+		uint64_t dataHash; // Hash of the decompressed data following the header.
+		uint64_t dataSize;
+	};
+
+	static_assert(sizeof(CacheHeader) == 40);
+
+	uint64_t HashBytes(const uint8_t *data, size_t count)
+	{
+		// 64-bit FNV-1a.
+		uint64_t hash = 0xCBF29CE484222325;
+		for (size_t i = 0; i < count; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
 	}
 
-	bitTree1.insert(Duplication1[11], 13);
+	// Compressed data starts at this offset and is followed by 8 bytes with the decompressed length.
+	constexpr size_t COMPRESSED_OFFSET = 752;
+	constexpr size_t TRAILER_SIZE = 8;
+
+	// Returns whether the executable is big enough to hold PKLITE-compressed data and a trailer.
+	bool IsCompressedSizeValid(size_t srcSize)
+	{
+		return srcSize >= (COMPRESSED_OFFSET + TRAILER_SIZE + 2);
+	}
 
-	for (int i = 12; i < Duplication1.size(); i++)
+	// Calculates the length of the decompressed data from the trailer -- more precise method (for A.EXE).
+	size_t GetDecompressedLength(const uint8_t *srcPtr, size_t srcSize)
 	{
-		bitTree1.insert(Duplication1[i], i + 1);
+		DebugAssert(IsCompressedSizeValid(srcSize));
+		const uint8_t *compressedEnd = srcPtr + (srcSize - TRAILER_SIZE);
+		const uint16_t segment = Bytes::getLE16(compressedEnd);
+		const uint16_t offset = Bytes::getLE16(compressedEnd + 2);
+		return (segment * 16) + offset;
 	}
 
-	for (int i = 0; i < Duplication2.size(); i++)
+	std::string GetElapsedMilliseconds(const std::chrono::steady_clock::time_point &startTime)
 	{
-		bitTree2.insert(Duplication2[i], i);
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		return String::fixedPrecision(elapsed.count(), 2);
+	}
+}
+
+bool ExeUnpacker::unpack(const uint8_t *srcPtr, size_t srcSize)
+{
+	if (!IsCompressedSizeValid(srcSize))
+	{
+		DebugLogError("Executable is too small to be PKLITE-compressed (" + std::to_string(srcSize) + " bytes).");
+		return false;
 	}
 
 	// Beginning and end of compressed data in the executable.
-	const uint8_t *compressedStart = srcPtr + 752;
-	const uint8_t *compressedEnd = srcPtr + (src.getCount() - 8);
+	const uint8_t *compressedStart = srcPtr + COMPRESSED_OFFSET;
+	const uint8_t *compressedEnd = srcPtr + (srcSize - TRAILER_SIZE);
+	const size_t compressedSize = compressedEnd - compressedStart;
 
 	// Last word of compressed data must be 0xFFFF.
 	const uint16_t lastCompWord = Bytes::getLE16(compressedEnd - 2);
@@ -250,110 +347,47 @@ bool ExeUnpacker::init(const char *filename)
 		return false;
 	}
 
-	// Calculate length of decompressed data -- more precise method (for A.EXE).
-	const size_t decompLen = [compressedEnd]()
-	{
-		const uint16_t segment = Bytes::getLE16(compressedEnd);
-		const uint16_t offset = Bytes::getLE16(compressedEnd + 2);
-		return (segment * 16) + offset;
-	}();
+	const size_t decompLen = GetDecompressedLength(srcPtr, srcSize);
 
 	// Buffer for the decompressed data (also little endian).
 	this->exeData = std::vector<uint8_t>(decompLen, 0);
+	uint8_t *decompPtr = this->exeData.data();
 
 	// Current position for inserting decompressed data.
 	size_t decompIndex = 0;
 
-	// A 16-bit array of compressed data.
-	uint16_t bitArray = Bytes::getLE16(compressedStart);
+	const DecodeTable1 &duplication1Table = GetDuplication1Table();
+	const DecodeTable2 &duplication2Table = GetDuplication2Table();
+	BitReader bitReader(compressedStart);
 
-	// Offset from start of compressed data (start at 2 because of the bit array).
-	int byteIndex = 2;
-
-	// Number of bits consumed in the current 16-bit array.
-	int bitsRead = 0;
-
-	// Continually read bit arrays from the compressed data and interpret each bit. 
-	// Break once a compressed byte equals 0xFF in duplication mode.
+	// Continually read bits from the compressed data and interpret them. Break once a compressed
+	// byte equals 0xFF in duplication mode. One pass reads at most a few bytes, and the trailer
+	// after the compressed data keeps those in bounds.
 	while (true)
 	{
-		// Lambda for getting the next byte from compressed data.
-		auto getNextByte = [compressedStart, &byteIndex]()
+		if (bitReader.getByteIndex() > compressedSize)
 		{
-			const uint8_t byte = compressedStart[byteIndex];
-			byteIndex++;
-
-			return byte;
-		};
-
-		// Lambda for getting the next bit in the theoretical bit stream.
-		auto getNextBit = [&bitArray, &bitsRead, &getNextByte]()
-		{
-			const bool bit = (bitArray & (1 << bitsRead)) != 0;
-			bitsRead++;
-
-			// Advance the bit array if done with the current one.
-			if (bitsRead == 16)
-			{
-				bitsRead = 0;
-
-				// Get two bytes in little endian format.
-				const uint8_t byte1 = getNextByte();
-				const uint8_t byte2 = getNextByte();
-				bitArray = byte1 | (byte2 << 8);
-			}
-
-			return bit;
-		};
+			DebugLogError("Compressed data ended without an end marker.");
+			return false;
+		}
 
 		// Decide which mode to use for the current bit.
-		if (getNextBit())
+		if (bitReader.getNextBit())
 		{
 			// "Duplication" mode.
-			// Calculate which bytes in the decompressed data to duplicate and append.
-			BitVector copyBits;
-			const int *copyPtr = nullptr;
-
-			// Read bits until they match a bit tree leaf.
-			while (copyPtr == nullptr)
-			{
-				copyBits.bits.at(copyBits.count) = getNextBit();
-				copyBits.count++;
-				copyPtr = bitTree1.get(copyBits);
-			}
-
 			// Calculate the number of bytes in the decompressed data to copy.
-			uint16_t copyCount = 0;
-
-			// Lambda for comparing a bit vector's equality with the special case.
-			auto matchesSpecialCase = [](const BitVector &bitVector)
+			int copyCount;
+			if (!bitReader.tryDecode(duplication1Table, &copyCount))
 			{
-				const std::vector<bool> &specialCase = Duplication1.at(11);
-				const bool equalSize = bitVector.count == specialCase.size();
-
-				if (!equalSize)
-				{
-					return false;
-				}
-				else
-				{
-					for (int i = 0; i < bitVector.count; i++)
-					{
-						if (bitVector.bits.at(i) != specialCase.at(i))
-						{
-							return false;
-						}
-					}
-
-					return true;
-				}
-			};
+				DebugLogError("Invalid byte count bits at " + std::to_string(bitReader.getByteIndex()) + ".");
+				return false;
+			}
 
 			// Check for the special bit vector case "011100".
-			if (matchesSpecialCase(copyBits))
+			if (copyCount == DUPLICATION1_SPECIAL_CASE)
 			{
 				// Read a compressed byte.
-				const uint8_t encryptedByte = getNextByte();
+				const uint8_t encryptedByte = bitReader.getNextByte();
 
 				if (encryptedByte == 0xFE)
 				{
@@ -371,69 +405,63 @@ bool ExeUnpacker::init(const char *filename)
 					copyCount = encryptedByte + 25;
 				}
 			}
-			else
-			{
-				// Use the decoded value from the first bit table.
-				copyCount = *copyPtr;
-			}
 
 			// Calculate the offset in decompressed data. It is a two byte value.
 			// The most significant byte is 0 by default.
-			uint8_t mostSigByte = 0;
+			int mostSigByte = 0;
 
 			// If the copy count is not 2, decode the most significant byte.
 			if (copyCount != 2)
 			{
-				BitVector offsetBits;
-				const int* offsetPtr = nullptr;
-
-				// Read bits until they match a bit tree leaf.
-				while (offsetPtr == nullptr)
+				if (!bitReader.tryDecode(duplication2Table, &mostSigByte))
 				{
-					offsetBits.bits.at(offsetBits.count) = getNextBit();
-					offsetBits.count++;
-					offsetPtr = bitTree2.get(offsetBits);
+					DebugLogError("Invalid offset bits at " + std::to_string(bitReader.getByteIndex()) + ".");
+					return false;
 				}
-
-				// Use the decoded value from the second bit table.
-				mostSigByte = *offsetPtr;
 			}
 
 			// Get the least significant byte of the two bytes.
-			const uint8_t leastSigByte = getNextByte();
+			const uint8_t leastSigByte = bitReader.getNextByte();
 
 			// Combine the two bytes.
-			const uint16_t offset = leastSigByte | (mostSigByte << 8);
+			const size_t offset = leastSigByte | (mostSigByte << 8);
+			if ((offset > decompIndex) || (static_cast<size_t>(copyCount) > (decompLen - decompIndex)))
+			{
+				DebugLogError("Invalid duplication (offset " + std::to_string(offset) + ", count " +
+					std::to_string(copyCount) + ") at " + std::to_string(decompIndex) + ".");
+				return false;
+			}
 
-			// Finally, duplicate the decompressed data using the calculated offset and size.
-			const size_t duplicateBegin = decompIndex - offset;
-			const size_t duplicateEnd = duplicateBegin + copyCount;
-			for (size_t i = duplicateBegin; i < duplicateEnd; i++, decompIndex++)
+			// Finally, duplicate the decompressed data using the calculated offset and size. The
+			// ranges can overlap, in which case bytes written earlier in the loop are repeated.
+			const uint8_t *duplicatePtr = decompPtr + (decompIndex - offset);
+			uint8_t *dstPtr = decompPtr + decompIndex;
+			for (int i = 0; i < copyCount; i++)
 			{
-				this->exeData.at(decompIndex) = this->exeData.at(i);
+				dstPtr[i] = duplicatePtr[i];
 			}
+
+			decompIndex += copyCount;
 		}
 		else
 		{
 			// "Decryption" mode.
 			// Read the next byte from the compressed data.
-			const uint8_t encryptedByte = getNextByte();
-
-			// Lambda for decrypting an encrypted byte with an XOR operation based on 
-			// the current bit index. "bitsRead" is between 0 and 15. It is 0 if the
-			// 16th bit of the previous array was used to get here.
-			auto decrypt = [](uint8_t encryptedByte, int bitsRead)
-			{
-				const uint8_t key = 16 - bitsRead;
-				const uint8_t decryptedByte = encryptedByte ^ key;
-				return decryptedByte;
-			};
+			const uint8_t encryptedByte = bitReader.getNextByte();
 
-			// Decrypt the byte.
-			const uint8_t decryptedByte = decrypt(encryptedByte, bitsRead);
+			// Decrypt the byte with an XOR operation based on the current bit index. "bitsRead" is
+			// between 0 and 15. It is 0 if the 16th bit of the previous array was used to get here.
+			const uint8_t key = 16 - bitReader.getBitsRead();
+			const uint8_t decryptedByte = encryptedByte ^ key;
 
 			// Append the decrypted byte onto the decompressed data.
-			this->exeData.at(decompIndex) = decryptedByte;
+			if (decompIndex == decompLen)
+			{
+				DebugLogError("Decompressed data is larger than " + std::to_string(decompLen) + " bytes.");
+				return false;
+			}
+
+			decompPtr[decompIndex] = decryptedByte;
 			decompIndex++;
 		}
 	}
@@ -441,6 +469,154 @@ bool ExeUnpacker::init(const char *filename)
 	return true;
 }
 
+bool ExeUnpacker::tryReadCache(const char *cacheFilename, uint64_t sourceHash, size_t sourceSize,
+	size_t dataSize)
+{
+	std::ifstream ifs(cacheFilename, std::ios::binary);
+	if (!ifs.is_open())
+	{
+		return false;
+	}
+
+	CacheHeader header;
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	{
+		DebugLogWarning("Unpacked executable cache \"" + std::string(cacheFilename) + "\" is truncated.");
+		return false;
+	}
+
+	if ((std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) || (header.version != CACHE_VERSION))
+	{
+		DebugLogWarning("Unpacked executable cache \"" + std::string(cacheFilename) + "\" has an unrecognized format.");
+		return false;
+	}
+
+	if ((header.sourceHash != sourceHash) || (header.sourceSize != sourceSize))
+	{
+		DebugLog("Unpacked executable cache \"" + std::string(cacheFilename) +
+			"\" is from a different executable, ignoring.");
+		return false;
+	}
+
+	// Check the data size before allocating so a damaged header can't ask for an arbitrary amount.
+	const std::streampos dataOffset = ifs.tellg();
+	ifs.seekg(0, std::ios::end);
+	const std::streampos fileSize = ifs.tellg();
+	ifs.seekg(dataOffset);
+	if ((dataOffset < 0) || (fileSize < dataOffset) || !ifs.good() ||
+		(header.dataSize != static_cast<uint64_t>(fileSize - dataOffset)) || (header.dataSize != dataSize))
+	{
+		DebugLogWarning("Unpacked executable cache \"" + std::string(cacheFilename) + "\" has the wrong size.");
+		return false;
+	}
+
+	std::vector<uint8_t> data(dataSize);
+	if (!ifs.read(reinterpret_cast<char*>(data.data()), data.size()) ||
+		(HashBytes(data.data(), data.size()) != header.dataHash))
+	{
+		DebugLogWarning("Unpacked executable cache \"" + std::string(cacheFilename) + "\" is corrupt.");
+		return false;
+	}
+
+	this->exeData = std::move(data);
+	return true;
+}
+
+bool ExeUnpacker::writeCache(const char *cacheFilename, uint64_t sourceHash, size_t sourceSize) const
+{
+	CacheHeader header;
+	std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.sourceHash = sourceHash;
+	header.sourceSize = sourceSize;
+	header.dataHash = HashBytes(this->exeData.data(), this->exeData.size());
+	header.dataSize = this->exeData.size();
+
+	// Write to a temporary file first so an interrupted write never leaves a partial cache behind.
+	const std::string tempFilename = std::string(cacheFilename) + ".tmp";
+	{
+		std::ofstream ofs(tempFilename, std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open())
+		{
+			DebugLogWarning("Couldn't open unpacked executable cache \"" + tempFilename + "\" for writing.");
+			return false;
+		}
+
+		ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		ofs.write(reinterpret_cast<const char*>(this->exeData.data()), this->exeData.size());
+		ofs.close();
+		if (!ofs.good())
+		{
+			DebugLogWarning("Couldn't write unpacked executable cache \"" + tempFilename + "\".");
+			std::remove(tempFilename.c_str());
+			return false;
+		}
+	}
+
+	// Windows can't rename over an existing file, so remove it and retry.
+	bool renamed = std::rename(tempFilename.c_str(), cacheFilename) == 0;
+	if (!renamed)
+	{
+		std::remove(cacheFilename);
+		renamed = std::rename(tempFilename.c_str(), cacheFilename) == 0;
+	}
+
+	if (!renamed)
+	{
+		DebugLogWarning("Couldn't move unpacked executable cache \"" + tempFilename + "\" to \"" +
+			std::string(cacheFilename) + "\".");
+		std::remove(tempFilename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool ExeUnpacker::init(const char *filename, const char *cacheFilename)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	Buffer<std::byte> src;
+	if (!VFS::Manager::get().read(filename, &src))
+	{
+		DebugLogError("Could not read \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+	const size_t srcSize = static_cast<size_t>(src.getCount());
+
+	// Prefer the cached decompressed image if it was made from this exact executable.
+	uint64_t sourceHash = 0;
+	if ((cacheFilename != nullptr) && IsCompressedSizeValid(srcSize))
+	{
+		sourceHash = HashBytes(srcPtr, srcSize);
+		const size_t dataSize = GetDecompressedLength(srcPtr, srcSize);
+		if (this->tryReadCache(cacheFilename, sourceHash, srcSize, dataSize))
+		{
+			DebugLog("Loaded unpacked \"" + std::string(filename) + "\" from cache in " +
+				GetElapsedMilliseconds(startTime) + "ms.");
+			return true;
+		}
+	}
+
+	if (!this->unpack(srcPtr, srcSize))
+	{
+		DebugLogError("Could not unpack \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	DebugLog("Unpacked \"" + std::string(filename) + "\" in " + GetElapsedMilliseconds(startTime) + "ms.");
+
+	if (cacheFilename != nullptr)
+	{
+		// Not fatal; the executable is unpacked again next time.
+		this->writeCache(cacheFilename, sourceHash, srcSize);
+	}
+
+	return true;
+}
+
 const std::vector<uint8_t> &ExeUnpacker::getData() const
 {
 	return this->exeData;
@@ -1,6 +1,7 @@
 #ifndef EXE_UNPACKER_H
 #define EXE_UNPACKER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -10,9 +11,18 @@ class ExeUnpacker
 {
 private:
 	std::vector<uint8_t> exeData;
+
+	// Decompresses the given PKLITE-compressed executable.
+	bool unpack(const uint8_t *srcPtr, size_t srcSize);
+
+	// Loads a previously decompressed image if it was made from an executable with the given hash
+	// and size, and has the decompressed length that executable says it unpacks to.
+	bool tryReadCache(const char *cacheFilename, uint64_t sourceHash, size_t sourceSize, size_t dataSize);
+	bool writeCache(const char *cacheFilename, uint64_t sourceHash, size_t sourceSize) const;
 public:
-	// Reads in a compressed EXE file and decompresses it.
-	bool init(const char *filename);
+	// Reads in a compressed EXE file and decompresses it. If a cache filename is given, the
+	// decompressed image is read from there when it matches the EXE, and written there otherwise.
+	bool init(const char *filename, const char *cacheFilename = nullptr);
 
 	// Gets the decompressed executable data.
 	const std::vector<uint8_t> &getData() const;
@@ -1,9 +1,9 @@
 #include <algorithm>
 #include <cctype>
-#include <cstdio>
+#include <charconv>
 #include <sstream>
 #include <string_view>
-#include <unordered_set>
+#include <unordered_map>
 
 #include "INFFile.h"
 
@@ -14,182 +14,1130 @@
 
 namespace
 {
+	// Gets the token at the given index when splitting on a separator. Same as indexing into
+	// StringView::split() without allocating. Returns false if there aren't enough tokens.
+	bool TryGetToken(const std::string_view &str, char separator, int index, std::string_view *outToken)
+	{
+		size_t begin = 0;
+		for (int i = 0; i < index; i++)
+		{
+			const size_t separatorPos = str.find(separator, begin);
+			if (separatorPos == std::string_view::npos)
+			{
+				return false;
+			}
+
+			begin = separatorPos + 1;
+		}
+
+		const size_t end = std::min(str.find(separator, begin), str.size());
+		*outToken = str.substr(begin, end - begin);
+		return true;
+	}
+
+	// Same as StringView::split(str, separator).size().
+	int GetTokenCount(const std::string_view &str, char separator)
+	{
+		return static_cast<int>(std::count(str.begin(), str.end(), separator)) + 1;
+	}
+
+	std::string_view GetToken(const std::string_view &str, char separator, int index)
+	{
+		std::string_view token;
+		if (!TryGetToken(str, separator, index, &token))
+		{
+			DebugCrash("Missing token " + std::to_string(index) + " in \"" + std::string(str) + "\".");
+		}
+
+		return token;
+	}
+
+	std::string_view GetToken(const std::string_view &str, int index)
+	{
+		return GetToken(str, String::SPACE, index);
+	}
+
+	// Parses the leading integer of a token, ignoring anything after it like std::stoi() does.
+	int ParseInt(const std::string_view &str)
+	{
+		const std::string_view trimmed = StringView::trimFront(str);
+		const char *begin = trimmed.data();
+		const char *end = begin + trimmed.size();
+		if ((begin != end) && (*begin == '+'))
+		{
+			begin++;
+		}
+
+		int value;
+		const std::from_chars_result result = std::from_chars(begin, end, value);
+		if (result.ec != std::errc())
+		{
+			DebugCrash("Invalid integer \"" + std::string(str) + "\".");
+		}
+
+		return value;
+	}
+
+	// Whitespace between flat line tokens can be any mix of spaces and tabs.
+	bool IsFlatTokenSeparator(char c)
+	{
+		return (c == ' ') || (c == '\t');
+	}
+
+	// Gets the next token in a flat line after the given position, treating each run of spaces
+	// and tabs as one separator. Returns false at the end of the line.
+	bool TryGetNextFlatToken(const std::string_view &line, size_t *position, std::string_view *outToken)
+	{
+		size_t begin = *position;
+		if (begin > line.size())
+		{
+			return false;
+		}
+
+		size_t end = begin;
+		while ((end < line.size()) && !IsFlatTokenSeparator(line[end]))
+		{
+			end++;
+		}
+
+		*outToken = line.substr(begin, end - begin);
+
+		// Skip the separator run so the next token starts after it.
+		size_t next = end;
+		while ((next < line.size()) && IsFlatTokenSeparator(line[next]))
+		{
+			next++;
+		}
+
+		*position = ((next == end) && (end == line.size())) ? (line.size() + 1) : next;
+		return true;
+	}
+
+	// Keeps the first entry for each ID, like std::unordered_map::insert() would, and sorts them
+	// for binary search.
+	template <typename T>
+	void SortByID(std::vector<std::pair<int, T>> &entries)
+	{
+		std::stable_sort(entries.begin(), entries.end(),
+			[](const std::pair<int, T> &a, const std::pair<int, T> &b)
+		{
+			return a.first < b.first;
+		});
+
+		const auto uniqueEnd = std::unique(entries.begin(), entries.end(),
+			[](const std::pair<int, T> &a, const std::pair<int, T> &b)
+		{
+			return a.first == b.first;
+		});
+
+		entries.erase(uniqueEnd, entries.end());
+	}
+
+	template <typename T>
+	const T *FindByID(const std::vector<std::pair<int, T>> &entries, int id)
+	{
+		const auto iter = std::lower_bound(entries.begin(), entries.end(), id,
+			[](const std::pair<int, T> &entry, int id)
+		{
+			return entry.first < id;
+		});
+
+		return ((iter != entries.end()) && (iter->first == id)) ? &iter->second : nullptr;
+	}
+
+	// Reads the .INF into the buffer, decrypting it if it's from GLOBAL.BSA.
+	bool TryReadDecrypted(const char *filename, Buffer<std::byte> *outSrc)
+	{
+		bool inGlobalBSA; // Set by VFS open() function.
+
+		// Some filenames (i.e., Crystal3.inf) have different casing between the floppy version and
+		// CD version, so this needs to use the case-insensitive open() method for correct behavior
+		// on Unix-based systems.
+		if (!VFS::Manager::get().readCaseInsensitive(filename, outSrc, &inGlobalBSA))
+		{
+			DebugLogError("Could not read \"" + std::string(filename) + "\".");
+			return false;
+		}
+
+		char *srcPtr = reinterpret_cast<char*>(outSrc->get());
+		char *srcEnd = reinterpret_cast<char*>(outSrc->end());
+
+		// Check if the .INF is encrypted.
+		const bool isEncrypted = inGlobalBSA;
+
+		if (isEncrypted)
+		{
+			// Adapted from BSATool.
+			constexpr std::array<uint8_t, 8> encryptionKeys =
+			{
+				0xEA, 0x7B, 0x4E, 0xBD, 0x19, 0xC9, 0x38, 0x99
+			};
+
+			// Iterate through the encoded data, XORing with some encryption keys.
+			// The count repeats every 256 bytes, and the key repeats every 8 bytes.
+			uint8_t keyIndex = 0;
+			uint8_t count = 0;
+			for (auto it = srcPtr; it != srcEnd; ++it)
+			{
+				uint8_t encryptedByte = static_cast<uint8_t>(*it);
+				encryptedByte ^= count + encryptionKeys[keyIndex];
+				*it = static_cast<char>(encryptedByte);
+				keyIndex = (keyIndex + 1) % encryptionKeys.size();
+				count++;
+			}
+		}
+
+		return true;
+	}
+
 	// Each '@' section may or may not have some state it currently possesses. They 
 	// also have a mode they can be in, via a tag like *BOXCAP or *TEXT.
 	struct FloorState
 	{
 		enum class Mode { None, BoxCap, Ceiling };
 
-		std::optional<INFFile::CeilingData> ceilingData;
-		std::string_view textureName;
-		FloorState::Mode mode;
-		std::optional<int> boxCapID;
+		std::optional<INFFile::CeilingData> ceilingData;
+		std::string_view textureName;
+		FloorState::Mode mode;
+		std::optional<int> boxCapID;
+
+		FloorState()
+		{
+			this->mode = FloorState::Mode::None;
+		}
+	};
+
+	struct WallState
+	{
+		enum class Mode
+		{
+			None, BoxCap, BoxSide, DryChasm, LavaChasm,
+			LevelDown, LevelUp, Menu, WetChasm
+		};
+
+		std::vector<int> boxCapIDs, boxSideIDs;
+		std::string_view textureName;
+		WallState::Mode mode;
+		std::optional<int> menuID;
+		bool dryChasm, lavaChasm, wetChasm;
+		// *TRANS, *TRANSWALKTHRU, and *WALKTHRU are unused (set by voxel data instead).
+
+		WallState()
+		{
+			this->mode = WallState::Mode::None;
+			this->dryChasm = false;
+			this->lavaChasm = false;
+			this->wetChasm = false;
+		}
+	};
+
+	struct FlatState
+	{
+		enum class Mode { None, Item };
+
+		FlatState::Mode mode;
+		std::optional<int> itemID;
+
+		FlatState()
+		{
+			this->mode = FlatState::Mode::None;
+		}
+	};
+
+	struct TextState
+	{
+		enum class Mode { None, Key, Riddle, Text };
+
+		struct RiddleState
+		{
+			enum class Mode { Riddle, Correct, Wrong };
+
+			INFFile::RiddleData data;
+			RiddleState::Mode mode;
+
+			RiddleState(int firstNumber, int secondNumber)
+				: data(firstNumber, secondNumber)
+			{
+				this->mode = RiddleState::Mode::Riddle;
+			}
+		};
+
+		std::optional<INFFile::KeyData> keyData;
+		std::optional<RiddleState> riddleState;
+		std::optional<INFFile::TextData> textData;
+		TextState::Mode mode; // Determines which data is in use.
+		int id; // *TEXT ID.
+
+		TextState(int id)
+		{
+			this->mode = TextState::Mode::None;
+			this->id = id;
+		}
+	};
+}
+
+INFFile::VoxelTextureData::VoxelTextureData(const std::string_view &filename, const std::optional<int> &setIndex)
+	: filename(filename), setIndex(setIndex) { }
+
+INFFile::VoxelTextureData::VoxelTextureData(const std::string_view &filename)
+	: VoxelTextureData(filename, std::nullopt) { }
+
+INFFile::FlatTextureData::FlatTextureData(std::string &&filename)
+	: filename(std::move(filename)) { }
+
+INFFile::CeilingData::CeilingData()
+{
+	this->height = CeilingData::DEFAULT_HEIGHT;
+	this->outdoorDungeon = false;
+}
+
+INFFile::FlatData::FlatData()
+{
+	this->yOffset = 0;
+	this->health = 0;
+	this->collider = false;
+	this->puddle = false;
+	this->largeScale = false;
+	this->dark = false;
+	this->transparent = false;
+	this->ceiling = false;
+	this->mediumScale = false;
+}
+
+INFFile::KeyData::KeyData(int id)
+{
+	this->id = id;
+}
+
+INFFile::RiddleData::RiddleData(int firstNumber, int secondNumber)
+{
+	this->firstNumber = firstNumber;
+	this->secondNumber = secondNumber;
+}
+
+INFFile::TextData::TextData(bool displayedOnce)
+{
+	this->displayedOnce = displayedOnce;
+}
+
+bool INFFile::init(const char *filename)
+{
+	Buffer<std::byte> src;
+	if (!TryReadDecrypted(filename, &src))
+	{
+		return false;
+	}
+
+	BufferView<char> data(reinterpret_cast<char*>(src.get()), src.getCount());
+	return this->initFromText(filename, data);
+}
+
+bool INFFile::initFromText(const char *name, BufferView<char> data)
+{
+	char *srcPtr = data.get();
+	char *srcEnd = data.end();
+	this->name = name;
+
+	// Remove carriage returns in place (newlines are nicer to work with). The decoded buffer is
+	// parsed directly and lines are views into it.
+	srcEnd = std::remove(srcPtr, srcEnd, '\r');
+	const std::string_view text(srcPtr, srcEnd - srcPtr);
+
+	// The parse mode indicates which '@' section is currently being parsed.
+	enum class ParseMode
+	{
+		Floors, Walls, Flats, Sound, Text
+	};
+
+	// Initialize loop states to empty (they are non-empty when in use by the loop).
+	// I tried re-organizing them into virtual classes, but this way seems to be the
+	// most practical for now.
+	std::optional<FloorState> floorState;
+	std::optional<WallState> wallState;
+	std::optional<FlatState> flatState;
+	std::optional<TextState> textState;
+
+	// Lambda for flushing state to the INFFile. This is useful during the parse loop,
+	// but it's also sometimes necessary at the end of the file because the last element 
+	// of certain sections (i.e., @TEXT) might get missed if there is no data after them.
+	auto flushTextState = [this, &textState]()
+	{
+		if (textState->mode == TextState::Mode::Key)
+		{
+			// Save key data.
+			this->keys.emplace_back(textState->id, textState->keyData.value());
+		}
+		else if (textState->mode == TextState::Mode::Riddle)
+		{
+			// Save riddle data.
+			this->riddles.emplace_back(textState->id, std::move(textState->riddleState->data));
+		}
+		else if (textState->mode == TextState::Mode::Text)
+		{
+			// Save text data.
+			this->texts.emplace_back(textState->id, std::move(textState->textData.value()));
+		}
+	};
+
+	// Lambda for flushing all states. Most states don't need an explicit flush because 
+	// they have no risk of leaving data behind.
+	auto flushAllStates = [&floorState, &wallState, &flatState, 
+		&textState, &flushTextState]()
+	{
+		if (floorState.has_value())
+		{
+			floorState.reset();
+		}
+
+		if (wallState.has_value())
+		{
+			wallState.reset();
+		}
+
+		if (flatState.has_value())
+		{
+			flatState.reset();
+		}
+
+		if (textState.has_value())
+		{
+			flushTextState();
+			textState.reset();
+		}
+	};
+
+	// Lambdas for parsing a line of text.
+	auto parseFloorLine = [this, &floorState](const std::string_view &line)
+	{
+		const char TYPE_CHAR = '*';
+
+		// Decide what to do based on the first character. Otherwise, read the line
+		// as a texture filename.
+		if (line.front() == TYPE_CHAR)
+		{
+			// Initialize floor state if it is null.
+			if (!floorState.has_value())
+			{
+				floorState = FloorState();
+			}
+
+			constexpr std::string_view BOXCAP_STR = "BOXCAP";
+			constexpr std::string_view CEILING_STR = "CEILING";
+			constexpr std::string_view TOP_STR = "TOP"; // Only occurs in LABRNTH{1,2}.INF.
+
+			// See what the type in the line is.
+			const std::string_view firstToken = GetToken(line, 0);
+			const std::string_view firstTokenType = firstToken.substr(1, firstToken.size() - 1);
+
+			if (firstTokenType == BOXCAP_STR)
+			{
+				// Write the *BOXCAP's ID to the floor state.
+				floorState->boxCapID = ParseInt(GetToken(line, 1));
+				floorState->mode = FloorState::Mode::BoxCap;
+			}
+			else if (firstTokenType == CEILING_STR)
+			{
+				// Initialize ceiling data.
+				floorState->ceilingData = CeilingData();
+				floorState->mode = FloorState::Mode::Ceiling;
+
+				// Check up to three numbers on the right: ceiling height, box scale,
+				// and indoor/outdoor dungeon boolean. Sometimes there are no numbers.
+				const int tokenCount = GetTokenCount(line, String::SPACE);
+				if (tokenCount >= 2)
+				{
+					floorState->ceilingData->height = ParseInt(GetToken(line, 1));
+				}
+
+				if (tokenCount >= 3)
+				{
+					floorState->ceilingData->boxScale = ParseInt(GetToken(line, 2));
+				}
+
+				if (tokenCount == 4)
+				{
+					floorState->ceilingData->outdoorDungeon = GetToken(line, 3) == "1";
+				}
+			}
+			else if (firstTokenType == TOP_STR)
+			{
+				// Not sure what *TOP is.
+				static_cast<void>(firstTokenType);
+			}
+			else
+			{
+				DebugCrash("Unrecognized @FLOOR section \"" + std::string(firstToken) + "\".");
+			}
+		}
+		else if (!floorState.has_value())
+		{
+			// No current floor state, so the current line is a loose texture filename
+			// (found in some city .INFs).
+			const int tokenCount = GetTokenCount(line, '#');
+
+			if (tokenCount == 1)
+			{
+				// A regular filename (like an .IMG).
+				this->voxelTextures.emplace_back(line);
+			}
+			else
+			{
+				// A .SET filename. Expand it for each of the .SET indices.
+				const std::string_view textureName = StringView::trimBack(GetToken(line, '#', 0));
+				const int setSize = ParseInt(GetToken(line, '#', 1));
+
+				for (int i = 0; i < setSize; i++)
+				{
+					this->voxelTextures.emplace_back(textureName, i);
+				}
+			}
+		}
+		else
+		{
+			// There is existing floor state (or it is in the default state with box cap 
+			// ID unset), so this line is expected to be a filename.
+			const int currentIndex = [this, &floorState, &line]()
+			{
+				// If the line contains a '#', it's a .SET file.
+				const int tokenCount = GetTokenCount(line, '#');
+
+				// Assign texture data depending on whether the line is for a .SET file.
+				if (tokenCount == 1)
+				{
+					// Just a regular texture (like an .IMG).
+					floorState->textureName = line;
+
+					this->voxelTextures.emplace_back(floorState->textureName);
+					return static_cast<int>(this->voxelTextures.size()) - 1;
+				}
+				else
+				{
+					// Left side is the filename, right side is the .SET size.
+					floorState->textureName = StringView::trimBack(GetToken(line, '#', 0));
+					const int setSize = ParseInt(GetToken(line, '#', 1));
+
+					for (int i = 0; i < setSize; i++)
+					{
+						this->voxelTextures.emplace_back(floorState->textureName, i);
+					}
+
+					return static_cast<int>(this->voxelTextures.size()) - setSize;
+				}
+			}();
+
+			// Write the boxcap data if a *BOXCAP line is currently stored in the floor state.
+			// The floor state ID will be unset for loose filenames that don't have an 
+			// associated *BOXCAP line, but might have an associated *CEILING line.
+			if (floorState->boxCapID.has_value())
+			{
+				this->boxCaps.at(floorState->boxCapID.value()) = currentIndex;
+			}
+
+			// Write to the ceiling data if it is being defined for the current group.
+			if (floorState->ceilingData.has_value())
+			{
+				this->ceiling.textureIndex = currentIndex;
+				this->ceiling.height = floorState->ceilingData->height;
+				this->ceiling.boxScale = std::move(floorState->ceilingData->boxScale);
+				this->ceiling.outdoorDungeon = floorState->ceilingData->outdoorDungeon;
+			}
+
+			// Reset the floor state for any future floor data.
+			floorState = FloorState();
+		}
+	};
+
+	auto parseWallLine = [this, &wallState](const std::string_view &line)
+	{
+		const char TYPE_CHAR = '*';
+
+		// Decide what to do based on the first character. Otherwise, read the line
+		// as a texture filename.
+		if (line.front() == TYPE_CHAR)
+		{
+			// Initialize wall state if it is null.
+			if (!wallState.has_value())
+			{
+				wallState = WallState();
+			}
+
+			// All the different possible '*' sections for walls.
+			constexpr std::string_view BOXCAP_STR = "BOXCAP";
+			constexpr std::string_view BOXSIDE_STR = "BOXSIDE";
+			constexpr std::string_view DOOR_STR = "DOOR"; // *DOOR is ignored.
+			constexpr std::string_view DRYCHASM_STR = "DRYCHASM";
+			constexpr std::string_view LAVACHASM_STR = "LAVACHASM";
+			constexpr std::string_view LEVELDOWN_STR = "LEVELDOWN";
+			constexpr std::string_view LEVELUP_STR = "LEVELUP";
+			constexpr std::string_view MENU_STR = "MENU"; // Exterior <-> interior transitions.
+			constexpr std::string_view TRANS_STR = "TRANS"; // *TRANS is ignored.
+			constexpr std::string_view TRANSWALKTHRU_STR = "TRANSWALKTHRU"; // *TRANSWALKTHRU is ignored.
+			constexpr std::string_view WALKTHRU_STR = "WALKTHRU"; // *WALKTHRU is ignored.
+			constexpr std::string_view WETCHASM_STR = "WETCHASM";
+
+			// See what the type in the line is.
+			const std::string_view firstToken = GetToken(line, 0);
+			const std::string_view firstTokenType = firstToken.substr(1, firstToken.size() - 1);
+
+			if (firstTokenType == BOXCAP_STR)
+			{
+				wallState->mode = WallState::Mode::BoxCap;
+				wallState->boxCapIDs.push_back(ParseInt(GetToken(line, 1)));
+			}
+			else if (firstTokenType == BOXSIDE_STR)
+			{
+				wallState->mode = WallState::Mode::BoxSide;
+				wallState->boxSideIDs.push_back(ParseInt(GetToken(line, 1)));
+			}
+			else if (firstTokenType == DOOR_STR)
+			{
+				// Ignore *DOOR lines explicitly so they aren't "unrecognized".
+				static_cast<void>(firstTokenType);
+			}
+			else if (firstTokenType == DRYCHASM_STR)
+			{
+				wallState->mode = WallState::Mode::DryChasm;
+				wallState->dryChasm = true;
+			}
+			else if (firstTokenType == LAVACHASM_STR)
+			{
+				wallState->mode = WallState::Mode::LavaChasm;
+				wallState->lavaChasm = true;
+			}
+			else if (firstTokenType == LEVELDOWN_STR)
+			{
+				wallState->mode = WallState::Mode::LevelDown;
+			}
+			else if (firstTokenType == LEVELUP_STR)
+			{
+				wallState->mode = WallState::Mode::LevelUp;
+			}
+			else if (firstTokenType == MENU_STR)
+			{
+				wallState->mode = WallState::Mode::Menu;
+				wallState->menuID = ParseInt(GetToken(line, 1));
+			}
+			else if (firstTokenType == TRANS_STR)
+			{
+				// Ignore *TRANS lines (unused).
+				static_cast<void>(firstTokenType);
+			}
+			else if (firstTokenType == TRANSWALKTHRU_STR)
+			{
+				// Ignore *TRANSWALKTHRU lines (unused).
+				static_cast<void>(firstTokenType);
+			}
+			else if (firstTokenType == WALKTHRU_STR)
+			{
+				// Ignore *WALKTHRU lines (unused).
+				static_cast<void>(firstTokenType);
+			}
+			else if (firstTokenType == WETCHASM_STR)
+			{
+				wallState->mode = WallState::Mode::WetChasm;
+				wallState->wetChasm = true;
+			}
+			else
+			{
+				DebugCrash("Unrecognized @WALLS section \"" + std::string(firstTokenType) + "\".");
+			}
+		}
+		else if (!wallState.has_value())
+		{
+			// No existing wall state, so this line contains a "loose" texture name.
+			const int tokenCount = GetTokenCount(line, '#');
+
+			if (tokenCount == 1)
+			{
+				// A regular filename (like an .IMG).
+				this->voxelTextures.emplace_back(line);
+			}
+			else
+			{
+				// A .SET filename. Expand it for each of the .SET indices.
+				const std::string_view textureName = StringView::trimBack(GetToken(line, '#', 0));
+				const int setSize = ParseInt(GetToken(line, '#', 1));
+
+				for (int i = 0; i < setSize; i++)
+				{
+					this->voxelTextures.emplace_back(textureName, i);
+				}
+			}
+		}
+		else
+		{
+			// There is existing wall state, so this line contains a texture name associated 
+			// with some '*' section(s).
+			const int currentIndex = [this, &wallState, &line]()
+			{
+				// If the line contains a '#', it's a .SET file.
+				const int tokenCount = GetTokenCount(line, '#');
+
+				// Assign texture data depending on whether the line is for a .SET file.
+				if (tokenCount == 1)
+				{
+					// Just a regular texture (like an .IMG).
+					wallState->textureName = line;
+
+					this->voxelTextures.emplace_back(wallState->textureName);
+					return static_cast<int>(this->voxelTextures.size()) - 1;
+				}
+				else
+				{
+					// Left side is the filename, right side is the .SET size.
+					wallState->textureName = StringView::trimBack(GetToken(line, '#', 0));
+					const int setSize = ParseInt(GetToken(line, '#', 1));
+
+					for (int i = 0; i < setSize; i++)
+					{
+						this->voxelTextures.emplace_back(wallState->textureName, i);
+					}
+
+					return static_cast<int>(this->voxelTextures.size()) - setSize;
+				}
+			}();
+
+			// Write ID-related data for each tag (*BOXCAP, *BOXSIDE, etc.) found in the 
+			// current wall state.
+			for (int boxCapID : wallState->boxCapIDs)
+			{
+				this->boxCaps.at(boxCapID) = currentIndex;
+			}
+
+			for (int boxSideID : wallState->boxSideIDs)
+			{
+				this->boxSides.at(boxSideID) = currentIndex;
+			}
+
+			// Write *MENU ID (if any).
+			if (wallState->menuID.has_value())
+			{
+				this->menus.at(wallState->menuID.value()) = currentIndex;
+			}
+
+			// Write texture index for any chasms.
+			if (wallState->dryChasm)
+			{
+				this->dryChasmIndex = currentIndex;
+			}
+			else if (wallState->lavaChasm)
+			{
+				this->lavaChasmIndex = currentIndex;
+			}
+			else if (wallState->wetChasm)
+			{
+				this->wetChasmIndex = currentIndex;
+			}
+
+			// Write the texture index based on remaining wall modes.
+			if (wallState->mode == WallState::Mode::LevelDown)
+			{
+				this->levelDownIndex = currentIndex;
+			}
+			else if (wallState->mode == WallState::Mode::LevelUp)
+			{
+				this->levelUpIndex = currentIndex;
+			}
+
+			wallState = WallState();
+		}
+	};
+
+	auto parseFlatLine = [this, &flatState](const std::string_view &line)
+	{
+		const char TYPE_CHAR = '*';
+
+		// Check if the first character is a '*' for an *ITEM line. Otherwise, read the line 
+		// as a texture filename, and check for extra tokens on the right (F:, Y:, etc.).
+		if (line.front() == TYPE_CHAR)
+		{
+			// Initialize flat state if it is null.
+			if (!flatState.has_value())
+			{
+				flatState = FlatState();
+			}
+
+			constexpr std::string_view ITEM_STR = "ITEM";
+
+			// See what the type in the line is.
+			const std::string_view firstToken = GetToken(line, 0);
+			const std::string_view firstTokenType = firstToken.substr(1, firstToken.size() - 1);
+
+			if (firstTokenType == ITEM_STR)
+			{
+				flatState->mode = FlatState::Mode::Item;
+				flatState->itemID = ParseInt(GetToken(line, 1));
+			}
+			else
+			{
+				DebugCrash("Unrecognized @FLATS section \"" + std::string(firstTokenType) + "\".");
+			}
+		}
+		else
+		{
+			// Separator for each modifier value to the right of the flat name.
+			const char MODIFIER_SEPARATOR = ':';
+
+			// A texture name potentially after an *ITEM line, and potentially with some 
+			// modifiers on the right. Each token might be split by tabs or spaces, so always 
+			// check for both cases. The texture name always has a tab on the right though 
+			// (if there's any whitespace).
+			// Special case at *ITEM 55 in CRYSTAL3.INF: do not split on whitespace, because
+			// there are no modifiers.
+			const bool hasModifiers = line.find(MODIFIER_SEPARATOR) != std::string_view::npos;
+			size_t tokenPosition = 0;
+
+			// Get the texture name. Creature flats are between *ITEM 32 and *ITEM 54. These do
+			// not need their texture line parsed because their animation filename is fetched
+			// later as a .CFA (supposedly the placeholder .DFAs are for the level editor).
+			std::string textureName;
+			if (hasModifiers)
+			{
+				std::string_view firstToken;
+				TryGetNextFlatToken(line, &tokenPosition, &firstToken);
+				textureName = std::string(firstToken);
+			}
+			else
+			{
+				// The whole line, with each run of whitespace as one space.
+				textureName.reserve(line.size());
+				for (size_t i = 0; i < line.size(); i++)
+				{
+					const char c = line[i];
+					if (!IsFlatTokenSeparator(c))
+					{
+						textureName.push_back(c);
+					}
+					else if ((i == 0) || !IsFlatTokenSeparator(line[i - 1]))
+					{
+						textureName.push_back(' ');
+					}
+				}
+			}
+
+			const bool hasDash = textureName.at(0) == '-'; // @todo: not sure what this is.
+			if (hasDash)
+			{
+				textureName.erase(textureName.begin());
+			}
+
+			// Add the flat's texture name to the textures vector.
+			this->flatTextures.emplace_back(String::toUppercase(textureName));
+
+			// Add a new flat data record.
+			this->flats.push_back(INFFile::FlatData());
+
+			// Assign the current line's values and modifiers to the new flat.
+			INFFile::FlatData &flat = this->flats.back();
+			flat.textureIndex = static_cast<int>(this->flatTextures.size() - 1);
+			flat.itemIndex = flatState.has_value() ? flatState->itemID : std::nullopt;
+
+			// If the flat has modifiers, then check each modifier and mutate the flat accordingly.
+			// If it is a creature then it will ignore these modifiers and use ones from the creature
+			// arrays in the .exe data.
+			if (hasModifiers)
+			{
+				std::string_view modifierStr;
+				while (TryGetNextFlatToken(line, &tokenPosition, &modifierStr))
+				{
+					const char FLAT_PROPERTIES_MODIFIER = 'F';
+					const char LIGHT_MODIFIER = 'S';
+					const char Y_OFFSET_MODIFIER = 'Y';
+
+					const char modifierType = std::toupper(modifierStr.at(0));
+
+					// The modifier value comes after the modifier separator.
+					const int modifierValue = ParseInt(GetToken(modifierStr, MODIFIER_SEPARATOR, 1));
+
+					if (modifierType == FLAT_PROPERTIES_MODIFIER)
+					{
+						// Flat properties (collider, puddle, triple scale, transparent, etc.).
+						flat.collider = (modifierValue & (1 << 0)) != 0;
+						flat.puddle = (modifierValue & (1 << 1)) != 0;
+						flat.largeScale = (modifierValue & (1 << 2)) != 0;
+						flat.dark = (modifierValue & (1 << 3)) != 0;
+						flat.transparent = (modifierValue & (1 << 4)) != 0;
+						flat.ceiling = (modifierValue & (1 << 5)) != 0;
+						flat.mediumScale = (modifierValue & (1 << 6)) != 0;
+					}
+					else if (modifierType == LIGHT_MODIFIER)
+					{
+						// Light range (in units of voxels).
+						flat.lightIntensity = modifierValue;
+					}
+					else if (modifierType == Y_OFFSET_MODIFIER)
+					{
+						// Y offset in world (for flying entities, hanging chains, etc.).
+						flat.yOffset = modifierValue;
+					}
+					else
+					{
+						DebugCrash("Unrecognized modifier \""
+							+ std::to_string(modifierType) + "\".");
+					}
+				}
+			}
+
+			// Reset flat state for the next loop.
+			flatState = FlatState();
+		}
+	};
+
+	auto parseSoundLine = [this](const std::string_view &line)
+	{
+		// Split into the filename and ID. Make sure the filename is all caps.
+		std::string vocFilename = String::toUppercase(std::string(GetToken(line, 0)));
+		const int vocID = ParseInt(GetToken(line, 1));
+		this->sounds.emplace_back(vocID, std::move(vocFilename));
+	};
+
+	auto parseTextLine = [this, &textState, &flushTextState](const std::string_view &line)
+	{
+		// Start a new text state after each *TEXT tag.
+		constexpr char TEXT_CHAR = '*';
+		constexpr char KEY_INDEX_CHAR = '+';
+		constexpr char RIDDLE_CHAR = '^';
+		constexpr char DISPLAYED_ONCE_CHAR = '~';
+
+		// Check the first character in the line to determine any changes in text mode.
+		// Otherwise, parse the line based on the current mode.
+		if (line.front() == TEXT_CHAR)
+		{
+			// Get the ID after *TEXT.
+			const int textID = ParseInt(GetToken(line, 1));
+
+			// If there is existing text state present, save it.
+			if (textState.has_value())
+			{
+				flushTextState();
+			}
 
-		FloorState()
+			// Reset the text state to default with the new *TEXT ID.
+			textState = TextState(textID);
+		}
+		else if (line.front() == KEY_INDEX_CHAR)
 		{
-			this->mode = FloorState::Mode::None;
+			// Get key number. No need for a key section here since it's only one line.
+			const std::string_view keyStr = StringView::substr(line, 1, line.size() - 1);
+			const int keyNumber = ParseInt(keyStr);
+
+			textState->mode = TextState::Mode::Key;
+			textState->keyData = KeyData(keyNumber);
 		}
-	};
+		else if (line.front() == RIDDLE_CHAR)
+		{
+			// Get riddle numbers.
+			const std::string_view numbers = StringView::substr(line, 1, line.size() - 1);
+			const int firstNumber = ParseInt(GetToken(numbers, 0));
+			const int secondNumber = ParseInt(GetToken(numbers, 1));
 
-	struct WallState
-	{
-		enum class Mode
+			textState->mode = TextState::Mode::Riddle;
+			textState->riddleState = TextState::RiddleState(firstNumber, secondNumber);
+		}
+		else if (line.front() == DISPLAYED_ONCE_CHAR)
 		{
-			None, BoxCap, BoxSide, DryChasm, LavaChasm,
-			LevelDown, LevelUp, Menu, WetChasm
-		};
+			textState->mode = TextState::Mode::Text;
 
-		std::vector<int> boxCapIDs, boxSideIDs;
-		std::string_view textureName;
-		WallState::Mode mode;
-		std::optional<int> menuID;
-		bool dryChasm, lavaChasm, wetChasm;
-		// *TRANS, *TRANSWALKTHRU, and *WALKTHRU are unused (set by voxel data instead).
+			const bool displayedOnce = true;
+			textState->textData = TextData(displayedOnce);
 
-		WallState()
+			// Append the rest of the line to the text data.
+			textState->textData->text.append(line.substr(1, line.size() - 1));
+			textState->textData->text.push_back('\n');
+		}
+		else if (textState->mode == TextState::Mode::Riddle)
 		{
-			this->mode = WallState::Mode::None;
-			this->dryChasm = false;
-			this->lavaChasm = false;
-			this->wetChasm = false;
+			const char ANSWER_CHAR = ':'; // An accepted answer.
+			const char RESPONSE_SECTION_CHAR = '`'; // CORRECT/WRONG.
+
+			if (line.front() == ANSWER_CHAR)
+			{
+				// Add the answer to the answers data.
+				const std::string_view answer = StringView::substr(line, 1, line.size() - 1);
+				textState->riddleState->data.answers.push_back(std::string(answer));
+			}
+			else if (line.front() == RESPONSE_SECTION_CHAR)
+			{
+				// Change riddle mode based on the response section.
+				constexpr std::string_view CORRECT_STR = "CORRECT";
+				constexpr std::string_view WRONG_STR = "WRONG";
+				const std::string_view responseSection = StringView::substr(line, 1, line.size() - 1);
+
+				if (responseSection == CORRECT_STR)
+				{
+					textState->riddleState->mode = TextState::RiddleState::Mode::Correct;
+				}
+				else if (responseSection == WRONG_STR)
+				{
+					textState->riddleState->mode = TextState::RiddleState::Mode::Wrong;
+				}
+			}
+			else if (textState->riddleState->mode == TextState::RiddleState::Mode::Riddle)
+			{
+				// Read the line into the riddle text.
+				textState->riddleState->data.riddle.append(line);
+				textState->riddleState->data.riddle.push_back('\n');
+			}
+			else if (textState->riddleState->mode == TextState::RiddleState::Mode::Correct)
+			{
+				// Read the line into the correct text.
+				textState->riddleState->data.correct.append(line);
+				textState->riddleState->data.correct.push_back('\n');
+			}
+			else if (textState->riddleState->mode == TextState::RiddleState::Mode::Wrong)
+			{
+				// Read the line into the wrong text.
+				textState->riddleState->data.wrong.append(line);
+				textState->riddleState->data.wrong.push_back('\n');
+			}
 		}
-	};
+		else if (textState->mode == TextState::Mode::Text)
+		{
+			// Read the line into the text data.
+			textState->textData->text.append(line);
+			textState->textData->text.push_back('\n');
+		}
+		else
+		{
+			// Plain old text after a *TEXT line, and on rare occasions it's after a key 
+			// line (+123, like in AGTEMPL.INF).
+			if ((textState->mode == TextState::Mode::None) ||
+				(textState->mode == TextState::Mode::Key))
+			{
+				if (textState->mode == TextState::Mode::Key)
+				{
+					// Save key data and empty the key data state.
+					this->keys.emplace_back(textState->id, textState->keyData.value());
+					textState->keyData.reset();
+				}
 
-	struct FlatState
-	{
-		enum class Mode { None, Item };
+				textState->mode = TextState::Mode::Text;
 
-		FlatState::Mode mode;
-		std::optional<int> itemID;
+				const bool displayedOnce = false;
+				textState->textData = TextData(displayedOnce);
+			}
 
-		FlatState()
-		{
-			this->mode = FlatState::Mode::None;
+			// Read the line into the text data.
+			textState->textData->text.append(line);
+			textState->textData->text.push_back('\n');
 		}
 	};
 
-	struct TextState
-	{
-		enum class Mode { None, Key, Riddle, Text };
+	// Default to "@FLOORS" since the final staff piece dungeon doesn't have that
+	// tag even when it's needed.
+	ParseMode parseMode = ParseMode::Floors;
 
-		struct RiddleState
-		{
-			enum class Mode { Riddle, Correct, Wrong };
+	size_t lineStart = 0;
+	while (lineStart < text.size())
+	{
+		// Same lines as std::getline(), so there's no empty line after a trailing newline.
+		const size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+		const std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
 
-			INFFile::RiddleData data;
-			RiddleState::Mode mode;
+		const char SECTION_SEPARATOR = '@';
 
-			RiddleState(int firstNumber, int secondNumber)
-				: data(firstNumber, secondNumber)
+		// First check if the line is empty. Then check the first character for any changes 
+		// in the current section. Otherwise, parse the line depending on the current mode.
+		if (line.size() == 0)
+		{
+			// Usually, empty lines indicate a separation from two sections, but there are 
+			// some riddles with newlines (like *TEXT 0 in LABRNTH2.INF), so don't skip those.
+			if (textState.has_value() && textState->riddleState.has_value() &&
+				(textState->riddleState->mode == TextState::RiddleState::Mode::Riddle))
 			{
-				this->mode = RiddleState::Mode::Riddle;
+				textState->riddleState->data.riddle += '\n';
+			}
+			else
+			{
+				// Save any current state into INFFile members.
+				flushAllStates();
 			}
-		};
-
-		std::optional<INFFile::KeyData> keyData;
-		std::optional<RiddleState> riddleState;
-		std::optional<INFFile::TextData> textData;
-		TextState::Mode mode; // Determines which data is in use.
-		int id; // *TEXT ID.
-
-		TextState(int id)
-		{
-			this->mode = TextState::Mode::None;
-			this->id = id;
 		}
-	};
-}
+		else if (line.front() == SECTION_SEPARATOR)
+		{
+			constexpr std::pair<std::string_view, ParseMode> Sections[] =
+			{
+				{ "@FLOORS", ParseMode::Floors },
+				{ "@WALLS", ParseMode::Walls },
+				{ "@FLATS", ParseMode::Flats },
+				{ "@SOUND", ParseMode::Sound },
+				{ "@TEXT", ParseMode::Text }
+			};
 
-INFFile::VoxelTextureData::VoxelTextureData(const char *filename, const std::optional<int> &setIndex)
-	: filename(filename), setIndex(setIndex) { }
+			// Separate the '@' token from other things in the line (like @FLATS NOSHOW).
+			const std::string_view sectionName = GetToken(line, 0);
 
-INFFile::VoxelTextureData::VoxelTextureData(const char *filename)
-	: VoxelTextureData(filename, std::nullopt) { }
+			// See which token the section is.
+			const auto sectionIter = std::find_if(std::begin(Sections), std::end(Sections),
+				[&sectionName](const std::pair<std::string_view, ParseMode> &section)
+			{
+				return section.first == sectionName;
+			});
 
-INFFile::FlatTextureData::FlatTextureData(const char *filename)
-	: filename(filename) { }
+			DebugAssertMsg(sectionIter != std::end(Sections),
+				"Unrecognized .INF section \"" + std::string(sectionName) + "\".");
 
-INFFile::CeilingData::CeilingData()
-{
-	this->height = CeilingData::DEFAULT_HEIGHT;
-	this->outdoorDungeon = false;
-}
+			// Flush any existing state.
+			flushAllStates();
 
-INFFile::FlatData::FlatData()
-{
-	this->yOffset = 0;
-	this->health = 0;
-	this->collider = false;
-	this->puddle = false;
-	this->largeScale = false;
-	this->dark = false;
-	this->transparent = false;
-	this->ceiling = false;
-	this->mediumScale = false;
-}
+			// Assign the new parse mode.
+			parseMode = sectionIter->second;
+		}
+		else if (parseMode == ParseMode::Floors)
+		{
+			parseFloorLine(line);
+		}
+		else if (parseMode == ParseMode::Walls)
+		{
+			parseWallLine(line);
+		}
+		else if (parseMode == ParseMode::Flats)
+		{
+			parseFlatLine(line);
+		}
+		else if (parseMode == ParseMode::Sound)
+		{
+			parseSoundLine(line);
+		}
+		else if (parseMode == ParseMode::Text)
+		{
+			parseTextLine(line);
+		}
+	}
 
-INFFile::KeyData::KeyData(int id)
-{
-	this->id = id;
-}
+	// Flush any remaining data. Most of these won't ever need flushing -- it's 
+	// primarily for @TEXT since it's frequently the last section in the file
+	// and has the possibility of an off-by-one error with its *TEXT saving.
+	flushAllStates();
 
-INFFile::RiddleData::RiddleData(int firstNumber, int secondNumber)
-{
-	this->firstNumber = firstNumber;
-	this->secondNumber = secondNumber;
-}
+	SortByID(this->sounds);
+	SortByID(this->keys);
+	SortByID(this->riddles);
+	SortByID(this->texts);
 
-INFFile::TextData::TextData(bool displayedOnce)
-{
-	this->displayedOnce = displayedOnce;
+	return true;
 }
 
-bool INFFile::init(const char *filename)
+bool INFFile::initReference(const char *filename)
 {
-	bool inGlobalBSA; // Set by VFS open() function.
-
-	// Some filenames (i.e., Crystal3.inf) have different casing between the floppy version and
-	// CD version, so this needs to use the case-insensitive open() method for correct behavior
-	// on Unix-based systems.
 	Buffer<std::byte> src;
-	if (!VFS::Manager::get().readCaseInsensitive(filename, &src, &inGlobalBSA))
+	if (!TryReadDecrypted(filename, &src))
 	{
-		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
 	}
 
-	uint8_t *srcPtr = reinterpret_cast<uint8_t*>(src.get());
-	uint8_t *srcEnd = reinterpret_cast<uint8_t*>(src.end());
-
-	// Check if the .INF is encrypted.
-	const bool isEncrypted = inGlobalBSA;
-
-	if (isEncrypted)
-	{
-		// Adapted from BSATool.
-		constexpr std::array<uint8_t, 8> encryptionKeys =
-		{
-			0xEA, 0x7B, 0x4E, 0xBD, 0x19, 0xC9, 0x38, 0x99
-		};
-
-		// Iterate through the encoded data, XORing with some encryption keys.
-		// The count repeats every 256 bytes, and the key repeats every 8 bytes.
-		uint8_t keyIndex = 0;
-		uint8_t count = 0;
-		for (auto it = srcPtr; it != srcEnd; ++it)
-		{
-			uint8_t &encryptedByte = *it;
-			encryptedByte ^= count + encryptionKeys.at(keyIndex);
-			keyIndex = (keyIndex + 1) % encryptionKeys.size();
-			count++;
-		}
-	}
+	const BufferView<const char> data(reinterpret_cast<const char*>(src.get()), src.getCount());
+	return this->initFromTextReference(filename, data);
+}
 
-	this->name = filename;
+bool INFFile::initFromTextReference(const char *name, const BufferView<const char> &data)
+{
+	this->name = name;
 
 	// Assign the data (now decoded if it was encoded) to the text member exposed
 	// to the rest of the program.
-	std::string text(reinterpret_cast<char*>(srcPtr), src.getCount());
+	std::string text(data.get(), data.getCount());
 
 	// Remove carriage returns (newlines are nicer to work with).
 	text = String::replace(text, "\r", "");
@@ -216,17 +1164,17 @@ bool INFFile::init(const char *filename)
 		if (textState->mode == TextState::Mode::Key)
 		{
 			// Save key data.
-			this->keys.insert(std::make_pair(textState->id, textState->keyData.value()));
+			this->keys.emplace_back(std::make_pair(textState->id, textState->keyData.value()));
 		}
 		else if (textState->mode == TextState::Mode::Riddle)
 		{
 			// Save riddle data.
-			this->riddles.insert(std::make_pair(textState->id, textState->riddleState->data));
+			this->riddles.emplace_back(std::make_pair(textState->id, textState->riddleState->data));
 		}
 		else if (textState->mode == TextState::Mode::Text)
 		{
 			// Save text data.
-			this->texts.insert(std::make_pair(textState->id, textState->textData.value()));
+			this->texts.emplace_back(std::make_pair(textState->id, textState->textData.value()));
 		}
 	};
 
@@ -743,7 +1691,7 @@ bool INFFile::init(const char *filename)
 		const std::vector<std::string_view> tokens = StringView::split(line);
 		std::string vocFilename = String::toUppercase(std::string(tokens.front()));
 		const int vocID = std::stoi(std::string(tokens.at(1)));
-		this->sounds.emplace(vocID, std::move(vocFilename));
+		this->sounds.emplace_back(vocID, std::move(vocFilename));
 	};
 
 	auto parseTextLine = [this, &textState, &flushTextState](const std::string &line)
@@ -860,7 +1808,7 @@ bool INFFile::init(const char *filename)
 				if (textState->mode == TextState::Mode::Key)
 				{
 					// Save key data and empty the key data state.
-					this->keys.insert(std::make_pair(textState->id, textState->keyData.value()));
+					this->keys.emplace_back(std::make_pair(textState->id, textState->keyData.value()));
 					textState->keyData.reset();
 				}
 
@@ -956,6 +1904,12 @@ bool INFFile::init(const char *filename)
 	// and has the possibility of an off-by-one error with its *TEXT saving.
 	flushAllStates();
 
+	// The ID mappings were unordered maps here, where the first insert of an ID wins.
+	SortByID(this->sounds);
+	SortByID(this->keys);
+	SortByID(this->riddles);
+	SortByID(this->texts);
+
 	return true;
 }
 
@@ -994,6 +1948,12 @@ const std::optional<int> &INFFile::getBoxSide(int index) const
 	}
 }
 
+bool INFFile::hasBoxSide(int index) const
+{
+	DebugAssertIndex(this->boxSides, index);
+	return this->boxSides[index].has_value();
+}
+
 const std::optional<int> &INFFile::getMenu(int index) const
 {
 	DebugAssertIndex(this->menus, index);
@@ -1032,50 +1992,63 @@ const INFFile::FlatData *INFFile::getFlatWithItemIndex(ArenaTypes::ItemIndex ite
 
 const char *INFFile::getSound(int index) const
 {
-	const auto soundIter = this->sounds.find(index);
+	const std::string *sound = FindByID(this->sounds, index);
 
 	// The sound indices are sometimes out-of-bounds, which means that the program
 	// needs to modify them in some way. For now, just print a warning and return
 	// some default sound.
-	if (soundIter != this->sounds.end())
+	if (sound != nullptr)
 	{
-		return soundIter->second.c_str();
+		return sound->c_str();
 	}
 	else
 	{
 		DebugLogWarning("Invalid sound index \"" + std::to_string(index) + "\".");
-		return this->sounds.at(0).c_str();
+		const std::string *defaultSound = FindByID(this->sounds, 0);
+		DebugAssert(defaultSound != nullptr);
+		return defaultSound->c_str();
 	}
 }
 
+bool INFFile::hasSoundIndex(int index) const
+{
+	return FindByID(this->sounds, index) != nullptr;
+}
+
 bool INFFile::hasKeyIndex(int index) const
 {
-	return this->keys.find(index) != this->keys.end();
+	return FindByID(this->keys, index) != nullptr;
 }
 
 bool INFFile::hasRiddleIndex(int index) const
 {
-	return this->riddles.find(index) != this->riddles.end();
+	return FindByID(this->riddles, index) != nullptr;
 }
 
 bool INFFile::hasTextIndex(int index) const
 {
-	return this->texts.find(index) != this->texts.end();
+	return FindByID(this->texts, index) != nullptr;
 }
 
 const INFFile::KeyData &INFFile::getKey(int index) const
 {
-	return this->keys.at(index);
+	const KeyData *data = FindByID(this->keys, index);
+	DebugAssertMsg(data != nullptr, "Invalid key index \"" + std::to_string(index) + "\".");
+	return *data;
 }
 
 const INFFile::RiddleData &INFFile::getRiddle(int index) const
 {
-	return this->riddles.at(index);
+	const RiddleData *data = FindByID(this->riddles, index);
+	DebugAssertMsg(data != nullptr, "Invalid riddle index \"" + std::to_string(index) + "\".");
+	return *data;
 }
 
 const INFFile::TextData &INFFile::getText(int index) const
 {
-	return this->texts.at(index);
+	const TextData *data = FindByID(this->texts, index);
+	DebugAssertMsg(data != nullptr, "Invalid text index \"" + std::to_string(index) + "\".");
+	return *data;
 }
 
 const char *INFFile::getName() const
@@ -5,12 +5,14 @@
 #include <memory>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "ArenaTypes.h"
 
 #include "components/dos/DOSUtils.h"
+#include "components/utilities/BufferView.h"
 
 // An .INF file contains definitions of what the IDs in a .MIF file point to. These 
 // are mostly texture IDs, but also text IDs and sound IDs telling which voxels have 
@@ -24,15 +26,15 @@ public:
 		std::string filename;
 		std::optional<int> setIndex; // Index into .SET file texture (if any).
 
-		VoxelTextureData(const char *filename, const std::optional<int> &setIndex);
-		VoxelTextureData(const char *filename);
+		VoxelTextureData(const std::string_view &filename, const std::optional<int> &setIndex);
+		VoxelTextureData(const std::string_view &filename);
 	};
 
 	struct FlatTextureData
 	{
 		std::string filename;
 
-		FlatTextureData(const char *filename);
+		FlatTextureData(std::string &&filename);
 	};
 
 	struct CeilingData
@@ -130,17 +132,17 @@ private:
 	// (i.e., texture index, etc.).
 	std::vector<FlatData> flats;
 
-	// .VOC files for each sound ID.
-	std::unordered_map<int, std::string> sounds;
+	// .VOC files for each sound ID. These ID mappings are sorted by ID for binary search.
+	std::vector<std::pair<int, std::string>> sounds;
 
 	// Key info for *TEXT IDs.
-	std::unordered_map<int, KeyData> keys;
+	std::vector<std::pair<int, KeyData>> keys;
 
 	// Riddle info for *TEXT IDs.
-	std::unordered_map<int, RiddleData> riddles;
+	std::vector<std::pair<int, RiddleData>> riddles;
 
 	// Text pop-ups for *TEXT IDs. Some places have several dozen *TEXT definitions.
-	std::unordered_map<int, TextData> texts;
+	std::vector<std::pair<int, TextData>> texts;
 
 	std::string name;
 
@@ -152,15 +154,25 @@ private:
 public:
 	bool init(const char *filename);
 
+	// Parses decrypted .INF text. Carriage returns are removed from the data in place.
+	bool initFromText(const char *name, BufferView<char> data);
+
+	// Previous parser that copies the text into a string stream and splits lines into temporary
+	// strings, for verifying init() and initFromText().
+	bool initReference(const char *filename);
+	bool initFromTextReference(const char *name, const BufferView<const char> &data);
+
 	const std::vector<VoxelTextureData> &getVoxelTextures() const;
 	const std::vector<FlatTextureData> &getFlatTextures() const;
 	const std::optional<int> &getBoxCap(int index) const;
 	const std::optional<int> &getBoxSide(int index) const;
+	bool hasBoxSide(int index) const;
 	const std::optional<int> &getMenu(int index) const;
 	std::optional<int> getMenuIndex(int textureID) const; // Temporary hack?
 	const FlatData &getFlat(int index) const;
 	const FlatData *getFlatWithItemIndex(ArenaTypes::ItemIndex itemIndex) const;
 	const char *getSound(int index) const;
+	bool hasSoundIndex(int index) const;
 	bool hasKeyIndex(int index) const;
 	bool hasRiddleIndex(int index) const;
 	bool hasTextIndex(int index) const;
@@ -1,8 +1,12 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -12,7 +16,9 @@
 
 #include "alext.h" // Using local copy (+ "efx.h") to guarantee existence on system.
 #include "AudioManager.h"
+#include "Midi.h"
 #include "MusicDefinition.h"
+#include "MusicRenderCache.h"
 #include "WildMidi.h"
 #include "../Assets/VOCFile.h"
 #include "../Game/Options.h"
@@ -26,16 +32,53 @@
 
 std::unique_ptr<MidiDevice> MidiDevice::sInstance;
 
+namespace
+{
+	struct SoundCategoryInfo
+	{
+		int priority; // Higher priority sounds can steal voices from lower priority ones.
+		int maxVoices; // Max voices the category can use at once.
+	};
+
+	// Indexed by sound category. Caps keep common sounds like creature noises from crowding out
+	// everything else.
+	constexpr std::array<SoundCategoryInfo, 5> SoundCategoryInfos =
+	{
+		{
+			{ 0, 4 }, // Ambient
+			{ 1, 8 }, // Creature
+			{ 2, 12 }, // World
+			{ 3, 12 }, // Combat
+			{ 4, std::numeric_limits<int>::max() } // Interface
+		}
+	};
+
+	const SoundCategoryInfo &GetSoundCategoryInfo(AudioManager::SoundCategory category)
+	{
+		const int index = static_cast<int>(category);
+		DebugAssertIndex(SoundCategoryInfos, index);
+		return SoundCategoryInfos[index];
+	}
+}
+
 class OpenALStream
 {
 private:
 	std::deque<ALuint> *mFreeSourcesPtr; // Free sources owned by audio manager.
-	MidiSong *mSong;
+	std::string mFilename;
+	MidiSongPtr mSong; // Opened on the background thread.
 	bool mLoop;
 
+	/* Pre-rendered samples from the start of the song, if any. */
+	std::shared_ptr<const MusicRenderCache::Entry> mIntro;
+	size_t mIntroOffset; // In bytes.
+	bool mSongOpened; // Whether opening the song has been attempted.
+
 	/* Background thread and control. */
 	std::atomic<bool> mQuit;
 	std::thread mThread;
+	std::mutex mQuitMutex;
+	std::condition_variable mQuitCondition;
 
 	/* Playback source and buffer queue. */
 	static constexpr int sBufferFrames = 16384;
@@ -48,18 +91,67 @@ private:
 	ALuint mSampleRate;
 	ALuint mFrameSize;
 
+	/* Stats owned by audio manager. */
+	std::atomic<int> *mUnderrunCountPtr;
+	std::atomic<double> *mStartLatencyPtr;
+	std::chrono::steady_clock::time_point mPlayTime;
+	bool mHasStarted;
+
 	bool threadIsValid() const
 	{
 		return mThread.get_id() != std::thread::id();
 	}
 
+	void signalQuit()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mQuitMutex);
+			mQuit.store(true);
+		}
+
+		mQuitCondition.notify_one();
+	}
+
+	/* Starts the source and records how long it took to get the first
+	 * samples queued.
+	 */
+	void startSource()
+	{
+		alSourcePlay(mSource);
+
+		if (!mHasStarted)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			const std::chrono::duration<double> latency = startTime - mPlayTime;
+			mStartLatencyPtr->store(latency.count());
+			mHasStarted = true;
+		}
+	}
+
 	/* Read samples from the song and fill the given OpenAL buffer ID (buffer
 	 * vector is for temporary storage). Returns true if the buffer was filled.
 	 */
 	bool fillBuffer(ALuint bufid, std::vector<char> &buffer)
 	{
 		size_t totalSize = 0;
-		while (totalSize < buffer.size())
+
+		/* Use pre-rendered samples first. Until the song is open, only whole
+		 * buffers are queued so playback doesn't get a gap of silence.
+		 */
+		if (mIntro != nullptr)
+		{
+			const size_t introRemaining = mIntro->pcm.size() - mIntroOffset;
+			if (!mSongOpened && (introRemaining < buffer.size()))
+				return false;
+
+			const size_t copySize = std::min(introRemaining, buffer.size());
+			std::copy(mIntro->pcm.begin() + mIntroOffset,
+				mIntro->pcm.begin() + mIntroOffset + copySize, buffer.begin());
+			mIntroOffset += copySize;
+			totalSize += copySize;
+		}
+
+		while ((totalSize < buffer.size()) && (mSong != nullptr))
 		{
 			const size_t framesToGet = (buffer.size() - totalSize) / mFrameSize;
 			const size_t framesReceived = mSong->read(buffer.data() + totalSize, framesToGet);
@@ -120,6 +212,38 @@ private:
 		return queued;
 	}
 
+	/* Opens the song, continuing after any pre-rendered samples. Returns
+	 * false if there's nothing left to play.
+	 */
+	bool openSong()
+	{
+		mSong = MidiDevice::get().open(mFilename);
+		mSongOpened = true;
+
+		if (mSong == nullptr)
+		{
+			DebugLogWarning("Failed to open " + mFilename + ".");
+			return mIntro != nullptr;
+		}
+
+		if (mIntro != nullptr)
+		{
+			if (!mSong->seek(mIntro->frameCount))
+			{
+				DebugLogWarning("Failed to seek " + mFilename + " past its pre-rendered samples.");
+				mSong = nullptr;
+			}
+		}
+		else
+		{
+			int srate;
+			mSong->getFormat(&srate);
+			mSampleRate = srate;
+		}
+
+		return true;
+	}
+
 	/* A method run in a backround thread, to keep filling the queue with new
 	 * audio over time.
 	 */
@@ -130,6 +254,22 @@ private:
 		 */
 		std::vector<char> buffer(sBufferFrames * mFrameSize);
 
+		/* Start playing any pre-rendered samples right away, then open the
+		 * song while those play. Opening can take a while so it's never done
+		 * on the game thread.
+		 */
+		if (mIntro != nullptr)
+		{
+			if (fillBufferQueue(buffer) > 0)
+				startSource();
+		}
+
+		if (!openSong())
+		{
+			mQuit.store(true);
+			return;
+		}
+
 		while (!mQuit.load())
 		{
 			/* First, make sure the buffer queue is filled. */
@@ -162,8 +302,11 @@ private:
 					return;
 				}
 
+				if (mHasStarted)
+					(*mUnderrunCountPtr)++;
+
 				/* Now start the sound source. */
-				alSourcePlay(mSource);
+				startSource();
 			}
 
 			ALint processed;
@@ -172,7 +315,12 @@ private:
 			{
 				/* Wait until a buffer in the queue has been processed. */
 				do {
-					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+					std::unique_lock<std::mutex> lock(mQuitMutex);
+					mQuitCondition.wait_for(lock, std::chrono::milliseconds(50), [this]()
+					{
+						return mQuit.load();
+					});
+
 					if (mQuit.load()) break;
 					alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
 				} while (processed == 0);
@@ -190,16 +338,22 @@ private:
 	}
 
 public:
-	OpenALStream(std::deque<ALuint> *freeSources, MidiSong *song)
-		: mQuit(false)
+	OpenALStream(std::deque<ALuint> *freeSources, const std::string &filename,
+		std::shared_ptr<const MusicRenderCache::Entry> intro, std::atomic<int> *underrunCount,
+		std::atomic<double> *startLatency)
+		: mFilename(filename), mIntro(std::move(intro)), mQuit(false)
 	{
 		mFreeSourcesPtr = freeSources;
-		mSong = song;
+		mLoop = false;
+		mIntroOffset = 0;
+		mSongOpened = false;
 		mSource = 0;
 		mBuffers.fill(0);
 		mBufferIdx = 0;
 		mSampleRate = 0;
-		mLoop = false;
+		mUnderrunCountPtr = underrunCount;
+		mStartLatencyPtr = startLatency;
+		mHasStarted = false;
 	}
 
 	~OpenALStream()
@@ -207,7 +361,7 @@ public:
 		if (threadIsValid())
 		{
 			/* Tell the thread to quit and wait for it to stop. */
-			mQuit.store(true);
+			signalQuit();
 			mThread.join();
 		}
 		if (mSource)
@@ -244,6 +398,11 @@ public:
 		alSourceRewind(mSource);
 		alSourcei(mSource, AL_BUFFER, 0);
 		mBufferIdx = 0;
+		mIntroOffset = 0;
+		mSong = nullptr;
+		mSongOpened = false;
+		mHasStarted = false;
+		mPlayTime = std::chrono::steady_clock::now();
 		mQuit.store(false);
 
 		/* Start the background thread processing. */
@@ -254,7 +413,7 @@ public:
 	{
 		if (threadIsValid())
 		{
-			mQuit.store(true);
+			signalQuit();
 			mThread.join();
 		}
 
@@ -297,13 +456,12 @@ public:
 		if (alGetError() != AL_NO_ERROR)
 			return false;
 
-		int srate;
-		mSong->getFormat(&srate);
-
-		/* Currently hard-coded to 16-bit stereo. */
+		/* Currently hard-coded to 16-bit stereo. The sample rate comes from
+		 * the pre-rendered samples, or from the song once it's opened.
+		 */
 		mFormat = AL_FORMAT_STEREO16;
-		mFrameSize = 4;
-		mSampleRate = srate;
+		mFrameSize = MusicRenderCache::FRAME_SIZE;
+		mSampleRate = (mIntro != nullptr) ? mIntro->sampleRate : 0;
 
 		mSource = source;
 		mLoop = loop;
@@ -324,6 +482,17 @@ const Double3 &AudioManager::ListenerData::getDirection() const
 	return this->direction;
 }
 
+AudioManager::Voice::Voice(const std::string &filename, ALuint source, SoundCategory category, int priority,
+	const std::optional<Double3> &position, double audibility, double secondsRemaining)
+	: filename(filename), position(position)
+{
+	this->source = source;
+	this->category = category;
+	this->priority = priority;
+	this->audibility = audibility;
+	this->secondsRemaining = secondsRemaining;
+}
+
 AudioManager::AudioManager()
 {
 	mMusicVolume = 0.0f;
@@ -331,6 +500,12 @@ AudioManager::AudioManager()
 	mHasResamplerExtension = false;
 	mResampler = -1;
 	mIs3D = false;
+	mListenerPosition = Double3::Zero;
+	mDroppedSoundCount = 0;
+	mStolenSoundCount = 0;
+	mMusicFadeSecondsRemaining = 0.0;
+	mMusicUnderrunCount = 0;
+	mMusicStartLatency = 0.0;
 }
 
 AudioManager::~AudioManager()
@@ -338,6 +513,7 @@ AudioManager::~AudioManager()
 	this->stopMusic();
 	this->stopSound();
 
+	mMusicRenderCache.shutdown();
 	MidiDevice::shutdown();
 
 	ALCcontext *context = alcGetCurrentContext();
@@ -355,7 +531,7 @@ AudioManager::~AudioManager()
 
 	for (auto &pair : mSoundBuffers)
 	{
-		ALuint buffer = pair.second;
+		ALuint buffer = pair.second.id;
 		alDeleteBuffers(1, &buffer);
 	}
 
@@ -374,6 +550,7 @@ void AudioManager::init(double musicVolume, double soundVolume, int maxChannels,
 
 #ifdef HAVE_WILDMIDI
 	WildMidiDevice::init(midiConfig);
+	mMusicRenderCache.init(MusicRenderCache::DEFAULT_INTRO_FRAME_COUNT, MusicRenderCache::DEFAULT_MAX_BYTE_COUNT);
 #endif
 
 	// Initialize the OpenAL device and context.
@@ -455,14 +632,14 @@ bool AudioManager::hasResamplerExtension() const
 
 bool AudioManager::isPlayingSound(const std::string &filename) const
 {
-	// Check through used sources' filenames.
-	const auto iter = std::find_if(mUsedSources.begin(), mUsedSources.end(),
-		[&filename](const std::pair<std::string, ALuint> &pair)
+	// Check through voices' filenames.
+	const auto iter = std::find_if(mVoices.begin(), mVoices.end(),
+		[&filename](const Voice &voice)
 	{
-		return pair.first == filename;
+		return voice.filename == filename;
 	});
 
-	return iter != mUsedSources.end();
+	return iter != mVoices.end();
 }
 
 bool AudioManager::soundExists(const std::string &filename) const
@@ -512,8 +689,124 @@ bool AudioManager::hasNextMusic() const
 	return !this->mNextSong.empty();
 }
 
+double AudioManager::getAudibility(const std::optional<Double3> &position) const
+{
+	if (!position.has_value())
+	{
+		return 1.0;
+	}
+
+	// Inverse distance clamped model with a reference distance and rolloff factor of 1.
+	const double distance = std::max((*position - mListenerPosition).length(), 1.0);
+	return 1.0 / distance;
+}
+
+std::optional<int> AudioManager::tryGetStealableVoiceIndex(const SoundCategory *category, int priority,
+	double audibility) const
+{
+	// Take the lowest priority voice, and the quietest one among equal priorities. A voice can only
+	// be taken by a more important sound, or by a louder sound of the same priority.
+	std::optional<int> bestIndex;
+	for (int i = 0; i < static_cast<int>(mVoices.size()); i++)
+	{
+		const Voice &voice = mVoices[i];
+		if ((category != nullptr) && (voice.category != *category))
+		{
+			continue;
+		}
+
+		const bool isStealable = (voice.priority < priority) ||
+			((voice.priority == priority) && (voice.audibility < audibility));
+		if (!isStealable)
+		{
+			continue;
+		}
+
+		if (!bestIndex.has_value())
+		{
+			bestIndex = i;
+			continue;
+		}
+
+		const Voice &bestVoice = mVoices[*bestIndex];
+		if ((voice.priority < bestVoice.priority) ||
+			((voice.priority == bestVoice.priority) && (voice.audibility < bestVoice.audibility)))
+		{
+			bestIndex = i;
+		}
+	}
+
+	return bestIndex;
+}
+
+void AudioManager::freeVoice(int index)
+{
+	DebugAssertIndex(mVoices, index);
+	const ALuint source = mVoices[index].source;
+	alSourceStop(source);
+	this->resetSource(source);
+	mFreeSources.push_front(source);
+	mVoices.erase(mVoices.begin() + index);
+}
+
+void AudioManager::resetSource(ALuint source)
+{
+	alSourceRewind(source);
+	alSourcei(source, AL_BUFFER, 0);
+
+	if (mHasResamplerExtension)
+	{
+		const ALint defaultResampler = AudioManager::getDefaultResampler();
+		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
+	}
+}
+
+const AudioManager::SoundBuffer &AudioManager::getSoundBuffer(const std::string &filename)
+{
+	auto iter = mSoundBuffers.find(filename);
+	if (iter == mSoundBuffers.end())
+	{
+		// Load the .VOC file and give its PCM data to a new OpenAL buffer.
+		VOCFile voc;
+		if (!voc.init(filename.c_str()))
+		{
+			DebugCrash("Could not init .VOC file \"" + filename + "\".");
+		}
+
+		// Clear OpenAL error.
+		alGetError();
+
+		ALuint bufferID;
+		alGenBuffers(1, &bufferID);
+
+		const ALenum status = alGetError();
+		if (status != AL_NO_ERROR)
+		{
+			DebugLogWarning("alGenBuffers() error " + std::to_string(status) + ".");
+		}
+
+		const std::vector<uint8_t> &audioData = voc.getAudioData();
+
+		alBufferData(bufferID, AL_FORMAT_MONO8,
+			static_cast<const ALvoid*>(audioData.data()),
+			static_cast<ALsizei>(audioData.size()),
+			static_cast<ALsizei>(voc.getSampleRate()));
+
+		// One byte per sample.
+		SoundBuffer soundBuffer;
+		soundBuffer.id = bufferID;
+		soundBuffer.duration = static_cast<double>(audioData.size()) / static_cast<double>(voc.getSampleRate());
+
+		iter = mSoundBuffers.emplace(filename, soundBuffer).first;
+	}
+
+	return iter->second;
+}
+
 void AudioManager::setListenerPosition(const Double3 &position)
 {
+	mListenerPosition = position;
+
 	const ALfloat posX = static_cast<ALfloat>(position.x);
 	const ALfloat posY = static_cast<ALfloat>(position.y);
 	const ALfloat posZ = static_cast<ALfloat>(position.z);
@@ -540,7 +833,23 @@ void AudioManager::setListenerOrientation(const Double3 &direction)
 	alListenerfv(AL_ORIENTATION, orientation.data());
 }
 
-void AudioManager::playSound(const std::string &filename, const std::optional<Double3> &position)
+int AudioManager::getActiveSoundCount() const
+{
+	return static_cast<int>(mVoices.size());
+}
+
+int AudioManager::getDroppedSoundCount() const
+{
+	return mDroppedSoundCount;
+}
+
+int AudioManager::getStolenSoundCount() const
+{
+	return mStolenSoundCount;
+}
+
+void AudioManager::playSound(const std::string &filename, const std::optional<Double3> &position,
+	SoundCategory category)
 {
 	// Certain sounds should only have one live instance at a time. This is purely an arbitrary
 	// rule to avoid having long sounds overlap each other which would be very annoying and/or
@@ -550,96 +859,127 @@ void AudioManager::playSound(const std::string &filename, const std::optional<Do
 	const bool allowedToPlay = !isSingleInstance ||
 		(isSingleInstance && !this->isPlayingSound(filename));
 
-	if (!mFreeSources.empty() && allowedToPlay)
+	if (!allowedToPlay)
 	{
-		auto vocIter = mSoundBuffers.find(filename);
-
-		if (vocIter == mSoundBuffers.end())
-		{
-			// Load the .VOC file and give its PCM data to a new OpenAL buffer.
-			VOCFile voc;
-			if (!voc.init(filename.c_str()))
-			{
-				DebugCrash("Could not init .VOC file \"" + filename + "\".");
-			}
-
-			// Clear OpenAL error.
-			alGetError();
-
-			ALuint bufferID;
-			alGenBuffers(1, &bufferID);
-
-			const ALenum status = alGetError();
-			if (status != AL_NO_ERROR)
-			{
-				DebugLogWarning("alGenBuffers() error " + std::to_string(status) + ".");
-			}
+		return;
+	}
 
-			const std::vector<uint8_t> &audioData = voc.getAudioData();
+	// Play the sound in 3D if it has a position and we are set to 3D mode. Otherwise, play it in
+	// 2D centered on the listener. Don't bother claiming a voice for sounds too far away to hear.
+	const std::optional<Double3> voicePosition = mIs3D ? position : std::nullopt;
+	const double audibility = this->getAudibility(voicePosition);
+	if (audibility < AudioManager::MIN_AUDIBILITY)
+	{
+		mDroppedSoundCount++;
+		return;
+	}
 
-			alBufferData(bufferID, AL_FORMAT_MONO8,
-				static_cast<const ALvoid*>(audioData.data()),
-				static_cast<ALsizei>(audioData.size()),
-				static_cast<ALsizei>(voc.getSampleRate()));
+	// Find a voice for the sound, stealing one from a less important sound if the category is at
+	// its limit or there are no free sources.
+	const SoundCategoryInfo &categoryInfo = GetSoundCategoryInfo(category);
+	const int categoryVoiceCount = static_cast<int>(std::count_if(mVoices.begin(), mVoices.end(),
+		[category](const Voice &voice)
+	{
+		return voice.category == category;
+	}));
 
-			vocIter = mSoundBuffers.insert(std::make_pair(filename, bufferID)).first;
+	const bool isCategoryFull = categoryVoiceCount >= categoryInfo.maxVoices;
+	if (isCategoryFull || mFreeSources.empty())
+	{
+		const std::optional<int> stealIndex = this->tryGetStealableVoiceIndex(
+			isCategoryFull ? &category : nullptr, categoryInfo.priority, audibility);
+		if (!stealIndex.has_value())
+		{
+			mDroppedSoundCount++;
+			return;
 		}
 
-		// Set up the sound source.
-		const ALuint source = mFreeSources.front();
-		alSourcei(source, AL_BUFFER, vocIter->second);
+		this->freeVoice(*stealIndex);
+		mStolenSoundCount++;
+	}
 
-		// Play the sound in 3D if it has a position and we are set to 3D mode.
-		// Otherwise, play it in 2D centered on the listener.
-		if (position.has_value() && mIs3D)
-		{
-			alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
-			const Double3 &positionValue = *position;
-			const ALfloat posX = static_cast<ALfloat>(positionValue.x);
-			const ALfloat posY = static_cast<ALfloat>(positionValue.y);
-			const ALfloat posZ = static_cast<ALfloat>(positionValue.z);
-			alSource3f(source, AL_POSITION, posX, posY, posZ);
-		}
-		else
-		{
-			alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
-			alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
-		}
+	DebugAssert(!mFreeSources.empty());
+	const SoundBuffer &soundBuffer = this->getSoundBuffer(filename);
 
-		// Set resampling if the extension is supported.
-		if (mHasResamplerExtension)
-		{
-			alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
-		}
+	// Set up the sound source.
+	const ALuint source = mFreeSources.front();
+	alSourcei(source, AL_BUFFER, soundBuffer.id);
 
-		// Play the sound.
-		alSourcePlay(source);
+	if (voicePosition.has_value())
+	{
+		alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
+		const Double3 &positionValue = *voicePosition;
+		const ALfloat posX = static_cast<ALfloat>(positionValue.x);
+		const ALfloat posY = static_cast<ALfloat>(positionValue.y);
+		const ALfloat posZ = static_cast<ALfloat>(positionValue.z);
+		alSource3f(source, AL_POSITION, posX, posY, posZ);
+	}
+	else
+	{
+		alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+	}
 
-		mUsedSources.push_front(std::make_pair(filename, source));
-		mFreeSources.pop_front();
+	// Set resampling if the extension is supported.
+	if (mHasResamplerExtension)
+	{
+		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
+
+	// Play the sound.
+	alSourcePlay(source);
+
+	mVoices.emplace_back(Voice(filename, source, category, categoryInfo.priority, voicePosition, audibility,
+		soundBuffer.duration));
+	mFreeSources.pop_front();
 }
 
 void AudioManager::playMusic(const std::string &filename, bool loop)
 {
-	stopMusic();
+	if (!MidiDevice::isInited())
+	{
+		DebugLogWarning("Failed to play " + filename + ".");
+		return;
+	}
 
-	if (!mFreeSources.empty())
+	// Fade out the current music while the new one fades in instead of cutting it off.
+	this->stopFadingMusic();
+	const bool shouldCrossfade = (mSongStream != nullptr) && mSongStream->isPlaying();
+	if (shouldCrossfade)
 	{
-		if (MidiDevice::isInited())
-			mCurrentSong = MidiDevice::get().open(filename);
-		if (!mCurrentSong)
-		{
-			DebugLogWarning("Failed to play " + filename + ".");
-			return;
-		}
+		mFadingSongStream = std::move(mSongStream);
+		mMusicFadeSecondsRemaining = AudioManager::MUSIC_CROSSFADE_SECONDS;
+	}
+	else
+	{
+		this->stopMusic();
+	}
 
-		mSongStream = std::make_unique<OpenALStream>(&mFreeSources, mCurrentSong.get());
-		if (mSongStream->init(mFreeSources.front(), mMusicVolume, loop))
+	// Music is more important than any sound.
+	if (mFreeSources.empty() && !mVoices.empty())
+	{
+		const std::optional<int> stealIndex = this->tryGetStealableVoiceIndex(nullptr,
+			std::numeric_limits<int>::max(), 0.0);
+		DebugAssert(stealIndex.has_value());
+		this->freeVoice(*stealIndex);
+		mStolenSoundCount++;
+	}
+
+	if (!mFreeSources.empty())
+	{
+		// The song is opened on the stream's thread. If its start was pre-rendered, playback
+		// begins with those samples while the song is opened.
+		std::shared_ptr<const MusicRenderCache::Entry> intro = mMusicRenderCache.tryGet(filename);
+		const bool isPrerendered = intro != nullptr;
+		mSongStream = std::make_unique<OpenALStream>(&mFreeSources, filename, std::move(intro),
+			&mMusicUnderrunCount, &mMusicStartLatency);
+
+		const float volume = shouldCrossfade ? 0.0f : mMusicVolume;
+		if (mSongStream->init(mFreeSources.front(), volume, loop))
 		{
 			mFreeSources.pop_front();
 			mSongStream->play();
-			DebugLog("Playing music " + filename + ".");
+			DebugLog("Playing music " + filename + (isPrerendered ? " (pre-rendered)." : "."));
 		}
 		else
 		{
@@ -648,6 +988,46 @@ void AudioManager::playMusic(const std::string &filename, bool loop)
 	}
 }
 
+void AudioManager::stopFadingMusic()
+{
+	if (mFadingSongStream != nullptr)
+	{
+		mFadingSongStream->stop();
+	}
+
+	mFadingSongStream = nullptr;
+	mMusicFadeSecondsRemaining = 0.0;
+}
+
+void AudioManager::updateMusicFade(double dt)
+{
+	if (mFadingSongStream == nullptr)
+	{
+		return;
+	}
+
+	mMusicFadeSecondsRemaining -= dt;
+	if (mMusicFadeSecondsRemaining <= 0.0)
+	{
+		this->stopFadingMusic();
+
+		if (mSongStream != nullptr)
+		{
+			mSongStream->setVolume(mMusicVolume);
+		}
+
+		return;
+	}
+
+	const float fadePercent = static_cast<float>(mMusicFadeSecondsRemaining / AudioManager::MUSIC_CROSSFADE_SECONDS);
+	mFadingSongStream->setVolume(mMusicVolume * fadePercent);
+
+	if (mSongStream != nullptr)
+	{
+		mSongStream->setVolume(mMusicVolume * (1.0f - fadePercent));
+	}
+}
+
 void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefinition *optMusicDef)
 {
 	if (optMusicDef != nullptr)
@@ -659,6 +1039,7 @@ void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefiniti
 
 		DebugAssert(musicDef != nullptr);
 		mNextSong = musicDef->getFilename();
+		mMusicRenderCache.request(mNextSong);
 	}
 	else if (musicDef != nullptr)
 	{
@@ -674,37 +1055,45 @@ void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefiniti
 	}
 }
 
+void AudioManager::prerenderMusic(const MusicDefinition &musicDef)
+{
+	mMusicRenderCache.request(musicDef.getFilename());
+}
+
 void AudioManager::stopMusic()
 {
+	this->stopFadingMusic();
+
 	if (mSongStream != nullptr)
 	{
 		mSongStream->stop();
 	}
 
 	mSongStream = nullptr;
-	mCurrentSong = nullptr;
+}
+
+int AudioManager::getMusicUnderrunCount() const
+{
+	return mMusicUnderrunCount.load();
+}
+
+double AudioManager::getMusicStartLatency() const
+{
+	return mMusicStartLatency.load();
 }
 
 void AudioManager::stopSound()
 {
 	// Reset all used sources and return them to the free sources.
-	for (const auto &pair : mUsedSources)
+	for (const Voice &voice : mVoices)
 	{
-		const ALuint source = pair.second;
+		const ALuint source = voice.source;
 		alSourceStop(source);
-		alSourceRewind(source);
-		alSourcei(source, AL_BUFFER, 0);
-
-		if (mHasResamplerExtension)
-		{
-			const ALint defaultResampler = AudioManager::getDefaultResampler();
-			alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
-		}
-
+		this->resetSource(source);
 		mFreeSources.push_front(source);
 	}
 
-	mUsedSources.clear();
+	mVoices.clear();
 }
 
 void AudioManager::setMusicVolume(double percent)
@@ -715,6 +1104,8 @@ void AudioManager::setMusicVolume(double percent)
 	{
 		mSongStream->setVolume(mMusicVolume);
 	}
+
+	// The crossfade picks up the new volume next update.
 }
 
 void AudioManager::setSoundVolume(double percent)
@@ -727,10 +1118,9 @@ void AudioManager::setSoundVolume(double percent)
 		alSourcef(source, AL_GAIN, mSfxVolume);
 	}
 
-	for (const auto &pair : mUsedSources)
+	for (const Voice &voice : mVoices)
 	{
-		const ALuint source = pair.second;
-		alSourcef(source, AL_GAIN, mSfxVolume);
+		alSourcef(voice.source, AL_GAIN, mSfxVolume);
 	}
 }
 
@@ -748,10 +1138,9 @@ void AudioManager::setResamplingOption(int resamplingOption)
 		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
 
-	for (const auto &pair : mUsedSources)
+	for (const Voice &voice : mVoices)
 	{
-		const ALuint source = pair.second;
-		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
+		alSourcei(voice.source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
 }
 
@@ -780,30 +1169,35 @@ void AudioManager::update(double dt, const ListenerData *listenerData)
 		this->setListenerOrientation(listenerData->getDirection());
 	}
 
-	// If a sound source is done, reset it and return the ID to the free sources.
-	for (size_t i = 0; i < mUsedSources.size(); i++)
+	// If a sound source is done, reset it and return the ID to the free sources. Only sounds that
+	// should have finished by now need their source state checked.
+	int voiceIndex = 0;
+	while (voiceIndex < static_cast<int>(mVoices.size()))
 	{
-		const ALuint source = mUsedSources[i].second;
+		Voice &voice = mVoices[voiceIndex];
+		voice.secondsRemaining -= dt;
 
-		ALint state;
-		alGetSourcei(source, AL_SOURCE_STATE, &state);
-
-		if (state == AL_STOPPED)
+		if (voice.secondsRemaining <= 0.0)
 		{
-			alSourceRewind(source);
-			alSourcei(source, AL_BUFFER, 0);
+			ALint state;
+			alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
 
-			if (mHasResamplerExtension)
+			if (state == AL_STOPPED)
 			{
-				const ALint defaultResampler = AudioManager::getDefaultResampler();
-				alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
+				this->resetSource(voice.source);
+				mFreeSources.push_front(voice.source);
+				mVoices.erase(mVoices.begin() + voiceIndex);
+				continue;
 			}
-
-			mFreeSources.push_front(source);
-			mUsedSources.erase(mUsedSources.begin() + i);
 		}
+
+		// The listener may have moved.
+		voice.audibility = this->getAudibility(voice.position);
+		voiceIndex++;
 	}
 
+	this->updateMusicFade(dt);
+
 	// Check if another music is staged and should start when the current one is done.
 	if (this->hasNextMusic())
 	{
@@ -1,6 +1,7 @@
 #ifndef AUDIO_MANAGER_H
 #define AUDIO_MANAGER_H
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <optional>
@@ -10,7 +11,7 @@
 
 #include "al.h"
 
-#include "Midi.h"
+#include "MusicRenderCache.h"
 
 #include "../Math/Vector3.h"
 
@@ -35,9 +36,48 @@ public:
 		const Double3 &getPosition() const;
 		const Double3 &getDirection() const;
 	};
+
+	// Determines a sound's priority and how many voices sounds like it can use at once. When all
+	// voices are busy, a new sound can steal the voice of a less important or quieter sound.
+	enum class SoundCategory
+	{
+		Ambient, // Weather, etc..
+		Creature, // Idle creature noises.
+		World, // Doors, triggers, etc..
+		Combat, // Attacks and hits.
+		Interface // Cinematic voices and anything else that must always be heard.
+	};
 private:
+	// A sound currently playing in a source.
+	struct Voice
+	{
+		std::string filename; // Required for sounds that can only have one instance active at a time.
+		ALuint source;
+		SoundCategory category;
+		int priority;
+		std::optional<Double3> position; // Empty if played globally.
+		double audibility; // Estimated gain at the listener, used for picking a voice to steal.
+		double secondsRemaining; // Source state is only queried once this runs out.
+
+		Voice(const std::string &filename, ALuint source, SoundCategory category, int priority,
+			const std::optional<Double3> &position, double audibility, double secondsRemaining);
+	};
+
+	// An OpenAL buffer loaded from a .VOC file.
+	struct SoundBuffer
+	{
+		ALuint id;
+		double duration; // In seconds.
+	};
+
 	static constexpr ALint UNSUPPORTED_EXTENSION = -1;
 
+	// Positional sounds quieter than this at the listener are not played.
+	static constexpr double MIN_AUDIBILITY = 0.025;
+
+	// Time for the old music to fade out and the new music to fade in when switching songs.
+	static constexpr double MUSIC_CROSSFADE_SECONDS = 0.75;
+
 	float mMusicVolume;
 	float mSfxVolume;
 	bool mHasResamplerExtension; // Whether AL_SOFT_source_resampler is supported.
@@ -51,21 +91,34 @@ private:
 	// can only play one sound at a time, so it doesn't have this problem.
 	std::vector<std::string> mSingleInstanceSounds;
 
-	// Currently active song and playback stream.
-	MidiSongPtr mCurrentSong;
+	// Currently active playback stream, and the previous one while it fades out.
 	std::unique_ptr<OpenALStream> mSongStream;
+	std::unique_ptr<OpenALStream> mFadingSongStream;
+	double mMusicFadeSecondsRemaining;
+
+	// Starts of songs rendered ahead of time so song switches don't wait on the MIDI device.
+	MusicRenderCache mMusicRenderCache;
+
+	// Written by stream threads. Underruns are times the music ran dry after it started, and the
+	// start latency is the time from the last song switch to its first queued samples.
+	std::atomic<int> mMusicUnderrunCount;
+	std::atomic<double> mMusicStartLatency;
 
 	// Loaded sound buffers from .VOC files.
-	std::unordered_map<std::string, ALuint> mSoundBuffers;
+	std::unordered_map<std::string, SoundBuffer> mSoundBuffers;
 
 	// A deque of available sources to play sounds and streams with.
 	std::deque<ALuint> mFreeSources;
 
-	// A deque of currently used sources for sounds (the music source is owned
-	// by OpenALStream). The string is the filename and the integer is the ID.
-	// The filename is required for some sounds that can only have one instance
-	// active at a time.
-	std::deque<std::pair<std::string, ALuint>> mUsedSources;
+	// Sounds currently using a source (the music source is owned by OpenALStream).
+	std::vector<Voice> mVoices;
+
+	Double3 mListenerPosition;
+
+	// Sounds that didn't get a voice (either culled or nothing to steal) and sounds that had
+	// their voice stolen by a more important sound.
+	int mDroppedSoundCount;
+	int mStolenSoundCount;
 
 	// Use this when resetting sound sources back to their default resampling. This uses
 	// whatever setting is the default within OpenAL.
@@ -79,10 +132,33 @@ private:
 	// Whether there is a music queued after the current one.
 	bool hasNextMusic() const;
 
+	// Estimated gain of a sound at the listener, assuming OpenAL's default distance model.
+	double getAudibility(const std::optional<Double3> &position) const;
+
+	// Gets the index of the least important voice that a sound with the given priority and
+	// audibility may take, optionally limited to one category.
+	std::optional<int> tryGetStealableVoiceIndex(const SoundCategory *category, int priority,
+		double audibility) const;
+
+	// Stops a voice's sound and returns its source to the free sources.
+	void freeVoice(int index);
+
+	// Resets a source's playback state so it can be reused.
+	void resetSource(ALuint source);
+
+	// Gets the sound buffer for a .VOC file, loading it if needed.
+	const SoundBuffer &getSoundBuffer(const std::string &filename);
+
 	void setListenerPosition(const Double3 &position);
 	void setListenerOrientation(const Double3 &direction);
 
 	void playMusic(const std::string &filename, bool loop);
+
+	// Stops the music being faded out, if any.
+	void stopFadingMusic();
+
+	// Updates the volumes of the old and new music during a crossfade.
+	void updateMusicFade(double dt);
 public:
 	AudioManager();
 	~AudioManager();
@@ -105,15 +181,28 @@ public:
 	// Returns whether the given filename references an actual sound.
 	bool soundExists(const std::string &filename) const;
 
+	// Gets the number of sounds currently playing and the counts of dropped and stolen sounds.
+	int getActiveSoundCount() const;
+	int getDroppedSoundCount() const;
+	int getStolenSoundCount() const;
+
 	// Plays a sound file. All sounds should play once. If 'position' is empty then the sound
-	// is played globally.
-	void playSound(const std::string &filename,
-		const std::optional<Double3> &position = std::nullopt);
+	// is played globally. If no voice is free, the sound takes the voice of the least important
+	// sound playing, or is dropped if none are less important.
+	void playSound(const std::string &filename, const std::optional<Double3> &position = std::nullopt,
+		SoundCategory category = SoundCategory::World);
 
 	// Sets the music to the given music definition, with an optional music to play first as a
 	// lead-in to the actual music. If no music definition is given, the current music is stopped.
 	void setMusic(const MusicDefinition *musicDef, const MusicDefinition *optMusicDef = nullptr);
 
+	// Renders the start of the given music in the background so switching to it later can begin
+	// playback right away.
+	void prerenderMusic(const MusicDefinition &musicDef);
+
+	int getMusicUnderrunCount() const;
+	double getMusicStartLatency() const;
+
 	// Stops the music.
 	void stopMusic();
 
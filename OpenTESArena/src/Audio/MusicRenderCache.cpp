@@ -0,0 +1,194 @@
+#include <algorithm>
+
+#include "Midi.h"
+#include "MusicRenderCache.h"
+
+#include "components/debug/Debug.h"
+
+MusicRenderCache::Entry::Entry()
+{
+	this->sampleRate = 0;
+	this->frameCount = 0;
+}
+
+MusicRenderCache::MusicRenderCache()
+{
+	this->introFrameCount = 0;
+	this->byteCount = 0;
+	this->maxByteCount = 0;
+	this->quit = false;
+}
+
+MusicRenderCache::~MusicRenderCache()
+{
+	this->shutdown();
+}
+
+void MusicRenderCache::init(size_t introFrameCount, size_t maxByteCount)
+{
+	DebugAssert(!this->isInited());
+	DebugAssert(MidiDevice::isInited());
+
+	this->introFrameCount = introFrameCount;
+	this->byteCount = 0;
+	this->maxByteCount = maxByteCount;
+	this->quit = false;
+	this->thread = std::thread(&MusicRenderCache::workerProc, this);
+}
+
+bool MusicRenderCache::isInited() const
+{
+	return this->thread.joinable();
+}
+
+std::list<std::shared_ptr<const MusicRenderCache::Entry>>::iterator MusicRenderCache::findEntry(
+	const std::string &filename)
+{
+	return std::find_if(this->entries.begin(), this->entries.end(),
+		[&filename](const std::shared_ptr<const Entry> &entry)
+	{
+		return entry->filename == filename;
+	});
+}
+
+std::shared_ptr<const MusicRenderCache::Entry> MusicRenderCache::renderEntry(const std::string &filename) const
+{
+	MidiSongPtr song = MidiDevice::get().open(filename);
+	if (song == nullptr)
+	{
+		DebugLogWarning("Couldn't open \"" + filename + "\" for pre-rendering.");
+		return nullptr;
+	}
+
+	auto entry = std::make_shared<Entry>();
+	entry->filename = filename;
+	song->getFormat(&entry->sampleRate);
+	entry->pcm.resize(this->introFrameCount * MusicRenderCache::FRAME_SIZE);
+
+	size_t frameCount = 0;
+	while (frameCount < this->introFrameCount)
+	{
+		char *dst = entry->pcm.data() + (frameCount * MusicRenderCache::FRAME_SIZE);
+		const size_t framesReceived = song->read(dst, this->introFrameCount - frameCount);
+		if (framesReceived == 0)
+		{
+			break;
+		}
+
+		frameCount += framesReceived;
+	}
+
+	entry->pcm.resize(frameCount * MusicRenderCache::FRAME_SIZE);
+	entry->pcm.shrink_to_fit();
+	entry->frameCount = frameCount;
+	return entry;
+}
+
+void MusicRenderCache::workerProc()
+{
+	while (true)
+	{
+		std::string filename;
+
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->condVar.wait(lock, [this]()
+			{
+				return this->quit || !this->requests.empty();
+			});
+
+			if (this->quit)
+			{
+				return;
+			}
+
+			filename = std::move(this->requests.front());
+			this->requests.pop_front();
+
+			if (this->findEntry(filename) != this->entries.end())
+			{
+				continue;
+			}
+		}
+
+		// Synthesize without holding the lock so look-ups from the game thread never wait on it.
+		std::shared_ptr<const Entry> entry = this->renderEntry(filename);
+		if (entry == nullptr)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->byteCount += entry->pcm.size();
+		this->entries.emplace_front(std::move(entry));
+
+		// Evict the least recently used songs, always keeping the newest one. Streams still
+		// playing an evicted song keep it alive through their own reference.
+		while ((this->byteCount > this->maxByteCount) && (this->entries.size() > 1))
+		{
+			this->byteCount -= this->entries.back()->pcm.size();
+			this->entries.pop_back();
+		}
+	}
+}
+
+void MusicRenderCache::request(const std::string &filename)
+{
+	if (!this->isInited())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		const bool isCached = this->findEntry(filename) != this->entries.end();
+		const bool isRequested = std::find(this->requests.begin(), this->requests.end(), filename) !=
+			this->requests.end();
+		if (isCached || isRequested)
+		{
+			return;
+		}
+
+		this->requests.emplace_back(filename);
+	}
+
+	this->condVar.notify_one();
+}
+
+std::shared_ptr<const MusicRenderCache::Entry> MusicRenderCache::tryGet(const std::string &filename)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	const auto iter = this->findEntry(filename);
+	if (iter == this->entries.end())
+	{
+		return nullptr;
+	}
+
+	// Mark as most recently used.
+	this->entries.splice(this->entries.begin(), this->entries, iter);
+	return this->entries.front();
+}
+
+int MusicRenderCache::getEntryCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return static_cast<int>(this->entries.size());
+}
+
+void MusicRenderCache::shutdown()
+{
+	if (this->isInited())
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->quit = true;
+		}
+
+		this->condVar.notify_one();
+		this->thread.join();
+	}
+
+	this->requests.clear();
+	this->entries.clear();
+	this->byteCount = 0;
+}
@@ -0,0 +1,76 @@
+#ifndef MUSIC_RENDER_CACHE_H
+#define MUSIC_RENDER_CACHE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Renders the start of songs on a background thread ahead of time so a music switch can begin
+// playback immediately instead of waiting for the MIDI device to open and synthesize the song.
+// The cache is bounded by size and evicts the least recently used songs first.
+
+class MusicRenderCache
+{
+public:
+	// Samples rendered from the start of a song in the MIDI device's output format.
+	struct Entry
+	{
+		std::string filename;
+		std::vector<char> pcm;
+		int sampleRate;
+		size_t frameCount; // Less than the requested count if the song is shorter.
+
+		Entry();
+	};
+
+	// MIDI songs are currently always rendered as 16-bit stereo.
+	static constexpr int FRAME_SIZE = 4;
+
+	static constexpr size_t DEFAULT_INTRO_FRAME_COUNT = 65536; // ~1.4 seconds at 48khz.
+	static constexpr size_t DEFAULT_MAX_BYTE_COUNT = DEFAULT_INTRO_FRAME_COUNT * FRAME_SIZE * 8;
+private:
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable condVar;
+	std::deque<std::string> requests; // Songs waiting to be rendered.
+	std::list<std::shared_ptr<const Entry>> entries; // Most recently used first.
+	size_t introFrameCount;
+	size_t byteCount, maxByteCount;
+	bool quit;
+
+	// Gets the cached entry for the given song, or null if not rendered yet. The mutex must be held.
+	std::list<std::shared_ptr<const Entry>>::iterator findEntry(const std::string &filename);
+
+	// Renders the start of the given song. Returns null if the song couldn't be opened.
+	std::shared_ptr<const Entry> renderEntry(const std::string &filename) const;
+
+	void workerProc();
+public:
+	MusicRenderCache();
+	~MusicRenderCache();
+
+	// Starts the render thread. The MIDI device must be initialized.
+	void init(size_t introFrameCount, size_t maxByteCount);
+
+	bool isInited() const;
+
+	// Queues the start of the given song to be rendered if it isn't cached already. Does not block.
+	void request(const std::string &filename);
+
+	// Gets the rendered start of the given song if it's ready, or null otherwise.
+	std::shared_ptr<const Entry> tryGet(const std::string &filename);
+
+	int getEntryCount();
+
+	// Stops the render thread and frees all cached songs. Must be called before the MIDI device
+	// is shut down.
+	void shutdown();
+};
+
+#endif
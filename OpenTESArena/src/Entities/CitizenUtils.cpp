@@ -4,7 +4,6 @@
 #include "EntityDefinitionLibrary.h"
 #include "EntityManager.h"
 #include "EntityType.h"
-#include "../Assets/ArenaAnimUtils.h"
 #include "../Assets/ArenaPaletteName.h"
 #include "../Assets/BinaryAssetLibrary.h"
 #include "../Game/CardinalDirection.h"
@@ -82,45 +81,12 @@ int CitizenUtils::getRandomCitizenDirectionIndex(Random &random)
 
 int CitizenUtils::getCitizenCount(const EntityManager &entityManager)
 {
-	constexpr EntityType entityType = EntityType::Dynamic;
-	Buffer<const Entity*> entities(entityManager.getCountOfType(entityType));
-	const int entityWriteCount = entityManager.getEntitiesOfType(entityType, entities.get(), entities.getCount());
-
-	int count = 0;
-	for (int i = 0; i < entityWriteCount; i++)
-	{
-		const Entity *entity = entities.get(i);
-		const DynamicEntity *dynamicEntity = dynamic_cast<const DynamicEntity*>(entity);
-		if (dynamicEntity->getDerivedType() == DynamicEntityType::Citizen)
-		{
-			count++;
-		}
-	}
-
-	return count;
+	return entityManager.getCountOfType(DynamicEntityType::Citizen);
 }
 
 int CitizenUtils::getCitizenCountInChunk(const ChunkInt2 &chunk, const EntityManager &entityManager)
 {
-	constexpr EntityType entityType = EntityType::Dynamic;
-	Buffer<const Entity*> entities(entityManager.getCountInChunk(chunk));
-	const int entityWriteCount = entityManager.getEntitiesInChunk(chunk, entities.get(), entities.getCount());
-
-	int count = 0;
-	for (int i = 0; i < entityWriteCount; i++)
-	{
-		const Entity *entity = entities.get(i);
-		if (entity->getEntityType() == entityType)
-		{
-			const DynamicEntity *dynamicEntity = dynamic_cast<const DynamicEntity*>(entity);
-			if (dynamicEntity->getDerivedType() == DynamicEntityType::Citizen)
-			{
-				count++;
-			}
-		}
-	}
-
-	return count;
+	return entityManager.getCountInChunk(chunk, DynamicEntityType::Citizen);
 }
 
 CitizenUtils::CitizenGenInfo CitizenUtils::makeCitizenGenInfo(int raceID, ArenaTypes::ClimateType climateType,
@@ -170,36 +136,16 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 		return false;
 	}
 
-	const std::optional<VoxelInt2> spawnVoxel = [&chunk, &random]() -> std::optional<VoxelInt2>
-	{
-		DebugAssert(chunk.getHeight() >= 2);
-
-		constexpr int spawnTriesCount = 20;
-		for (int spawnTry = 0; spawnTry < spawnTriesCount; spawnTry++)
-		{
-			const VoxelInt2 spawnVoxel(random.next(Chunk::WIDTH), random.next(Chunk::DEPTH));
-			const Chunk::VoxelID voxelID = chunk.getVoxel(spawnVoxel.x, 1, spawnVoxel.y);
-			const Chunk::VoxelID groundVoxelID = chunk.getVoxel(spawnVoxel.x, 0, spawnVoxel.y);
-			const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
-			const VoxelDefinition &groundVoxelDef = chunk.getVoxelDef(groundVoxelID);
-
-			if ((voxelDef.type == ArenaTypes::VoxelType::None) &&
-				(groundVoxelDef.type == ArenaTypes::VoxelType::Floor))
-			{
-				return spawnVoxel;
-			}
-		}
-
-		// No spawn position found.
-		return std::nullopt;
-	}();
-
-	if (!spawnVoxel.has_value())
+	// Pick from the chunk's walkable ground voxels so a spawn never fails if there's room for one.
+	const int spawnVoxelCount = chunk.getSpawnVoxelCount();
+	if (spawnVoxelCount == 0)
 	{
-		DebugLogWarning("Couldn't find spawn voxel for citizen.");
+		DebugLogWarning("No spawn voxels for citizen in chunk \"" + chunkCoord.toString() + "\".");
 		return false;
 	}
 
+	const VoxelInt2 &spawnVoxel = chunk.getSpawnVoxel(random.next(spawnVoxelCount));
+
 	const bool male = random.next(2) == 0;
 	const EntityDefID entityDefID = male ? citizenGenInfo.maleEntityDefID : citizenGenInfo.femaleEntityDefID;
 	const EntityDefinition &entityDef = male ? *citizenGenInfo.maleEntityDef : *citizenGenInfo.femaleEntityDef;
@@ -208,10 +154,10 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 
 	const Palette &palette = textureManager.getPaletteHandle(citizenGenInfo.paletteID);
 	const uint16_t colorSeed = static_cast<uint16_t>(random.next());
-	const Palette generatedPalette = ArenaAnimUtils::transformCitizenColors(
+	std::shared_ptr<const Palette> citizenPalette = entityManager.getCitizenPalette(
 		citizenGenInfo.raceID, colorSeed, palette, binaryAssetLibrary.getExeData());
 
-	EntityRef entityRef = entityManager.makeEntity(EntityType::Dynamic);
+	EntityRef entityRef = entityManager.makeDynamicEntity(DynamicEntityType::Citizen);
 	DynamicEntity *dynamicEntity = entityRef.getDerived<DynamicEntity>();
 	constexpr CardinalDirectionName direction = CardinalDirectionName::North;
 	dynamicEntity->initCitizen(entityDefID, entityAnimInst, direction);
@@ -228,12 +174,12 @@ bool CitizenUtils::trySpawnCitizenInChunk(const Chunk &chunk, const CitizenGenIn
 	animInst.setStateIndex(*stateIndex);
 
 	auto citizenParams = std::make_unique<EntityAnimationInstance::CitizenParams>();
-	citizenParams->palette = generatedPalette;
+	citizenParams->palette = std::move(citizenPalette);
 	animInst.setCitizenParams(std::move(citizenParams));
 
 	// Note: since the entity pointer is being used directly, update the position last
 	// in scope to avoid a dangling pointer problem in case it changes chunks.
-	const CoordDouble2 spawnCoordReal(chunkCoord, VoxelUtils::getVoxelCenter(*spawnVoxel));
+	const CoordDouble2 spawnCoordReal(chunkCoord, VoxelUtils::getVoxelCenter(spawnVoxel));
 	dynamicEntity->setPosition(spawnCoordReal, entityManager);
 
 	return true;
@@ -32,8 +32,8 @@ DynamicEntity::DynamicEntity()
 void DynamicEntity::initCitizen(EntityDefID defID, const EntityAnimationInstance &animInst,
 	CardinalDirectionName direction)
 {
+	DebugAssert(this->derivedType == DynamicEntityType::Citizen);
 	this->init(defID, animInst);
-	this->derivedType = DynamicEntityType::Citizen;
 
 	if (!CitizenUtils::tryGetCitizenDirectionFromCardinalDirection(direction, &this->direction))
 	{
@@ -44,8 +44,8 @@ void DynamicEntity::initCitizen(EntityDefID defID, const EntityAnimationInstance
 void DynamicEntity::initCreature(EntityDefID defID, const EntityAnimationInstance &animInst,
 	const NewDouble2 &direction, Random &random)
 {
+	DebugAssert(this->derivedType == DynamicEntityType::Creature);
 	this->init(defID, animInst);
-	this->derivedType = DynamicEntityType::Creature;
 	this->direction = direction;
 	this->secondsTillCreatureSound = DynamicEntity::nextCreatureSoundWaitTime(random);
 }
@@ -53,8 +53,8 @@ void DynamicEntity::initCreature(EntityDefID defID, const EntityAnimationInstanc
 void DynamicEntity::initProjectile(EntityDefID defID, const EntityAnimationInstance &animInst,
 	const NewDouble2 &direction)
 {
+	DebugAssert(this->derivedType == DynamicEntityType::Projectile);
 	this->init(defID, animInst);
-	this->derivedType = DynamicEntityType::Projectile;
 	this->direction = direction;
 }
 
@@ -83,6 +83,11 @@ const NewDouble2 *DynamicEntity::getDestination() const
 	return this->destination.has_value() ? &this->destination.value() : nullptr;
 }
 
+void DynamicEntity::setDerivedType(DynamicEntityType derivedType)
+{
+	this->derivedType = derivedType;
+}
+
 void DynamicEntity::setDirection(const NewDouble2 &direction)
 {
 	DebugAssert(std::isfinite(direction.lengthSquared()));
@@ -140,7 +145,7 @@ void DynamicEntity::playCreatureSound(const std::string &soundFilename, double c
 		this->position.chunk,
 		VoxelDouble3(this->position.point.x, ceilingScale * 1.50, this->position.point.y));
 	const NewDouble3 absoluteSoundPosition = VoxelUtils::coordToNewPoint(soundCoord);
-	audioManager.playSound(soundFilename, absoluteSoundPosition);
+	audioManager.playSound(soundFilename, absoluteSoundPosition, AudioManager::SoundCategory::Creature);
 }
 
 void DynamicEntity::yaw(double radians)
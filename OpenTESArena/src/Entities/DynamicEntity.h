@@ -58,6 +58,8 @@ public:
 	DynamicEntity();
 	~DynamicEntity() override = default;
 
+	// The derived type is assigned by the entity manager when the entity is made so it can keep count
+	// of each type. The init function called afterwards must match it.
 	void initCitizen(EntityDefID defID, const EntityAnimationInstance &animInst,
 		CardinalDirectionName direction);
 	void initCreature(EntityDefID defID, const EntityAnimationInstance &animInst,
@@ -71,6 +73,7 @@ public:
 	const NewDouble2 &getVelocity() const;
 	const NewDouble2 *getDestination() const;
 
+	void setDerivedType(DynamicEntityType derivedType);
 	void setDirection(const NewDouble2 &direction);
 
 	// Turns the camera around the global up vector by the given degrees.
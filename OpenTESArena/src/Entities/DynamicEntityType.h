@@ -1,6 +1,7 @@
 #ifndef DYNAMIC_ENTITY_TYPE_H
 #define DYNAMIC_ENTITY_TYPE_H
 
+// Values are used as array indices. The count below must name the last type if more are added.
 enum class DynamicEntityType
 {
 	Citizen, // Wanders around and can talk to player.
@@ -8,4 +9,6 @@ enum class DynamicEntityType
 	Projectile // Flying objects like arrows or spells.
 };
 
+constexpr int DYNAMIC_ENTITY_TYPE_COUNT = static_cast<int>(DynamicEntityType::Projectile) + 1;
+
 #endif
@@ -63,10 +63,11 @@ public:
 
 	struct CitizenParams
 	{
-		// Each citizen has a unique palette instead of unique textures for memory savings. It was found
+		// Each citizen has a generated palette instead of unique textures for memory savings. It was found
 		// through testing that hardly any citizen instances share textures due to variations in their
-		// random palette. As a result, citizen textures will need to be 8-bit.
-		Palette palette;
+		// random palette. As a result, citizen textures will need to be 8-bit. Citizens with the same
+		// race and color seed share one palette from the entity manager.
+		std::shared_ptr<const Palette> palette;
 	};
 private:
 	std::vector<State> states;
@@ -12,7 +12,10 @@ Entity *EntityGeneration::makeEntity(EntityType entityType, EntityDefinition::Ty
 	EntityDefID entityDefID, const EntityDefinition &entityDef, const EntityAnimationDefinition &animDef,
 	const EntityGenInfo &entityGenInfo, Random &random, EntityManager &entityManager)
 {
-	EntityRef entity = entityManager.makeEntity(entityType); // @todo: decide if chunk should be an argument too
+	// @todo: decide if chunk should be an argument too
+	EntityRef entity = (entityType == EntityType::Dynamic) ?
+		entityManager.makeDynamicEntity(EntityUtils::getDynamicEntityTypeFromDefType(entityDefType)) :
+		entityManager.makeStaticEntity();
 	Entity *entityPtr = entity.get();
 
 	EntityAnimationInstance animInst;
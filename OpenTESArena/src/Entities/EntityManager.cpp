@@ -6,6 +6,7 @@
 #include "EntityManager.h"
 #include "EntityType.h"
 #include "EntityVisibilityState.h"
+#include "../Assets/ArenaAnimUtils.h"
 #include "../Assets/MIFUtils.h"
 #include "../Game/Game.h"
 #include "../Math/Constants.h"
@@ -15,6 +16,37 @@
 
 #include "components/debug/Debug.h"
 
+namespace
+{
+	// Hashes the colors a citizen palette changes from the palette it was generated from, so citizens
+	// can be matched by how they look rather than by the seed that produced it.
+	uint64_t HashCitizenPaletteChanges(const Palette &citizenPalette, const Palette &palette)
+	{
+		// 64-bit FNV-1a over the index and color of each changed entry.
+		uint64_t hash = 0xCBF29CE484222325;
+		auto hashByte = [&hash](uint8_t value)
+		{
+			hash ^= value;
+			hash *= 0x100000001B3;
+		};
+
+		for (int i = 0; i < static_cast<int>(citizenPalette.size()); i++)
+		{
+			const Color &color = citizenPalette[i];
+			if (color != palette[i])
+			{
+				hashByte(static_cast<uint8_t>(i));
+				hashByte(color.r);
+				hashByte(color.g);
+				hashByte(color.b);
+				hashByte(color.a);
+			}
+		}
+
+		return hash;
+	}
+}
+
 template <typename T>
 int EntityManager::EntityGroup<T>::getCount() const
 {
@@ -245,6 +277,109 @@ void EntityManager::EntityGroup<T>::clear()
 	this->freeIndices.clear();
 }
 
+EntityManager::EntityCounts::EntityCounts()
+{
+	this->clear();
+}
+
+int &EntityManager::EntityCounts::getDynamicCount(DynamicEntityType dynamicEntityType)
+{
+	const int index = static_cast<int>(dynamicEntityType);
+	DebugAssertIndex(this->dynamicCounts, index);
+	return this->dynamicCounts[index];
+}
+
+int EntityManager::EntityCounts::getCount() const
+{
+	return this->getCountOfType(EntityType::Static) + this->getCountOfType(EntityType::Dynamic);
+}
+
+int EntityManager::EntityCounts::getCountOfType(EntityType entityType) const
+{
+	if (entityType == EntityType::Static)
+	{
+		return this->staticCount;
+	}
+	else if (entityType == EntityType::Dynamic)
+	{
+		int count = 0;
+		for (const int dynamicCount : this->dynamicCounts)
+		{
+			count += dynamicCount;
+		}
+
+		return count;
+	}
+	else
+	{
+		DebugUnhandledReturnMsg(int, std::to_string(static_cast<int>(entityType)));
+	}
+}
+
+int EntityManager::EntityCounts::getCountOfType(DynamicEntityType dynamicEntityType) const
+{
+	const int index = static_cast<int>(dynamicEntityType);
+	DebugAssertIndex(this->dynamicCounts, index);
+	return this->dynamicCounts[index];
+}
+
+void EntityManager::EntityCounts::add(const Entity &entity)
+{
+	const EntityType entityType = entity.getEntityType();
+	if (entityType == EntityType::Static)
+	{
+		this->staticCount++;
+	}
+	else if (entityType == EntityType::Dynamic)
+	{
+		const DynamicEntity &dynamicEntity = static_cast<const DynamicEntity&>(entity);
+		this->getDynamicCount(dynamicEntity.getDerivedType())++;
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
+	}
+}
+
+void EntityManager::EntityCounts::remove(const Entity &entity)
+{
+	const EntityType entityType = entity.getEntityType();
+	if (entityType == EntityType::Static)
+	{
+		DebugAssert(this->staticCount > 0);
+		this->staticCount--;
+	}
+	else if (entityType == EntityType::Dynamic)
+	{
+		const DynamicEntity &dynamicEntity = static_cast<const DynamicEntity&>(entity);
+		int &dynamicCount = this->getDynamicCount(dynamicEntity.getDerivedType());
+		DebugAssert(dynamicCount > 0);
+		dynamicCount--;
+	}
+	else
+	{
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
+	}
+}
+
+void EntityManager::EntityCounts::remove(const EntityCounts &other)
+{
+	this->staticCount -= other.staticCount;
+	DebugAssert(this->staticCount >= 0);
+
+	for (size_t i = 0; i < this->dynamicCounts.size(); i++)
+	{
+		this->dynamicCounts[i] -= other.dynamicCounts[i];
+		DebugAssert(this->dynamicCounts[i] >= 0);
+	}
+}
+
+void EntityManager::EntityCounts::clear()
+{
+	this->staticCount = 0;
+	this->dynamicCounts.fill(0);
+}
+
 void EntityManager::EntityChunk::init(const ChunkInt2 &chunk)
 {
 	this->chunk = chunk;
@@ -254,6 +389,7 @@ void EntityManager::EntityChunk::clear()
 {
 	this->staticGroup.clear();
 	this->dynamicGroup.clear();
+	this->counts.clear();
 }
 
 EntityManager::EntityManager()
@@ -279,37 +415,33 @@ EntityID EntityManager::nextFreeID()
 	}
 }
 
-EntityRef EntityManager::makeEntity(EntityType type)
+EntityRef EntityManager::makeStaticEntity()
 {
 	// Get the default chunk for creating the entity in.
 	DebugAssertMsg(!this->entityChunks.empty(), "Need at least one active chunk for creating an entity.");
 	EntityChunk &defaultEntityChunk = this->entityChunks.front();
 
 	const EntityID id = this->nextFreeID();
-	EntityRef entityRef = [this, type, &defaultEntityChunk, id]()
-	{
-		// Instantiate the entity based on their type.
-		if (type == EntityType::Static)
-		{
-			EntityGroup<StaticEntity> &group = defaultEntityChunk.staticGroup;
-			StaticEntity *entity = group.addEntity(id);
-			return EntityRef(this, id, type);
-		}
-		else if (type == EntityType::Dynamic)
-		{
-			EntityGroup<DynamicEntity> &group = defaultEntityChunk.dynamicGroup;
-			DynamicEntity *entity = group.addEntity(id);
-			return EntityRef(this, id, type);
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(type)));
-			return EntityRef(nullptr, EntityManager::NO_ID, static_cast<EntityType>(-1));
-		}
-	}();
+	EntityGroup<StaticEntity> &group = defaultEntityChunk.staticGroup;
+	const StaticEntity *entity = group.addEntity(id);
+	defaultEntityChunk.counts.add(*entity);
+	this->counts.add(*entity);
+	return EntityRef(this, id, EntityType::Static);
+}
+
+EntityRef EntityManager::makeDynamicEntity(DynamicEntityType derivedType)
+{
+	// Get the default chunk for creating the entity in.
+	DebugAssertMsg(!this->entityChunks.empty(), "Need at least one active chunk for creating an entity.");
+	EntityChunk &defaultEntityChunk = this->entityChunks.front();
 
-	DebugAssert(entityRef.getID() == id);
-	return entityRef;
+	const EntityID id = this->nextFreeID();
+	EntityGroup<DynamicEntity> &group = defaultEntityChunk.dynamicGroup;
+	DynamicEntity *entity = group.addEntity(id);
+	entity->setDerivedType(derivedType);
+	defaultEntityChunk.counts.add(*entity);
+	this->counts.add(*entity);
+	return EntityRef(this, id, EntityType::Dynamic);
 }
 
 template <typename T>
@@ -498,24 +630,12 @@ ConstEntityRef EntityManager::getEntityRef(EntityID id) const
 
 int EntityManager::getCountOfType(EntityType entityType) const
 {
-	int count = 0;
-	for (const EntityChunk &entityChunk : this->entityChunks)
-	{
-		if (entityType == EntityType::Static)
-		{
-			count += entityChunk.staticGroup.getCount();
-		}
-		else if (entityType == EntityType::Dynamic)
-		{
-			count += entityChunk.dynamicGroup.getCount();
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
-		}
-	}
+	return this->counts.getCountOfType(entityType);
+}
 
-	return count;
+int EntityManager::getCountOfType(DynamicEntityType dynamicEntityType) const
+{
+	return this->counts.getCountOfType(dynamicEntityType);
 }
 
 int EntityManager::getCountInChunk(const ChunkInt2 &chunk) const
@@ -530,12 +650,24 @@ int EntityManager::getCountInChunk(const ChunkInt2 &chunk) const
 	}
 
 	const EntityChunk &entityChunk = this->entityChunks[*chunkIndex];
-	return entityChunk.staticGroup.getCount() + entityChunk.dynamicGroup.getCount();
+	return entityChunk.counts.getCount();
+}
+
+int EntityManager::getCountInChunk(const ChunkInt2 &chunk, DynamicEntityType dynamicEntityType) const
+{
+	const std::optional<int> chunkIndex = this->tryGetChunkIndex(chunk);
+	if (!chunkIndex.has_value())
+	{
+		return 0;
+	}
+
+	const EntityChunk &entityChunk = this->entityChunks[*chunkIndex];
+	return entityChunk.counts.getCountOfType(dynamicEntityType);
 }
 
 int EntityManager::getCount() const
 {
-	return this->getCountOfType(EntityType::Static) + this->getCountOfType(EntityType::Dynamic);
+	return this->counts.getCount();
 }
 
 int EntityManager::getEntitiesOfType(EntityType entityType, Entity **outEntities, int outSize)
@@ -621,36 +753,15 @@ int EntityManager::getEntitiesInChunk(const ChunkInt2 &chunk, const Entity **out
 
 	const EntityChunk &entityChunk = this->entityChunks[*chunkIndex];
 
-	// Fill the output buffer with as many entities as will fit.
+	// Fill the output buffer with as many entities as will fit. Freed slots are skipped so the
+	// live count from getCountInChunk() is enough to hold every entity in the chunk.
 	int writeIndex = 0;
 
 	const EntityGroup<StaticEntity> &staticGroup = entityChunk.staticGroup;
-	const int staticEntityCount = staticGroup.getCount();
-	for (int i = 0; i < staticEntityCount; i++)
-	{
-		// Break if the output buffer is full.
-		if (writeIndex == outSize)
-		{
-			break;
-		}
-
-		outEntities[writeIndex] = staticGroup.getEntityAtIndex(i);
-		writeIndex++;
-	}
+	writeIndex += staticGroup.getEntities(outEntities + writeIndex, outSize - writeIndex);
 
 	const EntityGroup<DynamicEntity> &dynamicGroup = entityChunk.dynamicGroup;
-	const int dynamicEntityCount = dynamicGroup.getCount();
-	for (int i = 0; i < dynamicEntityCount; i++)
-	{
-		// Break if the output buffer is full.
-		if (writeIndex == outSize)
-		{
-			break;
-		}
-
-		outEntities[writeIndex] = dynamicGroup.getEntityAtIndex(i);
-		writeIndex++;
-	}
+	writeIndex += dynamicGroup.getEntities(outEntities + writeIndex, outSize - writeIndex);
 
 	return writeIndex;
 }
@@ -718,6 +829,33 @@ EntityDefID EntityManager::addEntityDef(EntityDefinition &&def,
 	return defID;
 }
 
+std::shared_ptr<const Palette> EntityManager::getCitizenPalette(int raceID, uint16_t colorSeed,
+	const Palette &palette, const ExeData &exeData)
+{
+	// Generating the colors is cheap compared to keeping a palette per citizen, so always generate them
+	// and look for an existing palette with the same result.
+	Palette citizenPalette = ArenaAnimUtils::transformCitizenColors(raceID, colorSeed, palette, exeData);
+	const uint64_t key = HashCitizenPaletteChanges(citizenPalette, palette);
+
+	const auto range = this->citizenPalettes.equal_range(key);
+	for (auto iter = range.first; iter != range.second; ++iter)
+	{
+		if (*iter->second == citizenPalette)
+		{
+			return iter->second;
+		}
+	}
+
+	const auto newIter = this->citizenPalettes.emplace(key,
+		std::make_shared<const Palette>(std::move(citizenPalette)));
+	return newIter->second;
+}
+
+int EntityManager::getCitizenPaletteCount() const
+{
+	return static_cast<int>(this->citizenPalettes.size());
+}
+
 void EntityManager::getEntityVisibilityState2D(const Entity &entity, const CoordDouble2 &eye2D,
 	const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
 	EntityVisibilityState2D &outVisState) const
@@ -927,6 +1065,7 @@ void EntityManager::updateEntityChunk(Entity *entity)
 		}
 
 		EntityChunk &newEntityChunk = this->entityChunks[*newChunkIndex];
+		const Entity *movedEntity = nullptr;
 		if (entityType == EntityType::Static)
 		{
 			EntityGroup<StaticEntity> &oldGroup = oldEntityChunk.staticGroup;
@@ -934,7 +1073,10 @@ void EntityManager::updateEntityChunk(Entity *entity)
 			if (!newGroup.tryAcquireEntity(entityID, oldGroup))
 			{
 				DebugLogError("Couldn't move static entity \"" + std::to_string(entityID) + "\" from old to new group.");
+				return;
 			}
+
+			movedEntity = this->getInternal(entityID, newGroup);
 		}
 		else if (entityType == EntityType::Dynamic)
 		{
@@ -943,12 +1085,20 @@ void EntityManager::updateEntityChunk(Entity *entity)
 			if (!newGroup.tryAcquireEntity(entityID, oldGroup))
 			{
 				DebugLogError("Couldn't move dynamic entity \"" + std::to_string(entityID) + "\" from old to new group.");
+				return;
 			}
+
+			movedEntity = this->getInternal(entityID, newGroup);
 		}
 		else
 		{
 			DebugNotImplementedMsg(std::to_string(static_cast<int>(entityType)));
+			return;
 		}
+
+		DebugAssert(movedEntity != nullptr);
+		oldEntityChunk.counts.remove(*movedEntity);
+		newEntityChunk.counts.add(*movedEntity);
 	}
 }
 
@@ -964,6 +1114,9 @@ void EntityManager::remove(EntityID id)
 		std::optional<int> entityIndex = staticGroup.getEntityIndex(id);
 		if (entityIndex.has_value())
 		{
+			const StaticEntity *entity = staticGroup.getEntityAtIndex(*entityIndex);
+			entityChunk.counts.remove(*entity);
+			this->counts.remove(*entity);
 			staticGroup.remove(id);
 			this->freeIDs.push_back(id);
 			return;
@@ -973,6 +1126,9 @@ void EntityManager::remove(EntityID id)
 		entityIndex = dynamicGroup.getEntityIndex(id);
 		if (entityIndex.has_value())
 		{
+			const DynamicEntity *entity = dynamicGroup.getEntityAtIndex(*entityIndex);
+			entityChunk.counts.remove(*entity);
+			this->counts.remove(*entity);
 			dynamicGroup.remove(id);
 			this->freeIDs.push_back(id);
 			return;
@@ -986,7 +1142,9 @@ void EntityManager::remove(EntityID id)
 void EntityManager::clear()
 {
 	this->entityChunks.clear();
+	this->counts.clear();
 	this->entityDefs.clear();
+	this->citizenPalettes.clear();
 	this->freeIDs.clear();
 	this->nextID = 0;
 }
@@ -1037,7 +1195,21 @@ void EntityManager::removeChunk(const ChunkInt2 &chunk)
 	}
 
 	// Remove the chunk from the entity manager.
+	this->counts.remove(entityChunk.counts);
 	this->entityChunks.erase(this->entityChunks.begin() + *chunkIndex);
+
+	// Free any citizen palettes that were only used by entities in the removed chunk.
+	for (auto iter = this->citizenPalettes.begin(); iter != this->citizenPalettes.end(); )
+	{
+		if (iter->second.use_count() == 1)
+		{
+			iter = this->citizenPalettes.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
 }
 
 void EntityManager::tick(Game &game, double dt)
@@ -1,24 +1,30 @@
 #ifndef ENTITY_MANAGER_H
 #define ENTITY_MANAGER_H
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include "DynamicEntity.h"
+#include "DynamicEntityType.h"
 #include "Entity.h"
 #include "EntityDefinition.h"
 #include "EntityRef.h"
 #include "EntityUtils.h"
 #include "StaticEntity.h"
 #include "../Math/Vector3.h"
+#include "../Media/Palette.h"
 #include "../World/VoxelUtils.h"
 
 #include "components/utilities/Buffer2D.h"
 
 class ChunkManager;
 class EntityDefinitionLibrary;
+class ExeData;
 class Game;
 
 struct EntityVisibilityState2D;
@@ -79,12 +85,35 @@ private:
 		void clear();
 	};
 
+	// Number of live entities of each type, kept up to date as entities are made, moved between chunks,
+	// and removed so they can be counted without iterating.
+	class EntityCounts
+	{
+	private:
+		int staticCount;
+		std::array<int, DYNAMIC_ENTITY_TYPE_COUNT> dynamicCounts;
+
+		int &getDynamicCount(DynamicEntityType dynamicEntityType);
+	public:
+		EntityCounts();
+
+		int getCount() const;
+		int getCountOfType(EntityType entityType) const;
+		int getCountOfType(DynamicEntityType dynamicEntityType) const;
+
+		void add(const Entity &entity);
+		void remove(const Entity &entity);
+		void remove(const EntityCounts &other);
+		void clear();
+	};
+
 	// All entities for a particular chunk.
 	struct EntityChunk
 	{
 		ChunkInt2 chunk;
 		EntityGroup<StaticEntity> staticGroup;
 		EntityGroup<DynamicEntity> dynamicGroup;
+		EntityCounts counts;
 
 		void init(const ChunkInt2 &chunk);
 
@@ -95,10 +124,18 @@ private:
 	// by the chunk manager.
 	std::vector<EntityChunk> entityChunks;
 
+	// Totals of the entity chunk counts.
+	EntityCounts counts;
+
 	// Entity definitions for the currently-active level. Their definition IDs CANNOT be assumed
 	// to be zero-based because these are in addition to ones in the entity definition library.
 	std::unordered_map<EntityDefID, EntityDefinition> entityDefs;
 
+	// Generated citizen palettes for the currently-active level, mapped by a hash of the colors they
+	// change. Citizens whose colors come out the same share one of these, even if their race or color
+	// seed differ.
+	std::unordered_multimap<uint64_t, std::shared_ptr<const Palette>> citizenPalettes;
+
 	// Free IDs (previously owned) and the next available ID (never owned).
 	std::vector<EntityID> freeIDs;
 	EntityID nextID;
@@ -122,9 +159,11 @@ public:
 
 	EntityManager();
 
-	// Factory function. This assigns the new entity an available ID. For simplicity of initialization,
-	// there must be at least one active chunk, and this entity is default-assigned to that chunk.
-	EntityRef makeEntity(EntityType type);
+	// Factory functions. These assign the new entity an available ID. For simplicity of initialization,
+	// there must be at least one active chunk, and this entity is default-assigned to that chunk. Dynamic
+	// entities are given their derived type here so they can be counted by it.
+	EntityRef makeStaticEntity();
+	EntityRef makeDynamicEntity(DynamicEntityType derivedType);
 
 	// Gets a raw entity handle, given their ID and an optional entity type for faster look-up.
 	// Returns null if no ID matches. Does not protect against dangling pointers.
@@ -142,10 +181,14 @@ public:
 
 	// Gets the number of entities of the given type in the manager.
 	int getCountOfType(EntityType entityType) const;
+	int getCountOfType(DynamicEntityType dynamicEntityType) const;
 
 	// Gets total number of entities in a chunk.
 	int getCountInChunk(const ChunkInt2 &chunk) const;
 
+	// Gets the number of dynamic entities of the given type in a chunk.
+	int getCountInChunk(const ChunkInt2 &chunk, DynamicEntityType dynamicEntityType) const;
+
 	// Gets total number of entities in the manager.
 	int getCount() const;
 
@@ -173,6 +216,14 @@ public:
 	// Adds an entity definition and returns its ID.
 	EntityDefID addEntityDef(EntityDefinition &&def, const EntityDefinitionLibrary &entityDefLibrary);
 
+	// Gets the palette for a citizen of the given race and color seed, shared with any other citizen
+	// in the active level whose generated colors are the same.
+	std::shared_ptr<const Palette> getCitizenPalette(int raceID, uint16_t colorSeed, const Palette &palette,
+		const ExeData &exeData);
+
+	// Gets the number of citizen palette variants currently in use.
+	int getCitizenPaletteCount() const;
+
 	// Gets the entity visibility data necessary for rendering and ray cast selection.
 	void getEntityVisibilityState2D(const Entity &entity, const CoordDouble2 &eye2D,
 		const ChunkManager &chunkManager, const EntityDefinitionLibrary &entityDefLibrary,
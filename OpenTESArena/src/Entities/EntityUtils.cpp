@@ -2,6 +2,7 @@
 
 #include "CharacterClassDefinition.h"
 #include "CharacterClassLibrary.h"
+#include "DynamicEntityType.h"
 #include "EntityDefinition.h"
 #include "EntityDefinitionLibrary.h"
 #include "EntityType.h"
@@ -29,6 +30,21 @@ EntityType EntityUtils::getEntityTypeFromDefType(EntityDefinition::Type defType)
 	}
 }
 
+DynamicEntityType EntityUtils::getDynamicEntityTypeFromDefType(EntityDefinition::Type defType)
+{
+	switch (defType)
+	{
+	case EntityDefinition::Type::Enemy:
+		return DynamicEntityType::Creature;
+	case EntityDefinition::Type::Citizen:
+		return DynamicEntityType::Citizen;
+	case EntityDefinition::Type::Projectile:
+		return DynamicEntityType::Projectile;
+	default:
+		DebugUnhandledReturnMsg(DynamicEntityType, std::to_string(static_cast<int>(defType)));
+	}
+}
+
 std::string EntityUtils::defTypeToString(const EntityDefinition &entityDef)
 {
 	const EntityDefinition::Type type = entityDef.getType();
@@ -15,12 +15,16 @@ using EntityDefID = int;
 class CharacterClassLibrary;
 class EntityDefinitionLibrary;
 
+enum class DynamicEntityType;
 enum class EntityType;
 
 namespace EntityUtils
 {
 	EntityType getEntityTypeFromDefType(EntityDefinition::Type defType);
 
+	// Gets the derived type of a dynamic entity created from the given definition type.
+	DynamicEntityType getDynamicEntityTypeFromDefType(EntityDefinition::Type defType);
+
 	// Gets the display name of the entity definition type for debugging.
 	std::string defTypeToString(const EntityDefinition &entityDef);
 
@@ -1,10 +1,8 @@
-#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <thread>
 
 #include "SDL.h"
 
@@ -12,6 +10,8 @@
 #include "Options.h"
 #include "PlayerInterface.h"
 #include "../Assets/CityDataFile.h"
+#include "../Entities/CitizenUtils.h"
+#include "../Entities/EntityManager.h"
 #include "../Input/InputActionName.h"
 #include "../Interface/CommonUiController.h"
 #include "../Interface/CommonUiView.h"
@@ -28,12 +28,13 @@
 #include "components/utilities/File.h"
 #include "components/utilities/String.h"
 #include "components/utilities/TextLinesFile.h"
+#include "components/utilities/TraceProfiler.h"
 #include "components/vfs/manager.hpp"
 
 namespace
 {
-	// Size of scratch buffer in bytes, reset each frame.
-	constexpr int SCRATCH_BUFFER_SIZE = 65536;
+	// Size of each frame allocator block in bytes. The allocator is reset each frame.
+	constexpr int FRAME_ALLOCATOR_BLOCK_SIZE = 65536;
 }
 
 Game::Game()
@@ -52,6 +53,21 @@ Game::Game()
 	// default file before the "changes" file.
 	this->initOptions(this->basePath, this->optionsPath);
 
+	// Optionally write log messages to a file in the log folder as well as the console.
+	if (this->options.getMisc_WriteLogFile())
+	{
+		const std::string logPath = Platform::getLogPath();
+		if (!Platform::directoryExists(logPath))
+		{
+			Platform::createDirectoryRecursively(logPath);
+		}
+
+		if (!Debug::initLogFile(logPath))
+		{
+			DebugLogWarning("Couldn't open log file in \"" + logPath + "\".");
+		}
+	}
+
 	// Initialize virtual file system using the Arena path in the options file.
 	const bool arenaPathIsRelative = File::pathIsRelative(this->options.getMisc_ArenaPath().c_str());
 	VFS::Manager::get().initialize(std::string(
@@ -119,18 +135,21 @@ Game::Game()
 	this->debugProfilerListenerID = this->inputManager.addInputActionListener(
 		InputActionName::DebugProfiler, CommonUiController::onDebugInputAction);
 
-	// Determine which version of the game the Arena path is pointing to.
-	const bool isFloppyVersion = [this, arenaPathIsRelative]()
+	this->debugTraceListenerID = this->inputManager.addInputActionListener(
+		InputActionName::DebugTrace, CommonUiController::onDebugTraceInputAction);
+
+	// Path to the Arena folder.
+	const std::string fullArenaPath = [this, arenaPathIsRelative]()
 	{
-		// Path to the Arena folder.
-		const std::string fullArenaPath = [this, arenaPathIsRelative]()
-		{
-			// Include the base path if the ArenaPath is relative.
-			const std::string path = (arenaPathIsRelative ? this->basePath : "") +
-				this->options.getMisc_ArenaPath();
-			return String::addTrailingSlashIfMissing(path);
-		}();
+		// Include the base path if the ArenaPath is relative.
+		const std::string path = (arenaPathIsRelative ? this->basePath : "") +
+			this->options.getMisc_ArenaPath();
+		return String::addTrailingSlashIfMissing(path);
+	}();
 
+	// Determine which version of the game the Arena path is pointing to.
+	const bool isFloppyVersion = [&fullArenaPath]()
+	{
 		// Check for the CD version first.
 		const std::string &acdExeName = ExeData::CD_VERSION_EXE_FILENAME;
 		const std::string acdExePath = fullArenaPath + acdExeName;
@@ -153,6 +172,24 @@ Game::Game()
 		throw DebugException("\"" + fullArenaPath + "\" does not have an Arena executable.");
 	}();
 
+	// Optionally serve decoded textures from a pack file instead of decoding Arena's image formats
+	// every launch. The pack is keyed on the Arena path, version and the names, sizes and modification
+	// times of the Arena files so it's rebuilt if any of them change.
+	if (this->options.getMisc_TexturePackCache())
+	{
+		const std::string cachePath = Platform::getCachePath();
+		if (!Platform::directoryExists(cachePath))
+		{
+			Platform::createDirectoryRecursively(cachePath);
+		}
+
+		const uint64_t sourceFolderHash = TexturePackFile::hashSourceFolder(fullArenaPath);
+		const std::string sourceKeyStr = this->options.getMisc_ArenaPath() + (isFloppyVersion ? "|floppy" : "|cd") +
+			'|' + std::to_string(sourceFolderHash);
+		const uint64_t sourceKey = TexturePackFile::hashString(sourceKeyStr.c_str(), sourceKeyStr.size());
+		this->textureManager.initTexturePack(cachePath + "textures.pack", sourceKey);
+	}
+
 	// Load fonts.
 	if (!this->fontLibrary.init())
 	{
@@ -210,7 +247,7 @@ Game::Game()
 	this->renderer.setWindowIcon(icon);
 
 	this->random.init();
-	this->scratchAllocator.init(SCRATCH_BUFFER_SIZE);
+	this->frameAllocator.init(FRAME_ALLOCATOR_BLOCK_SIZE);
 
 	// Initialize panel and music to default.
 	this->panel = IntroUiModel::makeStartupPanel(*this);
@@ -245,6 +282,7 @@ Game::Game()
 	// The pop is delayed until the beginning of the next frame.
 	this->requestedSubPanelPop = false;
 
+	this->traceFramesRemaining = 0;
 	this->running = true;
 }
 
@@ -269,6 +307,11 @@ Game::~Game()
 	{
 		this->inputManager.removeListener(*this->debugProfilerListenerID);
 	}
+
+	if (this->debugTraceListenerID.has_value())
+	{
+		this->inputManager.removeListener(*this->debugTraceListenerID);
+	}
 }
 
 Panel *Game::getActivePanel() const
@@ -364,9 +407,9 @@ Random &Game::getRandom()
 	return this->random;
 }
 
-ScratchAllocator &Game::getScratchAllocator()
+FrameAllocator &Game::getFrameAllocator()
 {
-	return this->scratchAllocator;
+	return this->frameAllocator;
 }
 
 Profiler &Game::getProfiler()
@@ -374,6 +417,21 @@ Profiler &Game::getProfiler()
 	return this->profiler;
 }
 
+void Game::beginTrace(int frameCount)
+{
+	if (this->traceFramesRemaining > 0)
+	{
+		DebugLogWarning("Trace already in progress.");
+		return;
+	}
+
+	DebugAssert(frameCount > 0);
+	DebugLog("Recording trace for " + std::to_string(frameCount) + " frames.");
+	TraceProfiler::clear();
+	TraceProfiler::setEnabled(true);
+	this->traceFramesRemaining = frameCount;
+}
+
 const FPSCounter &Game::getFPSCounter() const
 {
 	return this->fpsCounter;
@@ -481,6 +539,53 @@ void Game::saveScreenshot(const Surface &surface)
 	}
 }
 
+void Game::updateTrace()
+{
+	if (this->traceFramesRemaining == 0)
+	{
+		return;
+	}
+
+	this->traceFramesRemaining--;
+	if (this->traceFramesRemaining > 0)
+	{
+		return;
+	}
+
+	TraceProfiler::setEnabled(false);
+
+	// Get the path + filename to use for the new trace.
+	const std::string tracePath = []()
+	{
+		const std::string traceFolder = Platform::getLogPath();
+		const std::string tracePrefix("trace");
+		int traceIndex = 0;
+
+		auto getNextAvailablePath = [&traceFolder, &tracePrefix, &traceIndex]()
+		{
+			std::stringstream ss;
+			ss << std::setw(3) << std::setfill('0') << traceIndex;
+			traceIndex++;
+			return traceFolder + tracePrefix + ss.str() + ".json";
+		};
+
+		std::string path = getNextAvailablePath();
+		while (File::exists(path.c_str()))
+		{
+			path = getNextAvailablePath();
+		}
+
+		return path;
+	}();
+
+	if (!TraceProfiler::writeChromeTrace(tracePath.c_str()))
+	{
+		DebugLogWarning("Couldn't write trace to \"" + tracePath + "\".");
+	}
+
+	TraceProfiler::clear();
+}
+
 void Game::handlePanelChanges()
 {
 	// If a sub-panel pop was requested, then pop the top of the sub-panel stack.
@@ -511,6 +616,8 @@ void Game::handlePanelChanges()
 
 void Game::handleInput(double dt)
 {
+	TraceZone("Game::handleInput");
+
 	// Handle input listener callbacks and general input updating.
 	const BufferView<const ButtonProxy> buttonProxies = this->getActivePanel()->getButtonProxies();
 	auto onFinishedProcessingEventFunc = [this]()
@@ -543,6 +650,8 @@ void Game::handleWindowResized(int width, int height)
 
 void Game::tick(double dt)
 {
+	TraceZone("Game::tick");
+
 	// Tick the active panel.
 	this->getActivePanel()->tick(dt);
 
@@ -552,6 +661,8 @@ void Game::tick(double dt)
 
 void Game::updateAudio(double dt)
 {
+	TraceZone("Game::updateAudio");
+
 	if (this->gameStateIsActive())
 	{
 		const Player &player = this->getGameState().getPlayer();
@@ -590,6 +701,11 @@ void Game::renderDebugInfo()
 		const std::string highestFrameTimeText = String::fixedPrecision(highestFrameTimeMS, 1);
 		debugText.append("FPS: " + averageFpsText + " (" + averageFrameTimeText + "ms " + lowestFrameTimeText +
 			"ms " + highestFrameTimeText + "ms)");
+
+		// Frame pacing accuracy.
+		const std::string averageJitterText = String::fixedPrecision(this->framePacer.getAverageJitter() * 1000.0, 2);
+		const std::string maxJitterText = String::fixedPrecision(this->framePacer.getMaxJitter() * 1000.0, 2);
+		debugText.append("\nJitter: " + averageJitterText + "ms (max " + maxJitterText + "ms)");
 	}
 
 	const Int2 windowDims = this->renderer.getWindowDimensions();
@@ -611,17 +727,45 @@ void Game::renderDebugInfo()
 			const std::string renderResScale = String::fixedPrecision(resolutionScale, 2);
 			const std::string renderThreadCount = std::to_string(profilerData.threadCount);
 			const std::string renderTime = String::fixedPrecision(profilerData.frameTime * 1000.0, 2);
+			const std::string distantSkyTime = String::fixedPrecision(profilerData.distantSkyTime * 1000.0, 2);
+			const std::string skyPanoramaTime = String::fixedPrecision(profilerData.skyPanoramaRebuildTime * 1000.0, 2);
 			debugText.append("\nRender: " + renderWidth + "x" + renderHeight + " (" + renderResScale + "), " +
 				renderThreadCount + " thread" + ((profilerData.threadCount > 1) ? "s" : "") + '\n' +
 				"3D render: " + renderTime + "ms" + "\n" +
+				"Distant sky: " + distantSkyTime + "ms (panorama rebuild: " + skyPanoramaTime + "ms)" + "\n" +
 				"Vis flats: " + std::to_string(profilerData.visFlatCount) + " (" +
 				std::to_string(profilerData.potentiallyVisFlatCount) + ")" +
 				", lights: " + std::to_string(profilerData.visLightCount));
+
+			// Frame temporaries from the renderer and the main thread. Heap allocations should stay at
+			// zero once the allocators have grown to fit a typical frame.
+			const FrameAllocator::Stats &frameAllocatorStats = this->frameAllocator.getLastFrameStats();
+			const int frameHeapAllocCount = profilerData.frameHeapAllocCount + frameAllocatorStats.heapAllocCount;
+			debugText.append("\nFrame alloc: " + std::to_string(profilerData.frameAllocByteCount) + " B render, " +
+				std::to_string(frameAllocatorStats.peakByteCount) + " B main, heap allocs: " +
+				std::to_string(frameHeapAllocCount));
+			debugText.append("\nChunk render defs rebuilt: " + std::to_string(profilerData.chunkRenderDefRebuildCount));
 		}
 		else
 		{
 			debugText.append("\nNo profiler data available.");
 		}
+
+		debugText.append("\nSounds: " + std::to_string(this->audioManager.getActiveSoundCount()) + " (dropped: " +
+			std::to_string(this->audioManager.getDroppedSoundCount()) + ", stolen: " +
+			std::to_string(this->audioManager.getStolenSoundCount()) + ")");
+
+		const std::string musicStartTime = String::fixedPrecision(this->audioManager.getMusicStartLatency() * 1000.0, 2);
+		debugText.append("\nMusic start: " + musicStartTime + "ms, underruns: " +
+			std::to_string(this->audioManager.getMusicUnderrunCount()));
+
+		if (this->gameStateIsActive())
+		{
+			const MapInstance &mapInst = this->gameState->getActiveMapInst();
+			const EntityManager &entityManager = mapInst.getActiveLevel().getEntityManager();
+			debugText.append("\nCitizens: " + std::to_string(CitizenUtils::getCitizenCount(entityManager)) +
+				" (palettes: " + std::to_string(entityManager.getCitizenPaletteCount()) + ")");
+		}
 	}
 
 	if (profilerLevel >= 3)
@@ -670,6 +814,8 @@ void Game::renderDebugInfo()
 
 void Game::render()
 {
+	TraceZone("Game::render");
+
 	// Get the draw calls from each UI panel/sub-panel and determine what to draw.
 	std::vector<Panel*> panelsToRender;
 	panelsToRender.emplace_back(this->panel.get());
@@ -733,63 +879,23 @@ void Game::render()
 
 void Game::loop()
 {
-	// Nanoseconds per second. Only using this much precision because it's what
-	// high_resolution_clock gives back. Microseconds would be fine too.
-	constexpr int64_t timeUnits = 1000000000;
-
-	// Longest allowed frame time.
-	const std::chrono::duration<int64_t, std::nano> maxFrameTime(timeUnits / Options::MIN_FPS);
-
-	// On some platforms, thread sleeping takes longer than it should, so include a value to
-	// help compensate.
-	std::chrono::nanoseconds sleepBias(0);
-
-	auto thisTime = std::chrono::high_resolution_clock::now();
+	this->framePacer.init(this->options.getGraphics_TargetFPS(), Options::MIN_FPS);
 
 	// Primary game loop.
 	while (this->running)
 	{
-		const auto lastTime = thisTime;
-		thisTime = std::chrono::high_resolution_clock::now();
-
-		// Shortest allowed frame time.
-		const std::chrono::duration<int64_t, std::nano> minFrameTime(
-			timeUnits / this->options.getGraphics_TargetFPS());
-
-		// Time since the last frame started.
-		const auto frameTime = [minFrameTime, &sleepBias, &thisTime, lastTime]()
-		{
-			// Delay the current frame if the previous one was too fast.
-			auto diff = thisTime - lastTime;
-			if (diff < minFrameTime)
-			{
-				const auto sleepTime = minFrameTime - diff + sleepBias;
-				std::this_thread::sleep_for(sleepTime);
-
-				// Compensate for sleeping too long. Thread sleeping has questionable accuracy.
-				const auto tempTime = std::chrono::high_resolution_clock::now();
-				const auto unnecessarySleepTime = [thisTime, sleepTime, tempTime]()
-				{
-					const auto tempFrameTime = tempTime - thisTime;
-					return tempFrameTime - sleepTime;
-				}();
-
-				sleepBias = -unnecessarySleepTime;
-				thisTime = tempTime;
-				diff = thisTime - lastTime;
-			}
-
-			return diff;
-		}();
+		// Finish any trace before this frame's zone starts.
+		this->updateTrace();
+		TraceZone("Game::loop");
 
-		// Two delta times: actual and clamped. Use the clamped delta time for game calculations
-		// so things don't break at low frame rates.
-		constexpr double timeUnitsReal = static_cast<double>(timeUnits);
-		const double dt = static_cast<double>(frameTime.count()) / timeUnitsReal;
-		const double clampedDt = std::fmin(frameTime.count(), maxFrameTime.count()) / timeUnitsReal;
+		// Wait if the previous frame was too fast. Two delta times: actual and clamped. Use the clamped
+		// delta time for game calculations so things don't break at low frame rates.
+		this->framePacer.setTargetFPS(this->options.getGraphics_TargetFPS());
+		double clampedDt;
+		const double dt = this->framePacer.waitForNextFrame(&clampedDt);
 
-		// Reset scratch allocator for use with this frame.
-		this->scratchAllocator.clear();
+		// Reset frame allocator for use with this frame.
+		this->frameAllocator.clear();
 
 		// Update the audio manager listener (if any) and check for finished sounds.
 		this->updateAudio(dt);
@@ -835,4 +941,5 @@ void Game::loop()
 	// At this point, the program has received an exit signal, and is now 
 	// quitting peacefully.
 	this->options.saveChanges();
+	this->textureManager.saveTexturePack();
 }
@@ -26,6 +26,7 @@
 
 #include "components/utilities/Allocator.h"
 #include "components/utilities/FPSCounter.h"
+#include "components/utilities/FramePacer.h"
 #include "components/utilities/Profiler.h"
 
 // This class holds the current game state, manages the primary game loop, and 
@@ -51,7 +52,7 @@ private:
 	// Listener IDs are optional in case of failed Game construction.
 	InputManager inputManager;
 	std::optional<InputManager::ListenerID> applicationExitListenerID, windowResizedListenerID,
-		takeScreenshotListenerID, debugProfilerListenerID;
+		takeScreenshotListenerID, debugProfilerListenerID, debugTraceListenerID;
 
 	FontLibrary fontLibrary;
 	CinematicLibrary cinematicLibrary;
@@ -78,10 +79,12 @@ private:
 	BinaryAssetLibrary binaryAssetLibrary;
 	TextAssetLibrary textAssetLibrary;
 	Random random; // Convenience random for ease of use.
-	ScratchAllocator scratchAllocator;
+	FrameAllocator frameAllocator; // Main thread temporaries, reset each frame.
 	Profiler profiler;
 	FPSCounter fpsCounter;
+	FramePacer framePacer;
 	std::string basePath, optionsPath;
+	int traceFramesRemaining; // Frames left to record profiler zones for, or 0 if not tracing.
 	bool requestedSubPanelPop;
 	bool running;
 
@@ -97,6 +100,9 @@ private:
 	// available index.
 	void saveScreenshot(const Surface &surface);
 
+	// Counts down an in-progress profiler trace and writes it to the log folder when done.
+	void updateTrace();
+
 	// Handles any changes in panels after an SDL event or game tick.
 	void handlePanelChanges();
 
@@ -176,12 +182,16 @@ public:
 	// Gets the global RNG initialized at program start.
 	Random &getRandom();
 
-	// Gets the scratch buffer that is reset each frame.
-	ScratchAllocator &getScratchAllocator();
+	// Gets the main thread's allocator for temporaries that only live until the end of the frame.
+	FrameAllocator &getFrameAllocator();
 
 	// Gets the profiler instance for measuring precise time spans.
 	Profiler &getProfiler();
 
+	// Starts recording profiler zones for the given number of frames. The trace is written as a Chrome
+	// trace JSON file in the log folder afterwards.
+	void beginTrace(int frameCount);
+
 	// Gets the frames-per-second counter. This is updated in the game loop.
 	const FPSCounter &getFPSCounter() const;
 
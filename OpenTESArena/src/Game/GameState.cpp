@@ -759,6 +759,11 @@ const ProvinceMapUiModel::TravelData *GameState::getTravelData() const
 	return this->travelData.get();
 }
 
+AutomapTileCache &GameState::getAutomapTileCache()
+{
+	return this->automapTileCache;
+}
+
 const GameState::WeatherList &GameState::getWeathersArray() const
 {
 	return this->weathers;
@@ -13,6 +13,7 @@
 #include "../Assets/BinaryAssetLibrary.h"
 #include "../Entities/EntityManager.h"
 #include "../Entities/Player.h"
+#include "../Interface/AutomapTileCache.h"
 #include "../Interface/ProvinceMapUiModel.h"
 #include "../Math/Random.h"
 #include "../Math/Vector2.h"
@@ -115,6 +116,9 @@ private:
 	// - Effect text: effect on the player (disease, drunk, silence, etc.)
 	double triggerTextRemainingSeconds, actionTextRemainingSeconds, effectTextRemainingSeconds;
 
+	// Rasterized automap chunks, kept between automap openings.
+	AutomapTileCache automapTileCache;
+
 	WeatherList weathers;
 
 	// Custom function for *LEVELUP voxel enter events. If no function is set, the default
@@ -215,6 +219,7 @@ public:
 	ProvinceInstance &getProvinceInstance();
 	LocationInstance &getLocationInstance();
 	const ProvinceMapUiModel::TravelData *getTravelData() const;
+	AutomapTileCache &getAutomapTileCache();
 	const WeatherList &getWeathersArray() const;
 	Date &getDate();
 	Clock &getClock();
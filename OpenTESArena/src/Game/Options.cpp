@@ -27,7 +27,8 @@ namespace
 		{ "LetterboxMode", OptionType::Int },
 		{ "CursorScale", OptionType::Double },
 		{ "ModernInterface", OptionType::Bool },
-		{ "RenderThreadsMode", OptionType::Int }
+		{ "RenderThreadsMode", OptionType::Int },
+		{ "LightTableShading", OptionType::Bool }
 	};
 
 	const std::vector<std::pair<std::string, OptionType>> AudioMappings =
@@ -59,7 +60,9 @@ namespace
 		{ "TimeScale", OptionType::Double },
 		{ "ChunkDistance", OptionType::Int },
 		{ "StarDensity", OptionType::Int },
-		{ "PlayerHasLight", OptionType::Bool }
+		{ "PlayerHasLight", OptionType::Bool },
+		{ "TexturePackCache", OptionType::Bool },
+		{ "WriteLogFile", OptionType::Bool }
 	};
 }
 
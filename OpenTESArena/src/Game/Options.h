@@ -147,6 +147,7 @@ void set##section##_##name(const std::string &value) \
 	OPTION_DOUBLE(Graphics, CursorScale)
 	OPTION_BOOL(Graphics, ModernInterface)
 	OPTION_INT(Graphics, RenderThreadsMode)
+	OPTION_BOOL(Graphics, LightTableShading)
 
 	OPTION_DOUBLE(Audio, MusicVolume)
 	OPTION_DOUBLE(Audio, SoundVolume)
@@ -170,6 +171,8 @@ void set##section##_##name(const std::string &value) \
 	OPTION_INT(Misc, ChunkDistance)
 	OPTION_INT(Misc, StarDensity)
 	OPTION_BOOL(Misc, PlayerHasLight)
+	OPTION_BOOL(Misc, TexturePackCache)
+	OPTION_BOOL(Misc, WriteLogFile)
 
 	// Reads all the key-values pairs from the given absolute path into the default members.
 	void loadDefaults(const std::string &filename);
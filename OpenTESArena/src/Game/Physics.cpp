@@ -23,31 +23,46 @@
 
 namespace Physics
 {
-	// Container of the voxels each entity is touching per chunk. Each chunk needs to look at adjacent chunk
-	// entities in case some of them overlap the chunk edge.
-	struct ChunkEntityMap
+	// An entity touching a voxel in a chunk.
+	struct ChunkEntityMapping
 	{
-		ChunkInt2 chunk;
-		std::unordered_map<VoxelInt3, std::vector<EntityVisibilityState3D>> mappings;
-
-		void init(const ChunkInt2 &chunk)
-		{
-			this->chunk = chunk;
-		}
+		VoxelInt3 voxel;
+		int visStateIndex;
 
-		void add(const VoxelInt3 &voxel, const EntityVisibilityState3D &visState)
+		bool operator<(const ChunkEntityMapping &other) const
 		{
-			auto iter = this->mappings.find(voxel);
-			if (iter == this->mappings.end())
+			if (this->voxel.x != other.voxel.x)
 			{
-				iter = this->mappings.emplace(voxel, std::vector<EntityVisibilityState3D>()).first;
+				return this->voxel.x < other.voxel.x;
+			}
+			else if (this->voxel.y != other.voxel.y)
+			{
+				return this->voxel.y < other.voxel.y;
+			}
+			else
+			{
+				return this->voxel.z < other.voxel.z;
 			}
-
-			std::vector<EntityVisibilityState3D> &visStateList = iter->second;
-			visStateList.emplace_back(visState);
 		}
 	};
 
+	// Container of the voxels each entity is touching per chunk. Each chunk needs to look at adjacent chunk
+	// entities in case some of them overlap the chunk edge. Allocated from the frame allocator and sorted
+	// by voxel so a ray cast doesn't make any heap allocations.
+	struct ChunkEntityMap
+	{
+		ChunkInt2 chunk;
+		BufferView<EntityVisibilityState3D> visStates;
+		BufferView<ChunkEntityMapping> mappings;
+	};
+
+	// Chunk entity maps made so far by a ray cast.
+	struct ChunkEntityMapList
+	{
+		BufferView<ChunkEntityMap> maps;
+		int count;
+	};
+
 	// Converts the normal to the associated voxel facing on success. Not all conversions
 	// exist, for example, diagonals have normals but do not have a voxel facing.
 	bool tryGetFacingFromNormal(const NewDouble3 &normal, VoxelFacing3D *outFacing)
@@ -93,7 +108,7 @@ namespace Physics
 	// is needed for evaluating entity animations. Ignores entities behind the camera.
 	Physics::ChunkEntityMap makeChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
 		double ceilingScale, const ChunkManager &chunkManager, const EntityManager &entityManager,
-		const EntityDefinitionLibrary &entityDefLibrary)
+		const EntityDefinitionLibrary &entityDefLibrary, FrameAllocator &frameAllocator)
 	{
 		// Include entities within one chunk of the center chunk to get entities that are partially touching
 		// the center chunk.
@@ -116,8 +131,7 @@ namespace Physics
 			return count;
 		}();
 
-		Buffer<const Entity*> entities(totalNearbyEntities);
-		entities.fill(nullptr);
+		BufferView<const Entity*> entities = frameAllocator.alloc<const Entity*>(totalNearbyEntities, nullptr);
 
 		int entityInsertIndex = 0;
 		auto addEntitiesFromChunk = [&entityManager, &entities, &entityInsertIndex](SNInt chunkX, WEInt chunkZ)
@@ -138,21 +152,51 @@ namespace Physics
 		}
 
 		ChunkEntityMap chunkEntityMap;
-		chunkEntityMap.init(chunk);
+		chunkEntityMap.chunk = chunk;
+		chunkEntityMap.visStates = frameAllocator.alloc<EntityVisibilityState3D>(entityInsertIndex);
+
+		// Voxel range each entity's bounding box touches.
+		BufferView<CoordInt3> minVoxelCoords = frameAllocator.alloc<CoordInt3>(entityInsertIndex);
+		BufferView<VoxelInt3> voxelCoordDiffs = frameAllocator.alloc<VoxelInt3>(entityInsertIndex);
 
-		// Build mappings of voxels to entities.
-		for (int i = 0; i < entities.getCount(); i++)
+		// Iterates over the voxels in the center chunk touched by an entity.
+		auto forEachVoxelInChunk = [&chunk, &minVoxelCoords, &voxelCoordDiffs](int visStateIndex,
+			const auto &func)
 		{
-			const Entity *entityPtr = entities.get(i);
-			if (entityPtr == nullptr)
+			const CoordInt3 &minVoxelCoord = minVoxelCoords.get(visStateIndex);
+			const VoxelInt3 &voxelCoordDiff = voxelCoordDiffs.get(visStateIndex);
+			for (WEInt z = 0; z <= voxelCoordDiff.z; z++)
 			{
-				continue;
+				for (int y = 0; y <= voxelCoordDiff.y; y++)
+				{
+					for (SNInt x = 0; x <= voxelCoordDiff.x; x++)
+					{
+						const VoxelInt3 curVoxel(
+							minVoxelCoord.voxel.x + x,
+							minVoxelCoord.voxel.y + y,
+							minVoxelCoord.voxel.z + z);
+						const CoordInt3 curCoord = ChunkUtils::recalculateCoord(minVoxelCoord.chunk, curVoxel);
+
+						// If it's in the center chunk, it gets a mapping.
+						if (curCoord.chunk == chunk)
+						{
+							func(curCoord.voxel);
+						}
+					}
+				}
 			}
+		};
 
+		// Get each entity's visibility state and the voxels it touches.
+		int mappingCount = 0;
+		for (int i = 0; i < entityInsertIndex; i++)
+		{
+			const Entity *entityPtr = entities.get(i);
+			DebugAssert(entityPtr != nullptr);
 			const Entity &entity = *entityPtr;
 
 			const CoordDouble2 viewCoordXZ(viewCoord.chunk, VoxelDouble2(viewCoord.point.x, viewCoord.point.z));
-			EntityVisibilityState3D visState;
+			EntityVisibilityState3D &visState = chunkEntityMap.visStates.get(i);
 			entityManager.getEntityVisibilityState3D(entity, viewCoordXZ, ceilingScale, chunkManager,
 				entityDefLibrary, visState);
 
@@ -168,51 +212,53 @@ namespace Physics
 			// Get min and max coordinates in chunk space and get the difference for iteration.
 			const CoordInt3 minVoxelCoord(minCoord.chunk, VoxelUtils::pointToVoxel(minPoint));
 			const CoordInt3 maxVoxelCoord(maxCoord.chunk, VoxelUtils::pointToVoxel(maxPoint));
-			const VoxelInt3 voxelCoordDiff = maxVoxelCoord - minVoxelCoord;
+			minVoxelCoords.set(i, minVoxelCoord);
+			voxelCoordDiffs.set(i, maxVoxelCoord - minVoxelCoord);
 
-			// Iterate over the voxels the entity's bounding box touches.
-			for (WEInt z = 0; z <= voxelCoordDiff.z; z++)
-			{
-				for (int y = 0; y <= voxelCoordDiff.y; y++)
-				{
-					for (SNInt x = 0; x <= voxelCoordDiff.x; x++)
-					{
-						const VoxelInt3 curVoxel(
-							minVoxelCoord.voxel.x + x,
-							minVoxelCoord.voxel.y + y,
-							minVoxelCoord.voxel.z + z);
-						const CoordInt3 curCoord = ChunkUtils::recalculateCoord(minVoxelCoord.chunk, curVoxel);
+			forEachVoxelInChunk(i, [&mappingCount](const VoxelInt3&) { mappingCount++; });
+		}
 
-						// If it's in the center chunk, add a mapping.
-						if (curCoord.chunk == chunk)
-						{
-							chunkEntityMap.add(curCoord.voxel, visState);
-						}
-					}
-				}
-			}
+		// Build mappings of voxels to entities, sorted by voxel for look-ups.
+		chunkEntityMap.mappings = frameAllocator.alloc<ChunkEntityMapping>(mappingCount);
+
+		int mappingInsertIndex = 0;
+		for (int i = 0; i < entityInsertIndex; i++)
+		{
+			forEachVoxelInChunk(i, [&chunkEntityMap, &mappingInsertIndex, i](const VoxelInt3 &voxel)
+			{
+				ChunkEntityMapping &mapping = chunkEntityMap.mappings.get(mappingInsertIndex);
+				mapping.voxel = voxel;
+				mapping.visStateIndex = i;
+				mappingInsertIndex++;
+			});
 		}
 
+		DebugAssert(mappingInsertIndex == mappingCount);
+		std::stable_sort(chunkEntityMap.mappings.get(), chunkEntityMap.mappings.end());
+
 		return chunkEntityMap;
 	}
 
 	// The given chunk coordinate is known to be loaded.
 	const ChunkEntityMap &getOrAddChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
 		double ceilingScale, const ChunkManager &chunkManager, const EntityManager &entityManager,
-		const EntityDefinitionLibrary &entityDefLibrary, std::vector<ChunkEntityMap> &chunkEntityMaps)
+		const EntityDefinitionLibrary &entityDefLibrary, FrameAllocator &frameAllocator,
+		ChunkEntityMapList &chunkEntityMaps)
 	{
-		for (const ChunkEntityMap &map : chunkEntityMaps)
+		for (int i = 0; i < chunkEntityMaps.count; i++)
 		{
+			const ChunkEntityMap &map = chunkEntityMaps.maps.get(i);
 			if (map.chunk == chunk)
 			{
 				return map;
 			}
 		}
 
-		ChunkEntityMap newMap = Physics::makeChunkEntityMap(chunk, viewCoord, ceilingScale, chunkManager,
-			entityManager, entityDefLibrary);
-		chunkEntityMaps.emplace_back(std::move(newMap));
-		return chunkEntityMaps.back();
+		ChunkEntityMap &newMap = chunkEntityMaps.maps.get(chunkEntityMaps.count);
+		newMap = Physics::makeChunkEntityMap(chunk, viewCoord, ceilingScale, chunkManager, entityManager,
+			entityDefLibrary, frameAllocator);
+		chunkEntityMaps.count++;
+		return newMap;
 	}
 
 	// Checks an initial voxel for ray hits and writes them into the output parameter.
@@ -1012,32 +1058,32 @@ namespace Physics
 		Physics::Hit entityHit;
 		entityHit.setT(Hit::MAX_T);
 
-		const auto &entityMappings = chunkEntityMap.mappings;
-		const auto iter = entityMappings.find(voxel);
-		if (iter != entityMappings.end())
+		ChunkEntityMapping searchMapping;
+		searchMapping.voxel = voxel;
+		const BufferView<ChunkEntityMapping> &entityMappings = chunkEntityMap.mappings;
+		const auto range = std::equal_range(entityMappings.get(), entityMappings.end(), searchMapping);
+
+		// Iterate over all the entities that cross this voxel and ray test them.
+		for (const ChunkEntityMapping *mapping = range.first; mapping != range.second; ++mapping)
 		{
-			// Iterate over all the entities that cross this voxel and ray test them.
-			const std::vector<EntityVisibilityState3D> &entityVisStateList = iter->second;
-			for (const EntityVisibilityState3D &visState : entityVisStateList)
-			{
-				const Entity &entity = *visState.entity;
-				const EntityDefinition &entityDef = entityManager.getEntityDef(
-					entity.getDefinitionID(), entityDefLibrary);
-				const EntityAnimationDefinition::Keyframe &animKeyframe =
-					entityManager.getEntityAnimKeyframe(entity, visState, entityDefLibrary);
-
-				const double flatWidth = animKeyframe.getWidth();
-				const double flatHeight = animKeyframe.getHeight();
-
-				CoordDouble3 hitCoord;
-				if (renderer.getEntityRayIntersection(visState, entityDef, flatForward, flatRight, flatUp,
-					flatWidth, flatHeight, rayCoord, rayDirection, pixelPerfect, palette, &hitCoord))
+			const EntityVisibilityState3D &visState = chunkEntityMap.visStates.get(mapping->visStateIndex);
+			const Entity &entity = *visState.entity;
+			const EntityDefinition &entityDef = entityManager.getEntityDef(
+				entity.getDefinitionID(), entityDefLibrary);
+			const EntityAnimationDefinition::Keyframe &animKeyframe =
+				entityManager.getEntityAnimKeyframe(entity, visState, entityDefLibrary);
+
+			const double flatWidth = animKeyframe.getWidth();
+			const double flatHeight = animKeyframe.getHeight();
+
+			CoordDouble3 hitCoord;
+			if (renderer.getEntityRayIntersection(visState, entityDef, flatForward, flatRight, flatUp,
+				flatWidth, flatHeight, rayCoord, rayDirection, pixelPerfect, palette, &hitCoord))
+			{
+				const double distance = (hitCoord - rayCoord).length();
+				if (distance < entityHit.getT())
 				{
-					const double distance = (hitCoord - rayCoord).length();
-					if (distance < entityHit.getT())
-					{
-						entityHit.initEntity(distance, hitCoord, entity.getID(), entity.getEntityType());
-					}
+					entityHit.initEntity(distance, hitCoord, entity.getID(), entity.getEntityType());
 				}
 			}
 		}
@@ -1060,7 +1106,8 @@ namespace Physics
 	void rayCastInternal(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection,
 		const VoxelDouble3 &cameraForward, double ceilingScale, const LevelInstance &levelInst, bool pixelPerfect,
 		bool includeEntities, const Palette &palette, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, std::vector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
+		const Renderer &renderer, FrameAllocator &frameAllocator, ChunkEntityMapList &chunkEntityMaps,
+		Physics::Hit &hit)
 	{
 		const ChunkManager &chunkManager = levelInst.getChunkManager();
 		const EntityManager &entityManager = levelInst.getEntityManager();
@@ -1177,7 +1224,7 @@ namespace Physics
 			{
 				// Test the initial voxel's entities for ray intersections.
 				const ChunkEntityMap &chunkEntityMap = Physics::getOrAddChunkEntityMap(currentChunk, rayCoord,
-					ceilingScale, chunkManager, entityManager, entityDefLibrary, chunkEntityMaps);
+					ceilingScale, chunkManager, entityManager, entityDefLibrary, frameAllocator, chunkEntityMaps);
 				success |= Physics::testEntitiesInVoxel(rayCoord, rayDirection, flatForward, flatRight, flatUp,
 					rayVoxel, chunkEntityMap, pixelPerfect, palette, entityManager, entityDefLibrary, renderer, hit);
 			}
@@ -1319,7 +1366,7 @@ namespace Physics
 			{
 				// Test the current voxel's entities for ray intersections.
 				const ChunkEntityMap &chunkEntityMap = Physics::getOrAddChunkEntityMap(savedVoxelCoord.chunk, rayCoord,
-					ceilingScale, chunkManager, entityManager, entityDefLibrary, chunkEntityMaps);
+					ceilingScale, chunkManager, entityManager, entityDefLibrary, frameAllocator, chunkEntityMaps);
 				success |= Physics::testEntitiesInVoxel(rayCoord, rayDirection, flatForward, flatRight, flatUp,
 					savedVoxelCoord.voxel, chunkEntityMap, pixelPerfect, palette, entityManager, entityDefLibrary,
 					renderer, hit);
@@ -1402,14 +1449,24 @@ void Physics::Hit::setT(double t)
 bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
 	const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
 	const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary,
-	const Renderer &renderer, Physics::Hit &hit)
+	const Renderer &renderer, FrameAllocator &frameAllocator, Physics::Hit &hit)
 {
 	// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
 	// entity, the distance can still be used.
 	hit.setT(Hit::MAX_T);
 
-	// Voxel->entity mappings for each chunk touched by the ray casting loop.
-	std::vector<ChunkEntityMap> chunkEntityMaps;
+	// Everything allocated by the ray cast is released when it's done.
+	const FrameAllocator::Marker frameAllocatorMarker = frameAllocator.getMarker();
+
+	// Voxel->entity mappings for each chunk touched by the ray casting loop. A ray can only test
+	// entities in loaded chunks.
+	ChunkEntityMapList chunkEntityMaps;
+	chunkEntityMaps.count = 0;
+	if (includeEntities)
+	{
+		const int chunkCount = levelInst.getChunkManager().getChunkCount();
+		chunkEntityMaps.maps = frameAllocator.alloc<ChunkEntityMap>(chunkCount);
+	}
 
 	// Ray cast through the voxel grid, populating the output hit data. Use the ray direction booleans for
 	// better code generation (at the expense of having a pile of if/else branches here).
@@ -1424,14 +1481,14 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 			if (nonNegativeDirZ)
 			{
 				Physics::rayCastInternal<true, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 			else
 			{
 				Physics::rayCastInternal<true, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 		}
 		else
@@ -1439,14 +1496,14 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 			if (nonNegativeDirZ)
 			{
 				Physics::rayCastInternal<true, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 			else
 			{
 				Physics::rayCastInternal<true, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 		}
 	}
@@ -1457,14 +1514,14 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 			if (nonNegativeDirZ)
 			{
 				Physics::rayCastInternal<false, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 			else
 			{
 				Physics::rayCastInternal<false, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 		}
 		else
@@ -1472,18 +1529,20 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 			if (nonNegativeDirZ)
 			{
 				Physics::rayCastInternal<false, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 			else
 			{
 				Physics::rayCastInternal<false, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, chunkEntityMaps,
-					hit);
+					levelInst, pixelPerfect, includeEntities, palette, entityDefLibrary, renderer, frameAllocator,
+					chunkEntityMaps, hit);
 			}
 		}
 	}
 
+	frameAllocator.rewind(frameAllocatorMarker);
+
 	// Return whether the ray hit something.
 	return hit.getT() < Hit::MAX_T;
 }
@@ -1491,9 +1550,9 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection,
 	const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
 	const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer,
-	Physics::Hit &hit)
+	FrameAllocator &frameAllocator, Physics::Hit &hit)
 {
 	constexpr double ceilingScale = 1.0;
 	return Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraForward, pixelPerfect, palette,
-		includeEntities, levelInst, entityDefLibrary, renderer, hit);
+		includeEntities, levelInst, entityDefLibrary, renderer, frameAllocator, hit);
 }
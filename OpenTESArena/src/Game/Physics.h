@@ -13,6 +13,8 @@
 #include "../World/VoxelDefinition.h"
 #include "../World/VoxelUtils.h"
 
+#include "components/utilities/Allocator.h"
+
 // Namespace for physics-related calculations like ray casting.
 
 class LevelInstance;
@@ -65,14 +67,16 @@ namespace Physics
 	// @todo: bit mask elements for each voxel data type.
 
 	// Casts a ray through the world and writes any intersection data into the output parameter. Returns true
-	// if the ray hit something.
+	// if the ray hit something. Temporary data is allocated from the given frame allocator and released
+	// before returning.
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
 		const VoxelDouble3 &cameraForward, bool pixelPerfect, const Palette &palette, bool includeEntities,
 		const LevelInstance &levelInst, const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer,
-		Physics::Hit &hit);
+		FrameAllocator &frameAllocator, Physics::Hit &hit);
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, const VoxelDouble3 &cameraForward,
 		bool pixelPerfect, const Palette &palette, bool includeEntities, const LevelInstance &levelInst,
-		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit);
+		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, FrameAllocator &frameAllocator,
+		Physics::Hit &hit);
 };
 
 #endif
@@ -200,6 +200,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 
 		AudioManager &audioManager = game.getAudioManager();
 		audioManager.setMusic(musicDef, jingleMusicDef);
+		MapLogicController::prerenderLikelyMusic(game);
 	}
 	else
 	{
@@ -270,6 +271,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 
 			AudioManager &audioManager = game.getAudioManager();
 			audioManager.setMusic(musicDef);
+			MapLogicController::prerenderLikelyMusic(game);
 		}
 		else if (transitionType == TransitionType::CityGate)
 		{
@@ -455,6 +457,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 
 			AudioManager &audioManager = game.getAudioManager();
 			audioManager.setMusic(musicDef, jingleMusicDef);
+			MapLogicController::prerenderLikelyMusic(game);
 		}
 		else
 		{
@@ -664,3 +667,35 @@ void MapLogicController::handleLevelTransition(Game &game, const CoordInt3 &play
 		}
 	}
 }
+
+void MapLogicController::prerenderLikelyMusic(Game &game)
+{
+	const GameState &gameState = game.getGameState();
+	const MapType mapType = gameState.getActiveMapDef().getMapType();
+	const bool isNight = gameState.nightMusicIsActive();
+	const bool nextIsNight = (mapType == MapType::Interior) ? isNight : !isNight;
+
+	// Which song of the type gets picked is random, so render all of them. There are only a few per type.
+	const MusicDefinition::Type musicType = nextIsNight ? MusicDefinition::Type::Night : MusicDefinition::Type::Weather;
+	const WeatherDefinition &weatherDef = gameState.getWeatherDefinition();
+	const MusicLibrary &musicLibrary = game.getMusicLibrary();
+	AudioManager &audioManager = game.getAudioManager();
+
+	const int musicDefCount = musicLibrary.getMusicDefinitionCount(musicType);
+	for (int i = 0; i < musicDefCount; i++)
+	{
+		const MusicDefinition *musicDef = musicLibrary.getMusicDefinition(musicType, i);
+		DebugAssert(musicDef != nullptr);
+
+		if (musicType == MusicDefinition::Type::Weather)
+		{
+			const auto &weatherMusicDef = musicDef->getWeatherMusicDefinition();
+			if (!(weatherMusicDef.weatherDef == weatherDef))
+			{
+				continue;
+			}
+		}
+
+		audioManager.prerenderMusic(*musicDef);
+	}
+}
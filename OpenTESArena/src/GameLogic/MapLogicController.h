@@ -23,6 +23,10 @@ namespace MapLogicController
 	// Checks the given transition voxel to see if it's a level transition (i.e., level up/down), and changes
 	// the current level if it is.
 	void handleLevelTransition(Game &game, const CoordInt3 &playerCoord, const CoordInt3 &transitionCoord);
+
+	// Pre-renders the music most likely to play next: the other time of day's music in an exterior, or
+	// the current time of day's exterior music in an interior.
+	void prerenderLikelyMusic(Game &game);
 }
 
 #endif
@@ -469,7 +469,7 @@ void PlayerLogicController::handlePlayerAttack(Game &game, const Int2 &mouseDelt
 				}
 
 				// Play the swing sound.
-				audioManager.playSound(ArenaSoundName::Swish);
+				audioManager.playSound(ArenaSoundName::Swish, std::nullopt, AudioManager::SoundCategory::Combat);
 			}
 		}
 		else
@@ -515,7 +515,7 @@ void PlayerLogicController::handlePlayerAttack(Game &game, const Int2 &mouseDelt
 				weaponAnimation.setState(WeaponAnimation::State::Firing);
 
 				// Play the firing sound.
-				audioManager.playSound(ArenaSoundName::ArrowFire);
+				audioManager.playSound(ArenaSoundName::ArrowFire, std::nullopt, AudioManager::SoundCategory::Combat);
 			}
 		}
 	}
@@ -556,7 +556,7 @@ void PlayerLogicController::handleScreenToWorldInteraction(Game &game, const Int
 	Physics::Hit hit;
 	const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
 		pixelPerfectSelection, palette, includeEntities, levelInst, game.getEntityDefinitionLibrary(),
-		game.getRenderer(), hit);
+		game.getRenderer(), game.getFrameAllocator(), hit);
 
 	// See if the ray hit anything.
 	if (success)
@@ -77,6 +77,10 @@ namespace
 				InputActionName::DebugProfiler,
 				InputStateType::BeginPerform,
 				SDLK_F4));
+			defs.emplace_back(makeKeyDef(
+				InputActionName::DebugTrace,
+				InputStateType::BeginPerform,
+				SDLK_F6));
 
 			// Going to keep scroll up/down as pointer events since scrollable UI things need the pointer over them.
 		}
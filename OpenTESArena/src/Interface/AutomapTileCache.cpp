@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <vector>
+
+#include "AutomapTileCache.h"
+#include "AutomapUiView.h"
+#include "../World/Chunk.h"
+
+#include "components/debug/Debug.h"
+
+AutomapTileCache::AutomapTileCache()
+{
+	this->isWild = false;
+	this->useIndex = 0;
+}
+
+void AutomapTileCache::beginAutomap(bool isWild, const LevelInt2 &levelDims)
+{
+	if ((isWild != this->isWild) || (levelDims != this->levelDims))
+	{
+		this->tiles.clear();
+		this->isWild = isWild;
+		this->levelDims = levelDims;
+	}
+
+	this->useIndex++;
+}
+
+const Buffer2D<uint32_t> &AutomapTileCache::getTile(const Chunk &chunk)
+{
+	const ChunkInt2 &chunkPos = chunk.getCoord();
+	const uint64_t chunkRevision = chunk.getRevision();
+
+	auto iter = this->tiles.find(chunkPos);
+	if (iter == this->tiles.end())
+	{
+		Tile tile;
+		tile.texels.init(AutomapUiView::TileDim, AutomapUiView::TileDim);
+		AutomapUiView::rasterizeChunk(chunk, this->isWild, this->levelDims, tile.texels);
+		tile.chunkRevision = chunkRevision;
+		iter = this->tiles.emplace(chunkPos, std::move(tile)).first;
+	}
+	else if (iter->second.chunkRevision != chunkRevision)
+	{
+		// Chunk voxels changed since this tile was drawn (or it's a different chunk at the same position).
+		Tile &tile = iter->second;
+		AutomapUiView::rasterizeChunk(chunk, this->isWild, this->levelDims, tile.texels);
+		tile.chunkRevision = chunkRevision;
+	}
+
+	Tile &tile = iter->second;
+	tile.lastUsedIndex = this->useIndex;
+	return tile.texels;
+}
+
+void AutomapTileCache::endAutomap()
+{
+	const int tileCount = static_cast<int>(this->tiles.size());
+	if (tileCount <= AutomapTileCache::MAX_TILES)
+	{
+		return;
+	}
+
+	std::vector<std::pair<int, ChunkInt2>> usedIndices;
+	usedIndices.reserve(tileCount);
+	for (const auto &pair : this->tiles)
+	{
+		usedIndices.emplace_back(pair.second.lastUsedIndex, pair.first);
+	}
+
+	const int removeCount = tileCount - AutomapTileCache::MAX_TILES;
+	std::nth_element(usedIndices.begin(), usedIndices.begin() + removeCount, usedIndices.end(),
+		[](const auto &a, const auto &b) { return a.first < b.first; });
+
+	for (int i = 0; i < removeCount; i++)
+	{
+		this->tiles.erase(usedIndices[i].second);
+	}
+}
+
+void AutomapTileCache::clear()
+{
+	this->tiles.clear();
+	this->isWild = false;
+	this->levelDims = LevelInt2();
+	this->useIndex = 0;
+}
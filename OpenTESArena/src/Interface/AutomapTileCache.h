@@ -0,0 +1,53 @@
+#ifndef AUTOMAP_TILE_CACHE_H
+#define AUTOMAP_TILE_CACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "../World/Coord.h"
+
+#include "components/utilities/Buffer2D.h"
+
+class Chunk;
+
+// Rasterized automap images of chunks, kept between automap openings so only chunks that are new or
+// have changed since the last opening need to be drawn again. Tiles are in automap orientation
+// (mirrored, +X down) and are copied into the automap texture by their position relative to the player.
+
+class AutomapTileCache
+{
+private:
+	struct Tile
+	{
+		Buffer2D<uint32_t> texels;
+		uint64_t chunkRevision;
+		int lastUsedIndex;
+	};
+
+	// Max number of tiles to keep before the least recently used ones are freed.
+	static constexpr int MAX_TILES = 25;
+
+	std::unordered_map<ChunkInt2, Tile> tiles;
+
+	// Tiles depend on the map type and level bounds, so they are thrown out when these change.
+	bool isWild;
+	LevelInt2 levelDims;
+
+	int useIndex; // Incremented every time the automap is made.
+public:
+	AutomapTileCache();
+
+	// Prepares the cache for making an automap of the given level. Clears all tiles if they were
+	// rasterized for a different level shape.
+	void beginAutomap(bool isWild, const LevelInt2 &levelDims);
+
+	// Gets the automap tile for the chunk, rasterizing it if the chunk isn't cached or has changed.
+	const Buffer2D<uint32_t> &getTile(const Chunk &chunk);
+
+	// Frees the least recently used tiles if there are too many.
+	void endAutomap();
+
+	void clear();
+};
+
+#endif
@@ -1,3 +1,6 @@
+#include <algorithm>
+
+#include "AutomapTileCache.h"
 #include "AutomapUiView.h"
 #include "../Assets/ArenaTextureName.h"
 #include "../Assets/ArenaTypes.h"
@@ -297,37 +300,23 @@ const Color &AutomapUiView::getWildPixelColor(const VoxelDefinition &floorDef, c
 	}
 }
 
-Buffer2D<uint32_t> AutomapUiView::makeAutomap(const CoordInt2 &playerCoord, CardinalDirectionName playerCompassDir,
-	bool isWild, const LevelInt2 &levelDims, const ChunkManager &chunkManager)
+void AutomapUiView::rasterizeChunk(const Chunk &chunk, bool isWild, const LevelInt2 &levelDims, Buffer2D<uint32_t> &outTile)
 {
-	// Create scratch surface triple the size of the voxel area so that all directions of the player's arrow
-	// are representable in the same texture. This may change in the future for memory optimization.
-	constexpr int automapDim = ChunkUtils::CHUNK_DIM * ((AutomapUiView::ChunkDistance * 2) + 1);
-	constexpr int surfaceDim = automapDim * AutomapUiView::PixelSize;
-	Buffer2D<uint32_t> dstBuffer(surfaceDim, surfaceDim);
+	DebugAssert(outTile.getWidth() == AutomapUiView::TileDim);
+	DebugAssert(outTile.getHeight() == AutomapUiView::TileDim);
 
-	// Fill with transparent color first (used by floor voxels).
 	const Color &floorColor = AutomapUiView::ColorFloor;
-	dstBuffer.fill(floorColor.toARGB());
-
-	const ChunkInt2 &playerChunk = playerCoord.chunk;
-	ChunkInt2 minChunk, maxChunk;
-	ChunkUtils::getSurroundingChunks(playerChunk, AutomapUiView::ChunkDistance, &minChunk, &maxChunk);
+	const ChunkInt2 &chunkPos = chunk.getCoord();
+	uint32_t *pixels = outTile.get();
 
-	// Lambda for filling in a chunk voxel in the map surface.
-	auto drawSquare = [&dstBuffer, &minChunk, &maxChunk](const CoordInt2 &coord, const Color &color)
+	// Lambda for filling in a chunk voxel in the tile.
+	auto drawSquare = [pixels](SNInt x, WEInt z, const Color &color)
 	{
-		// The min chunk origin is at the top right corner of the texture. +X is south, +Z is west
-		// (strangely, flipping the horizontal coordinate here does not mirror the resulting texture,
-		// therefore the mirroring is done in the pixel drawing loop).
-		const int automapX = ((coord.chunk.y - minChunk.y) * ChunkUtils::CHUNK_DIM) + coord.voxel.y;
-		const int automapY = ((coord.chunk.x - minChunk.x) * ChunkUtils::CHUNK_DIM) + coord.voxel.x;
-
-		const int surfaceWidth = dstBuffer.getWidth();
-		const int xOffset = automapX * AutomapUiView::PixelSize;
-		const int yOffset = automapY * AutomapUiView::PixelSize;
+		// +X is south (down), +Z is west. The horizontal coordinate is mirrored here since flipping it
+		// in texture coordinates does not mirror the resulting texture.
+		const int xOffset = z * AutomapUiView::PixelSize;
+		const int yOffset = x * AutomapUiView::PixelSize;
 		const uint32_t colorARGB = color.toARGB();
-		uint32_t *pixels = dstBuffer.get();
 
 		for (int h = 0; h < AutomapUiView::PixelSize; h++)
 		{
@@ -335,13 +324,63 @@ Buffer2D<uint32_t> AutomapUiView::makeAutomap(const CoordInt2 &playerCoord, Card
 			for (int w = 0; w < AutomapUiView::PixelSize; w++)
 			{
 				const int xCoord = xOffset + w;
-				const int index = (surfaceWidth - xCoord - 1) + (yCoord * surfaceWidth);
+				const int index = (AutomapUiView::TileDim - xCoord - 1) + (yCoord * AutomapUiView::TileDim);
 				pixels[index] = colorARGB;
 			}
 		}
 	};
 
-	// Fill in squares on the automap.
+	for (SNInt x = 0; x < ChunkUtils::CHUNK_DIM; x++)
+	{
+		for (WEInt z = 0; z < ChunkUtils::CHUNK_DIM; z++)
+		{
+			const Chunk::VoxelID floorVoxelID = chunk.getVoxel(x, 0, z);
+			const Chunk::VoxelID wallVoxelID = chunk.getVoxel(x, 1, z);
+			const VoxelDefinition &floorVoxelDef = chunk.getVoxelDef(floorVoxelID);
+			const VoxelDefinition &wallVoxelDef = chunk.getVoxelDef(wallVoxelID);
+			const TransitionDefinition *transitionDef = chunk.tryGetTransition(VoxelInt3(x, 1, z));
+
+			// Decide which color to use for the automap pixel.
+			Color color;
+			if (isWild)
+			{
+				color = AutomapUiView::getWildPixelColor(floorVoxelDef, wallVoxelDef, transitionDef);
+			}
+			else
+			{
+				// @todo: make a coord-to-level-voxel function for this
+				const LevelInt2 levelPos(
+					(chunkPos.x * ChunkUtils::CHUNK_DIM) + x,
+					(chunkPos.y * ChunkUtils::CHUNK_DIM) + z);
+				const bool isInsideLevelBounds = (chunkPos.x >= 0) && (chunkPos.y >= 0) && (levelPos.x < levelDims.x) && (levelPos.y < levelDims.y);
+
+				if (isInsideLevelBounds)
+				{
+					color = AutomapUiView::getPixelColor(floorVoxelDef, wallVoxelDef, transitionDef);
+				}
+				else
+				{
+					color = floorColor;
+				}
+			}
+
+			drawSquare(x, z, color);
+		}
+	}
+}
+
+void AutomapUiView::makeAutomap(const CoordInt2 &playerCoord, CardinalDirectionName playerCompassDir, bool isWild,
+	const LevelInt2 &levelDims, const ChunkManager &chunkManager, AutomapTileCache &tileCache, uint32_t *outTexels)
+{
+	constexpr int surfaceDim = AutomapUiView::TextureDim;
+
+	const ChunkInt2 &playerChunk = playerCoord.chunk;
+	ChunkInt2 minChunk, maxChunk;
+	ChunkUtils::getSurroundingChunks(playerChunk, AutomapUiView::ChunkDistance, &minChunk, &maxChunk);
+
+	// Copy each chunk's tile into the texture. Only new or changed chunks are rasterized again. The min chunk
+	// origin is at the top right corner of the texture. +X is south, +Z is west.
+	tileCache.beginAutomap(isWild, levelDims);
 	for (SNInt chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
 	{
 		for (WEInt chunkZ = minChunk.y; chunkZ <= maxChunk.y; chunkZ++)
@@ -350,61 +389,35 @@ Buffer2D<uint32_t> AutomapUiView::makeAutomap(const CoordInt2 &playerCoord, Card
 			const Chunk *chunk = chunkManager.tryGetChunk(chunkPos);
 			DebugAssert(chunk != nullptr);
 
-			for (SNInt x = 0; x < ChunkUtils::CHUNK_DIM; x++)
+			const Buffer2D<uint32_t> &tile = tileCache.getTile(*chunk);
+			const uint32_t *srcTexels = tile.get();
+			const int dstX = surfaceDim - (((chunkZ - minChunk.y) + 1) * AutomapUiView::TileDim);
+			const int dstY = (chunkX - minChunk.x) * AutomapUiView::TileDim;
+
+			for (int y = 0; y < AutomapUiView::TileDim; y++)
 			{
-				for (WEInt z = 0; z < ChunkUtils::CHUNK_DIM; z++)
-				{
-					const Chunk::VoxelID floorVoxelID = chunk->getVoxel(x, 0, z);
-					const Chunk::VoxelID wallVoxelID = chunk->getVoxel(x, 1, z);
-					const VoxelDefinition &floorVoxelDef = chunk->getVoxelDef(floorVoxelID);
-					const VoxelDefinition &wallVoxelDef = chunk->getVoxelDef(wallVoxelID);
-					const TransitionDefinition *transitionDef = chunk->tryGetTransition(VoxelInt3(x, 1, z));
-
-					// Decide which color to use for the automap pixel.
-					Color color;
-					if (isWild)
-					{
-						color = AutomapUiView::getWildPixelColor(floorVoxelDef, wallVoxelDef, transitionDef);
-					}
-					else
-					{
-						// @todo: make a coord-to-level-voxel function for this
-						const LevelInt2 levelPos(
-							(chunkPos.x * ChunkUtils::CHUNK_DIM) + x,
-							(chunkPos.y * ChunkUtils::CHUNK_DIM) + z);
-						const bool isInsideLevelBounds = (chunkX >= 0) && (chunkZ >= 0) && (levelPos.x < levelDims.x) && (levelPos.y < levelDims.y);
-
-						if (isInsideLevelBounds)
-						{
-							color = AutomapUiView::getPixelColor(floorVoxelDef, wallVoxelDef, transitionDef);
-						}
-						else
-						{
-							color = floorColor;
-						}
-					}
-
-					drawSquare(CoordInt2(chunkPos, VoxelInt2(x, z)), color);
-				}
+				const uint32_t *srcRow = srcTexels + (y * AutomapUiView::TileDim);
+				uint32_t *dstRow = outTexels + dstX + ((dstY + y) * surfaceDim);
+				std::copy(srcRow, srcRow + AutomapUiView::TileDim, dstRow);
 			}
 		}
 	}
 
+	tileCache.endAutomap();
+
 	// Lambda for drawing the player's arrow in the automap. It's drawn differently 
 	// depending on their direction.
-	auto drawPlayer = [&dstBuffer](SNInt x, WEInt z, CardinalDirectionName cardinalDirection)
+	auto drawPlayer = [outTexels](SNInt x, WEInt z, CardinalDirectionName cardinalDirection)
 	{
-		const int surfaceX = dstBuffer.getWidth() - AutomapUiView::PixelSize - (z * AutomapUiView::PixelSize);
+		const int surfaceX = surfaceDim - AutomapUiView::PixelSize - (z * AutomapUiView::PixelSize);
 		const int surfaceY = x * AutomapUiView::PixelSize;
 
-		uint32_t *pixels = dstBuffer.get();
-
 		// Draw the player's arrow within the map pixel.
 		const std::vector<Int2> &offsets = AutomapUiView::PlayerArrowPatterns.at(cardinalDirection);
 		for (const auto &offset : offsets)
 		{
-			const int index = (surfaceX + offset.x) + ((surfaceY + offset.y) * dstBuffer.getWidth());
-			pixels[index] = AutomapUiView::ColorPlayer.toARGB();
+			const int index = (surfaceX + offset.x) + ((surfaceY + offset.y) * surfaceDim);
+			outTexels[index] = AutomapUiView::ColorPlayer.toARGB();
 		}
 	};
 
@@ -412,11 +425,9 @@ Buffer2D<uint32_t> AutomapUiView::makeAutomap(const CoordInt2 &playerCoord, Card
 	const SNInt playerLocalX = (AutomapUiView::ChunkDistance * ChunkUtils::CHUNK_DIM) + playerCoord.voxel.x;
 	const WEInt playerLocalZ = (AutomapUiView::ChunkDistance * ChunkUtils::CHUNK_DIM) + playerCoord.voxel.y;
 	drawPlayer(playerLocalX, playerLocalZ, playerCompassDir);
-
-	return dstBuffer;
 }
 
-UiTextureID AutomapUiView::allocMapTexture(const GameState &gameState, const CoordInt2 &playerCoordXZ,
+UiTextureID AutomapUiView::allocMapTexture(GameState &gameState, const CoordInt2 &playerCoordXZ,
 	const VoxelDouble2 &playerDirection, const ChunkManager &chunkManager, Renderer &renderer)
 {
 	const CardinalDirectionName playerCompassDir = CardinalDirection::getDirectionName(playerDirection);
@@ -431,16 +442,23 @@ UiTextureID AutomapUiView::allocMapTexture(const GameState &gameState, const Coo
 	const LevelDefinition &activeLevelDef = mapDef.getLevel(mapInst.getActiveLevelIndex());
 	const LevelInt2 levelDims(activeLevelDef.getWidth(), activeLevelDef.getDepth());
 
-	Buffer2D<uint32_t> automapBuffer = AutomapUiView::makeAutomap(playerCoordXZ, playerCompassDir, isWild, levelDims, chunkManager);
-	const BufferView2D<const uint32_t> automapBufferView(
-		automapBuffer.get(), automapBuffer.getWidth(), automapBuffer.getHeight());
-
 	UiTextureID textureID;
-	if (!renderer.tryCreateUiTexture(automapBufferView, &textureID))
+	if (!renderer.tryCreateUiTexture(AutomapUiView::TextureDim, AutomapUiView::TextureDim, &textureID))
 	{
 		DebugCrash("Couldn't create UI texture for automap.");
 	}
 
+	// Write the automap straight into the texture instead of a scratch buffer.
+	uint32_t *dstTexels = renderer.lockUiTexture(textureID);
+	if (dstTexels == nullptr)
+	{
+		DebugCrash("Couldn't lock automap texels for writing.");
+	}
+
+	AutomapTileCache &tileCache = gameState.getAutomapTileCache();
+	AutomapUiView::makeAutomap(playerCoordXZ, playerCompassDir, isWild, levelDims, chunkManager, tileCache, dstTexels);
+	renderer.unlockUiTexture(textureID);
+
 	return textureID;
 }
 
@@ -15,10 +15,13 @@
 #include "../UI/TextAlignment.h"
 #include "../UI/TextBox.h"
 #include "../UI/TextRenderUtils.h"
+#include "../World/ChunkUtils.h"
 #include "../World/Coord.h"
 
 #include "components/utilities/Buffer2D.h"
 
+class AutomapTileCache;
+class Chunk;
 class ChunkManager;
 class GameState;
 class Renderer;
@@ -36,6 +39,13 @@ namespace AutomapUiView
 	// Number of chunks away from the player to display in the automap.
 	constexpr int ChunkDistance = 1;
 
+	// Dimensions of one chunk's image in the automap texture.
+	constexpr int TileDim = ChunkUtils::CHUNK_DIM * PixelSize;
+
+	// Dimensions of the automap texture, triple the size of the voxel area so that all directions of the
+	// player's arrow are representable in the same texture.
+	constexpr int TextureDim = TileDim * ((ChunkDistance * 2) + 1);
+
 	// How fast the automap moves when scrolling.
 	constexpr double ScrollSpeed = 100.0;
 
@@ -106,12 +116,16 @@ namespace AutomapUiView
 	const Color &getWildPixelColor(const VoxelDefinition &floorDef, const VoxelDefinition &wallDef,
 		const TransitionDefinition *transitionDef);
 
-	// Generates a texture of the automap.
-	Buffer2D<uint32_t> makeAutomap(const CoordInt2 &playerCoord, CardinalDirectionName playerCompassDir,
-		bool isWild, const LevelInt2 &levelDims, const ChunkManager &chunkManager);
+	// Draws a chunk's voxels into an automap tile. The tile is mirrored horizontally like the automap itself.
+	void rasterizeChunk(const Chunk &chunk, bool isWild, const LevelInt2 &levelDims, Buffer2D<uint32_t> &outTile);
+
+	// Writes the automap around the player into the given texels (TextureDim x TextureDim), reusing chunk tiles
+	// from the cache when their chunks haven't changed.
+	void makeAutomap(const CoordInt2 &playerCoord, CardinalDirectionName playerCompassDir, bool isWild,
+		const LevelInt2 &levelDims, const ChunkManager &chunkManager, AutomapTileCache &tileCache, uint32_t *outTexels);
 
 	// Texture allocation functions (must be freed when done).
-	UiTextureID allocMapTexture(const GameState &gameState, const CoordInt2 &playerCoordXZ,
+	UiTextureID allocMapTexture(GameState &gameState, const CoordInt2 &playerCoordXZ,
 		const VoxelDouble2 &playerDirection, const ChunkManager &chunkManager, Renderer &renderer);
 	UiTextureID allocBgTexture(TextureManager &textureManager, Renderer &renderer);
 	UiTextureID allocCursorTexture(TextureManager &textureManager, Renderer &renderer);
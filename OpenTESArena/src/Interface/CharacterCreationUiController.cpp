@@ -489,7 +489,8 @@ void ChooseAttributesUiController::onSavedDoneButtonSelected(Game &game)
 		renderer.initializeWorldRendering(
 			options.getGraphics_ResolutionScale(),
 			fullGameWindow,
-			options.getGraphics_RenderThreadsMode());
+			options.getGraphics_RenderThreadsMode(),
+			options.getGraphics_LightTableShading());
 
 		std::unique_ptr<GameState> gameState = [&game, &renderer, &binaryAssetLibrary]()
 		{
@@ -14,4 +14,13 @@ void CommonUiController::onDebugInputAction(const InputActionCallbackValues &val
 		const int newProfilerLevel = (oldProfilerLevel < Options::MAX_PROFILER_LEVEL) ? (oldProfilerLevel + 1) : Options::MIN_PROFILER_LEVEL;
 		options.setMisc_ProfilerLevel(newProfilerLevel);
 	}
-}
\ No newline at end of file
+}
+void CommonUiController::onDebugTraceInputAction(const InputActionCallbackValues &values)
+{
+	if (values.performed)
+	{
+		// Record a few seconds of profiler zones.
+		auto &game = values.game;
+		game.beginTrace(CommonUiController::DebugTraceFrameCount);
+	}
+}
@@ -5,7 +5,11 @@ struct InputActionCallbackValues;
 
 namespace CommonUiController
 {
+	// Number of frames recorded by the trace hotkey.
+	constexpr int DebugTraceFrameCount = 300;
+
 	void onDebugInputAction(const InputActionCallbackValues &values);
+	void onDebugTraceInputAction(const InputActionCallbackValues &values);
 }
 
 #endif
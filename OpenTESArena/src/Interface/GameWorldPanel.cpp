@@ -21,6 +21,7 @@
 #include "../World/MapType.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/TraceProfiler.h"
 
 GameWorldPanel::GameWorldPanel(Game &game)
 	: Panel(game) { }
@@ -865,6 +866,8 @@ bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 
 void GameWorldPanel::tick(double dt)
 {
+	TraceZone("GameWorldPanel::tick");
+
 	auto &game = this->getGame();
 	DebugAssert(game.gameStateIsActive());
 
@@ -948,6 +951,11 @@ void GameWorldPanel::tick(double dt)
 
 			audioManager.setMusic(musicDef);
 		}
+
+		if (changeToDayMusic || changeToNightMusic)
+		{
+			MapLogicController::prerenderLikelyMusic(game);
+		}
 	}
 
 	// Tick the player.
@@ -550,7 +550,7 @@ void GameWorldUiView::DEBUG_ColorRaycastPixel(Game &game)
 			Physics::Hit hit;
 			const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
 				pixelPerfect, palette, includeEntities, levelInst, game.getEntityDefinitionLibrary(),
-				renderer, hit);
+				renderer, game.getFrameAllocator(), hit);
 
 			if (success)
 			{
@@ -621,7 +621,7 @@ void GameWorldUiView::DEBUG_PhysicsRaycast(Game &game)
 	Physics::Hit hit;
 	const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
 		options.getInput_PixelPerfectSelection(), palette, includeEntities, levelInst,
-		game.getEntityDefinitionLibrary(), renderer, hit);
+		game.getEntityDefinitionLibrary(), renderer, game.getFrameAllocator(), hit);
 
 	std::string text;
 	if (success)
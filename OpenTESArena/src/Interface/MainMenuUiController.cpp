@@ -114,7 +114,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 	const auto &options = game.getOptions();
 	const bool fullGameWindow = options.getGraphics_ModernInterface();
 	renderer.initializeWorldRendering(options.getGraphics_ResolutionScale(),
-		fullGameWindow, options.getGraphics_RenderThreadsMode());
+		fullGameWindow, options.getGraphics_RenderThreadsMode(), options.getGraphics_LightTableShading());
 
 	// Game data instance, to be initialized further by one of the loading methods below.
 	// Create a player with random data for testing.
@@ -369,6 +369,22 @@ std::unique_ptr<OptionsUiModel::IntOption> OptionsUiModel::makeRenderThreadsMode
 	});
 }
 
+std::unique_ptr<OptionsUiModel::BoolOption> OptionsUiModel::makeLightTableShadingOption(Game &game)
+{
+	const auto &options = game.getOptions();
+	return std::make_unique<OptionsUiModel::BoolOption>(
+		OptionsUiModel::LIGHT_TABLE_SHADING_NAME,
+		"Shades the game world with pre-shaded palette tables like the\noriginal game. Faster, but light and fog are slightly banded.",
+		options.getGraphics_LightTableShading(),
+		[&game](bool value)
+	{
+		auto &options = game.getOptions();
+		auto &renderer = game.getRenderer();
+		options.setGraphics_LightTableShading(value);
+		renderer.setLightTableShading(value);
+	});
+}
+
 OptionsUiModel::OptionGroup OptionsUiModel::makeGraphicsOptionGroup(Game &game)
 {
 	OptionGroup group;
@@ -380,6 +396,7 @@ OptionsUiModel::OptionGroup OptionsUiModel::makeGraphicsOptionGroup(Game &game)
 	group.emplace_back(OptionsUiModel::makeCursorScaleOption(game));
 	group.emplace_back(OptionsUiModel::makeModernInterfaceOption(game));
 	group.emplace_back(OptionsUiModel::makeRenderThreadsModeOption(game));
+	group.emplace_back(OptionsUiModel::makeLightTableShadingOption(game));
 	return group;
 }
 
@@ -32,6 +32,7 @@ namespace OptionsUiModel
 	const std::string LETTERBOX_MODE_NAME = "Letterbox Mode";
 	const std::string MODERN_INTERFACE_NAME = "Modern Interface";
 	const std::string RENDER_THREADS_MODE_NAME = "Render Threads Mode";
+	const std::string LIGHT_TABLE_SHADING_NAME = "Light Table Shading";
 	const std::string RESOLUTION_SCALE_NAME = "Resolution Scale";
 	const std::string VERTICAL_FOV_NAME = "Vertical FOV";
 
@@ -187,6 +188,7 @@ namespace OptionsUiModel
 	std::unique_ptr<OptionsUiModel::DoubleOption> makeCursorScaleOption(Game &game);
 	std::unique_ptr<OptionsUiModel::BoolOption> makeModernInterfaceOption(Game &game);
 	std::unique_ptr<OptionsUiModel::IntOption> makeRenderThreadsModeOption(Game &game);
+	std::unique_ptr<OptionsUiModel::BoolOption> makeLightTableShadingOption(Game &game);
 	OptionGroup makeGraphicsOptionGroup(Game &game);
 
 	// Audio options.
@@ -478,7 +478,6 @@ void ProvinceMapPanel::trySelectLocation(int selectedLocationID)
 {
 	auto &game = this->getGame();
 	auto &gameState = game.getGameState();
-	const auto &binaryAssetLibrary = game.getBinaryAssetLibrary();
 
 	const WorldMapDefinition &worldMapDef = gameState.getWorldMapDefinition();
 	const ProvinceDefinition &currentProvinceDef = gameState.getProvinceDefinition();
@@ -508,8 +507,9 @@ void ProvinceMapPanel::trySelectLocation(int selectedLocationID)
 
 		const Int2 srcGlobalPoint = makeGlobalPoint(currentLocationDef, currentProvinceDef);
 		const Int2 dstGlobalPoint = makeGlobalPoint(selectedLocationDef, selectedProvinceDef);
-		const int travelDays = ArenaLocationUtils::getTravelDays(srcGlobalPoint, dstGlobalPoint,
-			currentDate.getMonth(), gameState.getWeathersArray(), tempRandom, binaryAssetLibrary);
+		const TravelCostMap &travelCostMap = worldMapDef.getTravelCostMap();
+		const int travelDays = travelCostMap.getTravelDays(srcGlobalPoint, dstGlobalPoint,
+			currentDate.getMonth(), gameState.getWeathersArray(), tempRandom);
 
 		// Set selected map location.
 		gameState.setTravelData(std::make_unique<ProvinceMapUiModel::TravelData>(selectedLocationID, this->provinceID, travelDays));
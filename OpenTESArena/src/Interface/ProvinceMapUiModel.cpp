@@ -10,6 +10,7 @@
 #include "../UI/TextBox.h"
 #include "../UI/TextRenderUtils.h"
 #include "../WorldMap/ArenaLocationUtils.h"
+#include "../WorldMap/LocationNameIndex.h"
 
 #include "components/utilities/String.h"
 
@@ -329,46 +330,122 @@ std::vector<int> ProvinceSearchUiModel::getMatchingLocations(Game &game, const s
 	const int provinceDefIndex = provinceInst.getProvinceDefIndex();
 	const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(provinceDefIndex);
 
-	// Iterate through all locations in the province. If any visible location's name has
-	// a match with the one entered, then add the location to the matching IDs.
-	std::vector<int> locationIndices;
+	// Lowercase the entered name once; location definition names are already lowercased by the province's
+	// name index.
+	const LocationNameIndex &locationNameIndex = provinceDef.getLocationNameIndex();
+	std::string locationNameKey;
+	LocationNameIndex::makeKey(locationName, locationNameKey);
+
+	// Only visible locations can be matched. Renamed locations (i.e., dungeons) aren't in the definition
+	// name index, so they're matched by their own name instead.
+	std::vector<int> definitionLocationIndices(provinceDef.getLocationCount(), -1);
+	std::vector<int> renamedLocationIndices;
 	for (int i = 0; i < provinceInst.getLocationCount(); i++)
 	{
 		const LocationInstance &locationInst = provinceInst.getLocationInstance(i);
-
-		// Only check visible locations.
 		if (locationInst.isVisible())
 		{
-			const int locationDefIndex = locationInst.getLocationDefIndex();
-			const LocationDefinition &locationDef = provinceDef.getLocationDef(locationDefIndex);
-			const std::string &curLocationName = locationInst.getName(locationDef);
-
-			// See if the location names are an exact match.
-			const bool isExactMatch = String::caseInsensitiveEquals(locationName, curLocationName);
-
-			if (isExactMatch)
+			if (locationInst.hasNameOverride())
 			{
-				locationIndices.push_back(i);
-				*exactLocationIndex = &locationIndices.back();
-				break;
+				renamedLocationIndices.push_back(i);
 			}
 			else
 			{
-				// Approximate match behavior. If the given location name is a case-insensitive
-				// substring of the current location, it's a match.
-				const std::string locNameLower = String::toLowercase(locationName);
-				const std::string locDataNameLower = String::toLowercase(curLocationName);
-				const bool isApproxMatch = locDataNameLower.find(locNameLower) != std::string::npos;
-
-				if (isApproxMatch)
-				{
-					locationIndices.push_back(i);
-				}
+				definitionLocationIndices[locationInst.getLocationDefIndex()] = i;
 			}
 		}
 	}
 
-	// If no exact or approximate matches, just fill the list with all visible location IDs.
+	// Matches by location instance index.
+	std::vector<LocationNameIndex::Match> matches;
+	locationNameIndex.findMatches(locationNameKey, matches);
+	for (LocationNameIndex::Match &match : matches)
+	{
+		match.locationIndex = definitionLocationIndices[match.locationIndex];
+	}
+
+	matches.erase(std::remove_if(matches.begin(), matches.end(),
+		[](const LocationNameIndex::Match &match)
+	{
+		return match.locationIndex < 0;
+	}), matches.end());
+
+	std::string nameOverrideKey;
+	for (const int locationIndex : renamedLocationIndices)
+	{
+		const LocationInstance &locationInst = provinceInst.getLocationInstance(locationIndex);
+		const LocationDefinition &locationDef = provinceDef.getLocationDef(locationInst.getLocationDefIndex());
+		LocationNameIndex::makeKey(locationInst.getName(locationDef), nameOverrideKey);
+
+		LocationNameIndex::MatchType matchType;
+		int matchDistance;
+		if (LocationNameIndex::tryMatchName(locationNameKey, nameOverrideKey, &matchType, &matchDistance))
+		{
+			matches.emplace_back(locationIndex, matchType, matchDistance);
+		}
+	}
+
+	auto getLocationName = [&provinceInst, &provinceDef](int locationIndex) -> const std::string&
+	{
+		const LocationInstance &locationInst = provinceInst.getLocationInstance(locationIndex);
+		const LocationDefinition &locationDef = provinceDef.getLocationDef(locationInst.getLocationDefIndex());
+		return locationInst.getName(locationDef);
+	};
+
+	// An exact match is selected directly, so it's the only one returned.
+	std::vector<int> locationIndices;
+	const auto exactIter = std::find_if(matches.begin(), matches.end(),
+		[](const LocationNameIndex::Match &match)
+	{
+		return match.type == LocationNameIndex::MatchType::Exact;
+	});
+
+	if (exactIter != matches.end())
+	{
+		locationIndices.push_back(exactIter->locationIndex);
+		*exactLocationIndex = &locationIndices.front();
+		return locationIndices;
+	}
+
+	// Names that are only close to the entered one (typos) are only used if nothing else matches.
+	const bool hasNonTypoMatch = std::any_of(matches.begin(), matches.end(),
+		[](const LocationNameIndex::Match &match)
+	{
+		return match.type != LocationNameIndex::MatchType::Approximate;
+	});
+
+	if (hasNonTypoMatch)
+	{
+		matches.erase(std::remove_if(matches.begin(), matches.end(),
+			[](const LocationNameIndex::Match &match)
+		{
+			return match.type == LocationNameIndex::MatchType::Approximate;
+		}), matches.end());
+	}
+
+	// Best matches first (prefix before substring, fewer typos first), then alphabetically.
+	std::sort(matches.begin(), matches.end(),
+		[&getLocationName](const LocationNameIndex::Match &a, const LocationNameIndex::Match &b)
+	{
+		if (a.type != b.type)
+		{
+			return a.type < b.type;
+		}
+
+		if (a.distance != b.distance)
+		{
+			return a.distance < b.distance;
+		}
+
+		return getLocationName(a.locationIndex).compare(getLocationName(b.locationIndex)) < 0;
+	});
+
+	for (const LocationNameIndex::Match &match : matches)
+	{
+		locationIndices.push_back(match.locationIndex);
+	}
+
+	// If no matches at all, just fill the list with all visible location IDs.
 	if (locationIndices.empty())
 	{
 		for (int i = 0; i < provinceInst.getLocationCount(); i++)
@@ -379,34 +456,25 @@ std::vector<int> ProvinceSearchUiModel::getMatchingLocations(Game &game, const s
 				locationIndices.push_back(i);
 			}
 		}
+
+		// The original game orders locations by their location ID, but that's hardly helpful for the
+		// player because they memorize places by name. Therefore, this feature will deviate from
+		// the original behavior for the sake of convenience. If the list isn't sorted alphabetically,
+		// then it takes the player linear time to find a location in it, which essentially isn't any
+		// faster than hovering over each location individually.
+		std::sort(locationIndices.begin(), locationIndices.end(),
+			[&getLocationName](int a, int b)
+		{
+			return getLocationName(a).compare(getLocationName(b)) < 0;
+		});
 	}
 
 	// If one approximate match was found and no exact match was found, treat the approximate
 	// match as the nearest.
-	if ((locationIndices.size() == 1) && (*exactLocationIndex == nullptr))
+	if (locationIndices.size() == 1)
 	{
 		*exactLocationIndex = &locationIndices.front();
 	}
 
-	// The original game orders locations by their location ID, but that's hardly helpful for the
-	// player because they memorize places by name. Therefore, this feature will deviate from
-	// the original behavior for the sake of convenience. If the list isn't sorted alphabetically,
-	// then it takes the player linear time to find a location in it, which essentially isn't any
-	// faster than hovering over each location individually.
-	std::sort(locationIndices.begin(), locationIndices.end(),
-		[&provinceInst, &provinceDef](int a, int b)
-	{
-		const LocationInstance &locationInstA = provinceInst.getLocationInstance(a);
-		const LocationInstance &locationInstB = provinceInst.getLocationInstance(b);
-		const int locationDefIndexA = locationInstA.getLocationDefIndex();
-		const int locationDefIndexB = locationInstB.getLocationDefIndex();
-		const LocationDefinition &locationDefA = provinceDef.getLocationDef(locationDefIndexA);
-		const LocationDefinition &locationDefB = provinceDef.getLocationDef(locationDefIndexB);
-
-		const std::string &aName = locationInstA.getName(locationDefA);
-		const std::string &bName = locationInstB.getName(locationDefB);
-		return aName.compare(bName) < 0;
-	});
-
 	return locationIndices;
 }
@@ -179,7 +179,7 @@ void TextCinematicPanel::tick(double dt)
 		if (!playedFirstVoice)
 		{
 			const std::string voiceFilename = this->speechState.getVoiceFilename(this->speechState.getNextVoiceIndex());
-			audioManager.playSound(voiceFilename);
+			audioManager.playSound(voiceFilename, std::nullopt, AudioManager::SoundCategory::Interface);
 			this->speechState.incrementVoiceIndex();
 		}
 		else
@@ -195,7 +195,7 @@ void TextCinematicPanel::tick(double dt)
 
 				if (audioManager.soundExists(nextVoiceFilename))
 				{
-					audioManager.playSound(nextVoiceFilename);
+					audioManager.playSound(nextVoiceFilename, std::nullopt, AudioManager::SoundCategory::Interface);
 					this->speechState.incrementVoiceIndex();
 
 					if (TextCinematicUiModel::SpeechState::isBeginningOfNewPage(nextVoiceIndex))
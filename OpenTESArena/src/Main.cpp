@@ -1,5 +1,8 @@
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -11,13 +14,30 @@
 
 int main(int argc, char *argv[])
 {
-	static_cast<void>(argc);
-	static_cast<void>(argv);
+	// "--trace [frames]" records profiler zones for the first frames and writes them to the log folder.
+	std::optional<int> traceFrameCount;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--trace") == 0)
+		{
+			traceFrameCount = 300;
+			if (((i + 1) < argc) && (std::atoi(argv[i + 1]) > 0))
+			{
+				i++;
+				traceFrameCount = std::atoi(argv[i]);
+			}
+		}
+	}
 
 	try
 	{
 		// Allocated on the heap to avoid stack overflow warning.
 		auto g = std::make_unique<Game>();
+		if (traceFrameCount.has_value())
+		{
+			g->beginTrace(*traceFrameCount);
+		}
+
 		g->loop();
 	}
 	catch (const std::exception &e)
@@ -64,3 +64,47 @@ void ArenaRandom::srand(uint32_t seed)
 {
 	this->value = seed;
 }
+
+// CounterRandom
+
+CounterRandom::CounterRandom(uint64_t seed, uint64_t stream)
+{
+	this->init(seed, stream);
+}
+
+CounterRandom::CounterRandom()
+	: CounterRandom(0, 0) { }
+
+uint64_t CounterRandom::mix(uint64_t a, uint64_t b)
+{
+	uint64_t z = a + (b * 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+void CounterRandom::init(uint64_t seed, uint64_t stream)
+{
+	this->key = CounterRandom::mix(seed, stream);
+	this->counter = 0;
+}
+
+uint32_t CounterRandom::next()
+{
+	const uint64_t value = CounterRandom::mix(this->key, this->counter);
+	this->counter++;
+	return static_cast<uint32_t>(value >> 32);
+}
+
+int CounterRandom::next(int exclusiveMax)
+{
+	return static_cast<int>(this->next() % static_cast<uint32_t>(exclusiveMax));
+}
+
+double CounterRandom::nextReal()
+{
+	// 53 random bits scaled into [0, 1).
+	const uint64_t value = CounterRandom::mix(this->key, this->counter);
+	this->counter++;
+	return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -52,4 +52,32 @@ public:
 	void srand(uint32_t seed);
 };
 
+// Counter-based generator where each value is a hash of the seed and a counter, so any number in a
+// stream can be generated without the ones before it. Useful for giving threads or array elements their
+// own deterministic stream without sharing state.
+class CounterRandom
+{
+private:
+	uint64_t key;
+	uint64_t counter;
+public:
+	CounterRandom(uint64_t seed, uint64_t stream);
+	CounterRandom();
+
+	// Hashes the two values into a well-distributed 64-bit value (SplitMix64 finalizer).
+	static uint64_t mix(uint64_t a, uint64_t b);
+
+	// Starts a new stream. Different streams with the same seed are independent.
+	void init(uint64_t seed, uint64_t stream);
+
+	// Includes 0 to ~4.29 billion.
+	uint32_t next();
+
+	// Includes 0 to (exclusiveMax - 1).
+	int next(int exclusiveMax);
+
+	// Includes [0.0, 1.0).
+	double nextReal();
+};
+
 #endif
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <chrono>
+
 #include "SDL.h"
 
 #include "TextureManager.h"
@@ -26,6 +29,93 @@ namespace
 {
 	// Texture filename extensions.
 	constexpr const char *EXTENSION_BMP = "BMP";
+
+	// Decoded texture files waiting for the texture pack stop being kept past this size so they don't
+	// hold a second copy of every loaded texture for the whole session. Files past it are packed in a
+	// later session instead.
+	constexpr size_t MAX_PENDING_PACK_BYTE_COUNT = 32 * 1024 * 1024;
+
+	size_t getPackWriteEntryByteCount(const TexturePackFile::WriteEntry &entry)
+	{
+		size_t byteCount = 0;
+		for (int i = 0; i < entry.textures.getCount(); i++)
+		{
+			const TextureBuilder &texture = entry.textures.get(i);
+			const size_t bytesPerTexel = (texture.getType() == TextureBuilder::Type::Paletted) ?
+				sizeof(uint8_t) : sizeof(uint32_t);
+			byteCount += texture.getWidth() * texture.getHeight() * bytesPerTexel;
+		}
+
+		return byteCount;
+	}
+
+	double getElapsedSeconds(const std::chrono::high_resolution_clock::time_point &startTime)
+	{
+		const auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+			static_cast<double>(std::nano::den);
+	}
+
+	// Copies a decoded texture file into the requested out parameters.
+	void copyPackWriteEntry(const TexturePackFile::WriteEntry &entry, Buffer<TextureBuilder> *outTextures,
+		TextureFileMetadata *outMetadata)
+	{
+		const int textureCount = entry.textures.getCount();
+
+		if (outTextures != nullptr)
+		{
+			outTextures->init(textureCount);
+			for (int i = 0; i < textureCount; i++)
+			{
+				const TextureBuilder &srcTexture = entry.textures.get(i);
+				TextureBuilder &dstTexture = outTextures->get(i);
+				if (srcTexture.getType() == TextureBuilder::Type::Paletted)
+				{
+					dstTexture.initPaletted(srcTexture.getWidth(), srcTexture.getHeight(),
+						srcTexture.getPaletted().texels.get());
+				}
+				else
+				{
+					dstTexture.initTrueColor(srcTexture.getWidth(), srcTexture.getHeight(),
+						srcTexture.getTrueColor().texels.get());
+				}
+			}
+		}
+
+		if (outMetadata != nullptr)
+		{
+			const TextureFileMetadata &srcMetadata = entry.metadata;
+			Buffer<Int2> dimensions(textureCount);
+			Buffer<Int2> offsets;
+			if (srcMetadata.hasOffsets())
+			{
+				offsets.init(textureCount);
+			}
+
+			for (int i = 0; i < textureCount; i++)
+			{
+				dimensions.set(i, Int2(srcMetadata.getWidth(i), srcMetadata.getHeight(i)));
+
+				if (srcMetadata.hasOffsets())
+				{
+					offsets.set(i, srcMetadata.getOffset(i));
+				}
+			}
+
+			outMetadata->init(std::string(srcMetadata.getFilename()), std::move(dimensions), std::move(offsets));
+		}
+	}
+}
+
+TextureManager::TextureManager()
+{
+	this->texturePackSourceKey = 0;
+	this->pendingPackByteCount = 0;
+	this->texturePackEnabled = false;
+	this->packLoadCount = 0;
+	this->decodeLoadCount = 0;
+	this->packLoadSeconds = 0.0;
+	this->decodeLoadSeconds = 0.0;
 }
 
 bool TextureManager::matchesExtension(const char *filename, const char *extension)
@@ -421,8 +511,151 @@ bool TextureManager::tryLoadTextureData(const char *filename, Buffer<TextureBuil
 	return true;
 }
 
+bool TextureManager::tryLoadTextureDataCached(const char *filename, Buffer<TextureBuilder> *outTextures,
+	TextureFileMetadata *outMetadata)
+{
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	if (!this->texturePackEnabled)
+	{
+		if (!TextureManager::tryLoadTextureData(filename, outTextures, outMetadata))
+		{
+			return false;
+		}
+
+		this->decodeLoadSeconds += getElapsedSeconds(startTime);
+		this->decodeLoadCount++;
+		return true;
+	}
+
+	if (this->texturePack.tryGetTextureData(filename, outTextures, outMetadata))
+	{
+		this->packLoadSeconds += getElapsedSeconds(startTime);
+		this->packLoadCount++;
+		return true;
+	}
+
+	// Not in the pack. Decode both texels and metadata regardless of what was requested so the
+	// whole file can go in the next pack, and so a later request for the other half is free.
+	auto pendingIter = this->pendingPackEntries.find(filename);
+	if (pendingIter == this->pendingPackEntries.end())
+	{
+		if (this->pendingPackByteCount >= MAX_PENDING_PACK_BYTE_COUNT)
+		{
+			// Full for this session, decode without keeping a copy.
+			if (!TextureManager::tryLoadTextureData(filename, outTextures, outMetadata))
+			{
+				return false;
+			}
+
+			this->decodeLoadSeconds += getElapsedSeconds(startTime);
+			this->decodeLoadCount++;
+			return true;
+		}
+
+		TexturePackFile::WriteEntry newEntry;
+		if (!TextureManager::tryLoadTextureData(filename, &newEntry.textures, &newEntry.metadata))
+		{
+			return false;
+		}
+
+		this->pendingPackByteCount += getPackWriteEntryByteCount(newEntry);
+		pendingIter = this->pendingPackEntries.emplace(std::string(filename), std::move(newEntry)).first;
+		this->decodeLoadCount++;
+	}
+
+	copyPackWriteEntry(pendingIter->second, outTextures, outMetadata);
+	this->decodeLoadSeconds += getElapsedSeconds(startTime);
+	return true;
+}
+
+void TextureManager::initTexturePack(const std::string &filename, uint64_t sourceKey)
+{
+	std::lock_guard<std::recursive_mutex> lock(this->mutex);
+	this->texturePackFilename = filename;
+	this->texturePackSourceKey = sourceKey;
+	this->texturePackEnabled = true;
+
+	if (this->texturePack.init(filename.c_str(), sourceKey))
+	{
+		DebugLog("Loaded texture pack \"" + filename + "\" (" +
+			std::to_string(this->texturePack.getEntryCount()) + " files).");
+	}
+	else
+	{
+		DebugLog("No valid texture pack at \"" + filename + "\", it will be generated on exit.");
+	}
+}
+
+void TextureManager::saveTexturePack()
+{
+	std::lock_guard<std::recursive_mutex> lock(this->mutex);
+	DebugLog("Texture files: " + std::to_string(this->packLoadCount) + " from pack in " +
+		String::fixedPrecision(this->packLoadSeconds * 1000.0, 2) + "ms, " + std::to_string(this->decodeLoadCount) +
+		" decoded in " + String::fixedPrecision(this->decodeLoadSeconds * 1000.0, 2) + "ms.");
+
+	this->writeTexturePack();
+}
+
+void TextureManager::writeTexturePack()
+{
+	if (!this->texturePackEnabled || this->pendingPackEntries.empty())
+	{
+		return;
+	}
+
+	// Carry over everything from the existing pack, then append this session's decoded files.
+	const int existingCount = this->texturePack.isValid() ? this->texturePack.getEntryCount() : 0;
+	Buffer<TexturePackFile::WriteEntry> writeEntries(existingCount + static_cast<int>(this->pendingPackEntries.size()));
+	for (int i = 0; i < existingCount; i++)
+	{
+		const std::string entryFilename = this->texturePack.getEntryFilename(i);
+		TexturePackFile::WriteEntry &writeEntry = writeEntries.get(i);
+		if (!this->texturePack.tryGetTextureData(entryFilename.c_str(), &writeEntry.textures, &writeEntry.metadata))
+		{
+			// Drop this session's files too so the rewrite isn't retried on every texture load.
+			DebugLogError("Couldn't read \"" + entryFilename + "\" from texture pack.");
+			this->pendingPackEntries.clear();
+			this->pendingPackByteCount = 0;
+			return;
+		}
+	}
+
+	int writeIndex = existingCount;
+	for (auto &pair : this->pendingPackEntries)
+	{
+		writeEntries.set(writeIndex, std::move(pair.second));
+		writeIndex++;
+	}
+
+	this->pendingPackEntries.clear();
+	this->pendingPackByteCount = 0;
+
+	// The mapping must be released before the file is replaced.
+	this->texturePack.clear();
+
+	const BufferView<const TexturePackFile::WriteEntry> writeEntriesView(writeEntries.get(), writeEntries.getCount());
+	if (TexturePackFile::write(this->texturePackFilename.c_str(), this->texturePackSourceKey, writeEntriesView))
+	{
+		DebugLog("Wrote texture pack \"" + this->texturePackFilename + "\" (" +
+			std::to_string(writeEntries.getCount()) + " files).");
+	}
+	else
+	{
+		DebugLogError("Couldn't write texture pack \"" + this->texturePackFilename + "\".");
+	}
+
+	this->texturePack.init(this->texturePackFilename.c_str(), this->texturePackSourceKey);
+}
+
+std::unique_lock<std::recursive_mutex> TextureManager::lock() const
+{
+	return std::unique_lock<std::recursive_mutex>(this->mutex);
+}
+
 std::optional<PaletteIdGroup> TextureManager::tryGetPaletteIDs(const char *filename)
 {
+	std::lock_guard<std::recursive_mutex> lock(this->mutex);
 	if (String::isNullOrEmpty(filename))
 	{
 		DebugLogWarning("Missing palette filename.");
@@ -487,6 +720,7 @@ std::optional<PaletteID> TextureManager::tryGetPaletteID(const TextureAssetRefer
 
 std::optional<TextureBuilderIdGroup> TextureManager::tryGetTextureBuilderIDs(const char *filename)
 {
+	std::lock_guard<std::recursive_mutex> lock(this->mutex);
 	if (String::isNullOrEmpty(filename))
 	{
 		DebugLogWarning("Missing texture builder filename.");
@@ -498,7 +732,7 @@ std::optional<TextureBuilderIdGroup> TextureManager::tryGetTextureBuilderIDs(con
 	if (iter == this->textureBuilderIDs.end())
 	{
 		Buffer<TextureBuilder> textureBuilders;
-		if (!TextureManager::tryLoadTextureData(filename, &textureBuilders, nullptr))
+		if (!this->tryLoadTextureDataCached(filename, &textureBuilders, nullptr))
 		{
 			DebugLogWarning("Couldn't load texture builders from \"" + filenameStr + "\".");
 			return std::nullopt;
@@ -548,6 +782,7 @@ std::optional<PaletteID> TextureManager::tryGetTextureBuilderID(const TextureAss
 
 std::optional<TextureFileMetadataID> TextureManager::tryGetMetadataID(const char *filename)
 {
+	std::lock_guard<std::recursive_mutex> lock(this->mutex);
 	if (String::isNullOrEmpty(filename))
 	{
 		DebugLogWarning("Missing texture file metadata filename.");
@@ -559,7 +794,7 @@ std::optional<TextureFileMetadataID> TextureManager::tryGetMetadataID(const char
 	if (iter == this->metadataIndices.end())
 	{
 		TextureFileMetadata metadata;
-		if (!TextureManager::tryLoadTextureData(filename, nullptr, &metadata))
+		if (!this->tryLoadTextureDataCached(filename, nullptr, &metadata))
 		{
 			DebugLogWarning("Couldn't load texture file metadata from \"" + filenameStr + "\".");
 			return std::nullopt;
@@ -2,6 +2,7 @@
 #define TEXTURE_MANAGER_H
 
 #include <cstdint>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -11,6 +12,7 @@
 #include "Palette.h"
 #include "TextureBuilder.h"
 #include "TextureFileMetadata.h"
+#include "TexturePackFile.h"
 #include "TextureUtils.h"
 
 #include "components/utilities/Buffer.h"
@@ -39,6 +41,24 @@ private:
 	std::vector<TextureBuilder> textureBuilders;
 	std::vector<TextureFileMetadata> metadatas;
 
+	// Optional cache of already-decoded texture files. Files missing from the pack are decoded normally
+	// and kept by filename until the pack is rewritten once on exit. Past a memory cap they're no longer
+	// kept, so a session only ever writes the pack once.
+	TexturePackFile texturePack;
+	std::string texturePackFilename;
+	uint64_t texturePackSourceKey;
+	std::unordered_map<std::string, TexturePackFile::WriteEntry> pendingPackEntries;
+	size_t pendingPackByteCount;
+	bool texturePackEnabled;
+
+	// Texture file load statistics for comparing cold and warm starts.
+	int packLoadCount, decodeLoadCount;
+	double packLoadSeconds, decodeLoadSeconds;
+
+	// Guards loading so threads can look up texture IDs at the same time. Recursive so a thread holding
+	// it from lock() can still call the loading functions.
+	mutable std::recursive_mutex mutex;
+
 	// Returns whether the given filename has the given extension.
 	static bool matchesExtension(const char *filename, const char *extension);
 
@@ -46,7 +66,29 @@ private:
 	static bool tryLoadPalettes(const char *filename, Buffer<Palette> *outPalettes);
 	static bool tryLoadTextureData(const char *filename, Buffer<TextureBuilder> *outTextures,
 		TextureFileMetadata *outMetadata);
+
+	// Loads texture data through the texture pack if enabled, otherwise decodes the file.
+	bool tryLoadTextureDataCached(const char *filename, Buffer<TextureBuilder> *outTextures,
+		TextureFileMetadata *outMetadata);
+
+	// Rewrites the texture pack with its existing files plus the pending ones, then frees the pending ones.
+	void writeTexturePack();
 public:
+	TextureManager();
+
+	// Enables the texture pack cache at the given path. The source key identifies the Arena install
+	// the pack was generated from; a mismatched or missing pack is regenerated on the next save.
+	void initTexturePack(const std::string &filename, uint64_t sourceKey);
+
+	// Rewrites the texture pack if any texture files were decoded this session, and logs texture
+	// load timings.
+	void saveTexturePack();
+
+	// ID look-ups are safe to call from several threads, but handles aren't: another thread's load
+	// can move the texture buffers. Threads sharing the texture manager hold this while getting and
+	// using handles. Single-threaded callers don't need it.
+	std::unique_lock<std::recursive_mutex> lock() const;
+
 	// Texture ID retrieval functions, loading texture data if not loaded. All required palettes
 	// must be loaded by the caller in advance -- no palettes are loaded in non-palette loader
 	// functions. If the requested file has multiple images but the caller requested only one, the
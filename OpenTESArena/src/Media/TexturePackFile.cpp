@@ -0,0 +1,551 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <vector>
+
+#include "TexturePackFile.h"
+#include "../Math/Vector2.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	constexpr char PACK_MAGIC[4] = { 'O', 'T', 'P', 'K' };
+	constexpr uint32_t PACK_VERSION = 1;
+	constexpr uint32_t EMPTY_BUCKET = std::numeric_limits<uint32_t>::max();
+	constexpr size_t TEXEL_ALIGNMENT = 16;
+
+	constexpr uint32_t TEXTURE_TYPE_PALETTED = 0;
+	constexpr uint32_t TEXTURE_TYPE_TRUE_COLOR = 1;
+
+	struct PackHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t sourceKey;
+		uint32_t entryCount;
+		uint32_t bucketCount;
+		uint32_t recordCount;
+		uint32_t bucketsOffset;
+		uint32_t entriesOffset;
+		uint32_t recordsOffset;
+		uint32_t stringsOffset;
+		uint32_t texelsOffset;
+	};
+
+	struct PackEntry
+	{
+		uint64_t nameHash;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t firstRecord;
+		uint32_t recordCount;
+		uint32_t hasOffsets;
+		uint32_t padding;
+	};
+
+	struct PackRecord
+	{
+		int32_t width, height;
+		int32_t xOffset, yOffset;
+		uint32_t type;
+		uint32_t texelOffset;
+	};
+
+	static_assert(sizeof(PackHeader) == 48);
+	static_assert(sizeof(PackEntry) == 32);
+	static_assert(sizeof(PackRecord) == 24);
+
+	template <typename T>
+	T readStruct(const uint8_t *ptr)
+	{
+		T value;
+		std::memcpy(&value, ptr, sizeof(T));
+		return value;
+	}
+
+	size_t alignUp(size_t value, size_t alignment)
+	{
+		return (value + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	// Returns whether every section, bucket, entry, and record in the pack is within the file.
+	bool isPackValid(const uint8_t *data, size_t size, const PackHeader &header)
+	{
+		// 64-bit math so sums of 32-bit fields can't wrap.
+		const uint64_t fileSize = size;
+		const uint64_t bucketsEnd = static_cast<uint64_t>(header.bucketsOffset) +
+			(static_cast<uint64_t>(header.bucketCount) * sizeof(uint32_t));
+		const uint64_t entriesEnd = static_cast<uint64_t>(header.entriesOffset) +
+			(static_cast<uint64_t>(header.entryCount) * sizeof(PackEntry));
+		const uint64_t recordsEnd = static_cast<uint64_t>(header.recordsOffset) +
+			(static_cast<uint64_t>(header.recordCount) * sizeof(PackRecord));
+		const bool sectionsAreValid = (header.bucketsOffset >= sizeof(PackHeader)) && (bucketsEnd <= fileSize) &&
+			(header.entriesOffset >= sizeof(PackHeader)) && (entriesEnd <= fileSize) &&
+			(header.recordsOffset >= sizeof(PackHeader)) && (recordsEnd <= fileSize) &&
+			(header.stringsOffset >= sizeof(PackHeader)) && (header.stringsOffset <= header.texelsOffset) &&
+			(header.texelsOffset <= fileSize);
+		if (!sectionsAreValid)
+		{
+			return false;
+		}
+
+		// Look-ups probe until an empty bucket, so there must be at least one.
+		const bool bucketCountIsValid = (header.bucketCount > 0) &&
+			((header.bucketCount & (header.bucketCount - 1)) == 0) && (header.entryCount < header.bucketCount);
+		if (!bucketCountIsValid)
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < header.bucketCount; i++)
+		{
+			const uint32_t entryIndex = readStruct<uint32_t>(data + header.bucketsOffset + (i * sizeof(uint32_t)));
+			if ((entryIndex != EMPTY_BUCKET) && (entryIndex >= header.entryCount))
+			{
+				return false;
+			}
+		}
+
+		const uint64_t stringsSize = header.texelsOffset - header.stringsOffset;
+		for (uint32_t i = 0; i < header.entryCount; i++)
+		{
+			const PackEntry entry = readStruct<PackEntry>(data + header.entriesOffset + (i * sizeof(PackEntry)));
+			const uint64_t nameEnd = static_cast<uint64_t>(entry.nameOffset) + entry.nameLength;
+			const uint64_t recordEnd = static_cast<uint64_t>(entry.firstRecord) + entry.recordCount;
+			if ((nameEnd > stringsSize) || (recordEnd > header.recordCount))
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.recordCount; i++)
+		{
+			const PackRecord record = readStruct<PackRecord>(data + header.recordsOffset + (i * sizeof(PackRecord)));
+			const bool isPaletted = record.type == TEXTURE_TYPE_PALETTED;
+			if ((!isPaletted && (record.type != TEXTURE_TYPE_TRUE_COLOR)) || (record.width < 0) || (record.height < 0))
+			{
+				return false;
+			}
+
+			const uint64_t bytesPerTexel = isPaletted ? sizeof(uint8_t) : sizeof(uint32_t);
+			const uint64_t texelsEnd = static_cast<uint64_t>(record.texelOffset) +
+				(static_cast<uint64_t>(record.width) * static_cast<uint64_t>(record.height) * bytesPerTexel);
+			if ((record.texelOffset < header.texelsOffset) || ((record.texelOffset % TEXEL_ALIGNMENT) != 0) ||
+				(texelsEnd > fileSize))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	uint32_t getBucketCount(int entryCount)
+	{
+		// Keep the load factor at or below 50% so probe chains stay short.
+		uint32_t bucketCount = 16;
+		while (bucketCount < static_cast<uint32_t>(entryCount * 2))
+		{
+			bucketCount <<= 1;
+		}
+
+		return bucketCount;
+	}
+}
+
+TexturePackFile::TexturePackFile()
+{
+	this->entryCount = 0;
+	this->bucketCount = 0;
+	this->buckets = nullptr;
+	this->entries = nullptr;
+	this->records = nullptr;
+	this->strings = nullptr;
+}
+
+uint64_t TexturePackFile::hashString(const char *str, size_t length)
+{
+	// 64-bit FNV-1a.
+	uint64_t hash = 0xCBF29CE484222325;
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= static_cast<uint8_t>(str[i]);
+		hash *= 0x100000001B3;
+	}
+
+	return hash;
+}
+
+uint64_t TexturePackFile::hashSourceFolder(const std::string &folderPath)
+{
+	// Sorted so the key doesn't depend on directory iteration order.
+	std::vector<std::string> fileKeys;
+	std::error_code ec;
+	std::filesystem::recursive_directory_iterator iter(folderPath, ec);
+	const std::filesystem::recursive_directory_iterator endIter;
+	while (!ec && (iter != endIter))
+	{
+		const std::filesystem::directory_entry &entry = *iter;
+		if (entry.is_regular_file(ec))
+		{
+			const std::string relativePath = entry.path().lexically_relative(folderPath).generic_string();
+			const uintmax_t fileSize = entry.file_size(ec);
+			const auto writeTime = entry.last_write_time(ec).time_since_epoch().count();
+			fileKeys.emplace_back(relativePath + '|' + std::to_string(fileSize) + '|' + std::to_string(writeTime));
+		}
+
+		iter.increment(ec);
+	}
+
+	if (ec)
+	{
+		DebugLogWarning("Couldn't list all files in \"" + folderPath + "\" (" + ec.message() + ").");
+	}
+
+	std::sort(fileKeys.begin(), fileKeys.end());
+
+	std::string allFileKeys;
+	for (const std::string &fileKey : fileKeys)
+	{
+		allFileKeys += fileKey;
+		allFileKeys += '\n';
+	}
+
+	return TexturePackFile::hashString(allFileKeys.c_str(), allFileKeys.size());
+}
+
+bool TexturePackFile::init(const char *filename, uint64_t sourceKey)
+{
+	this->clear();
+
+	if (!this->mappedFile.init(filename))
+	{
+		return false;
+	}
+
+	const uint8_t *data = this->mappedFile.get();
+	const size_t size = this->mappedFile.getSize();
+	if (size < sizeof(PackHeader))
+	{
+		DebugLogWarning("Texture pack \"" + std::string(filename) + "\" is truncated.");
+		this->clear();
+		return false;
+	}
+
+	const PackHeader header = readStruct<PackHeader>(data);
+	if ((std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) || (header.version != PACK_VERSION))
+	{
+		DebugLogWarning("Texture pack \"" + std::string(filename) + "\" has an unrecognized format.");
+		this->clear();
+		return false;
+	}
+
+	if (header.sourceKey != sourceKey)
+	{
+		DebugLog("Texture pack \"" + std::string(filename) + "\" is from a different Arena install, ignoring.");
+		this->clear();
+		return false;
+	}
+
+	// Everything read from the pack later is only checked here, so a corrupt pack must be rejected
+	// before any look-ups instead of reading out of bounds.
+	if (!isPackValid(data, size, header))
+	{
+		DebugLogWarning("Texture pack \"" + std::string(filename) + "\" is corrupt.");
+		this->clear();
+		return false;
+	}
+
+	this->entryCount = header.entryCount;
+	this->bucketCount = header.bucketCount;
+	this->buckets = reinterpret_cast<const uint32_t*>(data + header.bucketsOffset);
+	this->entries = data + header.entriesOffset;
+	this->records = data + header.recordsOffset;
+	this->strings = data + header.stringsOffset;
+	return true;
+}
+
+bool TexturePackFile::isValid() const
+{
+	return this->mappedFile.isValid();
+}
+
+int TexturePackFile::getEntryCount() const
+{
+	return static_cast<int>(this->entryCount);
+}
+
+std::string TexturePackFile::getEntryFilename(int index) const
+{
+	DebugAssert(this->isValid());
+	DebugAssert(index >= 0);
+	DebugAssert(index < this->getEntryCount());
+	const PackEntry entry = readStruct<PackEntry>(this->entries + (index * sizeof(PackEntry)));
+	return std::string(reinterpret_cast<const char*>(this->strings + entry.nameOffset), entry.nameLength);
+}
+
+const uint8_t *TexturePackFile::findEntry(const char *filename) const
+{
+	if (!this->isValid())
+	{
+		return nullptr;
+	}
+
+	const size_t filenameLength = std::strlen(filename);
+	const uint64_t hash = TexturePackFile::hashString(filename, filenameLength);
+	const uint32_t bucketMask = this->bucketCount - 1;
+	uint32_t bucketIndex = static_cast<uint32_t>(hash) & bucketMask;
+
+	for (uint32_t i = 0; i < this->bucketCount; i++)
+	{
+		const uint32_t entryIndex = this->buckets[bucketIndex];
+		if (entryIndex == EMPTY_BUCKET)
+		{
+			return nullptr;
+		}
+
+		const uint8_t *entryPtr = this->entries + (entryIndex * sizeof(PackEntry));
+		const PackEntry entry = readStruct<PackEntry>(entryPtr);
+		if ((entry.nameHash == hash) && (entry.nameLength == filenameLength) &&
+			(std::memcmp(this->strings + entry.nameOffset, filename, filenameLength) == 0))
+		{
+			return entryPtr;
+		}
+
+		bucketIndex = (bucketIndex + 1) & bucketMask;
+	}
+
+	return nullptr;
+}
+
+bool TexturePackFile::tryGetTextureData(const char *filename, Buffer<TextureBuilder> *outTextures,
+	TextureFileMetadata *outMetadata) const
+{
+	DebugAssert((outTextures != nullptr) || (outMetadata != nullptr));
+
+	const uint8_t *entryPtr = this->findEntry(filename);
+	if (entryPtr == nullptr)
+	{
+		return false;
+	}
+
+	const uint8_t *data = this->mappedFile.get();
+	const PackEntry entry = readStruct<PackEntry>(entryPtr);
+	const int recordCount = static_cast<int>(entry.recordCount);
+
+	if (outTextures != nullptr)
+	{
+		outTextures->init(recordCount);
+		for (int i = 0; i < recordCount; i++)
+		{
+			const PackRecord record = readStruct<PackRecord>(
+				this->records + ((entry.firstRecord + i) * sizeof(PackRecord)));
+			const uint8_t *texels = data + record.texelOffset;
+
+			TextureBuilder &textureBuilder = outTextures->get(i);
+			if (record.type == TEXTURE_TYPE_PALETTED)
+			{
+				textureBuilder.initPaletted(record.width, record.height, texels);
+			}
+			else
+			{
+				textureBuilder.initTrueColor(record.width, record.height, reinterpret_cast<const uint32_t*>(texels));
+			}
+		}
+	}
+
+	if (outMetadata != nullptr)
+	{
+		Buffer<Int2> dimensions(recordCount);
+		Buffer<Int2> offsets;
+		if (entry.hasOffsets != 0)
+		{
+			offsets.init(recordCount);
+		}
+
+		for (int i = 0; i < recordCount; i++)
+		{
+			const PackRecord record = readStruct<PackRecord>(
+				this->records + ((entry.firstRecord + i) * sizeof(PackRecord)));
+			dimensions.set(i, Int2(record.width, record.height));
+
+			if (entry.hasOffsets != 0)
+			{
+				offsets.set(i, Int2(record.xOffset, record.yOffset));
+			}
+		}
+
+		outMetadata->init(std::string(filename), std::move(dimensions), std::move(offsets));
+	}
+
+	return true;
+}
+
+void TexturePackFile::clear()
+{
+	this->mappedFile.clear();
+	this->entryCount = 0;
+	this->bucketCount = 0;
+	this->buckets = nullptr;
+	this->entries = nullptr;
+	this->records = nullptr;
+	this->strings = nullptr;
+}
+
+bool TexturePackFile::write(const char *filename, uint64_t sourceKey, BufferView<const WriteEntry> entries)
+{
+	const int entryCount = entries.getCount();
+	const uint32_t bucketCount = getBucketCount(entryCount);
+
+	// Lay out all sections before writing anything.
+	std::vector<uint32_t> buckets(bucketCount, EMPTY_BUCKET);
+	std::vector<PackEntry> packEntries(entryCount);
+	std::vector<PackRecord> packRecords;
+	std::string strings;
+	size_t texelsSize = 0;
+
+	for (int i = 0; i < entryCount; i++)
+	{
+		const WriteEntry &writeEntry = entries.get(i);
+		const TextureFileMetadata &metadata = writeEntry.metadata;
+		const std::string &entryFilename = metadata.getFilename();
+		DebugAssert(writeEntry.textures.getCount() == metadata.getTextureCount());
+
+		PackEntry &packEntry = packEntries[i];
+		packEntry.nameHash = TexturePackFile::hashString(entryFilename.c_str(), entryFilename.size());
+		packEntry.nameOffset = static_cast<uint32_t>(strings.size());
+		packEntry.nameLength = static_cast<uint32_t>(entryFilename.size());
+		packEntry.firstRecord = static_cast<uint32_t>(packRecords.size());
+		packEntry.recordCount = static_cast<uint32_t>(writeEntry.textures.getCount());
+		packEntry.hasOffsets = metadata.hasOffsets() ? 1 : 0;
+		packEntry.padding = 0;
+		strings.append(entryFilename);
+
+		uint32_t bucketIndex = static_cast<uint32_t>(packEntry.nameHash) & (bucketCount - 1);
+		while (buckets[bucketIndex] != EMPTY_BUCKET)
+		{
+			bucketIndex = (bucketIndex + 1) & (bucketCount - 1);
+		}
+
+		buckets[bucketIndex] = static_cast<uint32_t>(i);
+
+		for (int j = 0; j < writeEntry.textures.getCount(); j++)
+		{
+			const TextureBuilder &textureBuilder = writeEntry.textures.get(j);
+			const bool isPaletted = textureBuilder.getType() == TextureBuilder::Type::Paletted;
+			const size_t bytesPerTexel = isPaletted ? sizeof(uint8_t) : sizeof(uint32_t);
+
+			PackRecord record;
+			record.width = textureBuilder.getWidth();
+			record.height = textureBuilder.getHeight();
+			record.xOffset = metadata.hasOffsets() ? metadata.getOffset(j).x : 0;
+			record.yOffset = metadata.hasOffsets() ? metadata.getOffset(j).y : 0;
+			record.type = isPaletted ? TEXTURE_TYPE_PALETTED : TEXTURE_TYPE_TRUE_COLOR;
+			record.texelOffset = static_cast<uint32_t>(texelsSize); // Relative until the texel section is placed.
+			packRecords.emplace_back(record);
+
+			texelsSize = alignUp(texelsSize + (record.width * record.height * bytesPerTexel), TEXEL_ALIGNMENT);
+		}
+	}
+
+	PackHeader header;
+	std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+	header.version = PACK_VERSION;
+	header.sourceKey = sourceKey;
+	header.entryCount = static_cast<uint32_t>(entryCount);
+	header.bucketCount = bucketCount;
+	header.recordCount = static_cast<uint32_t>(packRecords.size());
+	header.bucketsOffset = static_cast<uint32_t>(alignUp(sizeof(PackHeader), 8));
+	header.entriesOffset = static_cast<uint32_t>(alignUp(header.bucketsOffset + (buckets.size() * sizeof(uint32_t)), 8));
+	header.recordsOffset = static_cast<uint32_t>(alignUp(header.entriesOffset + (packEntries.size() * sizeof(PackEntry)), 8));
+	header.stringsOffset = static_cast<uint32_t>(header.recordsOffset + (packRecords.size() * sizeof(PackRecord)));
+
+	const size_t texelsOffset = alignUp(header.stringsOffset + strings.size(), TEXEL_ALIGNMENT);
+	const size_t fileSize = texelsOffset + texelsSize;
+	if (fileSize > std::numeric_limits<uint32_t>::max())
+	{
+		DebugLogError("Texture pack would be too large (" + std::to_string(fileSize) + " bytes).");
+		return false;
+	}
+
+	header.texelsOffset = static_cast<uint32_t>(texelsOffset);
+	for (PackRecord &record : packRecords)
+	{
+		record.texelOffset += header.texelsOffset;
+	}
+
+	std::vector<uint8_t> fileData(fileSize, 0);
+	std::memcpy(fileData.data(), &header, sizeof(header));
+	std::memcpy(fileData.data() + header.bucketsOffset, buckets.data(), buckets.size() * sizeof(uint32_t));
+	std::memcpy(fileData.data() + header.entriesOffset, packEntries.data(), packEntries.size() * sizeof(PackEntry));
+	std::memcpy(fileData.data() + header.recordsOffset, packRecords.data(), packRecords.size() * sizeof(PackRecord));
+	std::memcpy(fileData.data() + header.stringsOffset, strings.data(), strings.size());
+
+	int recordIndex = 0;
+	for (int i = 0; i < entryCount; i++)
+	{
+		const WriteEntry &writeEntry = entries.get(i);
+		for (int j = 0; j < writeEntry.textures.getCount(); j++)
+		{
+			const TextureBuilder &textureBuilder = writeEntry.textures.get(j);
+			const PackRecord &record = packRecords[recordIndex];
+			uint8_t *dstTexels = fileData.data() + record.texelOffset;
+			const int texelCount = record.width * record.height;
+
+			if (record.type == TEXTURE_TYPE_PALETTED)
+			{
+				const uint8_t *srcTexels = textureBuilder.getPaletted().texels.get();
+				std::copy(srcTexels, srcTexels + texelCount, dstTexels);
+			}
+			else
+			{
+				const uint32_t *srcTexels = textureBuilder.getTrueColor().texels.get();
+				std::memcpy(dstTexels, srcTexels, texelCount * sizeof(uint32_t));
+			}
+
+			recordIndex++;
+		}
+	}
+
+	// Write to a temporary file first so an interrupted write never leaves a partial pack behind.
+	const std::string tempFilename = std::string(filename) + ".tmp";
+	{
+		std::ofstream ofs(tempFilename, std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open())
+		{
+			DebugLogError("Couldn't open texture pack \"" + tempFilename + "\" for writing.");
+			return false;
+		}
+
+		ofs.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+		ofs.close();
+		if (ofs.fail())
+		{
+			DebugLogError("Couldn't write texture pack \"" + tempFilename + "\".");
+			std::remove(tempFilename.c_str());
+			return false;
+		}
+	}
+
+	// Replacing is atomic on POSIX. Windows can't rename over an existing file, so remove it and retry.
+	bool renamed = std::rename(tempFilename.c_str(), filename) == 0;
+	if (!renamed)
+	{
+		std::remove(filename);
+		renamed = std::rename(tempFilename.c_str(), filename) == 0;
+	}
+
+	if (!renamed)
+	{
+		DebugLogError("Couldn't move texture pack \"" + tempFilename + "\" to \"" + std::string(filename) + "\".");
+		std::remove(tempFilename.c_str());
+		return false;
+	}
+
+	return true;
+}
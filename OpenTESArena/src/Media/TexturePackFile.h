@@ -0,0 +1,74 @@
+#ifndef TEXTURE_PACK_FILE_H
+#define TEXTURE_PACK_FILE_H
+
+#include <cstdint>
+#include <string>
+
+#include "TextureBuilder.h"
+#include "TextureFileMetadata.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+#include "components/utilities/MappedFile.h"
+
+// A texture pack is a cache of already-decoded texture files so Arena's compressed image formats
+// don't need to be decoded again every launch. The file is memory-mapped and laid out as:
+// - Header
+// - Open-addressed hash table of filename hashes -> entry indices (power-of-two bucket count)
+// - Entries (one per texture filename)
+// - Records (one per texture in a file)
+// - Filename strings
+// - Texels, each texture starting on a 16-byte boundary
+// The pack is tied to one Arena install by a source key so switching versions or changing any of
+// the install's files invalidates it.
+
+class TexturePackFile
+{
+public:
+	// Decoded texture file to be written into a new pack.
+	struct WriteEntry
+	{
+		Buffer<TextureBuilder> textures;
+		TextureFileMetadata metadata;
+	};
+private:
+	MappedFile mappedFile;
+	uint32_t entryCount, bucketCount;
+	const uint32_t *buckets;
+	const uint8_t *entries, *records, *strings;
+
+	// Returns the entry with the given filename, or null if not in the pack.
+	const uint8_t *findEntry(const char *filename) const;
+public:
+	TexturePackFile();
+
+	// Hashes a filename or other identifying string for pack look-ups.
+	static uint64_t hashString(const char *str, size_t length);
+
+	// Hashes the relative paths, sizes and modification times of every file under the given folder
+	// so a pack generated from that folder goes stale when any of its files change.
+	static uint64_t hashSourceFolder(const std::string &folderPath);
+
+	// Maps the pack file and validates it against the given source key. Returns false if the
+	// pack doesn't exist or is stale.
+	bool init(const char *filename, uint64_t sourceKey);
+
+	bool isValid() const;
+	int getEntryCount() const;
+
+	// Gets the filename of the entry at the given index. Used when rebuilding a pack.
+	std::string getEntryFilename(int index) const;
+
+	// Copies texture data and/or metadata for the given texture filename out of the pack. Same
+	// contract as TextureManager's file loaders: at least one out parameter must be non-null.
+	bool tryGetTextureData(const char *filename, Buffer<TextureBuilder> *outTextures,
+		TextureFileMetadata *outMetadata) const;
+
+	// Unmaps the pack file.
+	void clear();
+
+	// Writes a new pack file containing the given texture files.
+	static bool write(const char *filename, uint64_t sourceKey, BufferView<const WriteEntry> entries);
+};
+
+#endif
@@ -4,7 +4,14 @@
 
 void ChunkRenderDefinition::init(SNInt width, int height, WEInt depth, const ChunkInt2 &coord)
 {
-	this->voxelRenderDefIDs.init(width, height, depth);
+	// Definitions are rebuilt whenever their chunk changes, so only reallocate if the dimensions differ.
+	if ((this->voxelRenderDefIDs.getWidth() != width) || (this->voxelRenderDefIDs.getHeight() != height) ||
+		(this->voxelRenderDefIDs.getDepth() != depth))
+	{
+		this->voxelRenderDefIDs.init(width, height, depth);
+	}
+
+	this->voxelRenderDefs.clear();
 	this->voxelRenderDefIDs.fill(ChunkRenderDefinition::NO_VOXEL_ID);
 	this->coord = coord;
 }
@@ -35,6 +42,11 @@ WEInt ChunkRenderDefinition::getDepth() const
 	return this->voxelRenderDefIDs.getDepth();
 }
 
+int ChunkRenderDefinition::getVoxelRenderDefCount() const
+{
+	return static_cast<int>(this->voxelRenderDefs.size());
+}
+
 VoxelRenderDefID ChunkRenderDefinition::getVoxelRenderDefID(SNInt x, int y, WEInt z) const
 {
 	return this->voxelRenderDefIDs.get(x, y, z);
@@ -47,6 +59,13 @@ VoxelRenderDefID ChunkRenderDefinition::addVoxelRenderDef(VoxelRenderDefinition
 	return id;
 }
 
+void ChunkRenderDefinition::setVoxelRenderDefID(SNInt x, int y, WEInt z, VoxelRenderDefID id)
+{
+	DebugAssert((id == ChunkRenderDefinition::NO_VOXEL_ID) ||
+		(id < static_cast<VoxelRenderDefID>(this->voxelRenderDefs.size())));
+	this->voxelRenderDefIDs.set(x, y, z, id);
+}
+
 void ChunkRenderDefinition::clear()
 {
 	this->voxelRenderDefs.clear();
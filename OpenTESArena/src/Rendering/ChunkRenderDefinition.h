@@ -33,9 +33,11 @@ public:
 	SNInt getWidth() const;
 	int getHeight() const;
 	WEInt getDepth() const;
+	int getVoxelRenderDefCount() const;
 	VoxelRenderDefID getVoxelRenderDefID(SNInt x, int y, WEInt z) const;
 
 	VoxelRenderDefID addVoxelRenderDef(VoxelRenderDefinition &&def);
+	void setVoxelRenderDefID(SNInt x, int y, WEInt z, VoxelRenderDefID id);
 	void clear();
 };
 
@@ -23,7 +23,27 @@ private:
 	T textureID;
 	AlphaType alphaType;
 public:
+	RectangleRenderDefinition()
+	{
+		this->textureID = -1;
+		this->alphaType = AlphaType::Opaque;
+	}
+
+	void init(T textureID, AlphaType alphaType)
+	{
+		this->textureID = textureID;
+		this->alphaType = alphaType;
+	}
 
+	T getTextureID() const
+	{
+		return this->textureID;
+	}
+
+	AlphaType getAlphaType() const
+	{
+		return this->alphaType;
+	}
 };
 
 using VoxelRectangleRenderDefinition = RectangleRenderDefinition<VoxelTextureID>;
@@ -1 +1,130 @@
-#include "RenderDataBuilder.h"
\ No newline at end of file
+#include <array>
+#include <limits>
+
+#include "RenderDataBuilder.h"
+#include "../World/Chunk.h"
+#include "../World/VoxelDefinition.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	VoxelRectangleRenderDefinition::AlphaType GetVoxelAlphaType(ArenaTypes::VoxelType voxelType)
+	{
+		switch (voxelType)
+		{
+		case ArenaTypes::VoxelType::TransparentWall:
+		case ArenaTypes::VoxelType::Edge:
+		case ArenaTypes::VoxelType::Door:
+			return VoxelRectangleRenderDefinition::AlphaType::AlphaTested;
+		default:
+			return VoxelRectangleRenderDefinition::AlphaType::Opaque;
+		}
+	}
+
+	VoxelRenderDefinition MakeVoxelRenderDefinition(const VoxelDefinition &voxelDef,
+		const VoxelTextureIdFunc &textureIdFunc)
+	{
+		VoxelRenderDefinition renderDef;
+		renderDef.init(voxelDef);
+
+		const VoxelRectangleRenderDefinition::AlphaType alphaType = GetVoxelAlphaType(voxelDef.type);
+
+		// One rectangle per texture, in the voxel definition's texture order.
+		const int textureCount = voxelDef.getTextureAssetReferenceCount();
+		for (int i = 0; i < textureCount; i++)
+		{
+			const TextureAssetReference &textureAssetRef = voxelDef.getTextureAssetReference(i);
+
+			VoxelTextureID textureID;
+			if (!textureIdFunc(textureAssetRef, &textureID))
+			{
+				DebugLogWarning("Couldn't get voxel texture ID for \"" + textureAssetRef.filename + "\".");
+				textureID = -1;
+			}
+
+			VoxelRectangleRenderDefinition rect;
+			rect.init(textureID, alphaType);
+			renderDef.addRect(rect);
+		}
+
+		// Axis-aligned faces are known ahead of time for box-like voxels. Other voxel types depend on
+		// instance state (door percent, chasm walls) or aren't aligned to a voxel face.
+		const ArenaTypes::VoxelType voxelType = voxelDef.type;
+		if ((voxelType == ArenaTypes::VoxelType::Wall) || (voxelType == ArenaTypes::VoxelType::Raised))
+		{
+			constexpr std::array<int, 2> sideAxes = { 0, 2 };
+			for (const int axis : sideAxes)
+			{
+				renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(axis, true),
+					VoxelRenderDefinition::SIDE_RECT_INDEX);
+				renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(axis, false),
+					VoxelRenderDefinition::SIDE_RECT_INDEX);
+			}
+
+			renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(1, true),
+				VoxelRenderDefinition::FLOOR_RECT_INDEX);
+			renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(1, false),
+				VoxelRenderDefinition::CEILING_RECT_INDEX);
+		}
+		else if (voxelType == ArenaTypes::VoxelType::Floor)
+		{
+			renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(1, true),
+				VoxelRenderDefinition::DEFAULT_RECT_INDEX);
+		}
+		else if (voxelType == ArenaTypes::VoxelType::Ceiling)
+		{
+			renderDef.addFaceIndex(VoxelRenderDefinition::getFaceIndex(1, false),
+				VoxelRenderDefinition::DEFAULT_RECT_INDEX);
+		}
+
+		return renderDef;
+	}
+}
+
+void RenderDataBuilder::makeChunkDefinition(const Chunk &chunk, const VoxelTextureIdFunc &textureIdFunc,
+	ChunkRenderDefinition *outDef)
+{
+	DebugAssert(outDef != nullptr);
+
+	const SNInt width = Chunk::WIDTH;
+	const int height = chunk.getHeight();
+	const WEInt depth = Chunk::DEPTH;
+	outDef->init(width, height, depth, chunk.getCoord());
+
+	// Voxel render definitions are made the first time their voxel definition is used so unused
+	// voxel definitions don't get one.
+	constexpr int voxelIDCount = static_cast<int>(std::numeric_limits<Chunk::VoxelID>::max()) + 1;
+	std::array<VoxelRenderDefID, voxelIDCount> renderDefIDs;
+	std::array<bool, voxelIDCount> visitedVoxelIDs;
+	renderDefIDs.fill(ChunkRenderDefinition::NO_VOXEL_ID);
+	visitedVoxelIDs.fill(false);
+
+	for (WEInt z = 0; z < depth; z++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			for (SNInt x = 0; x < width; x++)
+			{
+				const Chunk::VoxelID voxelID = chunk.getVoxel(x, y, z);
+				if (!visitedVoxelIDs[voxelID])
+				{
+					visitedVoxelIDs[voxelID] = true;
+
+					const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+					if (voxelDef.type != ArenaTypes::VoxelType::None)
+					{
+						renderDefIDs[voxelID] = outDef->addVoxelRenderDef(
+							MakeVoxelRenderDefinition(voxelDef, textureIdFunc));
+					}
+				}
+
+				const VoxelRenderDefID renderDefID = renderDefIDs[voxelID];
+				if (renderDefID != ChunkRenderDefinition::NO_VOXEL_ID)
+				{
+					outDef->setVoxelRenderDefID(x, y, z, renderDefID);
+				}
+			}
+		}
+	}
+}
@@ -1,17 +1,25 @@
 #ifndef RENDER_DATA_BUILDER_H
 #define RENDER_DATA_BUILDER_H
 
+#include "ChunkRenderDefinition.h"
 #include "RenderCamera.h"
 #include "RenderDefinitionGroup.h"
 #include "RenderInstanceGroup.h"
+#include "RenderTextureUtils.h"
 
 // Generates bulk render data from gameplay data to be passed to a renderer.
 
+class Chunk;
+
 namespace RenderDataBuilder
 {
+	// Converts a chunk's voxels to a flat grid of render definition IDs with one voxel render
+	// definition per unique voxel definition in the chunk.
+	void makeChunkDefinition(const Chunk &chunk, const VoxelTextureIdFunc &textureIdFunc,
+		ChunkRenderDefinition *outDef);
+
 	// @todo: pass gameplay data as parameters
 	RenderCamera makeCamera();
-	RenderDefinitionGroup makeDefinitions();
 	RenderInstanceGroup makeInstances();
 }
 
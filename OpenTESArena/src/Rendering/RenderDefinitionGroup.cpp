@@ -1 +1,92 @@
-#include "RenderDefinitionGroup.h"
\ No newline at end of file
+#include <utility>
+
+#include "RenderDataBuilder.h"
+#include "RenderDefinitionGroup.h"
+#include "../World/Chunk.h"
+#include "../World/ChunkManager.h"
+
+#include "components/debug/Debug.h"
+
+RenderDefinitionGroup::ChunkEntry::ChunkEntry()
+{
+	this->revision = 0;
+	this->valid = false;
+}
+
+RenderDefinitionGroup::RenderDefinitionGroup()
+{
+	this->chunkEntryCount = 0;
+	this->textureGeneration = 0;
+}
+
+int RenderDefinitionGroup::getChunkRenderDefCount() const
+{
+	return this->chunkEntryCount;
+}
+
+const ChunkRenderDefinition &RenderDefinitionGroup::getChunkRenderDef(int index) const
+{
+	DebugAssert(index >= 0);
+	DebugAssert(index < this->chunkEntryCount);
+	return this->chunkEntries[index].def;
+}
+
+int RenderDefinitionGroup::updateChunkRenderDefs(const ChunkManager &chunkManager,
+	const VoxelTextureIdFunc &textureIdFunc, uint64_t textureGeneration)
+{
+	const bool texturesChanged = textureGeneration != this->textureGeneration;
+	this->textureGeneration = textureGeneration;
+
+	const int chunkCount = chunkManager.getChunkCount();
+	if (static_cast<int>(this->chunkEntries.size()) < chunkCount)
+	{
+		this->chunkEntries.resize(chunkCount);
+	}
+
+	int rebuildCount = 0;
+	for (int i = 0; i < chunkCount; i++)
+	{
+		const Chunk &chunk = chunkManager.getChunk(i);
+		const ChunkInt2 &chunkCoord = chunk.getCoord();
+
+		// The chunk manager reorders its chunks when some are recycled, so find this chunk's
+		// previous definition (if any) instead of rebuilding it.
+		ChunkEntry *entryPtr = &this->chunkEntries[i];
+		if (!entryPtr->valid || (entryPtr->def.getCoord() != chunkCoord))
+		{
+			for (int j = i + 1; j < static_cast<int>(this->chunkEntries.size()); j++)
+			{
+				ChunkEntry &otherEntry = this->chunkEntries[j];
+				if (otherEntry.valid && (otherEntry.def.getCoord() == chunkCoord))
+				{
+					std::swap(*entryPtr, otherEntry);
+					break;
+				}
+			}
+		}
+
+		ChunkEntry &entry = *entryPtr;
+		const uint64_t chunkRevision = chunk.getRevision();
+		if (!entry.valid || texturesChanged || (entry.def.getCoord() != chunkCoord) ||
+			(entry.revision != chunkRevision))
+		{
+			RenderDataBuilder::makeChunkDefinition(chunk, textureIdFunc, &entry.def);
+			entry.revision = chunkRevision;
+			entry.valid = true;
+			rebuildCount++;
+		}
+	}
+
+	this->chunkEntryCount = chunkCount;
+	return rebuildCount;
+}
+
+void RenderDefinitionGroup::clear()
+{
+	for (ChunkEntry &entry : this->chunkEntries)
+	{
+		entry.valid = false;
+	}
+
+	this->chunkEntryCount = 0;
+}
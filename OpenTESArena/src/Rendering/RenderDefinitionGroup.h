@@ -1,7 +1,12 @@
 #ifndef RENDER_DEFINITION_GROUP_H
 #define RENDER_DEFINITION_GROUP_H
 
+#include <cstdint>
+#include <vector>
+
+#include "ChunkRenderDefinition.h"
 #include "EntityRenderDefinition.h"
+#include "RenderTextureUtils.h"
 #include "SkyObjectRenderDefinition.h"
 #include "VoxelRenderDefinition.h"
 
@@ -10,14 +15,40 @@
 // It's useful to generate more data than may seem useful in case of render features like shadows
 // that frequently need off-screen data.
 
+class ChunkManager;
+
 class RenderDefinitionGroup
 {
 private:
-	// @todo: collections of voxel/entity/sky-object render definitions
-	// - might have ChunkRenderDefinition for voxels, or not if an array is fine (indexable by
-	//   voxel render instances).
+	struct ChunkEntry
+	{
+		ChunkRenderDefinition def;
+		uint64_t revision; // Chunk revision the definition was built from.
+		bool valid;
+
+		ChunkEntry();
+	};
+
+	// Chunk render definitions in the same order as the chunk manager's active chunks so a renderer
+	// can index them with a chunk index. Entries past the active count are kept for reuse.
+	std::vector<ChunkEntry> chunkEntries;
+	int chunkEntryCount;
+	uint64_t textureGeneration; // Renderer texture set the definitions' texture IDs point into.
+
+	// @todo: collections of entity/sky-object render definitions
 public:
+	RenderDefinitionGroup();
+
+	int getChunkRenderDefCount() const;
+	const ChunkRenderDefinition &getChunkRenderDef(int index) const;
+
+	// Brings chunk render definitions in line with the chunk manager, only rebuilding ones whose
+	// chunk has changed since they were built (or all of them if the renderer's textures changed).
+	// Returns the number of definitions rebuilt.
+	int updateChunkRenderDefs(const ChunkManager &chunkManager, const VoxelTextureIdFunc &textureIdFunc,
+		uint64_t textureGeneration);
 
+	void clear();
 };
 
 #endif
@@ -1,10 +1,11 @@
 #include "RenderInitSettings.h"
 
-void RenderInitSettings::init(int width, int height, int renderThreadsMode)
+void RenderInitSettings::init(int width, int height, int renderThreadsMode, bool lightTableShading)
 {
     this->width = width;
     this->height = height;
     this->renderThreadsMode = renderThreadsMode;
+    this->lightTableShading = lightTableShading;
 }
 
 int RenderInitSettings::getWidth() const
@@ -21,3 +22,8 @@ int RenderInitSettings::getRenderThreadsMode() const
 {
     return renderThreadsMode;
 }
+
+bool RenderInitSettings::getLightTableShading() const
+{
+    return lightTableShading;
+}
@@ -13,12 +13,14 @@ private:
 
 	int width, height;
 	int renderThreadsMode;
+	bool lightTableShading;
 public:
-	void init(int width, int height, int renderThreadsMode);
+	void init(int width, int height, int renderThreadsMode, bool lightTableShading);
 
 	int getWidth() const;
 	int getHeight() const;
 	int getRenderThreadsMode() const;
+	bool getLightTableShading() const;
 };
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef RENDER_TEXTURE_UTILS_H
 #define RENDER_TEXTURE_UTILS_H
 
+#include <functional>
+
 #include "../Math/Vector2.h"
 
 // Common texture handles allocated by a renderer for a user when they want a new texture in the
@@ -13,6 +15,12 @@ using UiTextureID = int; // Used with all UI textures.
 
 class Renderer;
 
+struct TextureAssetReference;
+
+// Gets a renderer's texture ID for a texture asset reference. Returns false if the renderer doesn't
+// have the texture.
+using VoxelTextureIdFunc = std::function<bool(const TextureAssetReference&, VoxelTextureID*)>;
+
 // Convenience classes for creating and automatically destroying a texture.
 // @temp: commented out until the renderers are working with texture builders and texture IDs instead of
 // TextureAssetReferences for texture handle creation/destruction.
@@ -100,10 +100,17 @@ Renderer::ProfilerData::ProfilerData()
 	this->visFlatCount = -1;
 	this->visLightCount = -1;
 	this->frameTime = 0.0;
+	this->distantSkyTime = 0.0;
+	this->skyPanoramaRebuildTime = 0.0;
+	this->frameAllocByteCount = -1;
+	this->frameHeapAllocCount = -1;
+	this->chunkRenderDefRebuildCount = -1;
 }
 
 void Renderer::ProfilerData::init(int width, int height, int threadCount, int potentiallyVisFlatCount,
-	int visFlatCount, int visLightCount, double frameTime)
+	int visFlatCount, int visLightCount, double frameTime, double distantSkyTime,
+	double skyPanoramaRebuildTime, int frameAllocByteCount, int frameHeapAllocCount,
+	int chunkRenderDefRebuildCount)
 {
 	this->width = width;
 	this->height = height;
@@ -112,6 +119,11 @@ void Renderer::ProfilerData::init(int width, int height, int threadCount, int po
 	this->visFlatCount = visFlatCount;
 	this->visLightCount = visLightCount;
 	this->frameTime = frameTime;
+	this->distantSkyTime = distantSkyTime;
+	this->skyPanoramaRebuildTime = skyPanoramaRebuildTime;
+	this->frameAllocByteCount = frameAllocByteCount;
+	this->frameHeapAllocCount = frameHeapAllocCount;
+	this->chunkRenderDefRebuildCount = chunkRenderDefRebuildCount;
 }
 
 const char *Renderer::DEFAULT_RENDER_SCALE_QUALITY = "nearest";
@@ -742,7 +754,7 @@ void Renderer::setClipRect(const SDL_Rect *rect)
 }
 
 void Renderer::initializeWorldRendering(double resolutionScale, bool fullGameWindow,
-	int renderThreadsMode)
+	int renderThreadsMode, bool lightTableShading)
 {
 	this->fullGameWindow = fullGameWindow;
 
@@ -759,7 +771,7 @@ void Renderer::initializeWorldRendering(double resolutionScale, bool fullGameWin
 
 	// Initialize 3D rendering.
 	RenderInitSettings initSettings;
-	initSettings.init(renderWidth, renderHeight, renderThreadsMode);
+	initSettings.init(renderWidth, renderHeight, renderThreadsMode, lightTableShading);
 	this->renderer3D->init(initSettings);
 }
 
@@ -769,6 +781,12 @@ void Renderer::setRenderThreadsMode(int mode)
 	this->renderer3D->setRenderThreadsMode(mode);
 }
 
+void Renderer::setLightTableShading(bool enabled)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->renderer3D->setLightTableShading(enabled);
+}
+
 bool Renderer::tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef, TextureManager &textureManager)
 {
 	return this->renderer3D->tryCreateVoxelTexture(textureAssetRef, textureManager);
@@ -990,7 +1008,9 @@ void Renderer::renderWorld(const CoordDouble3 &eye, const Double3 &direction, do
 	const RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
 	this->profilerData.init(swProfilerData.width, swProfilerData.height, swProfilerData.threadCount,
 		swProfilerData.potentiallyVisFlatCount, swProfilerData.visFlatCount, swProfilerData.visLightCount,
-		frameTime);
+		frameTime, swProfilerData.distantSkyTime, swProfilerData.skyPanoramaRebuildTime,
+		swProfilerData.frameAllocByteCount, swProfilerData.frameHeapAllocCount,
+		swProfilerData.chunkRenderDefRebuildCount);
 
 	// Update the game world texture with the new ARGB8888 pixels.
 	SDL_UnlockTexture(this->gameWorldTexture.get());
@@ -67,10 +67,21 @@ public:
 
 		double frameTime;
 
+		// Distant sky draw time and the most recent sky panorama rebuild time.
+		double distantSkyTime, skyPanoramaRebuildTime;
+
+		// Bytes of frame temporaries and heap allocations the frame allocator needed for them.
+		int frameAllocByteCount, frameHeapAllocCount;
+
+		// Chunk render definitions rebuilt this frame due to chunk changes.
+		int chunkRenderDefRebuildCount;
+
 		ProfilerData();
 
 		void init(int width, int height, int threadCount, int potentiallyVisFlatCount,
-			int visFlatCount, int visLightCount, double frameTime);
+			int visFlatCount, int visLightCount, double frameTime, double distantSkyTime,
+			double skyPanoramaRebuildTime, int frameAllocByteCount, int frameHeapAllocCount,
+			int chunkRenderDefRebuildCount);
 	};
 
 	using ResolutionScaleFunc = std::function<double()>;
@@ -196,11 +207,14 @@ public:
 	// the game interface. If there is an existing renderer in memory, it will be 
 	// overwritten with the new one.
 	void initializeWorldRendering(double resolutionScale, bool fullGameWindow,
-		int renderThreadsMode);
+		int renderThreadsMode, bool lightTableShading);
 
 	// Sets which mode to use for software render threads (low, medium, high, etc.).
 	void setRenderThreadsMode(int mode);
 
+	// Sets whether the software renderer shades with per-frame light tables.
+	void setLightTableShading(bool enabled);
+
 	// Texture handle allocation functions.
 	// @todo: see RendererSystem3D -- these should take TextureBuilders instead and return optional handles.
 	bool tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef, TextureManager &textureManager);
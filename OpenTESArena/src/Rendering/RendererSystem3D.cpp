@@ -1,7 +1,8 @@
 #include "RendererSystem3D.h"
 
 RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCount, int potentiallyVisFlatCount,
-	int visFlatCount, int visLightCount)
+	int visFlatCount, int visLightCount, double distantSkyTime, double skyPanoramaRebuildTime,
+	int frameAllocByteCount, int frameHeapAllocCount, int chunkRenderDefRebuildCount)
 {
 	this->width = width;
 	this->height = height;
@@ -9,6 +10,11 @@ RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCo
 	this->potentiallyVisFlatCount = potentiallyVisFlatCount;
 	this->visFlatCount = visFlatCount;
 	this->visLightCount = visLightCount;
+	this->distantSkyTime = distantSkyTime;
+	this->skyPanoramaRebuildTime = skyPanoramaRebuildTime;
+	this->frameAllocByteCount = frameAllocByteCount;
+	this->frameHeapAllocCount = frameHeapAllocCount;
+	this->chunkRenderDefRebuildCount = chunkRenderDefRebuildCount;
 }
 
 RendererSystem3D::~RendererSystem3D()
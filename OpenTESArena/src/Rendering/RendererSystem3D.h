@@ -42,9 +42,13 @@ public:
 		int width, height;
 		int threadCount;
 		int potentiallyVisFlatCount, visFlatCount, visLightCount;
+		double distantSkyTime, skyPanoramaRebuildTime;
+		int frameAllocByteCount, frameHeapAllocCount; // Frame allocator usage and block allocations.
+		int chunkRenderDefRebuildCount; // Chunk render definitions rebuilt this frame.
 
 		ProfilerData(int width, int height, int threadCount, int potentiallyVisFlatCount,
-			int visFlatCount, int visLightCount);
+			int visFlatCount, int visLightCount, double distantSkyTime, double skyPanoramaRebuildTime,
+			int frameAllocByteCount, int frameHeapAllocCount, int chunkRenderDefRebuildCount);
 	};
 
 	virtual ~RendererSystem3D();
@@ -87,6 +91,7 @@ public:
 
 	// Legacy functions (remove these eventually).
 	virtual void setRenderThreadsMode(int mode) = 0;
+	virtual void setLightTableShading(bool enabled) = 0;
 	virtual void setFogDistance(double fogDistance) = 0;
 	virtual void addChasmTexture(ArenaTypes::ChasmType chasmType, const uint8_t *colors,
 		int width, int height, const Palette &palette) = 0;
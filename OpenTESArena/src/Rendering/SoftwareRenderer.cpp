@@ -1,6 +1,8 @@
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <tuple>
 
 #include "ArenaRenderUtils.h"
@@ -22,6 +24,7 @@
 #include "../Media/TextureManager.h"
 #include "../UI/Surface.h"
 #include "../Utilities/Platform.h"
+#include "../World/ArenaSkyUtils.h"
 #include "../World/ArenaVoxelUtils.h"
 #include "../World/ArenaWeatherUtils.h"
 #include "../World/ChunkManager.h"
@@ -34,6 +37,7 @@
 #include "../World/WeatherInstance.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/TraceProfiler.h"
 
 namespace
 {
@@ -42,6 +46,35 @@ namespace
 	constexpr bool LightContributionCap = true;
 
 	constexpr double DEPTH_BUFFER_INFINITY = std::numeric_limits<double>::infinity();
+
+	// Size of each frame allocator block in bytes. Enough for a typical frame's temporaries.
+	constexpr int FRAME_ALLOCATOR_BLOCK_SIZE = 16384;
+
+	// Scales each channel of an RGB color by a visibility percent in the range [0, 255].
+	uint32_t diminishColor(uint32_t color, uint8_t visPercent)
+	{
+		const uint32_t r = (((color >> 16) & 0xFF) * visPercent) / 255;
+		const uint32_t g = (((color >> 8) & 0xFF) * visPercent) / 255;
+		const uint32_t b = ((color & 0xFF) * visPercent) / 255;
+		return (r << 16) | (g << 8) | b;
+	}
+
+	// Lerps each channel of a star color towards the sky gradient color by a percent in the range [0, 255].
+	uint32_t blendStarColor(uint32_t starColor, uint32_t gradientColor, uint8_t gradientPercent)
+	{
+		const int percent = gradientPercent;
+		auto blendChannel = [percent](uint32_t star, uint32_t gradient)
+		{
+			const int starValue = static_cast<int>(star & 0xFF);
+			const int gradientValue = static_cast<int>(gradient & 0xFF);
+			return static_cast<uint32_t>(starValue + (((gradientValue - starValue) * percent) / 255));
+		};
+
+		const uint32_t r = blendChannel(starColor >> 16, gradientColor >> 16);
+		const uint32_t g = blendChannel(starColor >> 8, gradientColor >> 8);
+		const uint32_t b = blendChannel(starColor, gradientColor);
+		return (r << 16) | (g << 8) | b;
+	}
 }
 
 void SoftwareRenderer::VoxelTexel::init(double r, double g, double b, double emission,
@@ -91,6 +124,7 @@ void SoftwareRenderer::VoxelTexture::init(int width, int height, const uint8_t *
 	DebugAssert(srcTexels != nullptr);
 
 	this->texels.resize(width * height);
+	this->lightTableTexels.resize(width * height);
 	this->lightTexels.clear();
 	this->width = width;
 	this->height = height;
@@ -112,6 +146,7 @@ void SoftwareRenderer::VoxelTexture::init(int width, int height, const uint8_t *
 
 			VoxelTexel &dstTexel = this->texels[index];
 			dstTexel.init(r, g, b, emission, transparent);
+			this->lightTableTexels[index] = srcTexel;
 
 			// Check if the texel is used with night lights (yellow at night).
 			if (srcTexel == ArenaRenderUtils::PALETTE_INDEX_NIGHT_LIGHT)
@@ -145,6 +180,9 @@ void SoftwareRenderer::VoxelTexture::setLightTexelsActive(bool active, const Pal
 		const double emission = texelEmission;
 		const bool transparent = texelColor.w == 0.0;
 		texel.init(r, g, b, emission, transparent);
+
+		const uint16_t paletteIndex = static_cast<uint16_t>(active ? activePaletteIndex : inactivePaletteIndex);
+		this->lightTableTexels[index] = active ? (paletteIndex | LightTable::EMISSIVE_BIT) : paletteIndex;
 	}
 }
 
@@ -232,6 +270,33 @@ void SoftwareRenderer::SkyTexture::init(int width, int height, const uint8_t *sr
 	}
 }
 
+SoftwareRenderer::StarTexture::StarTexture()
+{
+	this->width = 0;
+	this->height = 0;
+}
+
+void SoftwareRenderer::StarTexture::init(const SkyTexture &skyTexture)
+{
+	DebugAssert(skyTexture.width > 0);
+	DebugAssert(skyTexture.height > 0);
+
+	this->texels.resize(skyTexture.texels.size());
+	this->width = skyTexture.width;
+	this->height = skyTexture.height;
+
+	for (size_t i = 0; i < skyTexture.texels.size(); i++)
+	{
+		const SkyTexel &srcTexel = skyTexture.texels[i];
+		const uint32_t alpha = (srcTexel.a != 0.0) ? 0xFF000000 : 0;
+		const uint32_t color = Double3(
+			std::min(srcTexel.r, 1.0),
+			std::min(srcTexel.g, 1.0),
+			std::min(srcTexel.b, 1.0)).toRGB();
+		this->texels[i] = alpha | (color & 0x00FFFFFF);
+	}
+}
+
 SoftwareRenderer::ChasmTexture::ChasmTexture()
 {
 	this->width = 0;
@@ -274,12 +339,26 @@ SoftwareRenderer::VoxelTextureMapping::VoxelTextureMapping(TextureAssetReference
 	this->textureIndex = textureIndex;
 }
 
+SoftwareRenderer::VoxelTextures::VoxelTextures()
+{
+	this->generation = 0;
+	this->hasMissingTexture = false;
+}
+
 void SoftwareRenderer::VoxelTextures::addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef)
 {
 	this->textures.emplace_back(std::move(texture));
 
 	const int index = static_cast<int>(this->textures.size()) - 1;
 	this->mappings.emplace_back(VoxelTextureMapping(std::move(textureAssetRef), index));
+
+	// Existing texture IDs are unchanged by appending, so render definitions only need rebuilding if
+	// one of them was made without this texture.
+	if (this->hasMissingTexture)
+	{
+		this->generation++;
+		this->hasMissingTexture = false;
+	}
 }
 
 const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTexture(
@@ -300,10 +379,37 @@ const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTextur
 	return this->textures[index];
 }
 
+const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTexture(
+	const VoxelRenderDefinition &voxelRenderDef, int rectIndex) const
+{
+	const VoxelRectangleRenderDefinition &rect = voxelRenderDef.getRect(rectIndex);
+	const VoxelTextureID textureID = rect.getTextureID();
+	DebugAssertIndex(this->textures, textureID);
+	return this->textures[textureID];
+}
+
+bool SoftwareRenderer::VoxelTextures::tryGetTextureID(const TextureAssetReference &textureAssetRef,
+	VoxelTextureID *outID) const
+{
+	for (const VoxelTextureMapping &mapping : this->mappings)
+	{
+		if (mapping.textureAssetRef == textureAssetRef)
+		{
+			*outID = mapping.textureIndex;
+			return true;
+		}
+	}
+
+	this->hasMissingTexture = true;
+	return false;
+}
+
 void SoftwareRenderer::VoxelTextures::clear()
 {
 	this->textures.clear();
 	this->mappings.clear();
+	this->generation++;
+	this->hasMissingTexture = false;
 }
 
 SoftwareRenderer::EntityTextureMapping::EntityTextureMapping(TextureAssetReference &&textureAssetRef,
@@ -559,6 +665,7 @@ SoftwareRenderer::ShadingInfo::ShadingInfo(const Palette &palette, const std::ve
 
 	this->thunderstormFlashPercent = RendererUtils::getThunderstormFlashPercent(weatherInst);
 	this->isExterior = isExterior;
+	this->lightTable = nullptr;
 	this->ambient = ambient;
 	this->distantAmbient = RendererUtils::getDistantAmbientPercent(ambient);
 	this->fogDistance = fogDistance;
@@ -572,6 +679,94 @@ const Double3 &SoftwareRenderer::ShadingInfo::getFogColor() const
 	return this->skyColors.front();
 }
 
+SoftwareRenderer::LightTable::LightTable()
+{
+	this->paletteKey.fill(0);
+	this->fogColorKey = 0;
+}
+
+bool SoftwareRenderer::LightTable::isValid() const
+{
+	return this->colors.size() > 0;
+}
+
+void SoftwareRenderer::LightTable::update(const Palette &palette, const Double3 &fogColor)
+{
+	// The fog color is compared at the precision it's written to the frame buffer so gradual sky color
+	// changes don't rebuild the table every frame.
+	const uint32_t fogColorKey = Double3(
+		std::min(fogColor.x, 1.0),
+		std::min(fogColor.y, 1.0),
+		std::min(fogColor.z, 1.0)).toRGB();
+
+	std::array<uint32_t, COLOR_COUNT> paletteKey;
+	std::transform(palette.begin(), palette.end(), paletteKey.begin(),
+		[](const Color &color) { return color.toARGB(); });
+
+	if (this->isValid() && (fogColorKey == this->fogColorKey) && (paletteKey == this->paletteKey))
+	{
+		return;
+	}
+
+	this->colors.resize(FOG_STEP_COUNT * LIGHT_LEVEL_COUNT * COLOR_COUNT);
+	this->paletteKey = paletteKey;
+	this->fogColorKey = fogColorKey;
+
+	// Same shading as the floating point path, evaluated once per light level and fog step.
+	for (int fogStep = 0; fogStep < FOG_STEP_COUNT; fogStep++)
+	{
+		const double fogPercent = static_cast<double>(fogStep) / static_cast<double>(FOG_STEP_COUNT - 1);
+
+		for (int lightLevel = 0; lightLevel < LIGHT_LEVEL_COUNT; lightLevel++)
+		{
+			const double lightPercent = static_cast<double>(lightLevel) / static_cast<double>(LIGHT_LEVEL_COUNT - 1);
+			uint32_t *dstColors = this->colors.data() + (((fogStep * LIGHT_LEVEL_COUNT) + lightLevel) * COLOR_COUNT);
+
+			for (int i = 0; i < COLOR_COUNT; i++)
+			{
+				const Double4 texelColor = Double4::fromARGB(paletteKey[i]);
+				double colorR = texelColor.x * lightPercent;
+				double colorG = texelColor.y * lightPercent;
+				double colorB = texelColor.z * lightPercent;
+
+				colorR += (fogColor.x - colorR) * fogPercent;
+				colorG += (fogColor.y - colorG) * fogPercent;
+				colorB += (fogColor.z - colorB) * fogPercent;
+
+				dstColors[i] = Double3(std::min(colorR, 1.0), std::min(colorG, 1.0), std::min(colorB, 1.0)).toRGB();
+			}
+		}
+	}
+}
+
+int SoftwareRenderer::LightTable::getLightLevel(double lightPercent)
+{
+	const double lightLevelReal = std::clamp(lightPercent, 0.0, 1.0) * static_cast<double>(LIGHT_LEVEL_COUNT - 1);
+	return static_cast<int>(lightLevelReal + 0.50);
+}
+
+int SoftwareRenderer::LightTable::getFogStep(double fogPercent)
+{
+	const double fogStepReal = std::clamp(fogPercent, 0.0, 1.0) * static_cast<double>(FOG_STEP_COUNT - 1);
+	return static_cast<int>(fogStepReal + 0.50);
+}
+
+const uint32_t *SoftwareRenderer::LightTable::getColors(int lightLevel, int fogStep) const
+{
+	DebugAssert(lightLevel >= 0);
+	DebugAssert(lightLevel < LIGHT_LEVEL_COUNT);
+	DebugAssert(fogStep >= 0);
+	DebugAssert(fogStep < FOG_STEP_COUNT);
+	return this->colors.data() + (((fogStep * LIGHT_LEVEL_COUNT) + lightLevel) * COLOR_COUNT);
+}
+
+void SoftwareRenderer::LightTable::clear()
+{
+	this->colors.clear();
+	this->paletteKey.fill(0);
+	this->fogColorKey = 0;
+}
+
 SoftwareRenderer::FrameView::FrameView(uint32_t *colorBuffer, double *depthBuffer, 
 	int width, int height)
 {
@@ -809,8 +1004,6 @@ SoftwareRenderer::VisDistantObjects::VisDistantObjects()
 	this->moonEnd = 0;
 	this->sunStart = 0;
 	this->sunEnd = 0;
-	this->starStart = 0;
-	this->starEnd = 0;
 	this->lightningStart = 0;
 	this->lightningEnd = 0;
 }
@@ -826,12 +1019,46 @@ void SoftwareRenderer::VisDistantObjects::clear()
 	this->moonEnd = 0;
 	this->sunStart = 0;
 	this->sunEnd = 0;
-	this->starStart = 0;
-	this->starEnd = 0;
 	this->lightningStart = 0;
 	this->lightningEnd = 0;
 }
 
+void SoftwareRenderer::SkyPanoramaTexel::init(uint32_t color, uint8_t visPercent)
+{
+	this->color = color;
+	this->visPercent = visPercent;
+}
+
+SoftwareRenderer::SkyPanorama::SkyPanorama()
+{
+	this->topHeight = 0.0;
+	this->bottomHeight = 0.0;
+	this->yStart = 0;
+	this->yEnd = 0;
+	this->distantAmbientKey = -1;
+}
+
+bool SoftwareRenderer::SkyPanorama::isValid() const
+{
+	return this->texels.isValid() && (this->distantAmbientKey >= 0);
+}
+
+void SoftwareRenderer::SkyPanorama::invalidate()
+{
+	this->distantAmbientKey = -1;
+}
+
+void SoftwareRenderer::SkyPanorama::clear()
+{
+	this->texels.clear();
+	this->animLandIndices.clear();
+	this->topHeight = 0.0;
+	this->bottomHeight = 0.0;
+	this->yStart = 0;
+	this->yEnd = 0;
+	this->distantAmbientKey = -1;
+}
+
 void SoftwareRenderer::VisibleLight::init(const CoordDouble3 &coord, double radius)
 {
 	this->coord = coord;
@@ -891,7 +1118,7 @@ void SoftwareRenderer::VisibleLightList::sortByNearest(const CoordDouble3 &coord
 }
 
 void SoftwareRenderer::RenderThreadData::SkyGradient::init(double projectedYTop, double projectedYBottom,
-	Buffer<Double3> &rowCache)
+	Buffer<SkyGradientRow> &rowCache)
 {
 	this->threadsDone = 0;
 	this->rowCache = &rowCache;
@@ -901,23 +1128,29 @@ void SoftwareRenderer::RenderThreadData::SkyGradient::init(double projectedYTop,
 }
 
 void SoftwareRenderer::RenderThreadData::DistantSky::init(const VisDistantObjects &visDistantObjs,
-	const std::vector<SkyTexture> &skyTextures)
+	const std::vector<SkyTexture> &skyTextures, const SkyPanorama &skyPanorama,
+	const std::vector<VisibleStar> &visibleStars)
 {
 	this->threadsDone = 0;
 	this->visDistantObjs = &visDistantObjs;
 	this->skyTextures = &skyTextures;
+	this->skyPanorama = &skyPanorama;
+	this->visibleStars = &visibleStars;
+	this->drawTime = 0.0;
 	this->doneVisTesting = false;
 }
 
 void SoftwareRenderer::RenderThreadData::Voxels::init(int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const std::vector<VisibleLight> &visLights,
-	const VisibleLightLists &visLightLists, const VoxelTextures &voxelTextures,
-	const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion)
+	const ChunkManager &chunkManager, const RenderDefinitionGroup &renderDefGroup,
+	const std::vector<VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+	const VoxelTextures &voxelTextures, const ChasmTextureGroups &chasmTextureGroups,
+	Buffer<OcclusionData> &occlusion)
 {
 	this->threadsDone = 0;
 	this->chunkDistance = chunkDistance;
 	this->ceilingScale = ceilingScale;
 	this->chunkManager = &chunkManager;
+	this->renderDefGroup = &renderDefGroup;
 	this->visLights = &visLights;
 	this->visLightLists = &visLightLists;
 	this->voxelTextures = &voxelTextures;
@@ -939,11 +1172,11 @@ void SoftwareRenderer::RenderThreadData::Flats::init(const VoxelDouble3 &flatNor
 	this->doneSorting = false;
 }
 
-void SoftwareRenderer::RenderThreadData::Weather::init(const WeatherInstance &weatherInst, Random &random)
+void SoftwareRenderer::RenderThreadData::Weather::init(const WeatherInstance &weatherInst, uint64_t randomSeed)
 {
 	this->threadsDone = 0;
 	this->weatherInst = &weatherInst;
-	this->random = &random;
+	this->randomSeed = randomSeed;
 	this->doneDrawingFlats = false;
 }
 
@@ -975,7 +1208,11 @@ SoftwareRenderer::SoftwareRenderer()
 	this->width = 0;
 	this->height = 0;
 	this->renderThreadsMode = 0;
+	this->lightTableShading = false;
 	this->fogDistance = 0.0;
+	this->distantSkyTime = 0.0;
+	this->skyPanoramaRebuildTime = 0.0;
+	this->chunkRenderDefRebuildCount = 0;
 }
 
 SoftwareRenderer::~SoftwareRenderer()
@@ -993,9 +1230,11 @@ SoftwareRenderer::ProfilerData SoftwareRenderer::getProfilerData() const
 {
 	// @todo: make this a member of SoftwareRenderer eventually when it is capturing more
 	// information in render(), etc..
+	const FrameAllocator::Stats &frameAllocatorStats = this->frameAllocator.getStats();
 	return ProfilerData(this->width, this->height, this->renderThreads.getCount(),
 		static_cast<int>(this->potentiallyVisibleFlats.size()), static_cast<int>(this->visibleFlats.size()),
-		static_cast<int>(this->visibleLights.size()));
+		static_cast<int>(this->visibleLights.size()), this->distantSkyTime, this->skyPanoramaRebuildTime,
+		frameAllocatorStats.peakByteCount, frameAllocatorStats.heapAllocCount, this->chunkRenderDefRebuildCount);
 }
 
 bool SoftwareRenderer::tryGetEntitySelectionData(const Double2 &uv, const TextureAssetReference &textureAssetRef,
@@ -1074,7 +1313,7 @@ void SoftwareRenderer::init(const RenderInitSettings &settings)
 
 	// Initialize sky gradient cache.
 	this->skyGradientRowCache.init(settings.getHeight());
-	this->skyGradientRowCache.fill(Double3::Zero);
+	this->skyGradientRowCache.fill(SkyGradientRow());
 
 	// Initialize texture containers.
 	this->voxelTextures = VoxelTextures();
@@ -1083,10 +1322,14 @@ void SoftwareRenderer::init(const RenderInitSettings &settings)
 	this->width = settings.getWidth();
 	this->height = settings.getHeight();
 	this->renderThreadsMode = settings.getRenderThreadsMode();
+	this->lightTableShading = settings.getLightTableShading();
+	this->lightTable.clear();
 
 	// Fog distance is zero by default.
 	this->fogDistance = 0.0;
 
+	this->frameAllocator.init(FRAME_ALLOCATOR_BLOCK_SIZE);
+
 	// Initialize render threads.
 	const int threadCount = RendererUtils::getRenderThreadsFromMode(settings.getRenderThreadsMode());
 	this->initRenderThreads(settings.getWidth(), settings.getHeight(), threadCount);
@@ -1106,6 +1349,16 @@ void SoftwareRenderer::setRenderThreadsMode(int mode)
 	this->initRenderThreads(this->width, this->height, threadCount);
 }
 
+void SoftwareRenderer::setLightTableShading(bool enabled)
+{
+	this->lightTableShading = enabled;
+
+	if (!enabled)
+	{
+		this->lightTable.clear();
+	}
+}
+
 void SoftwareRenderer::setFogDistance(double fogDistance)
 {
 	this->fogDistance = fogDistance;
@@ -1117,9 +1370,48 @@ void SoftwareRenderer::setSky(const SkyInstance &skyInstance, const Palette &pal
 	// Clear old distant sky data.
 	this->distantObjects.clear();
 	this->skyTextures.clear();
+	this->skyPanorama.clear();
+	this->starTextures.clear();
+	this->starTextureRefs.clear();
+	this->visibleStars.clear();
 
 	// Create distant objects and set the sky textures.
 	this->distantObjects.init(skyInstance, this->skyTextures, palette, textureManager);
+
+	// Pack the textures used by stars so the star pass doesn't need to touch the float texels.
+	const int starStart = this->distantObjects.starStart;
+	const int starCount = this->distantObjects.starEnd - starStart;
+	std::unordered_map<int, int> starTextureIndices; // Sky texture index -> star texture index.
+	std::vector<int> starTextureIndexList(starCount);
+	for (int i = 0; i < starCount; i++)
+	{
+		const DistantObject &star = this->distantObjects.objs.get(starStart + i);
+		DebugAssert(star.textureIndexCount == 1);
+
+		auto iter = starTextureIndices.find(star.startTextureIndex);
+		if (iter == starTextureIndices.end())
+		{
+			DebugAssertIndex(this->skyTextures, star.startTextureIndex);
+			StarTexture starTexture;
+			starTexture.init(this->skyTextures[star.startTextureIndex]);
+			this->starTextures.emplace_back(std::move(starTexture));
+
+			const int starTextureIndex = static_cast<int>(this->starTextures.size()) - 1;
+			iter = starTextureIndices.emplace(star.startTextureIndex, starTextureIndex).first;
+		}
+
+		starTextureIndexList[i] = iter->second;
+	}
+
+	// Resolve references after all star textures are added so the vector won't reallocate under them.
+	if (starCount > 0)
+	{
+		this->starTextureRefs.init(starCount);
+		for (int i = 0; i < starCount; i++)
+		{
+			this->starTextureRefs.set(i, &this->starTextures[starTextureIndexList[i]]);
+		}
+	}
 }
 
 void SoftwareRenderer::setSkyColors(const uint32_t *colors, int count)
@@ -1164,12 +1456,20 @@ void SoftwareRenderer::clearTextures()
 	this->voxelTextures.clear();
 	this->entityTextures.clear();
 	this->skyTextures.clear();
+	this->skyPanorama.clear();
+	this->starTextures.clear();
+	this->starTextureRefs.clear();
+	this->visibleStars.clear();
 	this->chasmTextureGroups.clear();
 }
 
 void SoftwareRenderer::clearSky()
 {
 	this->distantObjects.clear();
+	this->skyPanorama.clear();
+	this->starTextures.clear();
+	this->starTextureRefs.clear();
+	this->visibleStars.clear();
 }
 
 void SoftwareRenderer::resize(int width, int height)
@@ -1181,7 +1481,10 @@ void SoftwareRenderer::resize(int width, int height)
 	this->occlusion.fill(OcclusionData(0, height));
 
 	this->skyGradientRowCache.init(height);
-	this->skyGradientRowCache.fill(Double3::Zero);
+	this->skyGradientRowCache.fill(SkyGradientRow());
+
+	this->skyPanorama.screenColumns.init(width);
+	this->skyPanorama.screenRows.init(height);
 
 	this->width = width;
 	this->height = height;
@@ -1378,9 +1681,342 @@ void SoftwareRenderer::resetRenderThreads()
 	this->threadData.isDestructing = false;
 }
 
+void SoftwareRenderer::getDistantSkyProjection(const Camera &camera, double *outHorizonProjY,
+	double *outHeightPerTangent)
+{
+	// Distant objects project their bottom edge then extend their height in screen space, so their
+	// sky-space height above the horizon only depends on zoom, and yaw only moves them sideways.
+	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
+	const double horizonProjY = RendererUtils::getProjectedY(
+		absoluteEye + Double3(camera.forwardX, 0.0, camera.forwardZ), camera.transform, camera.yShear);
+	const double tangentProjY = RendererUtils::getProjectedY(
+		absoluteEye + Double3(camera.forwardX, 1.0, camera.forwardZ).normalized(), camera.transform, camera.yShear);
+
+	*outHorizonProjY = horizonProjY;
+	*outHeightPerTangent = (horizonProjY - tangentProjY) / camera.zoom;
+}
+
+void SoftwareRenderer::updateSkyPanorama(const SkyInstance &skyInstance, const ShadingInfo &shadingInfo,
+	const Camera &camera, const FrameView &frame)
+{
+	TraceZone("SoftwareRenderer::updateSkyPanorama");
+
+	SkyPanorama &panorama = this->skyPanorama;
+
+	double horizonProjY, heightPerTangent;
+	SoftwareRenderer::getDistantSkyProjection(camera, &horizonProjY, &heightPerTangent);
+
+	// One texel per column/row at the scale distant objects are drawn in the middle of the screen.
+	constexpr double rowsPerHeight = ArenaSkyUtils::IDENTITY_DIM;
+	const int columnCount = static_cast<int>(std::round(
+		Constants::Pi * ArenaSkyUtils::IDENTITY_DIM * ArenaRenderUtils::TALL_PIXEL_RATIO));
+	const double columnsPerRadian = static_cast<double>(columnCount) / Constants::TwoPi;
+
+	// Only rebuild when the sky changes or the distant ambient changes enough to affect a color channel.
+	const int distantAmbientKey = static_cast<int>(std::round(shadingInfo.distantAmbient * 255.0));
+	if (distantAmbientKey != panorama.distantAmbientKey)
+	{
+		const auto rebuildStartTime = std::chrono::high_resolution_clock::now();
+
+		struct PanoramaObject
+		{
+			const SkyTexture *texture;
+			double angle; // Yaw of the object's center.
+			double bottomHeight; // Sky-space height of the object's bottom edge.
+			bool emissive;
+		};
+
+		// Static objects in the same order they would be drawn in (air first so land covers it).
+		std::vector<PanoramaObject> panoramaObjects;
+		panorama.animLandIndices.clear();
+
+		auto addPanoramaObject = [this, &skyInstance, heightPerTangent, &panoramaObjects](int index)
+		{
+			const DistantObject &distantObject = this->distantObjects.objs.get(index);
+			DebugAssertIndex(this->skyTextures, distantObject.startTextureIndex);
+			const SkyTexture &texture = this->skyTextures[distantObject.startTextureIndex];
+
+			Double3 direction;
+			TextureBuilderID textureBuilderID;
+			bool emissive;
+			double width, height;
+			skyInstance.getObject(index, &direction, &textureBuilderID, &emissive, &width, &height);
+
+			// @temp
+			static_cast<void>(textureBuilderID);
+			static_cast<void>(width);
+			static_cast<void>(height);
+
+			PanoramaObject panoramaObject;
+			panoramaObject.texture = &texture;
+			panoramaObject.angle = MathUtils::fullAtan2(direction.z, direction.x);
+			panoramaObject.bottomHeight = std::tan(direction.getYAngleRadians()) * heightPerTangent;
+			panoramaObject.emissive = emissive;
+			panoramaObjects.emplace_back(std::move(panoramaObject));
+		};
+
+		for (int i = this->distantObjects.airStart; i < this->distantObjects.airEnd; i++)
+		{
+			addPanoramaObject(i);
+		}
+
+		for (int i = this->distantObjects.landStart; i < this->distantObjects.landEnd; i++)
+		{
+			if (skyInstance.tryGetObjectAnimPercent(i).has_value())
+			{
+				panorama.animLandIndices.emplace_back(i);
+			}
+			else
+			{
+				addPanoramaObject(i);
+			}
+		}
+
+		// Height range covered by all static objects.
+		panorama.topHeight = 0.0;
+		panorama.bottomHeight = 0.0;
+		for (int i = 0; i < static_cast<int>(panoramaObjects.size()); i++)
+		{
+			const PanoramaObject &panoramaObject = panoramaObjects[i];
+			double objWidth, objHeight;
+			SkyUtils::getSkyObjectDimensions(panoramaObject.texture->width, panoramaObject.texture->height,
+				&objWidth, &objHeight);
+
+			const double objTopHeight = panoramaObject.bottomHeight + objHeight;
+			panorama.topHeight = (i == 0) ? objTopHeight : std::max(panorama.topHeight, objTopHeight);
+			panorama.bottomHeight = (i == 0) ? panoramaObject.bottomHeight :
+				std::min(panorama.bottomHeight, panoramaObject.bottomHeight);
+		}
+
+		const int rowCount = static_cast<int>(std::ceil((panorama.topHeight - panorama.bottomHeight) * rowsPerHeight));
+		if (rowCount > 0)
+		{
+			SkyPanoramaTexel emptyTexel;
+			emptyTexel.init(0, 255);
+			panorama.texels.init(columnCount, rowCount);
+			panorama.texels.fill(emptyTexel);
+		}
+		else
+		{
+			panorama.texels.clear();
+		}
+
+		// Composite each object into the panorama with the same shading the per-object path would use.
+		for (const PanoramaObject &panoramaObject : panoramaObjects)
+		{
+			if (!panorama.texels.isValid())
+			{
+				break;
+			}
+
+			const SkyTexture &texture = *panoramaObject.texture;
+			double objWidth, objHeight;
+			SkyUtils::getSkyObjectDimensions(texture.width, texture.height, &objWidth, &objHeight);
+
+			// Angular width that matches the object's projected width at the center of the screen.
+			const double objAngleWidth = (2.0 * objWidth) / ArenaRenderUtils::TALL_PIXEL_RATIO;
+			const double columnStart = (panoramaObject.angle - (objAngleWidth * 0.50)) * columnsPerRadian;
+			const double columnEnd = columnStart + (objAngleWidth * columnsPerRadian);
+			const double rowStart = (panorama.topHeight - (panoramaObject.bottomHeight + objHeight)) * rowsPerHeight;
+			const double rowEnd = rowStart + (objHeight * rowsPerHeight);
+
+			// Columns may wrap around, rows are clamped.
+			const int startColumn = static_cast<int>(std::ceil(columnStart - 0.50));
+			const int endColumn = static_cast<int>(std::floor(columnEnd + 0.50));
+			const int startRow = RendererUtils::getLowerBoundedPixel(rowStart, rowCount);
+			const int endRow = RendererUtils::getUpperBoundedPixel(rowEnd, rowCount);
+
+			const double shading = panoramaObject.emissive ? 1.0 : shadingInfo.distantAmbient;
+
+			for (int column = startColumn; column < endColumn; column++)
+			{
+				const double u = std::clamp(
+					((static_cast<double>(column) + 0.50) - columnStart) / (columnEnd - columnStart),
+					0.0, Constants::JustBelowOne);
+				const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+				const int dstColumn = ((column % columnCount) + columnCount) % columnCount;
+
+				for (int row = startRow; row < endRow; row++)
+				{
+					const double v = std::clamp(
+						((static_cast<double>(row) + 0.50) - rowStart) / (rowEnd - rowStart),
+						0.0, Constants::JustBelowOne);
+					const int textureY = static_cast<int>(v * static_cast<double>(texture.height));
+					const SkyTexel &texel = texture.texels[textureX + (textureY * texture.width)];
+					if (texel.a == 0.0)
+					{
+						continue;
+					}
+
+					SkyPanoramaTexel &dstTexel = panorama.texels.get(dstColumn, row);
+					if (texel.a < 1.0)
+					{
+						// Cloud edge. Diminishes whatever ends up behind it, so combine with what's already here.
+						const uint8_t visPercent = static_cast<uint8_t>(
+							std::clamp(1.0 - texel.a, 0.0, 1.0) * 255.0);
+
+						if (dstTexel.visPercent == 0)
+						{
+							dstTexel.color = diminishColor(dstTexel.color, visPercent);
+						}
+						else
+						{
+							dstTexel.visPercent = static_cast<uint8_t>((dstTexel.visPercent * visPercent) / 255);
+						}
+					}
+					else
+					{
+						// Texture color with shading, clamped like the per-object path.
+						const double colorR = std::min(texel.r * shading, 1.0);
+						const double colorG = std::min(texel.g * shading, 1.0);
+						const double colorB = std::min(texel.b * shading, 1.0);
+						const uint32_t colorRGB = static_cast<uint32_t>(
+							((static_cast<uint8_t>(colorR * 255.0)) << 16) |
+							((static_cast<uint8_t>(colorG * 255.0)) << 8) |
+							((static_cast<uint8_t>(colorB * 255.0))));
+						dstTexel.init(colorRGB, 0);
+					}
+				}
+			}
+		}
+
+		panorama.distantAmbientKey = distantAmbientKey;
+
+		const auto rebuildEndTime = std::chrono::high_resolution_clock::now();
+		this->skyPanoramaRebuildTime = std::chrono::duration<double>(rebuildEndTime - rebuildStartTime).count();
+	}
+
+	if (!panorama.isValid())
+	{
+		panorama.yStart = 0;
+		panorama.yEnd = 0;
+		return;
+	}
+
+	// Panorama column through the middle of each screen column.
+	const NewDouble2 forwardZoomed(camera.forwardZoomedX, camera.forwardZoomedZ);
+	const NewDouble2 rightAspected(camera.rightAspectedX, camera.rightAspectedZ);
+	for (int x = 0; x < frame.width; x++)
+	{
+		const double xPercent = (static_cast<double>(x) + 0.50) / frame.widthReal;
+		const NewDouble2 direction = forwardZoomed + (rightAspected * ((2.0 * xPercent) - 1.0));
+		const Radians angle = MathUtils::fullAtan2(direction.y, direction.x);
+		const int column = std::clamp(static_cast<int>(angle * columnsPerRadian), 0, columnCount - 1);
+		panorama.screenColumns.set(x, column);
+	}
+
+	// Screen rows the panorama covers and the panorama row through the middle of each one.
+	const int rowCount = panorama.texels.getHeight();
+	const double yProjTop = horizonProjY - (panorama.topHeight * camera.zoom);
+	const double yProjBottom = horizonProjY - (panorama.bottomHeight * camera.zoom);
+	panorama.yStart = RendererUtils::getLowerBoundedPixel(yProjTop * frame.heightReal, frame.height);
+	panorama.yEnd = RendererUtils::getUpperBoundedPixel(yProjBottom * frame.heightReal, frame.height);
+
+	for (int y = panorama.yStart; y < panorama.yEnd; y++)
+	{
+		const double yProj = (static_cast<double>(y) + 0.50) / frame.heightReal;
+		const double height = (horizonProjY - yProj) / camera.zoom;
+		const int row = static_cast<int>((panorama.topHeight - height) * rowsPerHeight);
+		panorama.screenRows.set(y, std::clamp(row, 0, rowCount - 1));
+	}
+}
+
+void SoftwareRenderer::updateVisibleStars(const SkyInstance &skyInstance, const Camera &camera,
+	const FrameView &frame)
+{
+	TraceZone("SoftwareRenderer::updateVisibleStars");
+
+	this->visibleStars.clear();
+
+	BufferView<const double> dirXs, dirYs, dirZs;
+	skyInstance.getStarDirections(&dirXs, &dirYs, &dirZs);
+
+	const int starCount = dirXs.getCount();
+	if (starCount == 0)
+	{
+		return;
+	}
+
+	DebugAssert(starCount == this->starTextureRefs.getCount());
+
+	double horizonProjY, heightPerTangent;
+	SoftwareRenderer::getDistantSkyProjection(camera, &horizonProjY, &heightPerTangent);
+
+	// Each star is projected from a point one unit from the eye like other distant objects. The eye's
+	// contribution to the projected X and W is the same for every star so it's only calculated once.
+	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
+	const Matrix4d &transform = camera.transform;
+	const double eyeProjX = (transform.x.x * absoluteEye.x) + (transform.y.x * absoluteEye.y) +
+		(transform.z.x * absoluteEye.z) + transform.w.x;
+	const double eyeProjW = (transform.x.w * absoluteEye.x) + (transform.y.w * absoluteEye.y) +
+		(transform.z.w * absoluteEye.z) + transform.w.w;
+
+	const double projWidthScale = camera.zoom / (camera.aspect * ArenaRenderUtils::TALL_PIXEL_RATIO);
+	const double projHeightScale = camera.zoom;
+	const double *dirXsPtr = dirXs.get();
+	const double *dirYsPtr = dirYs.get();
+	const double *dirZsPtr = dirZs.get();
+
+	for (int i = 0; i < starCount; i++)
+	{
+		const double dirX = dirXsPtr[i];
+		const double dirY = dirYsPtr[i];
+		const double dirZ = dirZsPtr[i];
+
+		// Behind the camera.
+		if (((dirX * camera.forwardX) + (dirZ * camera.forwardZ)) <= 0.0)
+		{
+			continue;
+		}
+
+		const StarTexture &texture = *this->starTextureRefs.get(i);
+		double objWidth, objHeight;
+		SkyUtils::getSkyObjectDimensions(texture.width, texture.height, &objWidth, &objHeight);
+
+		// Project the center point on-screen for its X coordinate like other distant objects.
+		const double projX = eyeProjX + (transform.x.x * dirX) + (transform.y.x * dirY) + (transform.z.x * dirZ);
+		const double projW = eyeProjW + (transform.x.w * dirX) + (transform.y.w * dirY) + (transform.z.w * dirZ);
+		const double xProjCenter = 0.50 + ((projX / projW) * 0.50);
+		const double xProjHalfWidth = (objWidth * projWidthScale) * 0.50;
+		const double xProjStart = xProjCenter - xProjHalfWidth;
+		const double xProjEnd = xProjCenter + xProjHalfWidth;
+		if ((xProjStart > 1.0) || (xProjEnd < 0.0))
+		{
+			continue;
+		}
+
+		// Bottom edge from the tangent of the star's angle above the horizon, then its height on top.
+		const double xzLength = std::sqrt((dirX * dirX) + (dirZ * dirZ));
+		const double yProjEnd = horizonProjY - ((dirY / xzLength) * heightPerTangent * camera.zoom);
+		const double yProjStart = yProjEnd - (objHeight * projHeightScale);
+		if ((yProjStart > 1.0) || (yProjEnd < 0.0))
+		{
+			continue;
+		}
+
+		VisibleStar visibleStar;
+		visibleStar.texture = &texture;
+		visibleStar.xProjStart = xProjStart * frame.widthReal;
+		visibleStar.xProjEnd = xProjEnd * frame.widthReal;
+		visibleStar.yProjStart = yProjStart * frame.heightReal;
+		visibleStar.yProjEnd = yProjEnd * frame.heightReal;
+		visibleStar.xStart = RendererUtils::getLowerBoundedPixel(visibleStar.xProjStart, frame.width);
+		visibleStar.xEnd = RendererUtils::getUpperBoundedPixel(visibleStar.xProjEnd, frame.width);
+		visibleStar.yStart = RendererUtils::getLowerBoundedPixel(visibleStar.yProjStart, frame.height);
+		visibleStar.yEnd = RendererUtils::getUpperBoundedPixel(visibleStar.yProjEnd, frame.height);
+
+		if ((visibleStar.xStart < visibleStar.xEnd) && (visibleStar.yStart < visibleStar.yEnd))
+		{
+			this->visibleStars.emplace_back(visibleStar);
+		}
+	}
+}
+
 void SoftwareRenderer::updateVisibleDistantObjects(const SkyInstance &skyInstance, const ShadingInfo &shadingInfo,
 	const Camera &camera, const FrameView &frame)
 {
+	TraceZone("SoftwareRenderer::updateVisibleDistantObjects");
+
 	this->visDistantObjs.clear();
 
 	// Directions forward and along the edges of the 2D frustum.
@@ -1472,11 +2108,14 @@ void SoftwareRenderer::updateVisibleDistantObjects(const SkyInstance &skyInstanc
 	};
 
 	// Iterate all distant objects and gather up the visible ones. Set the start and end ranges for each object
-	// type to be used during rendering for different types of shading.
+	// type to be used during rendering for different types of shading. Static land and air are drawn from
+	// the sky panorama instead, so only animated land is gathered here.
 	this->visDistantObjs.landStart = 0;
 
-	for (int i = this->distantObjects.landEnd - 1; i >= this->distantObjects.landStart; i--)
+	const std::vector<int> &animLandIndices = this->skyPanorama.animLandIndices;
+	for (int animLandIndex = static_cast<int>(animLandIndices.size()) - 1; animLandIndex >= 0; animLandIndex--)
 	{
+		const int i = animLandIndices[animLandIndex];
 		const DistantObject &land = this->distantObjects.objs.get(i);
 
 		// @todo: redesign this once public texture handles are being allocated.
@@ -1505,31 +2144,7 @@ void SoftwareRenderer::updateVisibleDistantObjects(const SkyInstance &skyInstanc
 
 	this->visDistantObjs.landEnd = static_cast<int>(this->visDistantObjs.objs.size());
 	this->visDistantObjs.airStart = this->visDistantObjs.landEnd;
-
-	for (int i = this->distantObjects.airEnd - 1; i >= this->distantObjects.airStart; i--)
-	{
-		const DistantObject &air = this->distantObjects.objs.get(i);
-		DebugAssert(air.textureIndexCount == 1);
-
-		DebugAssertIndex(this->skyTextures, air.startTextureIndex);
-		const SkyTexture &texture = this->skyTextures[air.startTextureIndex];
-
-		Double3 direction;
-		TextureBuilderID textureBuilderID;
-		bool emissive;
-		double width, height;
-		skyInstance.getObject(i, &direction, &textureBuilderID, &emissive, &width, &height);
-
-		// @temp
-		static_cast<void>(textureBuilderID);
-		static_cast<void>(width);
-		static_cast<void>(height);
-
-		constexpr Orientation orientation = Orientation::Bottom;
-		tryAddObject(texture, direction, emissive, orientation);
-	}
-
-	this->visDistantObjs.airEnd = static_cast<int>(this->visDistantObjs.objs.size());
+	this->visDistantObjs.airEnd = this->visDistantObjs.airStart;
 	this->visDistantObjs.moonStart = this->visDistantObjs.airEnd;
 
 	for (int i = this->distantObjects.moonEnd - 1; i >= this->distantObjects.moonStart; i--)
@@ -1582,42 +2197,7 @@ void SoftwareRenderer::updateVisibleDistantObjects(const SkyInstance &skyInstanc
 	}
 
 	this->visDistantObjs.sunEnd = static_cast<int>(this->visDistantObjs.objs.size());
-	this->visDistantObjs.starStart = this->visDistantObjs.sunEnd;
-
-	for (int i = this->distantObjects.starEnd - 1; i >= this->distantObjects.starStart; i--)
-	{
-		const DistantObject &star = this->distantObjects.objs.get(i);
-		DebugAssert(star.textureIndexCount == 1);
-
-		DebugAssertIndex(this->skyTextures, star.startTextureIndex);
-		const SkyTexture &texture = this->skyTextures[star.startTextureIndex];
-
-		Double3 direction;
-		bool emissive = true;
-		double width, height;
-		if (skyInstance.isObjectSmallStar(i))
-		{
-			uint8_t paletteIndex;
-			skyInstance.getObjectSmallStar(i, &direction, &paletteIndex, &width, &height);
-			static_cast<void>(paletteIndex);
-		}
-		else
-		{
-			TextureBuilderID textureBuilderID;
-			skyInstance.getObject(i, &direction, &textureBuilderID, &emissive, &width, &height);
-			static_cast<void>(textureBuilderID);
-		}
-
-		// @temp
-		static_cast<void>(width);
-		static_cast<void>(height);
-
-		constexpr Orientation orientation = Orientation::Bottom;
-		tryAddObject(texture, direction, emissive, orientation);
-	}
-
-	this->visDistantObjs.starEnd = static_cast<int>(this->visDistantObjs.objs.size());
-	this->visDistantObjs.lightningStart = this->visDistantObjs.starEnd;
+	this->visDistantObjs.lightningStart = this->visDistantObjs.sunEnd;
 
 	for (int i = this->distantObjects.lightningEnd - 1; i >= this->distantObjects.lightningStart; i--)
 	{
@@ -1654,8 +2234,11 @@ void SoftwareRenderer::updateVisibleDistantObjects(const SkyInstance &skyInstanc
 }
 
 void SoftwareRenderer::updatePotentiallyVisibleFlats(const Camera &camera, int chunkDistance,
-	const EntityManager &entityManager, std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount)
+	const EntityManager &entityManager, FrameAllocator &frameAllocator,
+	std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount)
 {
+	TraceZone("SoftwareRenderer::updatePotentiallyVisibleFlats");
+
 	const ChunkInt2 &cameraChunk = camera.eye.chunk;
 
 	// Get the min and max chunk coordinates to loop over.
@@ -1688,7 +2271,10 @@ void SoftwareRenderer::updatePotentiallyVisibleFlats(const Camera &camera, int c
 	};
 
 	// Get potentially visible flat counts for each chunk.
-	Buffer2D<int> chunkPotentiallyVisFlatCounts(potentiallyVisChunkCountX, potentiallyVisChunkCountZ);
+	BufferView<int> chunkPotentiallyVisFlatCountsData =
+		frameAllocator.alloc<int>(potentiallyVisChunkCountX * potentiallyVisChunkCountZ);
+	BufferView2D<int> chunkPotentiallyVisFlatCounts(chunkPotentiallyVisFlatCountsData.get(),
+		potentiallyVisChunkCountX, potentiallyVisChunkCountZ);
 	for (WEInt z = 0; z < chunkPotentiallyVisFlatCounts.getHeight(); z++)
 	{
 		for (SNInt x = 0; x < chunkPotentiallyVisFlatCounts.getWidth(); x++)
@@ -1738,13 +2324,15 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 	int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
 	const EntityManager &entityManager, const EntityDefinitionLibrary &entityDefLibrary)
 {
+	TraceZone("SoftwareRenderer::updateVisibleFlats");
+
 	this->visibleFlats.clear();
 	this->visibleLights.clear();
 
 	// Update potentially visible flats so this method knows what to work with.
 	int potentiallyVisFlatCount;
 	SoftwareRenderer::updatePotentiallyVisibleFlats(camera, chunkDistance, entityManager,
-		&this->potentiallyVisibleFlats, &potentiallyVisFlatCount);
+		this->frameAllocator, &this->potentiallyVisibleFlats, &potentiallyVisFlatCount);
 
 	// Each flat shares the same axes. The forward direction always faces opposite to 
 	// the camera direction.
@@ -1875,7 +2463,7 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 				// Add palette override if it is a citizen entity.
 				const EntityAnimationInstance &animInst = entity->getAnimInstance();
 				const EntityAnimationInstance::CitizenParams *citizenParams = animInst.getCitizenParams();
-				visFlat.overridePalette = (citizenParams != nullptr) ? &citizenParams->palette : nullptr;
+				visFlat.overridePalette = (citizenParams != nullptr) ? citizenParams->palette.get() : nullptr;
 
 				// Add the flat data to the draw list.
 				this->visibleFlats.emplace_back(std::move(visFlat));
@@ -1891,27 +2479,28 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 void SoftwareRenderer::updateVisibleLightLists(const Camera &camera, int chunkDistance,
 	double ceilingScale)
 {
+	TraceZone("SoftwareRenderer::updateVisibleLightLists");
+
 	const ChunkInt2 &cameraChunk = camera.eye.chunk;
 
 	// Visible light lists are dependent on the active chunks.
 	ChunkInt2 minChunk, maxChunk;
 	ChunkUtils::getSurroundingChunks(cameraChunk, chunkDistance, &minChunk, &maxChunk);
 
-	// Clear out old chunks.
+	// Clear out old chunks, keeping their light lists around for new chunks.
 	// @todo: this could probably just iterate over the chunk manager's chunks.
-	std::vector<ChunkInt2> chunksToRemove;
-	for (const auto &pair : this->visLightLists)
+	for (auto iter = this->visLightLists.begin(); iter != this->visLightLists.end(); )
 	{
-		const ChunkInt2 &oldChunk = pair.first;
+		const ChunkInt2 &oldChunk = iter->first;
 		if (!ChunkUtils::isWithinActiveRange(cameraChunk, oldChunk, chunkDistance))
 		{
-			chunksToRemove.push_back(oldChunk);
+			this->freeVisLightListGroups.emplace_back(std::move(iter->second));
+			iter = this->visLightLists.erase(iter);
+		}
+		else
+		{
+			++iter;
 		}
-	}
-
-	for (const ChunkInt2 &chunkToRemove : chunksToRemove)
-	{
-		this->visLightLists.erase(chunkToRemove);
 	}
 
 	// Add new chunks.
@@ -1923,7 +2512,17 @@ void SoftwareRenderer::updateVisibleLightLists(const Camera &camera, int chunkDi
 			const auto iter = this->visLightLists.find(chunk);
 			if (iter == this->visLightLists.end())
 			{
-				Buffer2D<VisibleLightList> visLightListGroup(ChunkUtils::CHUNK_DIM, ChunkUtils::CHUNK_DIM);
+				Buffer2D<VisibleLightList> visLightListGroup;
+				if (this->freeVisLightListGroups.size() > 0)
+				{
+					visLightListGroup = std::move(this->freeVisLightListGroups.back());
+					this->freeVisLightListGroups.pop_back();
+				}
+				else
+				{
+					visLightListGroup.init(ChunkUtils::CHUNK_DIM, ChunkUtils::CHUNK_DIM);
+				}
+
 				this->visLightLists.emplace(chunk, std::move(visLightListGroup));
 			}
 		}
@@ -3492,6 +4091,48 @@ void SoftwareRenderer::drawPixelsShader(int x, const DrawRange &drawRange, doubl
 	occlusion.clipRange(&yStart, &yEnd);
 	occlusion.update(yStart, yEnd);
 
+	// Light and fog are constant for the column, so with light tables every pixel is a look-up into one
+	// row of pre-shaded colors (two counting emissive texels). Light tables only support nearest filtering.
+	if ((TextureFilterMode == 0) && (shadingInfo.lightTable != nullptr))
+	{
+		const LightTable &lightTable = *shadingInfo.lightTable;
+		double lightPercent = std::min(shading.x + lightContributionPercent, 1.0);
+		double emissiveLightPercent = 1.0;
+		if constexpr (Fading)
+		{
+			lightPercent *= fadePercent;
+			emissiveLightPercent *= fadePercent;
+		}
+
+		const int fogStep = LightTable::getFogStep(fogPercent);
+		const uint32_t *colors = lightTable.getColors(LightTable::getLightLevel(lightPercent), fogStep);
+		const uint32_t *emissiveColors = lightTable.getColors(
+			LightTable::getLightLevel(emissiveLightPercent), fogStep);
+
+		const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+		const double textureHeightReal = static_cast<double>(texture.height);
+		const uint16_t *lightTableTexels = texture.lightTableTexels.data();
+
+		for (int y = yStart; y < yEnd; y++)
+		{
+			const int index = x + (y * frame.width);
+			if (depth <= (frame.depthBuffer[index] - Constants::Epsilon))
+			{
+				const double yPercent =
+					((static_cast<double>(y) + 0.50) - yProjStart) / (yProjEnd - yProjStart);
+				const double v = vStart + ((vEnd - vStart) * yPercent);
+				const int textureY = static_cast<int>(v * textureHeightReal);
+				const uint16_t texel = lightTableTexels[textureX + (textureY * texture.width)];
+				const uint32_t *texelColors = ((texel & LightTable::EMISSIVE_BIT) != 0) ? emissiveColors : colors;
+
+				frame.colorBuffer[index] = texelColors[texel & 0xFF];
+				frame.depthBuffer[index] = depth;
+			}
+		}
+
+		return;
+	}
+
 	// Draw the column to the output buffer.
 	for (int y = yStart; y < yEnd; y++)
 	{
@@ -3634,18 +4275,39 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 			const double u = std::clamp(currentPointX - std::floor(currentPointX), 0.0, Constants::JustBelowOne);
 			const double v = std::clamp(currentPointY - std::floor(currentPointY), 0.0, Constants::JustBelowOne);
 
-			// Texture color. Alpha is ignored in this loop, so transparent texels will appear black.
-			constexpr bool TextureTransparency = false;
-			double colorR, colorG, colorB, colorEmission;
-			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
-				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, nullptr);
-
 			// Light contribution.
 			const NewDouble2 currentPoint(currentPointX, currentPointY);
 			const CoordDouble2 currentCoord = VoxelUtils::newPointToCoord(currentPoint); // @todo: do the shading in chunk space to begin with
 			const double lightContributionPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(currentCoord, visLights, visLightList);
 
+			if ((TextureFilterMode == 0) && (shadingInfo.lightTable != nullptr))
+			{
+				// Pre-shaded palette color for this pixel's light level and fog step.
+				const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+				const int textureY = static_cast<int>(v * static_cast<double>(texture.height));
+				const uint16_t texel = texture.lightTableTexels[textureX + (textureY * texture.width)];
+				const bool isEmissive = (texel & LightTable::EMISSIVE_BIT) != 0;
+
+				double lightPercent = isEmissive ? 1.0 : std::min(shading.x + lightContributionPercent, 1.0);
+				if constexpr (Fading)
+				{
+					lightPercent *= fadePercent;
+				}
+
+				const uint32_t *colors = shadingInfo.lightTable->getColors(
+					LightTable::getLightLevel(lightPercent), LightTable::getFogStep(fogPercent));
+				frame.colorBuffer[index] = colors[texel & 0xFF];
+				frame.depthBuffer[index] = depth;
+				continue;
+			}
+
+			// Texture color. Alpha is ignored in this loop, so transparent texels will appear black.
+			constexpr bool TextureTransparency = false;
+			double colorR, colorG, colorB, colorEmission;
+			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
+				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, nullptr);
+
 			// Shading from light.
 			constexpr double shadingMax = 1.0;
 			const double combinedEmission = colorEmission + lightContributionPercent;
@@ -4527,133 +5189,58 @@ void SoftwareRenderer::drawMoonPixels(int x, const DrawRange &drawRange, double
 
 			double colorR;
 			double colorG;
-			double colorB;
-
-			if (texelIsLit)
-			{
-				// Use the moon texel.
-				colorR = texel.r;
-				colorG = texel.g;
-				colorB = texel.b;
-			}
-			else
-			{
-				// Use the gradient color.
-				colorR = gradientColor.x;
-				colorG = gradientColor.y;
-				colorB = gradientColor.z;
-			}
-
-			// Clamp maximum (don't worry about negative values).
-			const double high = 1.0;
-			colorR = (colorR > high) ? high : colorR;
-			colorG = (colorG > high) ? high : colorG;
-			colorB = (colorB > high) ? high : colorB;
-
-			// Convert floats to integers.
-			const uint32_t colorRGB = static_cast<uint32_t>(
-				((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-				((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-				((static_cast<uint8_t>(colorB * 255.0))));
-
-			frame.colorBuffer[index] = colorRGB;
-		}
-	}
-}
-
-void SoftwareRenderer::drawStarPixels(int x, const DrawRange &drawRange, double u, double vStart,
-	double vEnd, const SkyTexture &texture, const Buffer<Double3> &skyGradientRowCache,
-	const ShadingInfo &shadingInfo, const FrameView &frame)
-{
-	// Draw range values.
-	const double yProjStart = drawRange.yProjStart;
-	const double yProjEnd = drawRange.yProjEnd;
-	const int yStart = drawRange.yStart;
-	const int yEnd = drawRange.yEnd;
-
-	// Horizontal offset in texture.
-	const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
-
-	// Draw the column to the output buffer.
-	for (int y = yStart; y < yEnd; y++)
-	{
-		const int index = x + (y * frame.width);
-
-		// Percent stepped from beginning to end on the column.
-		const double yPercent =
-			((static_cast<double>(y) + 0.50) - yProjStart) / (yProjEnd - yProjStart);
-
-		// Vertical texture coordinate.
-		const double v = vStart + ((vEnd - vStart) * yPercent);
-
-		// Y position in texture.
-		const int textureY = static_cast<int>(v * static_cast<double>(texture.height));
-
-		// Alpha is checked in this loop, and transparent texels are not drawn.
-		const int textureIndex = textureX + (textureY * texture.width);
-		const SkyTexel &texel = texture.texels[textureIndex];
-
-		if (texel.a != 0.0)
-		{
-			// Get gradient color from sky gradient row cache.
-			const Double3 &gradientColor = skyGradientRowCache.get(y);
-
-			// If the gradient color behind the star is dark enough, then draw. Interpolate with a
-			// range of intensities so stars don't immediately blink on/off when the gradient is a
-			// certain color. Stars are generally small so I think it's okay to do more expensive
-			// per-pixel operations here.
-			constexpr double visThreshold = ShadingInfo::STAR_VIS_THRESHOLD; // Stars are becoming visible.
-			constexpr double brightestThreshold = 32.0 / 255.0; // Stars are brightest.
-
-			const double brightestComponent = std::max(
-				std::max(gradientColor.x, gradientColor.y), gradientColor.z);
-			const bool isDarkEnough = brightestComponent <= visThreshold;
+			double colorB;
 
-			if (isDarkEnough)
+			if (texelIsLit)
 			{
-				const double gradientVisPercent = std::clamp(
-					(brightestComponent - brightestThreshold) / (visThreshold - brightestThreshold),
-					0.0, 1.0);
-
-				// Texture color with shading.
-				double colorR = texel.r;
-				double colorG = texel.g;
-				double colorB = texel.b;
-
-				// Lerp with sky gradient for smoother transition between day and night.
-				colorR += (gradientColor.x - colorR) * gradientVisPercent;
-				colorG += (gradientColor.y - colorG) * gradientVisPercent;
-				colorB += (gradientColor.z - colorB) * gradientVisPercent;
+				// Use the moon texel.
+				colorR = texel.r;
+				colorG = texel.g;
+				colorB = texel.b;
+			}
+			else
+			{
+				// Use the gradient color.
+				colorR = gradientColor.x;
+				colorG = gradientColor.y;
+				colorB = gradientColor.z;
+			}
 
-				// Clamp maximum (don't worry about negative values).
-				const double high = 1.0;
-				colorR = (colorR > high) ? high : colorR;
-				colorG = (colorG > high) ? high : colorG;
-				colorB = (colorB > high) ? high : colorB;
+			// Clamp maximum (don't worry about negative values).
+			const double high = 1.0;
+			colorR = (colorR > high) ? high : colorR;
+			colorG = (colorG > high) ? high : colorG;
+			colorB = (colorB > high) ? high : colorB;
 
-				// Convert floats to integers.
-				const uint32_t colorRGB = static_cast<uint32_t>(
-					((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-					((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-					((static_cast<uint8_t>(colorB * 255.0))));
+			// Convert floats to integers.
+			const uint32_t colorRGB = static_cast<uint32_t>(
+				((static_cast<uint8_t>(colorR * 255.0)) << 16) |
+				((static_cast<uint8_t>(colorG * 255.0)) << 8) |
+				((static_cast<uint8_t>(colorB * 255.0))));
 
-				frame.colorBuffer[index] = colorRGB;
-			}
+			frame.colorBuffer[index] = colorRGB;
 		}
 	}
 }
 
-void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk,
+	const ChunkRenderDefinition &chunkRenderDef, const VoxelInt3 &voxel, const Camera &camera, const Ray &ray,
+	VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
+	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 
@@ -4666,8 +5253,6 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
 		// Draw inner ceiling, wall, and floor.
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -4691,20 +5276,20 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 			voxel.x, voxel.y, voxel.z, chunk);
 
 		// Ceiling.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-			nearZ, farZ, -Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef),
+		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint, nearZ, farZ,
+			-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
 			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 		// Wall.
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(farCoord, visLights, visLightList);
-		SoftwareRenderer::drawPixels(x, drawRanges.at(1), farZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef),
-			fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
+		SoftwareRenderer::drawPixels(x, drawRanges.at(1), farZ, wallU, 0.0, Constants::JustBelowOne, wallNormal,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), fadePercent,
+			wallLightPercent, shadingInfo, occlusion, frame);
 
 		// Floor.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-			farZ, nearZ, Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef),
+		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint, farZ, nearZ,
+			Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
 			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
@@ -4716,8 +5301,6 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 		// Draw bottom of ceiling voxel if the camera is below it.
 		if (absoluteEye.y < voxelYReal)
 		{
-			const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 			const NewDouble3 nearFloorPoint(
 				nearPoint.x,
 				voxelYReal,
@@ -4732,9 +5315,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 			const double fadePercent = RendererUtils::getFadingVoxelPercent(
 				voxel.x, voxel.y, voxel.z, chunk);
 
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Raised)
@@ -4765,9 +5348,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -4783,9 +5366,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -4806,21 +5389,22 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(farCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal, textures.getTexture(raisedData.sideTextureAssetRef),
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -4851,9 +5435,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
@@ -4885,8 +5469,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -4966,9 +5551,10 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				LightContributionCap>(farCoord, visLights, visLightList);
 
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
-			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
-				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0, Constants::JustBelowOne,
+				farNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Door)
@@ -4998,8 +5584,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -5018,8 +5605,9 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -5046,9 +5634,10 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, vStart,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -5066,25 +5655,33 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, const Chunk &chunk, cons
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk,
+	const ChunkRenderDefinition &chunkRenderDef, const VoxelInt3 &voxel, const Camera &camera, const Ray &ray,
+	VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
+	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 
@@ -5096,8 +5693,6 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -5113,8 +5708,8 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 			voxel.x, voxel.y, voxel.z, chunk);
 
 		// Floor.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ, -Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
@@ -5124,8 +5719,6 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 	else if (voxelDef.type == ArenaTypes::VoxelType::Ceiling)
 	{
 		// Draw bottom of ceiling voxel.
-		const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -5140,8 +5733,8 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 		const double fadePercent = RendererUtils::getFadingVoxelPercent(
 			voxel.x, voxel.y, voxel.z, chunk);
 
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ, -Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Raised)
@@ -5172,9 +5765,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -5190,9 +5783,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -5213,21 +5806,22 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(farCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -5258,9 +5852,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
@@ -5292,8 +5886,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5328,8 +5923,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -5348,8 +5944,9 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -5376,9 +5973,10 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, vStart,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -5396,25 +5994,33 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk,
+	const ChunkRenderDefinition &chunkRenderDef, const VoxelInt3 &voxel, const Camera &camera, const Ray &ray,
+	VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
+	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 
@@ -5426,8 +6032,6 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -5443,15 +6047,13 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 			voxel.x, voxel.y, voxel.z, chunk);
 
 		// Ceiling.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ, Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
 	{
 		// Draw top of floor voxel.
-		const VoxelDefinition::FloorData &floorData = voxelDef.floor;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -5467,8 +6069,8 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 			voxel.x, voxel.y, voxel.z, chunk);
 
 		// Ceiling.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(floorData.textureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ, Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Ceiling)
@@ -5503,9 +6105,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -5521,9 +6123,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -5544,21 +6146,22 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(farCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -5589,9 +6192,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
@@ -5623,8 +6226,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5704,9 +6308,10 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				LightContributionCap>(farCoord, visLights, visLightList);
 
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
-			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
-				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0, Constants::JustBelowOne,
+				farNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Door)
@@ -5736,8 +6341,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -5756,8 +6362,9 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -5784,9 +6391,10 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, vStart,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -5804,20 +6412,22 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, const Chunk &chunk, const Vo
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, const Camera &camera,
-	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-	double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
-	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
-	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
+void SoftwareRenderer::drawInitialVoxelColumn(int x, const Chunk &chunk,
+	const ChunkRenderDefinition &chunkRenderDef, const VoxelInt2 &voxel, const Camera &camera, const Ray &ray,
+	VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
+	const FrameView &frame)
 {
 	// This method handles some special cases such as drawing the back-faces of wall sides.
 
@@ -5827,8 +6437,7 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, con
 	// either way, the drawing range should be contained within the projected range at the 
 	// sub-pixel level. This ensures that the vertical texture coordinate is always within 0->1.
 
-	const Chunk *chunkPtr = chunkManager.tryGetChunk(coord.chunk);
-	DebugAssert(chunkPtr != nullptr);
+	DebugAssert(chunkRenderDef.getCoord() == chunk.getCoord());
 
 	const double wallU = [&farPoint, facing]()
 	{
@@ -5863,44 +6472,52 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, const CoordInt2 &coord, con
 	const int adjustedVoxelY = camera.getAdjustedEyeVoxelY(ceilingScale);
 
 	// Try to draw the player's current voxel first.
-	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunkPtr->getHeight()))
+	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunk.getHeight()))
 	{
-		const VoxelInt3 sameFloorVoxel(coord.voxel.x, adjustedVoxelY, coord.voxel.y);
-		SoftwareRenderer::drawInitialVoxelSameFloor(x, *chunkPtr, sameFloorVoxel, camera, ray, facing, nearPoint,
-			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights,
-			visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 sameFloorVoxel(voxel.x, adjustedVoxelY, voxel.y);
+		SoftwareRenderer::drawInitialVoxelSameFloor(x, chunk, chunkRenderDef, sameFloorVoxel, camera, ray,
+			facing, nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance,
+			ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion,
+			frame);
 	}
 
 	// Try to draw voxels below the player's voxel (clamping in case the player is above the chunk).
-	for (int voxelY = std::min(adjustedVoxelY - 1, chunkPtr->getHeight() - 1); voxelY >= 0; voxelY--)
+	for (int voxelY = std::min(adjustedVoxelY - 1, chunk.getHeight() - 1); voxelY >= 0; voxelY--)
 	{
-		const VoxelInt3 belowVoxel(coord.voxel.x, voxelY, coord.voxel.y);
-		SoftwareRenderer::drawInitialVoxelBelow(x, *chunkPtr, belowVoxel, camera, ray, facing, nearPoint,
-			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager,
-			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 belowVoxel(voxel.x, voxelY, voxel.y);
+		SoftwareRenderer::drawInitialVoxelBelow(x, chunk, chunkRenderDef, belowVoxel, camera, ray, facing,
+			nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale,
+			chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 	}
 
 	// Try to draw voxels above the player's voxel (clamping in case the player is below the chunk).
-	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunkPtr->getHeight(); voxelY++)
+	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunk.getHeight(); voxelY++)
 	{
-		const VoxelInt3 aboveVoxel(coord.voxel.x, voxelY, coord.voxel.y);
-		SoftwareRenderer::drawInitialVoxelAbove(x, *chunkPtr, aboveVoxel, camera, ray, facing, nearPoint,
-			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager,
-			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 aboveVoxel(voxel.x, voxelY, voxel.y);
+		SoftwareRenderer::drawInitialVoxelAbove(x, chunk, chunkRenderDef, aboveVoxel, camera, ray, facing,
+			nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale,
+			chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 	}
 }
 
-void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-	double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-	int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-	const FrameView &frame)
+void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk,
+	const ChunkRenderDefinition &chunkRenderDef, const VoxelInt3 &voxel, const Camera &camera, const Ray &ray,
+	VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
+	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 	
@@ -5914,8 +6531,6 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
 		// Draw side.
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -5932,8 +6547,8 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearCoord, visLights, visLightList);
 
-		SoftwareRenderer::drawPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
+		SoftwareRenderer::drawPixels(x, drawRange, nearZ, wallU, 0.0, Constants::JustBelowOne, wallNormal,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), fadePercent,
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
@@ -5945,8 +6560,6 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 		// Draw bottom of ceiling voxel if the camera is below it.
 		if (absoluteEye.y < voxelYReal)
 		{
-			const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 			const NewDouble3 nearFloorPoint(
 				nearPoint.x,
 				voxelYReal,
@@ -5961,9 +6574,9 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			const double fadePercent = RendererUtils::getFadingVoxelPercent(
 				voxel.x, voxel.y, voxel.z, chunk);
 
-			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Raised)
@@ -5994,16 +6607,17 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6021,14 +6635,15 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -6038,9 +6653,10 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -6071,16 +6687,14 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6095,8 +6709,8 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearCoord, visLights, visLightList);
 
-		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0, Constants::JustBelowOne,
+			wallNormal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Edge)
@@ -6124,8 +6738,9 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6179,9 +6794,10 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
 
-			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0,
-				Constants::JustBelowOne, nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0, Constants::JustBelowOne,
+				nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
@@ -6225,9 +6841,10 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 				LightContributionCap>(farCoord, visLights, visLightList);
 
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
-			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
-				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0, Constants::JustBelowOne,
+				farNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Door)
@@ -6257,8 +6874,9 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -6278,7 +6896,8 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -6306,8 +6925,9 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
-					shadingInfo, occlusion, frame);
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -6326,23 +6946,32 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, const Chunk &chunk, const Voxel
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ,
-	double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
-	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+	const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+	const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+	const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 
@@ -6354,8 +6983,6 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6377,14 +7004,14 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 			LightContributionCap>(nearCoord, visLights, visLightList);
 
 		// Wall.
-		SoftwareRenderer::drawPixels(x, drawRanges.at(0), nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
-			wallLightPercent, shadingInfo, occlusion, frame);
+		SoftwareRenderer::drawPixels(x, drawRanges.at(0), nearZ, wallU, 0.0, Constants::JustBelowOne,
+			wallNormal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX),
+			fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 
 		// Floor.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-			nearZ, farZ, -Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef), fadePercent,
-			visLights, visLightList, shadingInfo, occlusion, frame);
+		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint, nearZ, farZ,
+			-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
 	{
@@ -6393,8 +7020,6 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 	else if (voxelDef.type == ArenaTypes::VoxelType::Ceiling)
 	{
 		// Draw bottom of ceiling voxel.
-		const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -6409,8 +7034,8 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 		const double fadePercent = RendererUtils::getFadingVoxelPercent(
 			voxel.x, voxel.y, voxel.z, chunk);
 
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ, farZ, -Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Raised)
@@ -6441,16 +7066,17 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6468,14 +7094,15 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -6485,9 +7112,10 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -6518,16 +7146,14 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6542,8 +7168,8 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearCoord, visLights, visLightList);
 
-		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0, Constants::JustBelowOne,
+			wallNormal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Edge)
@@ -6571,8 +7197,9 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6607,8 +7234,9 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -6628,7 +7256,8 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -6656,8 +7285,9 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
-					shadingInfo, occlusion, frame);
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -6676,23 +7306,32 @@ void SoftwareRenderer::drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ,
-	double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
-	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+	const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+	const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+	const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Nothing to draw for air voxels.
+	const VoxelRenderDefID voxelRenderDefID = chunkRenderDef.getVoxelRenderDefID(voxel.x, voxel.y, voxel.z);
+	if (voxelRenderDefID == ChunkRenderDefinition::NO_VOXEL_ID)
+	{
+		return;
+	}
+
+	const VoxelRenderDefinition &voxelRenderDef = chunkRenderDef.getVoxelRenderDef(voxelRenderDefID);
 	const CoordInt2 coord2D(chunk.getCoord(), VoxelInt2(voxel.x, voxel.z));
-	const Chunk::VoxelID voxelID = chunk.getVoxel(voxel.x, voxel.y, voxel.z);
-	const VoxelDefinition &voxelDef = chunk.getVoxelDef(voxelID);
+	const VoxelDefinition &voxelDef = voxelRenderDef.getVoxelDef();
 	const double voxelHeight = ceilingScale;
 	const double voxelYReal = static_cast<double>(voxel.y) * voxelHeight;
 
@@ -6705,8 +7344,6 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 
 	if (voxelDef.type == ArenaTypes::VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -6726,22 +7363,20 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			voxel.x, voxel.y, voxel.z, chunk);
 
 		// Ceiling.
-		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef), fadePercent,
-			visLights, visLightList, shadingInfo, occlusion, frame);
+		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ, nearZ,
+			Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 		// Wall.
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearCoord, visLights, visLightList);
-		SoftwareRenderer::drawPixels(x, drawRanges.at(1), nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
-			wallLightPercent, shadingInfo, occlusion, frame);
+		SoftwareRenderer::drawPixels(x, drawRanges.at(1), nearZ, wallU, 0.0, Constants::JustBelowOne,
+			wallNormal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX),
+			fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Floor)
 	{
 		// Draw top of floor voxel.
-		const VoxelDefinition::FloorData &floorData = voxelDef.floor;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -6756,8 +7391,8 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 		const double fadePercent = RendererUtils::getFadingVoxelPercent(
 			voxel.x, voxel.y, voxel.z, chunk);
 
-		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(floorData.textureAssetRef), fadePercent,
+		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ, nearZ, Double3::UnitY,
+			textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Ceiling)
@@ -6792,16 +7427,17 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 				voxel.x, voxel.y, voxel.z, chunk);
 
 			// Ceiling.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ, nearZ,
+				Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::CEILING_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6819,14 +7455,15 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
-			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 
 			// Floor.
-			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
-				visLights, visLightList, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint, nearZ, farZ,
+				-Double3::UnitY, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::FLOOR_RECT_INDEX),
+				fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
 		{
@@ -6836,9 +7473,10 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, raisedData.vTop,
+				raisedData.vBottom, wallNormal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::SIDE_RECT_INDEX), wallLightPercent,
+				shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Diagonal)
@@ -6869,16 +7507,14 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
-				wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0, Constants::JustBelowOne,
+				hit.normal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+				fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6893,8 +7529,8 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearCoord, visLights, visLightList);
 
-		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0, Constants::JustBelowOne,
+			wallNormal, textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Edge)
@@ -6922,8 +7558,9 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+				Constants::JustBelowOne, hit.normal,
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6977,9 +7614,10 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearCoord, visLights, visLightList);
 
-			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0,
-				Constants::JustBelowOne, nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0, Constants::JustBelowOne,
+				nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
@@ -7023,9 +7661,10 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 				LightContributionCap>(farCoord, visLights, visLightList);
 
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
-			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
-				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0, Constants::JustBelowOne,
+				farNormal, RendererUtils::isChasmEmissive(chasmData.type),
+				textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX), *chasmTexture,
+				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == ArenaTypes::VoxelType::Door)
@@ -7055,8 +7694,9 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 				const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
-				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Sliding)
@@ -7076,7 +7716,8 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Raising)
@@ -7104,8 +7745,9 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
-					shadingInfo, occlusion, frame);
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
+					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == ArenaTypes::DoorType::Splitting)
 			{
@@ -7124,19 +7766,21 @@ void SoftwareRenderer::drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3
 					LightContributionCap>(VoxelUtils::newPointToCoord(hit.point), visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal,
+					textures.getTexture(voxelRenderDef, VoxelRenderDefinition::DEFAULT_RECT_INDEX),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Camera &camera,
-	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-	double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-	const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
-	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
-	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
+void SoftwareRenderer::drawVoxelColumn(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+	const VoxelInt2 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+	const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
+	const FrameView &frame)
 {
 	// Much of the code here is duplicated from the initial voxel column drawing method, but
 	// there are a couple differences, like the horizontal texture coordinate being flipped,
@@ -7151,8 +7795,7 @@ void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Came
 	// either way, the drawing range should be contained within the projected range at the 
 	// sub-pixel level. This ensures that the vertical texture coordinate is always within 0->1.
 
-	const Chunk *chunkPtr = chunkManager.tryGetChunk(coord.chunk);
-	DebugAssert(chunkPtr != nullptr);
+	DebugAssert(chunkRenderDef.getCoord() == chunk.getCoord());
 
 	// Horizontal texture coordinate for the wall, potentially shared between multiple voxels
 	// in this voxel column.
@@ -7189,30 +7832,30 @@ void SoftwareRenderer::drawVoxelColumn(int x, const CoordInt2 &coord, const Came
 	const int adjustedVoxelY = camera.getAdjustedEyeVoxelY(ceilingScale);
 
 	// Try to draw voxel straight ahead first.
-	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunkPtr->getHeight()))
+	if ((adjustedVoxelY >= 0) && (adjustedVoxelY < chunk.getHeight()))
 	{
-		const VoxelInt3 sameFloorVoxel(coord.voxel.x, adjustedVoxelY, coord.voxel.y);
-		SoftwareRenderer::drawVoxelSameFloor(x, *chunkPtr, sameFloorVoxel, camera, ray, facing, nearPoint, farPoint,
-			nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights,
-			visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 sameFloorVoxel(voxel.x, adjustedVoxelY, voxel.y);
+		SoftwareRenderer::drawVoxelSameFloor(x, chunk, chunkRenderDef, sameFloorVoxel, camera, ray, facing,
+			nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale,
+			chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 	}
 
 	// Try to draw voxels below the player's voxel (clamping in case the player is above the chunk).
-	for (int voxelY = std::min(adjustedVoxelY - 1, chunkPtr->getHeight() - 1); voxelY >= 0; voxelY--)
+	for (int voxelY = std::min(adjustedVoxelY - 1, chunk.getHeight() - 1); voxelY >= 0; voxelY--)
 	{
-		const VoxelInt3 belowVoxel(coord.voxel.x, voxelY, coord.voxel.y);
-		SoftwareRenderer::drawVoxelBelow(x, *chunkPtr, belowVoxel, camera, ray, facing, nearPoint, farPoint,
-			nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights,
-			visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 belowVoxel(voxel.x, voxelY, voxel.y);
+		SoftwareRenderer::drawVoxelBelow(x, chunk, chunkRenderDef, belowVoxel, camera, ray, facing, nearPoint,
+			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager,
+			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 	}
 	
 	// Try to draw voxels above the player's voxel (clamping in case the player is below the chunk).
-	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunkPtr->getHeight(); voxelY++)
+	for (int voxelY = std::max(adjustedVoxelY + 1, 0); voxelY < chunk.getHeight(); voxelY++)
 	{
-		const VoxelInt3 aboveVoxel(coord.voxel.x, voxelY, coord.voxel.y);
-		SoftwareRenderer::drawVoxelAbove(x, *chunkPtr, aboveVoxel, camera, ray, facing, nearPoint, farPoint,
-			nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights,
-			visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const VoxelInt3 aboveVoxel(voxel.x, voxelY, voxel.y);
+		SoftwareRenderer::drawVoxelAbove(x, chunk, chunkRenderDef, aboveVoxel, camera, ray, facing, nearPoint,
+			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingScale, chunkManager,
+			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 	}
 }
 
@@ -7316,6 +7959,15 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 		const Double3 &fogColor = shadingInfo.getFogColor();
 		const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
 
+		// Pre-shaded palette colors for the column. Override palettes aren't in the light table.
+		const uint32_t *lightTableColors = nullptr;
+		if ((shadingInfo.lightTable != nullptr) && (overridePalette == nullptr))
+		{
+			const double lightPercent = std::min(shading.x + lightContributionPercent, 1.0);
+			lightTableColors = shadingInfo.lightTable->getColors(
+				LightTable::getLightLevel(lightPercent), LightTable::getFogStep(fogPercent));
+		}
+
 		for (int y = yStart; y < yEnd; y++)
 		{
 			const int index = x + (y * frame.width);
@@ -7386,6 +8038,14 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 						const bool isRedSrc2 = (texel.value == ArenaRenderUtils::PALETTE_INDEX_RED_SRC2);
 						const int paletteIndex = isRedSrc1 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST1 :
 							(isRedSrc2 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST2 : texel.value);
+
+						if (lightTableColors != nullptr)
+						{
+							frame.colorBuffer[index] = lightTableColors[paletteIndex];
+							frame.depthBuffer[index] = depth;
+							continue;
+						}
+
 						const Double4 texelColor = Double4::fromARGB(palette[paletteIndex].toARGB());
 
 						const double shadingMax = 1.0;
@@ -7422,9 +8082,9 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 template <bool NonNegativeDirX, bool NonNegativeDirZ>
 void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray &ray,
 	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-	const FrameView &frame)
+	const RenderDefinitionGroup &renderDefGroup, const BufferView<const VisibleLight> &visLights,
+	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
 	// Initially based on Lode Vandevenne's algorithm, this method of 2.5D ray casting is more 
 	// expensive as it does not stop at the first wall intersection, and it also renders voxels 
@@ -7479,11 +8139,12 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 		NonNegativeDirZ ? VoxelFacing2D::NegativeZ : VoxelFacing2D::PositiveZ
 	};
 
-	// Check whether the initial voxel is in a loaded chunk.
+	// Check whether the initial voxel is in a loaded chunk. The chunk is only looked up again when the
+	// ray crosses into another one. Render definitions are in the same order as the chunk manager's chunks.
 	ChunkInt2 currentChunk = camera.eye.chunk;
-	const Chunk *currentChunkPtr = chunkManager.tryGetChunk(currentChunk);
+	std::optional<int> currentChunkIndex = chunkManager.tryGetChunkIndex(currentChunk);
 
-	if (currentChunkPtr != nullptr)
+	if (currentChunkIndex.has_value())
 	{
 		// Decide how far the wall is, and which voxel face was hit.
 		if (initialDeltaDistX < initialDeltaDistZ)
@@ -7510,15 +8171,17 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 			VoxelDouble2(ray.dirX * rayDistance, ray.dirZ * rayDistance);
 
 		// Draw all voxels in a column at the player's XZ coordinate.
-		const CoordInt2 initialVoxelColumnCoord(currentChunk, VoxelUtils::pointToVoxel(eyePoint2D));
+		const Chunk &initialChunk = chunkManager.getChunk(*currentChunkIndex);
+		const ChunkRenderDefinition &initialChunkRenderDef = renderDefGroup.getChunkRenderDef(*currentChunkIndex);
+		const VoxelInt2 initialVoxel = VoxelUtils::pointToVoxel(eyePoint2D);
 		const NewDouble2 absoluteInitialNearPoint =
 			VoxelUtils::coordToNewPoint(CoordDouble2(currentChunk, initialNearPoint));
 		const NewDouble2 absoluteInitialFarPoint =
 			VoxelUtils::coordToNewPoint(CoordDouble2(currentChunk, initialFarPoint));
-		SoftwareRenderer::drawInitialVoxelColumn(x, initialVoxelColumnCoord, camera, ray, facing,
-			absoluteInitialNearPoint, absoluteInitialFarPoint, SoftwareRenderer::NEAR_PLANE, rayDistance,
-			shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights, visLightLists, textures,
-			chasmTextureGroups, occlusion, frame);
+		SoftwareRenderer::drawInitialVoxelColumn(x, initialChunk, initialChunkRenderDef, initialVoxel, camera,
+			ray, facing, absoluteInitialNearPoint, absoluteInitialFarPoint, SoftwareRenderer::NEAR_PLANE,
+			rayDistance, shadingInfo, chunkDistance, ceilingScale, chunkManager, visLights, visLightLists,
+			textures, chasmTextureGroups, occlusion, frame);
 	}
 
 	// The current voxel coordinate in the DDA loop. For all intents and purposes here, the Y coordinate
@@ -7539,7 +8202,7 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 	// @optimization: constexpr values in a lambda capture (stepX, zDistance values) are not baked in!!
 	// - Only way to get the values baked in is 1) make template doDDAStep() method, or 2) no lambda.
 	auto doDDAStep = [&camera, &ray, &chunkManager, &eyePoint, stepX, stepZ, deltaDistX, deltaDistZ,
-		&rayDistance, &facing, &visibleWallFacings, &currentChunk, &currentChunkPtr, &currentVoxel,
+		&rayDistance, &facing, &visibleWallFacings, &currentChunk, &currentChunkIndex, &currentVoxel,
 		&deltaDistSumX, &deltaDistSumZ, halfOneMinusStepXReal, halfOneMinusStepZReal]()
 	{
 		const ChunkInt2 oldChunk = currentChunk;
@@ -7603,7 +8266,7 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 
 		if (currentChunk != oldChunk)
 		{
-			currentChunkPtr = chunkManager.tryGetChunk(currentChunk);
+			currentChunkIndex = chunkManager.tryGetChunkIndex(currentChunk);
 		}
 	};
 
@@ -7612,11 +8275,12 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 
 	// Step through the voxel grid while the current chunk is valid and the column is not
 	// completely occluded.
-	while ((currentChunkPtr != nullptr) && (occlusion.yMin != occlusion.yMax))
+	while (currentChunkIndex.has_value() && (occlusion.yMin != occlusion.yMax))
 	{
 		// Store part of the current DDA state. The loop needs to do another DDA step to calculate
 		// the point on the far side of this voxel.
-		const CoordInt2 savedVoxelCoord(currentChunk, currentVoxel);
+		const int savedChunkIndex = *currentChunkIndex;
+		const VoxelInt2 savedVoxel = currentVoxel;
 		const VoxelFacing2D savedFacing = facing;
 		const double savedDistance = rayDistance;
 
@@ -7636,17 +8300,20 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 		const NewDouble2 absoluteFarPoint = VoxelUtils::coordToNewPoint(farCoord);
 
 		// Draw all voxels in a column at the given XZ coordinate.
-		SoftwareRenderer::drawVoxelColumn(x, savedVoxelCoord, camera, ray, savedFacing, absoluteNearPoint,
-			absoluteFarPoint, savedDistance, rayDistance, shadingInfo, chunkDistance, ceilingScale,
-			chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		const Chunk &savedChunk = chunkManager.getChunk(savedChunkIndex);
+		const ChunkRenderDefinition &savedChunkRenderDef = renderDefGroup.getChunkRenderDef(savedChunkIndex);
+		SoftwareRenderer::drawVoxelColumn(x, savedChunk, savedChunkRenderDef, savedVoxel, camera, ray,
+			savedFacing, absoluteNearPoint, absoluteFarPoint, savedDistance, rayDistance, shadingInfo,
+			chunkDistance, ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups,
+			occlusion, frame);
 	}
 }
 
 void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, const ShadingInfo &shadingInfo,
 	int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-	const FrameView &frame)
+	const RenderDefinitionGroup &renderDefGroup, const BufferView<const VisibleLight> &visLights,
+	const VisibleLightLists &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
 	// Certain values like the step delta are constant relative to the ray direction, allowing
 	// for some compile-time constants and better code generation.
@@ -7658,12 +8325,14 @@ void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, co
 		if (nonNegativeDirZ)
 		{
 			SoftwareRenderer::rayCast2DInternal<true, true>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingScale, chunkManager, renderDefGroup, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
 		}
 		else
 		{
 			SoftwareRenderer::rayCast2DInternal<true, false>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingScale, chunkManager, renderDefGroup, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
 		}
 	}
 	else
@@ -7671,20 +8340,24 @@ void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, co
 		if (nonNegativeDirZ)
 		{
 			SoftwareRenderer::rayCast2DInternal<false, true>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingScale, chunkManager, renderDefGroup, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
 		}
 		else
 		{
 			SoftwareRenderer::rayCast2DInternal<false, false>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingScale, chunkManager, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingScale, chunkManager, renderDefGroup, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
 		}
 	}
 }
 
 void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProjYTop,
-	double gradientProjYBottom, Buffer<Double3> &skyGradientRowCache,
+	double gradientProjYBottom, Buffer<SkyGradientRow> &skyGradientRowCache,
 	std::atomic<bool> &shouldDrawStars, const ShadingInfo &shadingInfo, const FrameView &frame)
 {
+	TraceZone("SoftwareRenderer::drawSkyGradient");
+
 	// Lambda for drawing one row of colors and depth in the frame buffer.
 	auto drawSkyRow = [&frame](int y, const Double3 &color)
 	{
@@ -7733,12 +8406,24 @@ void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProj
 				*thunderstormFlashPercent, thunderstormColors.data(), thunderstormColorCount);
 		}
 
-		// Cache row color for star rendering.
-		skyGradientRowCache.set(y, color);
-
-		// Update star visibility.
+		// Update star visibility. Interpolate with a range of intensities so stars don't immediately
+		// blink on/off when the gradient is a certain color.
+		constexpr double visThreshold = ShadingInfo::STAR_VIS_THRESHOLD;
+		constexpr double brightestThreshold = ShadingInfo::STAR_BRIGHTEST_THRESHOLD;
 		const double maxComp = std::max(std::max(color.x, color.y), color.z);
-		isDarkEnough |= maxComp <= ShadingInfo::STAR_VIS_THRESHOLD;
+		const bool isRowDarkEnough = maxComp <= visThreshold;
+		isDarkEnough |= isRowDarkEnough;
+
+		// Cache row color and star blend percent for star rendering.
+		SkyGradientRow &row = skyGradientRowCache.get(y);
+		row.color = color.toRGB();
+		row.starGradientPercent = 255;
+		if (isRowDarkEnough)
+		{
+			const double gradientVisPercent = std::clamp(
+				(maxComp - brightestThreshold) / (visThreshold - brightestThreshold), 0.0, 1.0);
+			row.starGradientPercent = static_cast<uint8_t>(std::round(gradientVisPercent * 255.0));
+		}
 
 		drawSkyRow(y, color);
 	}
@@ -7749,15 +8434,103 @@ void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProj
 	}
 }
 
+void SoftwareRenderer::drawStars(int startX, int endX, const std::vector<VisibleStar> &visibleStars,
+	const Buffer<SkyGradientRow> &skyGradientRowCache, const FrameView &frame)
+{
+	for (const VisibleStar &star : visibleStars)
+	{
+		const int xDrawStart = std::max(star.xStart, startX);
+		const int xDrawEnd = std::min(star.xEnd, endX);
+		if (xDrawStart >= xDrawEnd)
+		{
+			continue;
+		}
+
+		const StarTexture &texture = *star.texture;
+		const uint32_t *texels = texture.texels.data();
+		const double textureWidthReal = static_cast<double>(texture.width);
+		const double textureHeightReal = static_cast<double>(texture.height);
+		const double xProjWidth = star.xProjEnd - star.xProjStart;
+		const double yProjHeight = star.yProjEnd - star.yProjStart;
+
+		for (int y = star.yStart; y < star.yEnd; y++)
+		{
+			// Skip rows where the gradient is too bright for stars.
+			const SkyGradientRow &gradientRow = skyGradientRowCache.get(y);
+			if (gradientRow.starGradientPercent == 255)
+			{
+				continue;
+			}
+
+			const double v = std::clamp(((static_cast<double>(y) + 0.50) - star.yProjStart) / yProjHeight,
+				0.0, Constants::JustBelowOne);
+			const int textureY = static_cast<int>(v * textureHeightReal);
+			const uint32_t *texelRow = texels + (textureY * texture.width);
+			uint32_t *colorRow = frame.colorBuffer + (y * frame.width);
+
+			for (int x = xDrawStart; x < xDrawEnd; x++)
+			{
+				const double u = std::clamp(((static_cast<double>(x) + 0.50) - star.xProjStart) / xProjWidth,
+					0.0, Constants::JustBelowOne);
+				const int textureX = static_cast<int>(u * textureWidthReal);
+				const uint32_t texel = texelRow[textureX];
+
+				// Transparent texels are not drawn.
+				if ((texel & 0xFF000000) != 0)
+				{
+					// Lerp with sky gradient for smoother transition between day and night.
+					colorRow[x] = blendStarColor(texel, gradientRow.color, gradientRow.starGradientPercent);
+				}
+			}
+		}
+	}
+}
+
+void SoftwareRenderer::drawSkyPanorama(int startX, int endX, const SkyPanorama &skyPanorama,
+	const FrameView &frame)
+{
+	if (!skyPanorama.isValid())
+	{
+		return;
+	}
+
+	const int panoramaWidth = skyPanorama.texels.getWidth();
+	const SkyPanoramaTexel *panoramaTexels = skyPanorama.texels.get();
+	const int *screenColumns = skyPanorama.screenColumns.get();
+
+	for (int y = skyPanorama.yStart; y < skyPanorama.yEnd; y++)
+	{
+		const SkyPanoramaTexel *rowTexels = panoramaTexels + (skyPanorama.screenRows.get(y) * panoramaWidth);
+		uint32_t *colorRow = frame.colorBuffer + (y * frame.width);
+
+		for (int x = startX; x < endX; x++)
+		{
+			const SkyPanoramaTexel &texel = rowTexels[screenColumns[x]];
+			if (texel.visPercent == 0)
+			{
+				colorRow[x] = texel.color;
+			}
+			else if (texel.visPercent < 255)
+			{
+				// Cloud edge, diminish the previously rendered pixel.
+				colorRow[x] = diminishColor(colorRow[x], texel.visPercent);
+			}
+		}
+	}
+}
+
 void SoftwareRenderer::drawDistantSky(int startX, int endX, const VisDistantObjects &visDistantObjs,
-	const std::vector<SkyTexture> &skyTextures, const Buffer<Double3> &skyGradientRowCache,
+	const std::vector<SkyTexture> &skyTextures, const SkyPanorama &skyPanorama,
+	const std::vector<VisibleStar> &visibleStars, const Buffer<SkyGradientRow> &skyGradientRowCache,
 	bool shouldDrawStars, const ShadingInfo &shadingInfo, const FrameView &frame)
 {
-	enum class DistantRenderType { General, Moon, Star };
+	TraceZone("SoftwareRenderer::drawDistantSky");
+
+	enum class DistantRenderType { General, Moon };
 
 	// For each visible distant object, if it is at least partially within the start and end
 	// X, then draw.
-	auto drawDistantObj = [startX, endX, &skyTextures, &skyGradientRowCache, &shadingInfo, &frame](
+	auto drawDistantObj = [startX, endX, &skyTextures, &shadingInfo, &frame](
 		const VisDistantObject &obj, DistantRenderType renderType)
 	{
 		const SkyTexture &texture = *obj.texture;
@@ -7792,11 +8565,6 @@ void SoftwareRenderer::drawDistantSky(int startX, int endX, const VisDistantObje
 				SoftwareRenderer::drawMoonPixels(x, drawRange, u, 0.0, Constants::JustBelowOne,
 					texture, shadingInfo, frame);
 			}
-			else if (renderType == DistantRenderType::Star)
-			{
-				SoftwareRenderer::drawStarPixels(x, drawRange, u, 0.0, Constants::JustBelowOne,
-					texture, skyGradientRowCache, shadingInfo, frame);
-			}
 		}
 	};
 
@@ -7819,22 +8587,25 @@ void SoftwareRenderer::drawDistantSky(int startX, int endX, const VisDistantObje
 	// the daytime.
 	if (shouldDrawStars)
 	{
-		drawDistantObjRange(visDistantObjs.starStart, visDistantObjs.starEnd, DistantRenderType::Star);
+		SoftwareRenderer::drawStars(startX, endX, visibleStars, skyGradientRowCache, frame);
 	}
 
 	drawDistantObjRange(visDistantObjs.sunStart, visDistantObjs.sunEnd, DistantRenderType::General);
 	drawDistantObjRange(visDistantObjs.moonStart, visDistantObjs.moonEnd, DistantRenderType::Moon);
+	SoftwareRenderer::drawSkyPanorama(startX, endX, skyPanorama, frame);
 	drawDistantObjRange(visDistantObjs.airStart, visDistantObjs.airEnd, DistantRenderType::General);
 	drawDistantObjRange(visDistantObjs.landStart, visDistantObjs.landEnd, DistantRenderType::General);
 	drawDistantObjRange(visDistantObjs.lightningStart, visDistantObjs.lightningEnd, DistantRenderType::General);
 }
 
 void SoftwareRenderer::drawVoxels(int startX, int stride, const Camera &camera, int chunkDistance,
-	double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
-	const VisibleLightLists &visLightLists, const VoxelTextures &voxelTextures,
-	const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion,
-	const ShadingInfo &shadingInfo, const FrameView &frame)
+	double ceilingScale, const ChunkManager &chunkManager, const RenderDefinitionGroup &renderDefGroup,
+	const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+	const VoxelTextures &voxelTextures, const ChasmTextureGroups &chasmTextureGroups,
+	Buffer<OcclusionData> &occlusion, const ShadingInfo &shadingInfo, const FrameView &frame)
 {
+	TraceZone("SoftwareRenderer::drawVoxels");
+
 	const NewDouble2 forwardZoomed(camera.forwardZoomedX, camera.forwardZoomedZ);
 	const NewDouble2 rightAspected(camera.rightAspectedX, camera.rightAspectedZ);
 
@@ -7855,7 +8626,8 @@ void SoftwareRenderer::drawVoxels(int startX, int stride, const Camera &camera,
 
 		// Cast the 2D ray and fill in the column's pixels with color.
 		SoftwareRenderer::rayCast2D(x, camera, ray, shadingInfo, chunkDistance, ceilingScale, chunkManager,
-			visLights, visLightLists, voxelTextures, chasmTextureGroups, occlusion.get(x), frame);
+			renderDefGroup, visLights, visLightLists, voxelTextures, chasmTextureGroups, occlusion.get(x),
+			frame);
 	}
 }
 
@@ -7865,6 +8637,8 @@ void SoftwareRenderer::drawFlats(int startX, int endX, const Camera &camera,
 	const BufferView<const VisibleLight> &visLights,
 	const VisibleLightLists &visLightLists, const FrameView &frame)
 {
+	TraceZone("SoftwareRenderer::drawFlats");
+
 	// Iterate through all flats, rendering those visible within the given X range of 
 	// the screen.
 	for (const VisibleFlat &flat : visibleFlats)
@@ -7881,8 +8655,10 @@ void SoftwareRenderer::drawFlats(int startX, int endX, const Camera &camera,
 }
 
 void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const WeatherInstance &weatherInst,
-	const Camera &camera, const ShadingInfo &shadingInfo, Random &random, const FrameView &frame)
+	const Camera &camera, const ShadingInfo &shadingInfo, uint64_t randomSeed, const FrameView &frame)
 {
+	TraceZone("SoftwareRenderer::drawWeather");
+
 	// Disabled until the projection math is working.
 	if (false /*weatherInst.hasFog()*/)
 	{
@@ -8002,8 +8778,11 @@ void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const Weath
 
 					// Texture coordinates might be affected by current pixel coordinate.
 					// @todo: this is a placeholder until fog is more understood.
+					const int dstIndex = x + (y * frame.width);
 					if (((x + y) & 1) != 0)
 					{
+						// Each pixel has its own random stream so the result doesn't depend on the render threads.
+						CounterRandom random(randomSeed, dstIndex);
 						const double uRevised = random.nextReal();
 						const double vRevised = random.nextReal();
 						const uint8_t randomFogTexel = SoftwareRenderer::sampleFogMatrixTexture<
@@ -8016,7 +8795,6 @@ void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const Weath
 					// @temp: convert to true color.
 					const Double3 fogColor(1.0, 1.0, 1.0);
 
-					const int dstIndex = x + (y * frame.width);
 					const Double3 prevColor = Double3::fromRGB(frame.colorBuffer[dstIndex]);
 					const Double3 newColor = (prevColor + ((fogColor - prevColor) * fogPercent)).clamped();
 					frame.colorBuffer[dstIndex] = newColor.toRGB();
@@ -8055,13 +8833,14 @@ void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const Weath
 		};
 
 		const WeatherInstance::RainInstance &rainInst = weatherInst.getRain();
-		const Buffer<WeatherInstance::Particle> &particles = rainInst.particles;
+		const WeatherInstance::Particles &particles = rainInst.particles;
+		const double *xPercents = particles.xPercents.get();
+		const double *yPercents = particles.yPercents.get();
 		for (int i = 0; i < particles.getCount(); i++)
 		{
-			const WeatherInstance::Particle &particle = particles.get(i);
-			const double raindropLeft = particle.xPercent;
+			const double raindropLeft = xPercents[i];
 			const double raindropRight = raindropLeft + raindropScaledWidthPercent;
-			const double raindropTop = particle.yPercent;
+			const double raindropTop = yPercents[i];
 			const double raindropBottom = raindropTop + raindropBaseHeightPercent;
 
 			const int startX = std::max(RendererUtils::getLowerBoundedPixel(raindropLeft * frame.widthReal, frame.width), threadStartX);
@@ -8155,7 +8934,7 @@ void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const Weath
 		};
 
 		const WeatherInstance::SnowInstance &snowInst = weatherInst.getSnow();
-		const Buffer<WeatherInstance::Particle> &particles = snowInst.particles;
+		const WeatherInstance::Particles &particles = snowInst.particles;
 
 		auto drawSnowflakeRange = [threadStartX, threadEndX, &frame, &snowflakeDims, &snowflakeRealDims,
 			&snowflakeBaseHeightPercents, &snowflakeScaledWidthPercents, &snowflakeTextures,
@@ -8173,10 +8952,9 @@ void SoftwareRenderer::drawWeather(int threadStartX, int threadEndX, const Weath
 
 			for (int i = startIndex; i < endIndex; i++)
 			{
-				const WeatherInstance::Particle &particle = particles.get(i);
-				const double snowflakeLeft = particle.xPercent;
+				const double snowflakeLeft = particles.xPercents.get(i);
 				const double snowflakeRight = snowflakeLeft + scaledWidthPercent;
-				const double snowflakeTop = particle.yPercent;
+				const double snowflakeTop = particles.yPercents.get(i);
 				const double snowflakeBottom = snowflakeTop + baseHeightPercent;
 
 				const int startX = std::max(RendererUtils::getLowerBoundedPixel(snowflakeLeft * frame.widthReal, frame.width), threadStartX);
@@ -8270,9 +9048,16 @@ void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int thread
 		lk.unlock();
 
 		// Draw this thread's portion of distant sky objects.
+		const auto distantSkyStartTime = std::chrono::high_resolution_clock::now();
 		SoftwareRenderer::drawDistantSky(startX, endX, *distantSky.visDistantObjs,
-			*distantSky.skyTextures, *skyGradient.rowCache, skyGradient.shouldDrawStars,
-			*threadData.shadingInfo, *threadData.frame);
+			*distantSky.skyTextures, *distantSky.skyPanorama, *distantSky.visibleStars, *skyGradient.rowCache,
+			skyGradient.shouldDrawStars, *threadData.shadingInfo, *threadData.frame);
+		const auto distantSkyEndTime = std::chrono::high_resolution_clock::now();
+		const double distantSkyTime = std::chrono::duration<double>(distantSkyEndTime - distantSkyStartTime).count();
+
+		lk.lock();
+		distantSky.drawTime = std::max(distantSky.drawTime, distantSkyTime);
+		lk.unlock();
 
 		// Wait for other threads to finish distant sky objects.
 		threadBarrier(distantSky);
@@ -8291,9 +9076,9 @@ void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int thread
 		const BufferView<const VisibleLight> voxelsVisLightsView(voxels.visLights->data(),
 			static_cast<int>(voxels.visLights->size()));
 		SoftwareRenderer::drawVoxels(threadIndex, strideX, *threadData.camera, voxels.chunkDistance,
-			voxels.ceilingScale, *voxels.chunkManager, voxelsVisLightsView, *voxels.visLightLists,
-			*voxels.voxelTextures, *voxels.chasmTextureGroups, *voxels.occlusion, *threadData.shadingInfo,
-			*threadData.frame);
+			voxels.ceilingScale, *voxels.chunkManager, *voxels.renderDefGroup, voxelsVisLightsView,
+			*voxels.visLightLists, *voxels.voxelTextures, *voxels.chasmTextureGroups, *voxels.occlusion,
+			*threadData.shadingInfo, *threadData.frame);
 
 		// Wait for other threads to finish voxels.
 		threadBarrier(voxels);
@@ -8321,7 +9106,7 @@ void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int thread
 
 		// Draw this thread's portion of the weather.
 		SoftwareRenderer::drawWeather(startX, endX, *weather.weatherInst, *threadData.camera, *threadData.shadingInfo,
-			*weather.random, *threadData.frame);
+			weather.randomSeed, *threadData.frame);
 
 		// Wait for other threads to finish the weather.
 		threadBarrier(weather);
@@ -8334,6 +9119,20 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	const SkyInstance &skyInst, const WeatherInstance &weatherInst, Random &random, 
 	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer)
 {
+	TraceZone("SoftwareRenderer::render");
+
+	// Release the previous frame's temporaries.
+	this->frameAllocator.clear();
+
+	// Bring voxel render data up to date. Only chunks that changed since the last frame are rebuilt so
+	// the voxel drawing loops can read flat per-chunk arrays instead of looking up textures by name.
+	const VoxelTextures &voxelTextures = this->voxelTextures;
+	this->chunkRenderDefRebuildCount = this->renderDefGroup.updateChunkRenderDefs(levelInst.getChunkManager(),
+		[&voxelTextures](const TextureAssetReference &textureAssetRef, VoxelTextureID *outID)
+	{
+		return voxelTextures.tryGetTextureID(textureAssetRef, outID);
+	}, voxelTextures.generation);
+
 	// Constants for screen dimensions.
 	const double widthReal = static_cast<double>(this->width);
 	const double heightReal = static_cast<double>(this->height);
@@ -8350,8 +9149,14 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 
 	// Calculate shading information for this frame. Create some helper structs to keep similar
 	// values together.
-	const ShadingInfo shadingInfo(palette, this->skyColors, weatherInst, daytimePercent, latitude, ambient,
+	ShadingInfo shadingInfo(palette, this->skyColors, weatherInst, daytimePercent, latitude, ambient,
 		this->fogDistance, chasmAnimPercent, nightLightsAreActive, isExterior, playerHasLight);
+
+	if (this->lightTableShading)
+	{
+		this->lightTable.update(shadingInfo.palette, shadingInfo.getFogColor());
+		shadingInfo.lightTable = &this->lightTable;
+	}
 	const FrameView frame(colorBuffer, this->depthBuffer.get(), this->width, this->height);
 
 	// Projected Y range of the sky gradient.
@@ -8361,12 +9166,13 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	// Set all the render-thread-specific shared data for this frame.
 	this->threadData.init(this->renderThreads.getCount(), camera, shadingInfo, frame);
 	this->threadData.skyGradient.init(gradientProjYTop, gradientProjYBottom, this->skyGradientRowCache);
-	this->threadData.distantSky.init(this->visDistantObjs, this->skyTextures);
-	this->threadData.voxels.init(chunkDistance, ceilingScale, levelInst.getChunkManager(), this->visibleLights,
-		this->visLightLists, this->voxelTextures, this->chasmTextureGroups, this->occlusion);
+	this->threadData.distantSky.init(this->visDistantObjs, this->skyTextures, this->skyPanorama,
+		this->visibleStars);
+	this->threadData.voxels.init(chunkDistance, ceilingScale, levelInst.getChunkManager(), this->renderDefGroup,
+		this->visibleLights, this->visLightLists, this->voxelTextures, this->chasmTextureGroups, this->occlusion);
 	this->threadData.flats.init(flatNormal, this->visibleFlats, this->visibleLights, this->visLightLists,
 		this->entityTextures);
-	this->threadData.weather.init(weatherInst, random);
+	this->threadData.weather.init(weatherInst, static_cast<uint64_t>(random.next()));
 
 	// Give the render threads the go signal. They can work on the sky and voxels while this thread
 	// does things like resetting occlusion and doing visible flat determination.
@@ -8380,7 +9186,8 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	// it is read.
 	this->occlusion.fill(OcclusionData(0, this->height));
 
-	// Refresh the visible distant objects.
+	// Refresh the sky panorama and the visible distant objects.
+	this->updateSkyPanorama(skyInst, shadingInfo, camera, frame);
 	this->updateVisibleDistantObjects(skyInst, shadingInfo, camera, frame);
 
 	lk.lock();
@@ -8392,6 +9199,16 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	// Keep the render threads from getting the go signal again before the next frame.
 	this->threadData.go = false;
 
+	// Stars are only projected when the sky gradient is dark enough for any of them to be seen.
+	if (this->threadData.skyGradient.shouldDrawStars)
+	{
+		this->updateVisibleStars(skyInst, camera, frame);
+	}
+	else
+	{
+		this->visibleStars.clear();
+	}
+
 	// Let the render threads know that they can start drawing distant objects.
 	this->threadData.distantSky.doneVisTesting = true;
 	lk.unlock();
@@ -8413,6 +9230,8 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 		return this->threadData.distantSky.threadsDone == this->threadData.totalThreads;
 	});
 
+	this->distantSkyTime = this->threadData.distantSky.drawTime;
+
 	// Let the render threads know that they can start drawing voxels.
 	this->threadData.voxels.doneLightVisTesting = true;
 	lk.unlock();
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "RenderDefinitionGroup.h"
 #include "RendererSystem3D.h"
 #include "../Assets/ArenaTypes.h"
 #include "../Entities/EntityManager.h"
@@ -23,6 +24,7 @@
 #include "../World/VoxelDefinition.h"
 #include "../World/VoxelUtils.h"
 
+#include "components/utilities/Allocator.h"
 #include "components/utilities/Buffer2D.h"
 #include "components/utilities/BufferView.h"
 #include "components/utilities/BufferView2D.h"
@@ -73,6 +75,7 @@ private:
 	struct VoxelTexture
 	{
 		std::vector<VoxelTexel> texels;
+		std::vector<uint16_t> lightTableTexels; // Palette index + emissive bit, for light table shading.
 		std::vector<Int2> lightTexels; // Black during the day, yellow at night.
 		// @todo: replace lightTexels with two VoxelTextures: one for day, one for night.
 		int width, height;
@@ -104,6 +107,18 @@ private:
 		void init(int width, int height, const uint8_t *srcTexels, const Palette &palette);
 	};
 
+	// Sky texture with texels packed as ARGB so the star pass can blend them without converting per pixel.
+	// Alpha is either 0 (transparent) or 255.
+	struct StarTexture
+	{
+		std::vector<uint32_t> texels;
+		int width, height;
+
+		StarTexture();
+
+		void init(const SkyTexture &skyTexture);
+	};
+
 	struct ChasmTexture
 	{
 		std::vector<ChasmTexel> texels;
@@ -129,11 +144,20 @@ private:
 	{
 		std::vector<VoxelTexture> textures;
 		std::vector<VoxelTextureMapping> mappings;
+		uint64_t generation; // Incremented when texture IDs change so render definitions can be rebuilt.
+		mutable bool hasMissingTexture; // A render definition asked for a texture not added yet.
+
+		VoxelTextures();
 
 		void addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef);
 
 		const VoxelTexture &getTexture(const TextureAssetReference &textureAssetRef) const;
 
+		// Gets the texture of a voxel render definition's rectangle without searching mappings.
+		const VoxelTexture &getTexture(const VoxelRenderDefinition &voxelRenderDef, int rectIndex) const;
+
+		bool tryGetTextureID(const TextureAssetReference &textureAssetRef, VoxelTextureID *outID) const;
+
 		void clear();
 	};
 
@@ -262,6 +286,40 @@ private:
 		Double3 normal;
 	};
 
+	// Palette colors pre-shaded at each light level and fog step, like the original game's light tables.
+	// Only rebuilt when the palette or fog color changes, so shading becomes a look-up on 8-bit texels.
+	struct LightTable
+	{
+		static constexpr int LIGHT_LEVEL_COUNT = 32;
+		static constexpr int FOG_STEP_COUNT = 32;
+		static constexpr int COLOR_COUNT = 256;
+
+		// Set in light table texels of voxel textures for texels that ignore shading (i.e., night lights).
+		static constexpr uint16_t EMISSIVE_BIT = 0x100;
+
+		std::vector<uint32_t> colors; // Fog steps * light levels * colors.
+		std::array<uint32_t, COLOR_COUNT> paletteKey;
+		uint32_t fogColorKey;
+
+		LightTable();
+
+		bool isValid() const;
+
+		// Rebuilds the table if the palette or fog color is different from last time.
+		void update(const Palette &palette, const Double3 &fogColor);
+
+		// Gets the light level closest to the given light percent (clamped to [0, 1]).
+		static int getLightLevel(double lightPercent);
+
+		// Gets the fog step closest to the given fog percent in [0, 1].
+		static int getFogStep(double fogPercent);
+
+		// Gets the 256 shaded colors for a light level and fog step.
+		const uint32_t *getColors(int lightLevel, int fogStep) const;
+
+		void clear();
+	};
+
 	// Helper struct for keeping shading data organized in the renderer. These values are
 	// computed once per frame.
 	struct ShadingInfo
@@ -272,6 +330,9 @@ private:
 		// Sky gradient brightness when stars become visible.
 		static constexpr double STAR_VIS_THRESHOLD = 64.0 / 255.0;
 
+		// Sky gradient brightness when stars are brightest.
+		static constexpr double STAR_BRIGHTEST_THRESHOLD = 32.0 / 255.0;
+
 		// The palette used for converting 8-bit texels to true color.
 		Palette palette;
 
@@ -304,6 +365,9 @@ private:
 		// Whether the player has a light attached like the original game.
 		bool playerHasLight;
 
+		// Pre-shaded palette colors. Null if shading is done per-pixel in floating point instead.
+		const LightTable *lightTable;
+
 		ShadingInfo(const Palette &palette, const std::vector<Double3> &skyColors, const WeatherInstance &weatherInst,
 			double daytimePercent, double latitude, double ambient, double fogDistance, double chasmAnimPercent,
 			bool nightLightsAreActive, bool isExterior, bool playerHasLight);
@@ -393,15 +457,63 @@ private:
 		std::vector<VisDistantObject> objs;
 
 		// Need to store start and end indices for each range so we can call different 
-		// shading methods on some of them. End indices are exclusive.
-		int landStart, landEnd, airStart, airEnd, moonStart, moonEnd, sunStart, sunEnd, starStart, starEnd,
-			lightningStart, lightningEnd;
+		// shading methods on some of them. End indices are exclusive. Stars are handled separately.
+		int landStart, landEnd, airStart, airEnd, moonStart, moonEnd, sunStart, sunEnd, lightningStart,
+			lightningEnd;
 
 		VisDistantObjects();
 
 		void clear();
 	};
 
+	// A star that has been projected on-screen and is at least partially visible.
+	struct VisibleStar
+	{
+		const StarTexture *texture;
+		double xProjStart, xProjEnd, yProjStart, yProjEnd; // Projected screen coordinates in pixels.
+		int xStart, xEnd, yStart, yEnd; // Pixel coordinates.
+	};
+
+	// Row of the most recent sky gradient, with how much of it shows through stars drawn in front.
+	struct SkyGradientRow
+	{
+		uint32_t color;
+		uint8_t starGradientPercent; // 0 is a fully bright star, 255 hides stars in this row.
+	};
+
+	// Texel of the sky panorama. Land and air layers are composited ahead of time, so each texel is either
+	// transparent, an opaque pre-shaded color, or a cloud edge that diminishes whatever is behind it.
+	struct SkyPanoramaTexel
+	{
+		uint32_t color; // Pre-shaded color, only used when opaque.
+		uint8_t visPercent; // 255 is transparent, 0 is opaque, in-between scales the color behind it.
+
+		void init(uint32_t color, uint8_t visPercent);
+	};
+
+	// Cylindrical panorama of the static distant land and air objects. Mountains and clouds never move,
+	// so they are only resampled when the sky or its shading changes instead of once per object per frame.
+	// Columns wrap around 360 degrees of yaw, and rows are in sky-space height above the horizon.
+	struct SkyPanorama
+	{
+		Buffer2D<SkyPanoramaTexel> texels;
+		std::vector<int> animLandIndices; // Land objects still drawn per-frame since their texture changes.
+		Buffer<int> screenColumns; // Panorama column of each screen column for the current frame.
+		Buffer<int> screenRows; // Panorama row of each screen row for the current frame.
+		double topHeight, bottomHeight; // Sky-space height range covered by the rows (in zoom units).
+		int yStart, yEnd; // Screen rows covered by the panorama for the current frame.
+		int distantAmbientKey; // Quantized distant ambient the texels were shaded with, or -1 if stale.
+
+		SkyPanorama();
+
+		bool isValid() const;
+
+		// Marks the panorama for rebuilding before the next frame.
+		void invalidate();
+
+		void clear();
+	};
+
 	// Instance of a light in the world visible to the camera.
 	struct VisibleLight
 	{
@@ -449,11 +561,11 @@ private:
 		struct SkyGradient
 		{
 			int threadsDone;
-			Buffer<Double3> *rowCache;
+			Buffer<SkyGradientRow> *rowCache;
 			double projectedYTop, projectedYBottom; // Projected Y range of sky gradient.
 			std::atomic<bool> shouldDrawStars; // True if the sky is dark enough.
 
-			void init(double projectedYTop, double projectedYBottom, Buffer<Double3> &rowCache);
+			void init(double projectedYTop, double projectedYBottom, Buffer<SkyGradientRow> &rowCache);
 		};
 
 		struct DistantSky
@@ -461,16 +573,20 @@ private:
 			int threadsDone;
 			const VisDistantObjects *visDistantObjs;
 			const std::vector<SkyTexture> *skyTextures;
+			const SkyPanorama *skyPanorama;
+			const std::vector<VisibleStar> *visibleStars;
+			double drawTime; // Slowest render thread's distant sky time in seconds.
 			bool doneVisTesting; // True when render threads can start rendering distant sky.
 
-			void init(const VisDistantObjects &visDistantObjs,
-				const std::vector<SkyTexture> &skyTextures);
+			void init(const VisDistantObjects &visDistantObjs, const std::vector<SkyTexture> &skyTextures,
+				const SkyPanorama &skyPanorama, const std::vector<VisibleStar> &visibleStars);
 		};
 
 		struct Voxels
 		{
 			int threadsDone;
 			const ChunkManager *chunkManager;
+			const RenderDefinitionGroup *renderDefGroup;
 			const std::vector<VisibleLight> *visLights;
 			const VisibleLightLists *visLightLists;
 			const VoxelTextures *voxelTextures;
@@ -481,9 +597,9 @@ private:
 			bool doneLightVisTesting; // True when render threads can start rendering voxels.
 
 			void init(int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-				const std::vector<VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-				const VoxelTextures &voxelTextures, const ChasmTextureGroups &chasmTextureGroups,
-				Buffer<OcclusionData> &occlusion);
+				const RenderDefinitionGroup &renderDefGroup, const std::vector<VisibleLight> &visLights,
+				const VisibleLightLists &visLightLists, const VoxelTextures &voxelTextures,
+				const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion);
 		};
 
 		struct Flats
@@ -505,10 +621,10 @@ private:
 		{
 			int threadsDone;
 			const WeatherInstance *weatherInst;
-			Random *random;
+			uint64_t randomSeed; // Per-frame seed for weather effects that need random values.
 			bool doneDrawingFlats; // True when render threads can start rendering weather.
 
-			void init(const WeatherInstance &weatherInst, Random &random);
+			void init(const WeatherInstance &weatherInst, uint64_t randomSeed);
 		};
 
 		SkyGradient skyGradient;
@@ -547,19 +663,31 @@ private:
 	std::vector<VisibleFlat> visibleFlats; // Flats to be drawn.
 	DistantObjects distantObjects; // Distant sky objects (mountains, clouds, etc.).
 	VisDistantObjects visDistantObjs; // Visible distant sky objects.
+	SkyPanorama skyPanorama; // Pre-composited static distant land and air.
+	std::vector<StarTexture> starTextures; // Packed copies of the sky textures used by stars.
+	Buffer<const StarTexture*> starTextureRefs; // Star texture of each star in the sky instance.
+	std::vector<VisibleStar> visibleStars; // Stars to be drawn.
 	VisibleLightLists visLightLists; // Potentially-visible voxel column references to visible lights.
+	std::vector<Buffer2D<VisibleLightList>> freeVisLightListGroups; // Reused for chunks entering the active range.
 	std::vector<VisibleLight> visibleLights; // Lights that contribute to the current frame.
 	VoxelTextures voxelTextures; // Voxel textures and their mappings.
+	RenderDefinitionGroup renderDefGroup; // Per-chunk voxel render data, rebuilt when a chunk changes.
+	int chunkRenderDefRebuildCount; // Chunk render definitions rebuilt last frame.
 	EntityTextures entityTextures; // Entity textures and their mappings.
 	ChasmTextureGroups chasmTextureGroups; // Mappings from chasm ID to textures.
 	std::vector<SkyTexture> skyTextures; // Distant object textures. Size is managed internally.
 	std::vector<Double3> skyColors; // Colors for each time of day.
-	Buffer<Double3> skyGradientRowCache; // Contains row colors of most recent sky gradient.
+	Buffer<SkyGradientRow> skyGradientRowCache; // Contains rows of most recent sky gradient.
+	LightTable lightTable; // Pre-shaded palette colors for light table shading.
 	Buffer<std::thread> renderThreads; // Threads used for rendering the world.
 	RenderThreadData threadData; // Managed by main thread, used by render threads.
+	FrameAllocator frameAllocator; // Main thread temporaries for the frame being rendered.
 	double fogDistance; // Distance at which fog is maximum.
+	double distantSkyTime; // Time spent drawing distant sky objects last frame, in seconds.
+	double skyPanoramaRebuildTime; // Time spent on the most recent sky panorama rebuild, in seconds.
 	int width, height; // Dimensions of frame buffer.
 	int renderThreadsMode; // Determines number of threads to use for rendering.
+	bool lightTableShading; // Whether voxels and flats are shaded with the light table.
 
 	// Initializes render threads that run in the background for the duration of the renderer's
 	// lifetime. This can also be used to reset threads after a screen resize.
@@ -569,6 +697,20 @@ private:
 	// to be at their initial wait condition before being given the go + destruct signals.
 	void resetRenderThreads();
 
+	// Gets the projected Y of the horizon and the sky-space height of a direction per unit of its tangent
+	// above the horizon. Distant objects are placed with these so they only scale with zoom.
+	static void getDistantSkyProjection(const Camera &camera, double *outHorizonProjY,
+		double *outHeightPerTangent);
+
+	// Rebuilds the sky panorama if its sky or shading is stale, and maps the current frame's screen
+	// rows and columns onto it.
+	void updateSkyPanorama(const SkyInstance &skyInstance, const ShadingInfo &shadingInfo,
+		const Camera &camera, const FrameView &frame);
+
+	// Refreshes the list of stars to be drawn. All stars are projected in one pass over the sky
+	// instance's packed star directions.
+	void updateVisibleStars(const SkyInstance &skyInstance, const Camera &camera, const FrameView &frame);
+
 	// Refreshes the list of distant objects to be drawn.
 	void updateVisibleDistantObjects(const SkyInstance &skyInstance, const ShadingInfo &shadingInfo,
 		const Camera &camera, const FrameView &frame);
@@ -576,7 +718,8 @@ private:
 	// Refreshes the list of potentially visible flats (to be passed to actually-visible flat
 	// calculation).
 	static void updatePotentiallyVisibleFlats(const Camera &camera,int chunkDistance,
-		const EntityManager &entityManager, std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount);
+		const EntityManager &entityManager, FrameAllocator &frameAllocator,
+		std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount);
 
 	// Refreshes the list of flats to be drawn.
 	void updateVisibleFlats(const Camera &camera, const ShadingInfo &shadingInfo, int chunkDistance,
@@ -794,74 +937,76 @@ private:
 		double vEnd, const SkyTexture &texture, const ShadingInfo &shadingInfo,
 		const FrameView &frame);
 
-	// Draws a column of pixels for a star. This is its own pixel-rendering method because of
-	// the unique method of shading required for stars.
-	static void drawStarPixels(int x, const DrawRange &drawRange, double u, double vStart,
-		double vEnd, const SkyTexture &texture, const Buffer<Double3> &skyGradientRowCache,
-		const ShadingInfo &shadingInfo, const FrameView &frame);
+	// Draws the portion of all visible stars within the given X range of the screen. Stars are
+	// blended with the sky gradient behind them so they fade in as it gets darker.
+	static void drawStars(int startX, int endX, const std::vector<VisibleStar> &visibleStars,
+		const Buffer<SkyGradientRow> &skyGradientRowCache, const FrameView &frame);
 
 	// Helper functions for drawing the initial voxel column.
-	static void drawInitialVoxelSameFloor(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+	static void drawInitialVoxelSameFloor(int x, const Chunk &chunk,
+		const ChunkRenderDefinition &chunkRenderDef, const VoxelInt3 &voxel, const Camera &camera,
+		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
+		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
+		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
+		const FrameView &frame);
+	static void drawInitialVoxelAbove(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+		const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
 		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-	static void drawInitialVoxelAbove(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+	static void drawInitialVoxelBelow(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+		const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
 		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-	static void drawInitialVoxelBelow(int x, const Chunk &chunk, const VoxelInt3 &voxel,
-		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
-		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+
+	// Manages drawing voxels in the column that the player is in.
+	static void drawInitialVoxelColumn(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt2 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
+		const FrameView &frame);
+
+	// Helper functions for drawing a voxel column.
+	static void drawVoxelSameFloor(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+		const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
 		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-
-	// Manages drawing voxels in the column that the player is in.
-	static void drawInitialVoxelColumn(int x, const CoordInt2 &coord, const Camera &camera,
-		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-		double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+	static void drawVoxelAbove(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+		const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
+		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
+		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
+	static void drawVoxelBelow(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt3 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ, double wallU,
+		const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
 		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
 		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
-	// Helper functions for drawing a voxel column.
-	static void drawVoxelSameFloor(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-		const FrameView &frame);
-	static void drawVoxelAbove(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-		const FrameView &frame);
-	static void drawVoxelBelow(int x, const Chunk &chunk, const VoxelInt3 &voxel, const Camera &camera,
-		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+	// Manages drawing voxels in the column of the given XZ coordinate in the voxel grid.
+	static void drawVoxelColumn(int x, const Chunk &chunk, const ChunkRenderDefinition &chunkRenderDef,
+		const VoxelInt2 &voxel, const Camera &camera, const Ray &ray, VoxelFacing2D facing,
+		const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ, double farZ,
+		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
 		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
 		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
 		const FrameView &frame);
 
-	// Manages drawing voxels in the column of the given XZ coordinate in the voxel grid.
-	static void drawVoxelColumn(int x, const CoordInt2 &coord, const Camera &camera,
-		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
-		double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
-		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
-		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-
 	// Draws the portion of a flat contained within the given X range of the screen. The end
 	// X value is exclusive.
 	static void drawFlat(int startX, int endX, const VisibleFlat &flat, const Double3 &normal,
@@ -872,9 +1017,9 @@ private:
 
 	// Casts a 2D ray that steps through the current floor, rendering all voxels in the XZ column of each voxel.
 	template <bool NonNegativeDirX, bool NonNegativeDirZ>
-	static void rayCast2DInternal(int x, const Camera &camera, const Ray &ray,
-		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingScale,
-		const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
+	static void rayCast2DInternal(int x, const Camera &camera, const Ray &ray, const ShadingInfo &shadingInfo,
+		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
+		const RenderDefinitionGroup &renderDefGroup, const BufferView<const VisibleLight> &visLights,
 		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
@@ -882,28 +1027,32 @@ private:
 	// code generation.
 	static void rayCast2D(int x, const Camera &camera, const Ray &ray, const ShadingInfo &shadingInfo,
 		int chunkDistance, double ceilingScale, const ChunkManager &chunkManager,
-		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
-		const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
-		const FrameView &frame);
+		const RenderDefinitionGroup &renderDefGroup, const BufferView<const VisibleLight> &visLights,
+		const VisibleLightLists &visLightLists, const VoxelTextures &textures,
+		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
 	// Draws a portion of the sky gradient. The start and end Y are determined from current
 	// threading settings.
 	static void drawSkyGradient(int startY, int endY, double gradientProjYTop, double gradientProjYBottom,
-		Buffer<Double3> &skyGradientRowCache, std::atomic<bool> &shouldDrawStars,
+		Buffer<SkyGradientRow> &skyGradientRowCache, std::atomic<bool> &shouldDrawStars,
 		const ShadingInfo &shadingInfo, const FrameView &frame);
 
 	// Draws some columns of distant sky objects (mountains, clouds, etc.). The start and end X
 	// are determined from current threading settings.
 	static void drawDistantSky(int startX, int endX, const VisDistantObjects &visDistantObjs,
-		const std::vector<SkyTexture> &skyTextures, const Buffer<Double3> &skyGradientRowCache,
+		const std::vector<SkyTexture> &skyTextures, const SkyPanorama &skyPanorama,
+		const std::vector<VisibleStar> &visibleStars, const Buffer<SkyGradientRow> &skyGradientRowCache,
 		bool shouldDrawStars, const ShadingInfo &shadingInfo, const FrameView &frame);
 
+	// Draws some columns of the sky panorama, resampled with the current frame's row and column mappings.
+	static void drawSkyPanorama(int startX, int endX, const SkyPanorama &skyPanorama, const FrameView &frame);
+
 	// Handles drawing all voxels for the current frame.
-	static void drawVoxels(int startX, int stride, const Camera &camera, int chunkDistance,
-		double ceilingScale, const ChunkManager &chunkManager, const BufferView<const VisibleLight> &visLights,
-		const VisibleLightLists &visLightLists, const VoxelTextures &voxelTextures,
-		const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion,
-		const ShadingInfo &shadingInfo, const FrameView &frame);
+	static void drawVoxels(int startX, int stride, const Camera &camera, int chunkDistance, double ceilingScale,
+		const ChunkManager &chunkManager, const RenderDefinitionGroup &renderDefGroup,
+		const BufferView<const VisibleLight> &visLights, const VisibleLightLists &visLightLists,
+		const VoxelTextures &voxelTextures, const ChasmTextureGroups &chasmTextureGroups,
+		Buffer<OcclusionData> &occlusion, const ShadingInfo &shadingInfo, const FrameView &frame);
 
 	// Handles drawing all flats for the current frame.
 	static void drawFlats(int startX, int endX, const Camera &camera, const Double3 &flatNormal,
@@ -913,7 +1062,7 @@ private:
 
 	// Handles drawing the current weather (if any).
 	static void drawWeather(int threadStartX, int threadEndX, const WeatherInstance &weatherInst, const Camera &camera,
-		const ShadingInfo &shadingInfo, Random &random, const FrameView &frame);
+		const ShadingInfo &shadingInfo, uint64_t randomSeed, const FrameView &frame);
 
 	// Thread loop for each render thread. All threads are initialized in the constructor and
 	// wait for a go signal at the beginning of each render(). If the renderer is destructing,
@@ -942,6 +1091,9 @@ public:
 	// Sets the render threads mode to use (low, medium, high, etc.).
 	void setRenderThreadsMode(int mode) override;
 
+	// Sets whether voxels and flats are shaded with per-frame light tables instead of per-pixel math.
+	void setLightTableShading(bool enabled) override;
+
 	// Sets the distance at which the fog is maximum.
 	void setFogDistance(double fogDistance) override;
 
@@ -1 +1,70 @@
-#include "VoxelRenderDefinition.h"
\ No newline at end of file
+#include "VoxelRenderDefinition.h"
+
+#include "components/debug/Debug.h"
+
+VoxelRenderDefinition::VoxelRenderDefinition()
+{
+	for (FaceIndicesDef &faceIndicesDef : this->faceIndices)
+	{
+		faceIndicesDef.indices.fill(-1);
+		faceIndicesDef.count = 0;
+	}
+
+	this->rectCount = 0;
+	this->voxelDef = nullptr;
+}
+
+void VoxelRenderDefinition::init(const VoxelDefinition &voxelDef)
+{
+	this->voxelDef = &voxelDef;
+}
+
+int VoxelRenderDefinition::getFaceIndex(int axis, bool positive)
+{
+	DebugAssert((axis >= 0) && (axis < 3));
+	return (axis * 2) + (positive ? 0 : 1);
+}
+
+const VoxelDefinition &VoxelRenderDefinition::getVoxelDef() const
+{
+	DebugAssert(this->voxelDef != nullptr);
+	return *this->voxelDef;
+}
+
+int VoxelRenderDefinition::getRectCount() const
+{
+	return this->rectCount;
+}
+
+const VoxelRectangleRenderDefinition &VoxelRenderDefinition::getRect(int index) const
+{
+	DebugAssert(index >= 0);
+	DebugAssert(index < this->rectCount);
+	return this->rects[index];
+}
+
+const VoxelRenderDefinition::FaceIndicesDef &VoxelRenderDefinition::getFaceIndices(int faceIndex) const
+{
+	DebugAssertIndex(this->faceIndices, faceIndex);
+	return this->faceIndices[faceIndex];
+}
+
+int VoxelRenderDefinition::addRect(const VoxelRectangleRenderDefinition &rect)
+{
+	DebugAssert(this->rectCount < VoxelRenderDefinition::MAX_RECTS);
+	const int index = this->rectCount;
+	this->rects[index] = rect;
+	this->rectCount++;
+	return index;
+}
+
+void VoxelRenderDefinition::addFaceIndex(int faceIndex, int rectIndex)
+{
+	DebugAssertIndex(this->faceIndices, faceIndex);
+	DebugAssert((rectIndex >= 0) && (rectIndex < this->rectCount));
+
+	FaceIndicesDef &faceIndicesDef = this->faceIndices[faceIndex];
+	DebugAssert(faceIndicesDef.count < VoxelRenderDefinition::MAX_RECTS);
+	faceIndicesDef.indices[faceIndicesDef.count] = rectIndex;
+	faceIndicesDef.count++;
+}
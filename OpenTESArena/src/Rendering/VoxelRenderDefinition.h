@@ -5,6 +5,8 @@
 
 #include "RectangleRenderDefinition.h"
 
+class VoxelDefinition;
+
 // Common voxel render data usable by all renderers. Can be pointed to by multiple voxel
 // render instances. Each voxel render definition's coordinate is implicitly defined by its
 // XYZ grid position in a chunk.
@@ -15,6 +17,13 @@ public:
 	static constexpr int MAX_RECTS = 8; // Max number of rectangles in the voxel.
 	static constexpr int FACES = 6; // Number of faces on the voxel.
 
+	// Rectangle indices for each texture of a voxel, in the same order as the voxel definition's
+	// texture asset references. Voxels with one texture only have the default rectangle.
+	static constexpr int DEFAULT_RECT_INDEX = 0;
+	static constexpr int SIDE_RECT_INDEX = 0;
+	static constexpr int FLOOR_RECT_INDEX = 1;
+	static constexpr int CEILING_RECT_INDEX = 2;
+
 	// Indices to front-facing rectangles relative to this face of the voxel.
 	struct FaceIndicesDef
 	{
@@ -23,11 +32,30 @@ public:
 	};
 private:
 	// @todo: shared voxel render data a renderer would care about
-	// - Make a render utils function for converting +/- {x,y,z} face/enum to index (like sky octants).
 	std::array<VoxelRectangleRenderDefinition, MAX_RECTS> rects;
 	std::array<FaceIndicesDef, FACES> faceIndices; // X: 0, 1; Y: 2, 3; Z: 4, 5.
+	int rectCount;
+	const VoxelDefinition *voxelDef; // Owned by the chunk, which keeps it at the same address.
 public:
+	VoxelRenderDefinition();
+
+	void init(const VoxelDefinition &voxelDef);
+
+	// Gets the face index for a positive or negative axis direction.
+	static int getFaceIndex(int axis, bool positive);
+
+	// Gets the voxel definition this was made from, for renderers that still need its type data.
+	const VoxelDefinition &getVoxelDef() const;
+
+	int getRectCount() const;
+	const VoxelRectangleRenderDefinition &getRect(int index) const;
+	const FaceIndicesDef &getFaceIndices(int faceIndex) const;
+
+	// Returns the index of the new rectangle.
+	int addRect(const VoxelRectangleRenderDefinition &rect);
 
+	// Marks a rectangle as front-facing relative to the given face.
+	void addFaceIndex(int faceIndex, int rectIndex);
 };
 
 #endif
@@ -9,6 +9,7 @@
 
 FontDefinition::FontDefinition()
 {
+	this->asciiCharIDs.fill(-1);
 	this->characterHeight = -1;
 }
 
@@ -22,6 +23,7 @@ bool FontDefinition::init(const char *filename)
 	}
 
 	this->characters.init(fontFile.getCharacterCount());
+	this->asciiCharIDs.fill(-1);
 	this->characterHeight = fontFile.getHeight();
 	this->name = std::string(filename);
 
@@ -53,11 +55,63 @@ bool FontDefinition::init(const char *filename)
 
 		const CharID charID = static_cast<CharID>(i);
 		this->charIDs.emplace(std::make_pair(std::move(lookupStr), charID));
+		this->asciiCharIDs[static_cast<unsigned char>(c)] = charID;
 	}
 
+	this->initSpans();
 	return true;
 }
 
+void FontDefinition::initSpans()
+{
+	auto forEachSpan = [](const Character &character, const auto &func)
+	{
+		for (int y = 0; y < character.getHeight(); y++)
+		{
+			int x = 0;
+			while (x < character.getWidth())
+			{
+				if (!character.get(x, y))
+				{
+					x++;
+					continue;
+				}
+
+				const int spanStartX = x;
+				while ((x < character.getWidth()) && character.get(x, y))
+				{
+					x++;
+				}
+
+				func(PixelSpan { spanStartX, y, x - spanStartX });
+			}
+		}
+	};
+
+	const int characterCount = this->characters.getCount();
+	this->spanOffsets.init(characterCount + 1);
+
+	int spanCount = 0;
+	for (int i = 0; i < characterCount; i++)
+	{
+		this->spanOffsets.set(i, spanCount);
+		forEachSpan(this->characters.get(i), [&spanCount](const PixelSpan&) { spanCount++; });
+	}
+
+	this->spanOffsets.set(characterCount, spanCount);
+	this->spans.init(spanCount);
+
+	int spanIndex = 0;
+	for (int i = 0; i < characterCount; i++)
+	{
+		forEachSpan(this->characters.get(i), [this, &spanIndex](const PixelSpan &span)
+		{
+			this->spans.set(spanIndex, span);
+			spanIndex++;
+		});
+	}
+}
+
 const std::string &FontDefinition::getName() const
 {
 	return this->name;
@@ -108,9 +162,30 @@ bool FontDefinition::tryGetCharacterID(const char *c, CharID *outID) const
 	}
 }
 
+bool FontDefinition::tryGetCharacterID(char c, CharID *outID) const
+{
+	const CharID charID = this->asciiCharIDs[static_cast<unsigned char>(c)];
+	if (charID < 0)
+	{
+		return false;
+	}
+
+	*outID = charID;
+	return true;
+}
+
 const FontDefinition::Character &FontDefinition::getCharacter(CharID id) const
 {
 	DebugAssert(id >= 0);
 	DebugAssert(id < this->characters.getCount());
 	return this->characters.get(id);
 }
+
+BufferView<const FontDefinition::PixelSpan> FontDefinition::getCharacterSpans(CharID id) const
+{
+	DebugAssert(id >= 0);
+	DebugAssert(id < this->characters.getCount());
+	const int spanOffset = this->spanOffsets.get(id);
+	const int spanCount = this->spanOffsets.get(id + 1) - spanOffset;
+	return BufferView<const PixelSpan>(this->spans.get() + spanOffset, spanCount);
+}
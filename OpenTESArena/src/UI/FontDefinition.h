@@ -1,11 +1,13 @@
 #ifndef FONT_DEFINITION_H
 #define FONT_DEFINITION_H
 
+#include <array>
 #include <string>
 #include <unordered_map>
 
 #include "components/utilities/Buffer.h"
 #include "components/utilities/Buffer2D.h"
+#include "components/utilities/BufferView.h"
 
 class FontDefinition
 {
@@ -17,12 +19,28 @@ public:
 	// @todo: if alpha-blending is desired then change bool to float.
 	using Pixel = bool;
 	using Character = Buffer2D<Pixel>;
+
+	// Horizontal run of set pixels in a character. Drawing a character is a fill per span instead of a
+	// test per pixel.
+	struct PixelSpan
+	{
+		int x, y, width;
+	};
 private:
 	Buffer<Character> characters;
 	std::unordered_map<std::string, CharID> charIDs;
+	std::array<CharID, 256> asciiCharIDs; // Direct look-up for single-byte characters, -1 if none.
+
+	// Glyph atlas of every character's pixel spans, in character order. Character i's spans start at
+	// spanOffsets[i] and end at spanOffsets[i + 1].
+	Buffer<PixelSpan> spans;
+	Buffer<int> spanOffsets;
+
 	std::string name;
 	int characterHeight;
 
+	void initSpans();
+
 	static bool tryMakeCharLookupString(const char *c, std::string *outString);
 public:
 	FontDefinition();
@@ -38,8 +56,10 @@ public:
 
 	// Attempts to get the character ID associated with the given UTF-8 character.
 	bool tryGetCharacterID(const char *c, CharID *outID) const;
+	bool tryGetCharacterID(char c, CharID *outID) const;
 
 	const Character &getCharacter(CharID id) const;
+	BufferView<const PixelSpan> getCharacterSpans(CharID id) const;
 };
 
 #endif
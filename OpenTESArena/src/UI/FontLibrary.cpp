@@ -54,3 +54,8 @@ const FontDefinition &FontLibrary::getDefinition(int index) const
 	DebugAssertIndex(this->defs, index);
 	return this->defs[index];
 }
+
+TextLineCache &FontLibrary::getLineCache() const
+{
+	return this->lineCache;
+}
@@ -5,17 +5,24 @@
 #include <vector>
 
 #include "FontDefinition.h"
+#include "TextLineCache.h"
 
 class FontLibrary
 {
 private:
 	std::vector<FontDefinition> defs;
+
+	// Mutable since text is drawn with a const library. Caching lines doesn't change any font data.
+	mutable TextLineCache lineCache;
 public:
 	bool init();
 
 	int getDefinitionCount() const;
 	bool tryGetDefinitionIndex(const char *name, int *outIndex) const; // @todo: change to std::optional
 	const FontDefinition &getDefinition(int index) const;
+
+	// Gets the cache of recently drawn text lines shared by all fonts.
+	TextLineCache &getLineCache() const;
 };
 
 #endif
@@ -152,6 +152,12 @@ UiTextureID TextBox::getTextureID()
 
 void TextBox::setText(const std::string_view &text)
 {
+	// Text boxes are often given the same text every frame.
+	if (text == this->text)
+	{
+		return;
+	}
+
 	this->text = std::string(text);
 	this->dirty = true;
 }
@@ -205,7 +211,7 @@ void TextBox::updateTexture()
 			this->properties.shadowInfo.has_value() ? &(*this->properties.shadowInfo) : nullptr;
 		TextRenderUtils::drawTextLines(BufferView<const std::string_view>(textLines.data(), static_cast<int>(textLines.size())),
 			fontDef, 0, 0, this->properties.defaultColor, this->properties.alignment, this->properties.lineSpacing,
-			colorOverrideInfoPtr, shadowInfoPtr, textureView);
+			colorOverrideInfoPtr, shadowInfoPtr, &fontLibrary->getLineCache(), textureView);
 	}
 
 	this->textureRef.unlockTexels();
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "TextLineCache.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	template <typename T>
+	void appendKeyValue(std::string &key, const T &value)
+	{
+		char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		key.append(bytes, sizeof(T));
+	}
+}
+
+TextLineCache::TextLineCache()
+{
+	this->nextUseIndex = 0;
+	this->texelCount = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
+
+void TextLineCache::evict()
+{
+	while ((this->entries.size() > MAX_ENTRIES) || (this->texelCount > MAX_TEXELS))
+	{
+		if (this->entries.size() <= 1)
+		{
+			break;
+		}
+
+		// Never evicts the most recently used entry since it has the highest use index.
+		auto oldestIter = this->entries.begin();
+		for (auto iter = this->entries.begin(); iter != this->entries.end(); ++iter)
+		{
+			if (iter->second.lastUsedIndex < oldestIter->second.lastUsedIndex)
+			{
+				oldestIter = iter;
+			}
+		}
+
+		const Buffer2D<uint32_t> &texels = oldestIter->second.texels;
+		this->texelCount -= texels.getWidth() * texels.getHeight();
+		this->entries.erase(oldestIter);
+	}
+}
+
+const Buffer2D<uint32_t> &TextLineCache::getLine(const std::string_view &line, const FontDefinition &fontDef,
+	const Color &textColor, const TextRenderUtils::TextShadowInfo *shadow)
+{
+	std::string &key = this->keyBuffer;
+	key.clear();
+	key.append(fontDef.getName());
+	key.push_back('\0');
+	appendKeyValue(key, textColor.toARGB());
+	if (shadow != nullptr)
+	{
+		key.push_back(1);
+		appendKeyValue(key, shadow->offsetX);
+		appendKeyValue(key, shadow->offsetY);
+		appendKeyValue(key, shadow->color.toARGB());
+	}
+	else
+	{
+		key.push_back(0);
+	}
+
+	key.append(line);
+
+	const uint64_t useIndex = this->nextUseIndex;
+	this->nextUseIndex++;
+
+	auto iter = this->entries.find(key);
+	if (iter != this->entries.end())
+	{
+		this->hitCount++;
+		iter->second.lastUsedIndex = useIndex;
+		return iter->second.texels;
+	}
+
+	this->missCount++;
+
+	const std::vector<FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(line, fontDef);
+	std::optional<TextRenderUtils::TextShadowInfo> shadowInfo;
+	if (shadow != nullptr)
+	{
+		shadowInfo = *shadow;
+	}
+
+	const int width = TextRenderUtils::getLinePixelWidth(charIDs, fontDef, shadowInfo);
+	const int height = fontDef.getCharacterHeight() + ((shadow != nullptr) ? std::abs(shadow->offsetY) : 0);
+
+	Entry entry;
+	entry.texels.init(width, height);
+	entry.texels.fill(0);
+	entry.lastUsedIndex = useIndex;
+
+	BufferView2D<uint32_t> texelsView(entry.texels.get(), width, height);
+	const BufferView<const FontDefinition::CharID> charIdsView(charIDs.data(), static_cast<int>(charIDs.size()));
+	TextRenderUtils::drawTextLine(charIdsView, fontDef, 0, 0, textColor, nullptr, shadow, texelsView);
+
+	this->texelCount += width * height;
+	iter = this->entries.emplace(key, std::move(entry)).first;
+	const Buffer2D<uint32_t> *texels = &iter->second.texels;
+
+	this->evict();
+	return *texels;
+}
+
+int TextLineCache::getEntryCount() const
+{
+	return static_cast<int>(this->entries.size());
+}
+
+int TextLineCache::getHitCount() const
+{
+	return this->hitCount;
+}
+
+int TextLineCache::getMissCount() const
+{
+	return this->missCount;
+}
+
+void TextLineCache::clear()
+{
+	this->entries.clear();
+	this->texelCount = 0;
+}
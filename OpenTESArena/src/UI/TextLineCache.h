@@ -0,0 +1,55 @@
+#ifndef TEXT_LINE_CACHE_H
+#define TEXT_LINE_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "FontDefinition.h"
+#include "TextRenderUtils.h"
+#include "../Media/Color.h"
+
+#include "components/utilities/Buffer2D.h"
+
+// Cache of rasterized text lines keyed by font, text, color, and shadow. Text is redrawn whenever it
+// changes, but most lines are usually the same as last time (or the same as in some other text box),
+// so those are copied instead of drawn again. The least recently used lines are evicted.
+
+class TextLineCache
+{
+private:
+	struct Entry
+	{
+		Buffer2D<uint32_t> texels; // Line pixels, zero where nothing was drawn.
+		uint64_t lastUsedIndex;
+	};
+
+	std::unordered_map<std::string, Entry> entries;
+	std::string keyBuffer; // Reused for look-ups so cache hits don't allocate.
+	uint64_t nextUseIndex;
+	int texelCount; // Total texels of all entries.
+	int hitCount, missCount;
+
+	// Removes least recently used entries until the cache is within its limits.
+	void evict();
+public:
+	// Limits before evicting.
+	static constexpr int MAX_ENTRIES = 256;
+	static constexpr int MAX_TEXELS = 1 << 20;
+
+	TextLineCache();
+
+	// Gets the pixels for a line of text, drawing it first if it's not cached. The reference is valid
+	// until the next call.
+	const Buffer2D<uint32_t> &getLine(const std::string_view &line, const FontDefinition &fontDef,
+		const Color &textColor, const TextRenderUtils::TextShadowInfo *shadow);
+
+	int getEntryCount() const;
+	int getHitCount() const;
+	int getMissCount() const;
+
+	void clear();
+};
+
+#endif
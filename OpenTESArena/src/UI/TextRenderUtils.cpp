@@ -2,6 +2,7 @@
 #include <cmath>
 
 #include "TextAlignment.h"
+#include "TextLineCache.h"
 #include "TextRenderUtils.h"
 
 #include "components/debug/Debug.h"
@@ -121,20 +122,20 @@ std::vector<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const st
 	const FontDefinition &fontDef)
 {
 	FontDefinition::CharID fallbackCharID;
-	if (!fontDef.tryGetCharacterID("?", &fallbackCharID))
+	if (!fontDef.tryGetCharacterID('?', &fallbackCharID))
 	{
 		DebugCrash("Couldn't get fallback font character ID from font \"" + fontDef.getName() + "\".");
 	}
 
 	// @todo: support more than ASCII
 	std::vector<FontDefinition::CharID> charIDs;
+	charIDs.reserve(line.size());
 	for (const char c : line)
 	{
-		const std::string charUtf8(1, c);
 		FontDefinition::CharID charID;
-		if (!fontDef.tryGetCharacterID(charUtf8.c_str(), &charID))
+		if (!fontDef.tryGetCharacterID(c, &charID))
 		{
-			DebugLogWarning("Couldn't get font character ID for \"" + charUtf8 + "\".");
+			DebugLogWarning("Couldn't get font character ID for \"" + std::string(1, c) + "\".");
 			charID = fallbackCharID;
 		}
 
@@ -323,6 +324,28 @@ void TextRenderUtils::drawChar(const FontDefinition::Character &fontChar, int ds
 	}
 }
 
+void TextRenderUtils::drawChar(const BufferView<const FontDefinition::PixelSpan> &spans, int dstX, int dstY,
+	const Color &textColor, BufferView2D<uint32_t> &outBuffer)
+{
+	const uint32_t dstPixel = textColor.toARGB();
+	for (int i = 0; i < spans.getCount(); i++)
+	{
+		const FontDefinition::PixelSpan &span = spans.get(i);
+		const int y = dstY + span.y;
+		if ((y < 0) || (y >= outBuffer.getHeight()))
+		{
+			continue;
+		}
+
+		const int startX = std::max(dstX + span.x, 0);
+		const int endX = std::min(dstX + span.x + span.width, outBuffer.getWidth());
+		for (int x = startX; x < endX; x++)
+		{
+			outBuffer.set(x, y, dstPixel);
+		}
+	}
+}
+
 void TextRenderUtils::drawTextLine(const BufferView<const FontDefinition::CharID> &charIDs, const FontDefinition &fontDef,
 	int dstX, int dstY, const Color &textColor, const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow,
 	BufferView2D<uint32_t> &outBuffer)
@@ -349,7 +372,8 @@ void TextRenderUtils::drawTextLine(const BufferView<const FontDefinition::CharID
 				return color;
 			}();
 
-			TextRenderUtils::drawChar(fontChar, x + currentX, y, charColor, outBuffer);
+			const BufferView<const FontDefinition::PixelSpan> charSpans = fontDef.getCharacterSpans(charID);
+			TextRenderUtils::drawChar(charSpans, x + currentX, y, charColor, outBuffer);
 			currentX += fontChar.getWidth();
 		}
 	};
@@ -380,9 +404,30 @@ void TextRenderUtils::drawTextLine(const std::string_view &line, const FontDefin
 	TextRenderUtils::drawTextLine(charIdsView, fontDef, dstX, dstY, textColor, colorOverrideInfo, shadow, outBuffer);
 }
 
+void TextRenderUtils::drawCachedTextLine(const Buffer2D<uint32_t> &lineTexels, int dstX, int dstY,
+	BufferView2D<uint32_t> &outBuffer)
+{
+	const int startX = std::max(dstX, 0);
+	const int startY = std::max(dstY, 0);
+	const int endX = std::min(dstX + lineTexels.getWidth(), outBuffer.getWidth());
+	const int endY = std::min(dstY + lineTexels.getHeight(), outBuffer.getHeight());
+	for (int y = startY; y < endY; y++)
+	{
+		for (int x = startX; x < endX; x++)
+		{
+			const uint32_t srcPixel = lineTexels.get(x - dstX, y - dstY);
+			if (srcPixel != 0)
+			{
+				outBuffer.set(x, y, srcPixel);
+			}
+		}
+	}
+}
+
 void TextRenderUtils::drawTextLines(const BufferView<const std::string_view> &textLines, const FontDefinition &fontDef,
 	int dstX, int dstY, const Color &textColor, TextAlignment alignment, int lineSpacing,
-	const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow, BufferView2D<uint32_t> &outBuffer)
+	const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow, TextLineCache *lineCache,
+	BufferView2D<uint32_t> &outBuffer)
 {
 	// @todo: should pass std::optional parameter instead
 	std::optional<TextRenderUtils::TextShadowInfo> shadowInfo;
@@ -403,7 +448,19 @@ void TextRenderUtils::drawTextLines(const BufferView<const std::string_view> &te
 	{
 		const std::string_view &textLine = textLines.get(i);
 		const Int2 &offset = offsets[i];
-		TextRenderUtils::drawTextLine(textLine, fontDef, dstX + offset.x, dstY + offset.y, textColor,
-			colorOverrideInfo, shadow, outBuffer);
+
+		// Transparent text can't be told apart from undrawn pixels in a cached line.
+		const bool canUseLineCache = (lineCache != nullptr) && (colorOverrideInfo == nullptr) &&
+			(textColor.toARGB() != 0);
+		if (canUseLineCache)
+		{
+			const Buffer2D<uint32_t> &lineTexels = lineCache->getLine(textLine, fontDef, textColor, shadow);
+			TextRenderUtils::drawCachedTextLine(lineTexels, dstX + offset.x, dstY + offset.y, outBuffer);
+		}
+		else
+		{
+			TextRenderUtils::drawTextLine(textLine, fontDef, dstX + offset.x, dstY + offset.y, textColor,
+				colorOverrideInfo, shadow, outBuffer);
+		}
 	}
 }
@@ -15,6 +15,8 @@
 #include "components/utilities/BufferView.h"
 #include "components/utilities/BufferView2D.h"
 
+class TextLineCache;
+
 enum class TextAlignment;
 
 namespace TextRenderUtils
@@ -109,15 +111,22 @@ namespace TextRenderUtils
 	// - render
 	void drawChar(const FontDefinition::Character &fontChar, int dstX, int dstY, const Color &textColor,
 		BufferView2D<uint32_t> &outBuffer);
+	void drawChar(const BufferView<const FontDefinition::PixelSpan> &spans, int dstX, int dstY, const Color &textColor,
+		BufferView2D<uint32_t> &outBuffer);
 	void drawTextLine(const BufferView<const FontDefinition::CharID> &charIDs, const FontDefinition &fontDef,
 		int dstX, int dstY, const Color &textColor, const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow,
 		BufferView2D<uint32_t> &outBuffer);
 	void drawTextLine(const std::string_view &line, const FontDefinition &fontDef, int dstX, int dstY,
 		const Color &textColor, const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow,
 		BufferView2D<uint32_t> &outBuffer);
+
+	// Copies a line drawn ahead of time into the output texture, skipping pixels that weren't drawn.
+	void drawCachedTextLine(const Buffer2D<uint32_t> &lineTexels, int dstX, int dstY, BufferView2D<uint32_t> &outBuffer);
+
+	// Draws lines through the line cache when given one. Lines with color overrides are always drawn directly.
 	void drawTextLines(const BufferView<const std::string_view> &textLines, const FontDefinition &fontDef, int dstX, int dstY,
 		const Color &textColor, TextAlignment alignment, int lineSpacing, const ColorOverrideInfo *colorOverrideInfo,
-		const TextShadowInfo *shadow, BufferView2D<uint32_t> &outBuffer);
+		const TextShadowInfo *shadow, TextLineCache *lineCache, BufferView2D<uint32_t> &outBuffer);
 }
 
 #endif
@@ -23,6 +23,7 @@ namespace Platform
 	// subdirectory appended (i.e., "./local/share").
 	const std::string XDGDataHome = "XDG_DATA_HOME";
 	const std::string XDGConfigHome = "XDG_CONFIG_HOME";
+	const std::string XDGCacheHome = "XDG_CACHE_HOME";
 
 	// Gets the user's home environment variable ($HOME). Does not have a trailing slash.
 	std::string getHomeEnv()
@@ -50,6 +51,15 @@ namespace Platform
 		return (xdgEnv != nullptr) ? std::string(xdgEnv) :
 			(Platform::getHomeEnv() + "/.config");
 	}
+
+	// Gets the cache home directory from $XDG_CACHE_HOME (or $HOME/.cache as a fallback).
+	// Does not have a trailing slash.
+	std::string getXDGCacheHomeEnv()
+	{
+		const char *xdgEnv = SDL_getenv(Platform::XDGCacheHome.c_str());
+		return (xdgEnv != nullptr) ? std::string(xdgEnv) :
+			(Platform::getHomeEnv() + "/.cache");
+	}
 }
 
 std::string Platform::getPlatform()
@@ -165,6 +175,41 @@ std::string Platform::getLogPath()
 	}
 }
 
+std::string Platform::getCachePath()
+{
+	const std::string platform = Platform::getPlatform();
+
+	if (platform == "Windows")
+	{
+		char *cachePathPtr = SDL_GetPrefPath("OpenTESArena", "cache");
+
+		if (cachePathPtr == nullptr)
+		{
+			DebugLogWarning("SDL_GetPrefPath() not available on this platform.");
+			cachePathPtr = SDL_strdup("cache/");
+		}
+
+		const std::string cachePathString(cachePathPtr);
+		SDL_free(cachePathPtr);
+
+		// Convert Windows backslashes to forward slashes.
+		return String::replace(cachePathString, '\\', '/');
+	}
+	else if (platform == "Linux")
+	{
+		return Platform::getXDGCacheHomeEnv() + "/OpenTESArena/";
+	}
+	else if (platform == "Mac OS X")
+	{
+		return Platform::getHomeEnv() + "/Library/Caches/OpenTESArena/";
+	}
+	else
+	{
+		DebugLogWarning("No default cache path on this platform.");
+		return "OpenTESArena/cache/";
+	}
+}
+
 double Platform::getDefaultDPI()
 {
 	const std::string platform = Platform::getPlatform();
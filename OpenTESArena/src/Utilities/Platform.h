@@ -22,6 +22,9 @@ namespace Platform
 	// Gets the log folder path for logging program messages.
 	std::string getLogPath();
 
+	// Gets the cache folder path for generated files that can be safely deleted.
+	std::string getCachePath();
+
 	// Gets the default pixels-per-inch value from the OS.
 	double getDefaultDPI();
 
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Platform.h"
+#include "ThreadUtils.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	// Worker threads started on first use and kept until the program exits, so parallel loops don't pay
+	// for starting and joining threads every call. Each job is run once by every worker and once by the
+	// calling thread.
+	class WorkerPool
+	{
+	private:
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable jobCondVar, doneCondVar;
+		const std::function<void()> *job; // Job being run, or null if idle.
+		uint64_t jobGeneration; // Incremented for each job so workers know when there's a new one.
+		int busyWorkerCount;
+		bool quit;
+
+		// Set while a job is running so a nested or concurrent call doesn't wait on itself.
+		std::atomic<bool> running;
+
+		void workerProc()
+		{
+			uint64_t prevJobGeneration = 0;
+			while (true)
+			{
+				const std::function<void()> *currentJob;
+
+				{
+					std::unique_lock<std::mutex> lock(this->mutex);
+					this->jobCondVar.wait(lock, [this, prevJobGeneration]()
+					{
+						return this->quit || (this->jobGeneration != prevJobGeneration);
+					});
+
+					if (this->quit)
+					{
+						return;
+					}
+
+					prevJobGeneration = this->jobGeneration;
+					currentJob = this->job;
+				}
+
+				(*currentJob)();
+
+				{
+					std::lock_guard<std::mutex> lock(this->mutex);
+					this->busyWorkerCount--;
+				}
+
+				this->doneCondVar.notify_one();
+			}
+		}
+	public:
+		WorkerPool(int threadCount)
+		{
+			DebugAssert(threadCount >= 0);
+			this->job = nullptr;
+			this->jobGeneration = 0;
+			this->busyWorkerCount = 0;
+			this->quit = false;
+			this->running = false;
+
+			this->threads.reserve(threadCount);
+			for (int i = 0; i < threadCount; i++)
+			{
+				this->threads.emplace_back(&WorkerPool::workerProc, this);
+			}
+		}
+
+		WorkerPool(const WorkerPool&) = delete;
+
+		~WorkerPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->quit = true;
+			}
+
+			this->jobCondVar.notify_all();
+
+			for (std::thread &thread : this->threads)
+			{
+				thread.join();
+			}
+		}
+
+		WorkerPool &operator=(const WorkerPool&) = delete;
+
+		// Runs the job on every worker and the calling thread, and waits for all of them to finish.
+		// Returns false without running it if the pool is already busy (i.e., called from inside a job).
+		bool tryRun(const std::function<void()> &func)
+		{
+			bool wasRunning = false;
+			if (!this->running.compare_exchange_strong(wasRunning, true, std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->job = &func;
+				this->jobGeneration++;
+				this->busyWorkerCount = static_cast<int>(this->threads.size());
+			}
+
+			this->jobCondVar.notify_all();
+			func();
+
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+				this->doneCondVar.wait(lock, [this]()
+				{
+					return this->busyWorkerCount == 0;
+				});
+
+				this->job = nullptr;
+			}
+
+			this->running.store(false, std::memory_order_release);
+			return true;
+		}
+	};
+
+	WorkerPool &getWorkerPool()
+	{
+		static WorkerPool pool(std::max(Platform::getThreadCount() - 1, 0));
+		return pool;
+	}
+
+	std::atomic<bool> ParallelEnabled(true);
+}
+
+void ThreadUtils::parallelFor(int count, const std::function<void(int)> &func)
+{
+	DebugAssert(count >= 0);
+
+	auto runSerial = [count, &func]()
+	{
+		for (int i = 0; i < count; i++)
+		{
+			func(i);
+		}
+	};
+
+	if ((count <= 1) || !ThreadUtils::isParallelEnabled() || (Platform::getThreadCount() <= 1))
+	{
+		runSerial();
+		return;
+	}
+
+	// Threads take the next unclaimed index until none are left, so uneven amounts of work per index
+	// are balanced out. Workers beyond the index count find nothing left and return right away.
+	std::atomic<int> nextIndex(0);
+	const std::function<void()> workerFunc = [count, &func, &nextIndex]()
+	{
+		while (true)
+		{
+			const int index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+			if (index >= count)
+			{
+				break;
+			}
+
+			func(index);
+		}
+	};
+
+	if (!getWorkerPool().tryRun(workerFunc))
+	{
+		runSerial();
+	}
+}
+
+void ThreadUtils::setParallelEnabled(bool enabled)
+{
+	ParallelEnabled.store(enabled);
+}
+
+bool ThreadUtils::isParallelEnabled()
+{
+	return ParallelEnabled.load();
+}
@@ -0,0 +1,23 @@
+#ifndef THREAD_UTILS_H
+#define THREAD_UTILS_H
+
+#include <functional>
+
+// Helpers for spreading independent work across the CPU's threads.
+
+namespace ThreadUtils
+{
+	// Calls the given function once for every index in [0, count) using up to one thread per CPU
+	// thread, including the calling thread. Blocks until every index is done. The order that indices
+	// are visited in is not defined, so the function must not depend on other indices' results.
+	// The worker threads are reused between calls. A call made while another is running (i.e., from
+	// inside the function) runs on the calling thread only.
+	void parallelFor(int count, const std::function<void(int)> &func);
+
+	// Lets parallelFor() use worker threads (the default). When disabled, every call runs on the
+	// calling thread, for comparing threaded results against serial ones.
+	void setParallelEnabled(bool enabled);
+	bool isParallelEnabled();
+}
+
+#endif
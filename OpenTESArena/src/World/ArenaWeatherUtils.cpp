@@ -59,7 +59,7 @@ bool ArenaWeatherUtils::rainIsThunderstorm(Random &random)
 	return random.next(0x10000) < 24000;
 }
 
-bool ArenaWeatherUtils::shouldSnowflakeChangeDirection(Random &random)
+bool ArenaWeatherUtils::shouldSnowflakeChangeDirection(CounterRandom &random)
 {
 	return random.next(0x10000) < 15000;
 }
@@ -7,6 +7,7 @@
 #include "components/utilities/Buffer.h"
 
 class Color;
+class CounterRandom;
 class ExeData;
 class Random;
 class TextureManager;
@@ -71,7 +72,7 @@ namespace ArenaWeatherUtils
 
 	// Whether an individual snowflake should randomly switch between left/right at this point in time
 	// (not sure how frequently this is checked).
-	bool shouldSnowflakeChangeDirection(Random &random);
+	bool shouldSnowflakeChangeDirection(CounterRandom &random);
 
 	// Returns a filtered version of the given weather so that, i.e., deserts can't have snow.
 	ArenaTypes::WeatherType getFilteredWeatherType(ArenaTypes::WeatherType weatherType,
@@ -5,6 +5,12 @@
 
 #include "components/debug/Debug.h"
 
+namespace
+{
+	// Incremented every time a chunk is initialized so revisions stay unique across recycled chunks.
+	uint32_t NextChunkInitID = 0;
+}
+
 void Chunk::init(const ChunkInt2 &coord, int height)
 {
 	// Set all voxels to air and unused.
@@ -18,7 +24,14 @@ void Chunk::init(const ChunkInt2 &coord, int height)
 	// point to it.
 	this->activeVoxelDefs.front() = true;
 
+	// No ground to spawn on while everything is air.
+	this->spawnVoxels.clear();
+	this->spawnVoxelIndices.init(Chunk::WIDTH, Chunk::DEPTH);
+	this->spawnVoxelIndices.fill(-1);
+
 	this->coord = coord;
+	this->revision = static_cast<uint64_t>(NextChunkInitID) << 32;
+	NextChunkInitID++;
 }
 
 const ChunkInt2 &Chunk::getCoord() const
@@ -26,6 +39,11 @@ const ChunkInt2 &Chunk::getCoord() const
 	return this->coord;
 }
 
+uint64_t Chunk::getRevision() const
+{
+	return this->revision;
+}
+
 bool Chunk::isValidVoxel(SNInt x, int y, WEInt z) const
 {
 	return (x >= 0) && (x < Chunk::WIDTH) && (y >= 0) && (y < this->getHeight()) && (z >= 0) && (z < Chunk::DEPTH);
@@ -54,6 +72,17 @@ const VoxelDefinition &Chunk::getVoxelDef(VoxelID id) const
 	return this->voxelDefs[id];
 }
 
+int Chunk::getSpawnVoxelCount() const
+{
+	return static_cast<int>(this->spawnVoxels.size());
+}
+
+const VoxelInt2 &Chunk::getSpawnVoxel(int index) const
+{
+	DebugAssertIndex(this->spawnVoxels, index);
+	return this->spawnVoxels[index];
+}
+
 int Chunk::getVoxelInstCount() const
 {
 	return static_cast<int>(this->voxelInsts.size());
@@ -208,9 +237,66 @@ void Chunk::getAdjacentVoxelDefs(const VoxelInt3 &voxel, const VoxelDefinition *
 	tryWriteVoxelDef(westVoxel, outWest);
 }
 
+bool Chunk::isSpawnVoxel(SNInt x, WEInt z) const
+{
+	if (this->getHeight() < 2)
+	{
+		return false;
+	}
+
+	const VoxelDefinition &voxelDef = this->getVoxelDef(this->getVoxel(x, 1, z));
+	const VoxelDefinition &groundVoxelDef = this->getVoxelDef(this->getVoxel(x, 0, z));
+	return (voxelDef.type == ArenaTypes::VoxelType::None) && (groundVoxelDef.type == ArenaTypes::VoxelType::Floor);
+}
+
+void Chunk::updateSpawnVoxel(SNInt x, WEInt z)
+{
+	const bool isSpawnVoxel = this->isSpawnVoxel(x, z);
+	const int spawnVoxelIndex = this->spawnVoxelIndices.get(x, z);
+	const bool wasSpawnVoxel = spawnVoxelIndex >= 0;
+	if (isSpawnVoxel == wasSpawnVoxel)
+	{
+		return;
+	}
+
+	if (isSpawnVoxel)
+	{
+		this->spawnVoxelIndices.set(x, z, static_cast<int>(this->spawnVoxels.size()));
+		this->spawnVoxels.emplace_back(x, z);
+	}
+	else
+	{
+		// Swap with the last spawn voxel so removal doesn't shift the list.
+		DebugAssertIndex(this->spawnVoxels, spawnVoxelIndex);
+		const VoxelInt2 lastSpawnVoxel = this->spawnVoxels.back();
+		this->spawnVoxels[spawnVoxelIndex] = lastSpawnVoxel;
+		this->spawnVoxelIndices.set(lastSpawnVoxel.x, lastSpawnVoxel.y, spawnVoxelIndex);
+		this->spawnVoxels.pop_back();
+		this->spawnVoxelIndices.set(x, z, -1);
+	}
+}
+
+void Chunk::updateSpawnVoxels()
+{
+	for (WEInt z = 0; z < Chunk::DEPTH; z++)
+	{
+		for (SNInt x = 0; x < Chunk::WIDTH; x++)
+		{
+			this->updateSpawnVoxel(x, z);
+		}
+	}
+}
+
 void Chunk::setVoxel(SNInt x, int y, WEInt z, VoxelID value)
 {
 	this->voxels.set(x, y, z, value);
+	this->revision++;
+
+	// Only the ground and the voxel above it affect spawning.
+	if (y <= 1)
+	{
+		this->updateSpawnVoxel(x, z);
+	}
 }
 
 bool Chunk::tryAddVoxelDef(VoxelDefinition &&voxelDef, Chunk::VoxelID *outID)
@@ -275,6 +361,7 @@ void Chunk::addTransitionPosition(Chunk::TransitionID id, const VoxelInt3 &voxel
 {
 	DebugAssert(this->transitionDefIndices.find(voxel) == this->transitionDefIndices.end());
 	this->transitionDefIndices.emplace(voxel, id);
+	this->revision++;
 }
 
 void Chunk::addTriggerPosition(Chunk::TriggerID id, const VoxelInt3 &voxel)
@@ -306,6 +393,10 @@ void Chunk::removeVoxelDef(VoxelID id)
 	DebugAssert(id < this->voxelDefs.size());
 	this->voxelDefs[id] = VoxelDefinition();
 	this->activeVoxelDefs[id] = false;
+	this->revision++;
+
+	// Any voxels still pointing at the definition are no longer the same type.
+	this->updateSpawnVoxels();
 }
 
 void Chunk::removeVoxelInst(const VoxelInt3 &voxel, VoxelInstance::Type type)
@@ -328,6 +419,8 @@ void Chunk::clear()
 	this->voxelDefs.fill(VoxelDefinition());
 	this->activeVoxelDefs.fill(false);
 	this->voxelInsts.clear();
+	this->spawnVoxels.clear();
+	this->spawnVoxelIndices.clear();
 	this->transitionDefs.clear();
 	this->triggerDefs.clear();
 	this->lockDefs.clear();
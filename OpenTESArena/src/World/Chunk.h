@@ -20,6 +20,7 @@
 #include "VoxelUtils.h"
 #include "../Math/MathUtils.h"
 
+#include "components/utilities/Buffer2D.h"
 #include "components/utilities/Buffer3D.h"
 
 // A 3D set of voxels for a portion of the game world.
@@ -69,15 +70,34 @@ private:
 	std::unordered_map<VoxelInt3, BuildingNameID> buildingNameIndices;
 	std::unordered_map<VoxelInt3, DoorID> doorDefIndices;
 
+	// Walkable ground voxels (a floor with air above it) that citizens can spawn on, kept up to date
+	// as voxels change so spawning doesn't have to search for one. The indices are into the spawn
+	// voxels list, or -1 if that column isn't spawnable.
+	std::vector<VoxelInt2> spawnVoxels;
+	Buffer2D<int> spawnVoxelIndices;
+
 	// Chunk coordinates in the world.
 	ChunkInt2 coord;
 
+	// Changes whenever the chunk's voxels or transitions change. The high 32 bits are unique per chunk
+	// initialization so a recycled chunk never repeats a revision of its previous contents.
+	uint64_t revision;
+
 	// Gets the voxel definitions adjacent to a voxel. Useful with context-sensitive voxels like chasms.
 	// This is slightly different than the chunk manager's version since it is chunk-independent (but as
 	// a result, voxels on a chunk edge must be updated by the chunk manager).
 	void getAdjacentVoxelDefs(const VoxelInt3 &voxel, const VoxelDefinition **outNorth,
 		const VoxelDefinition **outEast, const VoxelDefinition **outSouth, const VoxelDefinition **outWest);
 
+	// Returns whether citizens can spawn on the ground of the given column.
+	bool isSpawnVoxel(SNInt x, WEInt z) const;
+
+	// Adds or removes the given column from the spawn voxels depending on its current voxels.
+	void updateSpawnVoxel(SNInt x, WEInt z);
+
+	// Rebuilds all spawn voxels, i.e., when a voxel definition in use might have changed.
+	void updateSpawnVoxels();
+
 	// Runs any voxel instance behavior based on its current state that cannot be done by the voxel
 	// instance itself.
 	void handleVoxelInstState(VoxelInstance &voxelInst, const CoordDouble3 &playerCoord,
@@ -103,6 +123,9 @@ public:
 	// Gets the chunk's XY coordinate in the world.
 	const ChunkInt2 &getCoord() const; // @todo: rename to position or something; Coord has different meaning now.
 
+	// Gets the chunk's revision, for caches that derive data from voxels (i.e., the automap).
+	uint64_t getRevision() const;
+
 	// Returns whether the given voxel coordinate is in the chunk.
 	bool isValidVoxel(SNInt x, int y, WEInt z) const;
 
@@ -115,6 +138,12 @@ public:
 	// Gets the voxel definition associated with a voxel ID.
 	const VoxelDefinition &getVoxelDef(VoxelID id) const;
 
+	// Gets the number of walkable ground voxels that citizens can spawn on.
+	int getSpawnVoxelCount() const;
+
+	// Gets the spawn voxel at the given index. The order changes as voxels are set.
+	const VoxelInt2 &getSpawnVoxel(int index) const;
+
 	// Gets the number of voxel instances.
 	int getVoxelInstCount() const;
 
@@ -14,6 +14,7 @@
 
 #include "components/debug/Debug.h"
 #include "components/utilities/Buffer.h"
+#include "components/utilities/TraceProfiler.h"
 
 namespace
 {
@@ -488,7 +489,8 @@ void ChunkManager::populateChunkEntities(Chunk &chunk, const LevelDefinition &le
 		}
 	}
 
-	if (citizenGenInfo.has_value())
+	// Only spawn citizens in chunks with ground for them to walk on.
+	if (citizenGenInfo.has_value() && (chunk.getSpawnVoxelCount() > 0))
 	{
 		// Spawn citizens if the total active limit has not been reached.
 		const int currentCitizenCount = CitizenUtils::getCitizenCount(entityManager);
@@ -512,6 +514,8 @@ void ChunkManager::populateChunk(int index, const ChunkInt2 &chunkCoord, const s
 	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	TextureManager &textureManager, EntityManager &entityManager)
 {
+	TraceZone("ChunkManager::populateChunk");
+
 	Chunk &chunk = this->getChunk(index);
 	
 	// Notify the entity manager about the new chunk so entities can be spawned in it.
@@ -750,6 +754,8 @@ void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, const CoordDo
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, AudioManager &audioManager,
 	EntityManager &entityManager)
 {
+	TraceZone("ChunkManager::update");
+
 	this->centerChunk = centerChunk;
 
 	// Free any out-of-range chunks.
@@ -71,6 +71,21 @@ void LevelDefinition::setVoxel(SNInt x, int y, WEInt z, VoxelDefID voxel)
 	this->voxels.set(x, y, z, voxel);
 }
 
+void LevelDefinition::setVoxels(const LevelDefinition &other, const BufferView<const VoxelDefID> &voxelDefIDs)
+{
+	DebugAssert(other.getWidth() == this->getWidth());
+	DebugAssert(other.getHeight() == this->getHeight());
+	DebugAssert(other.getDepth() == this->getDepth());
+
+	const VoxelDefID *srcVoxels = other.voxels.get();
+	VoxelDefID *dstVoxels = this->voxels.get();
+	const int voxelCount = this->getWidth() * this->getHeight() * this->getDepth();
+	for (int i = 0; i < voxelCount; i++)
+	{
+		dstVoxels[i] = voxelDefIDs.get(srcVoxels[i]);
+	}
+}
+
 int LevelDefinition::getEntityPlacementDefCount() const
 {
 	return static_cast<int>(this->entityPlacementDefs.size());
@@ -9,6 +9,7 @@
 #include "../Assets/MIFFile.h"
 
 #include "components/utilities/Buffer3D.h"
+#include "components/utilities/BufferView.h"
 
 // A single unbaked level of a map with IDs pointing to voxels, entities, etc. defined in a level
 // info definition. This can be for an interior level, whole city, or wilderness block.
@@ -90,6 +91,10 @@ public:
 	VoxelDefID getVoxel(SNInt x, int y, WEInt z) const;
 	void setVoxel(SNInt x, int y, WEInt z, VoxelDefID voxel);
 
+	// Copies the voxels of another level with the same dimensions, mapping each voxel definition ID
+	// through the given table. Used when merging levels that were generated separately.
+	void setVoxels(const LevelDefinition &other, const BufferView<const VoxelDefID> &voxelDefIDs);
+
 	int getEntityPlacementDefCount() const;
 	const EntityPlacementDef &getEntityPlacementDef(int index) const;
 	int getLockPlacementDefCount() const;
@@ -16,6 +16,7 @@
 #include "../Assets/MIFUtils.h"
 #include "../Assets/RMDFile.h"
 #include "../Math/Random.h"
+#include "../Utilities/ThreadUtils.h"
 
 #include "components/debug/Debug.h"
 #include "components/utilities/BufferView.h"
@@ -88,6 +89,7 @@ bool MapDefinition::initInteriorLevels(const MIFFile &mif, ArenaTypes::InteriorT
 	this->skyInfos.init(levelCount);
 	this->skyInfoMappings.init(levelCount);
 
+	// Levels have their own level info definitions so they can be converted on worker threads.
 	auto initLevelAndInfo = [this, &mif, interiorType, &rulerSeed, &rulerIsMale, &charClassLibrary,
 		&entityDefLibrary, &binaryAssetLibrary, &textureManager](int levelIndex,
 			const MIFFile::Level &mifLevel, const INFFile &inf)
@@ -120,28 +122,35 @@ bool MapDefinition::initInteriorLevels(const MIFFile &mif, ArenaTypes::InteriorT
 			entityDefLibrary, binaryAssetLibrary, textureManager, levelDefView, &levelInfoDef);
 		MapGeneration::readMifLocks(mifLevelView, inf, levelDefView, &levelInfoDef);
 		MapGeneration::readMifTriggers(mifLevelView, inf, levelDefView, &levelInfoDef);
-
-		// Generate interior sky.
-		SkyGeneration::InteriorSkyGenInfo interiorSkyGenInfo;
-		interiorSkyGenInfo.init(ceiling.outdoorDungeon);
-
-		SkyDefinition &skyDef = this->skies.get(levelIndex);
-		SkyInfoDefinition &skyInfoDef = this->skyInfos.get(levelIndex);
-		SkyGeneration::generateInteriorSky(interiorSkyGenInfo, textureManager, &skyDef, &skyInfoDef);
 	};
 
-	for (int i = 0; i < mif.getLevelCount(); i++)
+	// Load every level's .INF up front since file loading isn't thread-safe.
+	std::vector<INFFile> infs(levelCount);
+	for (int i = 0; i < levelCount; i++)
 	{
 		const MIFFile::Level &level = mif.getLevel(i);
 		const std::string infName = String::toUppercase(level.getInfo());
-		INFFile inf;
-		if (!inf.init(infName.c_str()))
+		if (!infs[i].init(infName.c_str()))
 		{
 			DebugLogError("Couldn't init .INF file \"" + infName + "\".");
 			return false;
 		}
+	}
 
-		initLevelAndInfo(i, level, inf);
+	ThreadUtils::parallelFor(levelCount, [&mif, &infs, &initLevelAndInfo](int i)
+	{
+		initLevelAndInfo(i, mif.getLevel(i), infs[i]);
+	});
+
+	// Generate interior skies on this thread since they use the texture manager.
+	for (int i = 0; i < levelCount; i++)
+	{
+		SkyGeneration::InteriorSkyGenInfo interiorSkyGenInfo;
+		interiorSkyGenInfo.init(infs[i].getCeiling().outdoorDungeon);
+
+		SkyDefinition &skyDef = this->skies.get(i);
+		SkyInfoDefinition &skyInfoDef = this->skyInfos.get(i);
+		SkyGeneration::generateInteriorSky(interiorSkyGenInfo, textureManager, &skyDef, &skyInfoDef);
 	}
 
 	// Each interior level info maps to its parallel level.
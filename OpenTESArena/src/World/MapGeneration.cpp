@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <mutex>
 #include <unordered_map>
 
 #include "ArenaCityUtils.h"
@@ -26,6 +27,8 @@
 #include "../Entities/EntityDefinitionLibrary.h"
 #include "../Entities/EntityType.h"
 #include "../Math/Random.h"
+#include "../Media/TextureManager.h"
+#include "../Utilities/ThreadUtils.h"
 #include "../WorldMap/ArenaLocationUtils.h"
 
 #include "components/debug/Debug.h"
@@ -43,6 +46,15 @@ namespace MapGeneration
 	using ArenaBuildingNameMappingCache = std::unordered_map<std::string, LevelDefinition::BuildingNameID>;
 	using ArenaDoorMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::DoorDefID>;
 
+	// Entity definitions made from .INF flats, shared by levels generated on worker threads from the
+	// same .INF so each flat's animations are made once instead of once per level. Flats that couldn't
+	// be made are stored as empty.
+	struct ArenaFlatEntityDefCache
+	{
+		std::mutex mutex;
+		std::unordered_map<ArenaTypes::FlatIndex, std::optional<EntityDefinition>> defs;
+	};
+
 	// Converts the given Arena *MENU ID to a modern interior type, if any.
 	std::optional<ArenaTypes::InteriorType> tryGetInteriorTypeFromMenuIndex(int menuIndex, MapType mapType)
 	{
@@ -158,6 +170,9 @@ namespace MapGeneration
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager, EntityDefinition *outDef)
 	{
+		// Levels are generated on worker threads, and the animations made here hold texture handles.
+		const std::unique_lock<std::recursive_mutex> lock = textureManager.lock();
+
 		const INFFile::FlatData &flatData = inf.getFlat(flatIndex);
 		const EntityType entityType = ArenaAnimUtils::getEntityTypeFromFlat(flatIndex, inf);
 		const std::optional<ArenaTypes::ItemIndex> &optItemIndex = flatData.itemIndex;
@@ -269,6 +284,44 @@ namespace MapGeneration
 		return true;
 	}
 
+	// Gets the entity definition for a flat from the shared cache if there is one, making it if needed.
+	bool tryGetEntityDefFromArenaFlat(ArenaTypes::FlatIndex flatIndex, MapType mapType,
+		const std::optional<ArenaTypes::InteriorType> &interiorType, const std::optional<bool> &rulerIsMale,
+		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager, ArenaFlatEntityDefCache *flatEntityDefCache, EntityDefinition *outDef)
+	{
+		if (flatEntityDefCache == nullptr)
+		{
+			return MapGeneration::tryMakeEntityDefFromArenaFlat(flatIndex, mapType, interiorType, rulerIsMale,
+				inf, charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, outDef);
+		}
+
+		std::lock_guard<std::mutex> lock(flatEntityDefCache->mutex);
+		auto iter = flatEntityDefCache->defs.find(flatIndex);
+		if (iter == flatEntityDefCache->defs.end())
+		{
+			EntityDefinition entityDef;
+			std::optional<EntityDefinition> cachedEntityDef;
+			if (MapGeneration::tryMakeEntityDefFromArenaFlat(flatIndex, mapType, interiorType, rulerIsMale,
+				inf, charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &entityDef))
+			{
+				cachedEntityDef = std::move(entityDef);
+			}
+
+			iter = flatEntityDefCache->defs.emplace(flatIndex, std::move(cachedEntityDef)).first;
+		}
+
+		const std::optional<EntityDefinition> &entityDef = iter->second;
+		if (!entityDef.has_value())
+		{
+			return false;
+		}
+
+		*outDef = *entityDef;
+		return true;
+	}
+
 	VoxelDefinition makeVoxelDefFromFLOR(ArenaTypes::VoxelID florVoxel, MapType mapType, const INFFile &inf)
 	{
 		const int textureID = (florVoxel & 0xFF00) >> 8;
@@ -945,7 +998,8 @@ namespace MapGeneration
 		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager, LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef,
-		ArenaVoxelMappingCache *voxelCache, ArenaEntityMappingCache *entityCache)
+		ArenaVoxelMappingCache *voxelCache, ArenaEntityMappingCache *entityCache,
+		ArenaFlatEntityDefCache *flatEntityDefCache)
 	{
 		for (SNInt florZ = 0; florZ < flor.getHeight(); florZ++)
 		{
@@ -987,9 +1041,9 @@ namespace MapGeneration
 					{
 						const ArenaTypes::FlatIndex flatIndex = floorFlatID - 1;
 						EntityDefinition entityDef;
-						if (!MapGeneration::tryMakeEntityDefFromArenaFlat(flatIndex, mapType,
+						if (!MapGeneration::tryGetEntityDefFromArenaFlat(flatIndex, mapType,
 							interiorType, rulerIsMale, inf, charClassLibrary, entityDefLibrary,
-							binaryAssetLibrary, textureManager, &entityDef))
+							binaryAssetLibrary, textureManager, flatEntityDefCache, &entityDef))
 						{
 							DebugLogWarning("Couldn't make entity definition from FLAT \"" +
 								std::to_string(flatIndex) + "\" with .INF \"" + inf.getName() + "\".");
@@ -1020,7 +1074,8 @@ namespace MapGeneration
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager, LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef,
 		ArenaVoxelMappingCache *voxelCache, ArenaEntityMappingCache *entityCache,
-		ArenaTransitionMappingCache *transitionCache, ArenaDoorMappingCache *doorCache)
+		ArenaTransitionMappingCache *transitionCache, ArenaDoorMappingCache *doorCache,
+		ArenaFlatEntityDefCache *flatEntityDefCache)
 	{
 		for (SNInt map1Z = 0; map1Z < map1.getHeight(); map1Z++)
 		{
@@ -1125,9 +1180,9 @@ namespace MapGeneration
 					{
 						const ArenaTypes::FlatIndex flatIndex = map1Voxel & 0x00FF;
 						EntityDefinition entityDef;
-						if (!MapGeneration::tryMakeEntityDefFromArenaFlat(flatIndex, mapType,
+						if (!MapGeneration::tryGetEntityDefFromArenaFlat(flatIndex, mapType,
 							interiorType, rulerIsMale, inf, charClassLibrary, entityDefLibrary,
-							binaryAssetLibrary, textureManager, &entityDef))
+							binaryAssetLibrary, textureManager, flatEntityDefCache, &entityDef))
 						{
 							DebugLogWarning("Couldn't make entity definition from FLAT \"" +
 								std::to_string(flatIndex) + "\" with .INF \"" + inf.getName() + "\".");
@@ -1219,6 +1274,18 @@ namespace MapGeneration
 		}
 	}
 
+	// Returns whether the two .MIF locks map to the same lock definition.
+	bool isSameArenaLock(const ArenaTypes::MIFLock &a, const ArenaTypes::MIFLock &b)
+	{
+		return (a.x == b.x) && (a.y == b.y) && (a.lockLevel == b.lockLevel);
+	}
+
+	// Returns whether the two .MIF triggers map to the same trigger definition.
+	bool isSameArenaTrigger(const ArenaTypes::MIFTrigger &a, const ArenaTypes::MIFTrigger &b)
+	{
+		return (a.x == b.x) && (a.y == b.y) && (a.textIndex == b.textIndex) && (a.soundIndex == b.soundIndex);
+	}
+
 	void readArenaLock(const ArenaTypes::MIFLock &lock, const INFFile &inf, LevelDefinition *outLevelDef,
 		LevelInfoDefinition *outLevelInfoDef, ArenaLockMappingCache *lockMappings)
 	{
@@ -1229,8 +1296,7 @@ namespace MapGeneration
 		const auto iter = std::find_if(lockMappings->begin(), lockMappings->end(),
 			[&lock](const std::pair<ArenaTypes::MIFLock, LevelDefinition::LockDefID> &pair)
 		{
-			const ArenaTypes::MIFLock &mifLock = pair.first;
-			return (mifLock.x == lock.x) && (mifLock.y == lock.y) && (mifLock.lockLevel == lock.lockLevel);
+			return MapGeneration::isSameArenaLock(pair.first, lock);
 		});
 
 		if (iter != lockMappings->end())
@@ -1260,9 +1326,7 @@ namespace MapGeneration
 		const auto iter = std::find_if(triggerMappings->begin(), triggerMappings->end(),
 			[&trigger](const std::pair<ArenaTypes::MIFTrigger, LevelDefinition::TriggerDefID> &pair)
 		{
-			const ArenaTypes::MIFTrigger &mifTrigger = pair.first;
-			return (mifTrigger.x == trigger.x) && (mifTrigger.y == trigger.y) &&
-				(mifTrigger.textIndex == trigger.textIndex) && (mifTrigger.soundIndex == trigger.soundIndex);
+			return MapGeneration::isSameArenaTrigger(pair.first, trigger);
 		});
 
 		if (iter == triggerMappings->end())
@@ -1289,7 +1353,7 @@ namespace MapGeneration
 		ArenaVoxelMappingCache *florMappings, ArenaVoxelMappingCache *map1Mappings,
 		ArenaEntityMappingCache *entityMappings, ArenaLockMappingCache *lockMappings,
 		ArenaTriggerMappingCache *triggerMappings, ArenaTransitionMappingCache *transitionMappings,
-		ArenaDoorMappingCache *doorMappings)
+		ArenaDoorMappingCache *doorMappings, ArenaFlatEntityDefCache *flatEntityDefCache)
 	{
 		// Create buffers for level blocks.
 		Buffer2D<ArenaTypes::VoxelID> levelFLOR(mif.getWidth() * widthChunks, mif.getDepth() * depthChunks);
@@ -1399,7 +1463,7 @@ namespace MapGeneration
 			levelMAP1.get(), levelMAP1.getWidth(), levelMAP1.getHeight());
 		MapGeneration::readArenaFLOR(levelFlorView, mapType, interiorType, rulerIsMale, inf,
 			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef,
-			outLevelInfoDef, florMappings, entityMappings);
+			outLevelInfoDef, florMappings, entityMappings, flatEntityDefCache);
 
 		constexpr std::optional<uint32_t> rulerSeed; // Not necessary for dungeons.
 		constexpr std::optional<bool> palaceIsMainQuestDungeon; // Not necessary for dungeons.
@@ -1409,7 +1473,7 @@ namespace MapGeneration
 		MapGeneration::readArenaMAP1(levelMap1View, mapType, interiorType, rulerSeed, rulerIsMale,
 			palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon, inf, charClassLibrary,
 			entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef, outLevelInfoDef,
-			map1Mappings, entityMappings, transitionMappings, doorMappings);
+			map1Mappings, entityMappings, transitionMappings, doorMappings, flatEntityDefCache);
 
 		// Generate ceiling (if any).
 		if (!inf.getCeiling().outdoorDungeon)
@@ -1418,6 +1482,327 @@ namespace MapGeneration
 		}
 	}
 
+	// A level converted on a worker thread with its own level info definition and mapping caches.
+	// Merging each level's definitions into the shared ones in level order assigns the same shared
+	// definition IDs as converting the levels one after another.
+	struct ArenaLevelGenResult
+	{
+		LevelDefinition levelDef;
+		LevelInfoDefinition levelInfoDef;
+		ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
+		ArenaEntityMappingCache entityMappings;
+		ArenaLockMappingCache lockMappings;
+		ArenaTriggerMappingCache triggerMappings;
+		ArenaTransitionMappingCache transitionMappings;
+		ArenaDoorMappingCache doorMappings;
+
+		// Local to shared definition IDs, written by the merge. Triggers already placed by an earlier
+		// level have no shared ID since duplicate triggers are not placed again.
+		std::vector<LevelDefinition::VoxelDefID> voxelDefIDs;
+		std::vector<LevelDefinition::EntityDefID> entityDefIDs;
+		std::vector<LevelDefinition::LockDefID> lockDefIDs;
+		std::vector<std::optional<LevelDefinition::TriggerDefID>> triggerDefIDs;
+		std::vector<LevelDefinition::TransitionDefID> transitionDefIDs;
+		std::vector<LevelDefinition::DoorDefID> doorDefIDs;
+
+		void init(const LevelDefinition &sharedLevelDef)
+		{
+			this->levelDef.init(sharedLevelDef.getWidth(), sharedLevelDef.getHeight(), sharedLevelDef.getDepth());
+
+			// Only used for its definitions. Voxel ID 0 is air like in the shared level info definition.
+			this->levelInfoDef.init(1.0);
+		}
+	};
+
+	// Maps each local definition to a shared one, adding it to the shared level info definition if its
+	// .MIF/.RMD voxel wasn't seen by an earlier level. Local IDs are visited in the order they were made.
+	template <typename DefType>
+	std::vector<int> mergeArenaMappings(const std::unordered_map<ArenaTypes::VoxelID, int> &localMappings,
+		const LevelInfoDefinition &localLevelInfoDef, int (LevelInfoDefinition::*getDefCount)() const,
+		const DefType &(LevelInfoDefinition::*getDef)(int) const, int (LevelInfoDefinition::*addDef)(DefType&&),
+		std::unordered_map<ArenaTypes::VoxelID, int> *sharedMappings, LevelInfoDefinition *outLevelInfoDef)
+	{
+		const int localDefCount = (localLevelInfoDef.*getDefCount)();
+		DebugAssert(static_cast<int>(localMappings.size()) == localDefCount);
+
+		std::vector<ArenaTypes::VoxelID> localArenaVoxels(localDefCount);
+		for (const auto &pair : localMappings)
+		{
+			DebugAssertIndex(localArenaVoxels, pair.second);
+			localArenaVoxels[pair.second] = pair.first;
+		}
+
+		std::vector<int> sharedIDs(localDefCount);
+		for (int i = 0; i < localDefCount; i++)
+		{
+			const ArenaTypes::VoxelID arenaVoxel = localArenaVoxels[i];
+			const auto iter = sharedMappings->find(arenaVoxel);
+			if (iter != sharedMappings->end())
+			{
+				sharedIDs[i] = iter->second;
+			}
+			else
+			{
+				DefType def = (localLevelInfoDef.*getDef)(i);
+				sharedIDs[i] = (outLevelInfoDef->*addDef)(std::move(def));
+				sharedMappings->insert(std::make_pair(arenaVoxel, sharedIDs[i]));
+			}
+		}
+
+		return sharedIDs;
+	}
+
+	// Merges a level's local definitions into the shared level info definition. Must be called for
+	// each level in order.
+	void mergeArenaLevelDefs(ArenaLevelGenResult &result, LevelInfoDefinition *outLevelInfoDef,
+		ArenaVoxelMappingCache *florMappings, ArenaVoxelMappingCache *map1Mappings,
+		ArenaVoxelMappingCache *map2Mappings, ArenaEntityMappingCache *entityMappings,
+		ArenaLockMappingCache *lockMappings, ArenaTriggerMappingCache *triggerMappings,
+		ArenaTransitionMappingCache *transitionMappings, ArenaDoorMappingCache *doorMappings)
+	{
+		const LevelInfoDefinition &localLevelInfoDef = result.levelInfoDef;
+
+		// Voxel definitions come from three caches sharing one ID range, and ceiling definitions
+		// aren't cached at all.
+		const int voxelDefCount = localLevelInfoDef.getVoxelDefCount();
+		std::vector<std::pair<ArenaVoxelMappingCache*, ArenaTypes::VoxelID>> voxelDefSources(
+			voxelDefCount, std::make_pair(nullptr, 0));
+		auto addVoxelDefSources = [&voxelDefSources](const ArenaVoxelMappingCache &localMappings,
+			ArenaVoxelMappingCache *sharedMappings)
+		{
+			for (const auto &pair : localMappings)
+			{
+				DebugAssertIndex(voxelDefSources, pair.second);
+				voxelDefSources[pair.second] = std::make_pair(sharedMappings, pair.first);
+			}
+		};
+
+		addVoxelDefSources(result.florMappings, florMappings);
+		addVoxelDefSources(result.map1Mappings, map1Mappings);
+		addVoxelDefSources(result.map2Mappings, map2Mappings);
+
+		result.voxelDefIDs.resize(voxelDefCount);
+		result.voxelDefIDs[0] = 0; // Air.
+		for (int i = 1; i < voxelDefCount; i++)
+		{
+			ArenaVoxelMappingCache *sharedMappings = voxelDefSources[i].first;
+			const ArenaTypes::VoxelID arenaVoxel = voxelDefSources[i].second;
+			if (sharedMappings != nullptr)
+			{
+				const auto iter = sharedMappings->find(arenaVoxel);
+				if (iter != sharedMappings->end())
+				{
+					result.voxelDefIDs[i] = iter->second;
+					continue;
+				}
+			}
+
+			VoxelDefinition voxelDef = localLevelInfoDef.getVoxelDef(i);
+			result.voxelDefIDs[i] = outLevelInfoDef->addVoxelDef(std::move(voxelDef));
+
+			if (sharedMappings != nullptr)
+			{
+				sharedMappings->insert(std::make_pair(arenaVoxel, result.voxelDefIDs[i]));
+			}
+		}
+
+		result.entityDefIDs = MapGeneration::mergeArenaMappings(result.entityMappings, localLevelInfoDef,
+			&LevelInfoDefinition::getEntityDefCount, &LevelInfoDefinition::getEntityDef,
+			&LevelInfoDefinition::addEntityDef, entityMappings, outLevelInfoDef);
+		result.transitionDefIDs = MapGeneration::mergeArenaMappings(result.transitionMappings, localLevelInfoDef,
+			&LevelInfoDefinition::getTransitionDefCount, &LevelInfoDefinition::getTransitionDef,
+			&LevelInfoDefinition::addTransitionDef, transitionMappings, outLevelInfoDef);
+		result.doorDefIDs = MapGeneration::mergeArenaMappings(result.doorMappings, localLevelInfoDef,
+			&LevelInfoDefinition::getDoorDefCount, &LevelInfoDefinition::getDoorDef,
+			&LevelInfoDefinition::addDoorDef, doorMappings, outLevelInfoDef);
+
+		// Lock and trigger mappings are in local ID order.
+		result.lockDefIDs.resize(result.lockMappings.size());
+		for (int i = 0; i < static_cast<int>(result.lockMappings.size()); i++)
+		{
+			const ArenaTypes::MIFLock &lock = result.lockMappings[i].first;
+			DebugAssert(result.lockMappings[i].second == i);
+			const auto iter = std::find_if(lockMappings->begin(), lockMappings->end(),
+				[&lock](const std::pair<ArenaTypes::MIFLock, LevelDefinition::LockDefID> &pair)
+			{
+				return MapGeneration::isSameArenaLock(pair.first, lock);
+			});
+
+			if (iter != lockMappings->end())
+			{
+				result.lockDefIDs[i] = iter->second;
+			}
+			else
+			{
+				LockDefinition lockDef = localLevelInfoDef.getLockDef(i);
+				result.lockDefIDs[i] = outLevelInfoDef->addLockDef(std::move(lockDef));
+				lockMappings->push_back(std::make_pair(lock, result.lockDefIDs[i]));
+			}
+		}
+
+		result.triggerDefIDs.resize(result.triggerMappings.size());
+		for (int i = 0; i < static_cast<int>(result.triggerMappings.size()); i++)
+		{
+			const ArenaTypes::MIFTrigger &trigger = result.triggerMappings[i].first;
+			DebugAssert(result.triggerMappings[i].second == i);
+			const auto iter = std::find_if(triggerMappings->begin(), triggerMappings->end(),
+				[&trigger](const std::pair<ArenaTypes::MIFTrigger, LevelDefinition::TriggerDefID> &pair)
+			{
+				return MapGeneration::isSameArenaTrigger(pair.first, trigger);
+			});
+
+			if (iter == triggerMappings->end())
+			{
+				TriggerDefinition triggerDef = localLevelInfoDef.getTriggerDef(i);
+				result.triggerDefIDs[i] = outLevelInfoDef->addTriggerDef(std::move(triggerDef));
+				triggerMappings->emplace_back(std::make_pair(trigger, *result.triggerDefIDs[i]));
+			}
+		}
+	}
+
+	// Writes a merged level's voxels and placements to the shared level definition using the shared
+	// definition IDs. Levels are independent of each other at this point.
+	void writeArenaLevel(const ArenaLevelGenResult &result, LevelDefinition *outLevelDef)
+	{
+		const LevelDefinition &localLevelDef = result.levelDef;
+		const BufferView<const LevelDefinition::VoxelDefID> voxelDefIDsView(
+			result.voxelDefIDs.data(), static_cast<int>(result.voxelDefIDs.size()));
+		outLevelDef->setVoxels(localLevelDef, voxelDefIDsView);
+
+		for (int i = 0; i < localLevelDef.getEntityPlacementDefCount(); i++)
+		{
+			const LevelDefinition::EntityPlacementDef &placementDef = localLevelDef.getEntityPlacementDef(i);
+			DebugAssertIndex(result.entityDefIDs, placementDef.id);
+			const LevelDefinition::EntityDefID entityDefID = result.entityDefIDs[placementDef.id];
+			for (const LevelDouble3 &position : placementDef.positions)
+			{
+				outLevelDef->addEntity(entityDefID, position);
+			}
+		}
+
+		for (int i = 0; i < localLevelDef.getLockPlacementDefCount(); i++)
+		{
+			const LevelDefinition::LockPlacementDef &placementDef = localLevelDef.getLockPlacementDef(i);
+			DebugAssertIndex(result.lockDefIDs, placementDef.id);
+			const LevelDefinition::LockDefID lockDefID = result.lockDefIDs[placementDef.id];
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addLock(lockDefID, position);
+			}
+		}
+
+		for (int i = 0; i < localLevelDef.getTriggerPlacementDefCount(); i++)
+		{
+			const LevelDefinition::TriggerPlacementDef &placementDef = localLevelDef.getTriggerPlacementDef(i);
+			DebugAssertIndex(result.triggerDefIDs, placementDef.id);
+			const std::optional<LevelDefinition::TriggerDefID> &triggerDefID = result.triggerDefIDs[placementDef.id];
+			if (!triggerDefID.has_value())
+			{
+				continue;
+			}
+
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addTrigger(*triggerDefID, position);
+			}
+		}
+
+		for (int i = 0; i < localLevelDef.getTransitionPlacementDefCount(); i++)
+		{
+			const LevelDefinition::TransitionPlacementDef &placementDef = localLevelDef.getTransitionPlacementDef(i);
+			DebugAssertIndex(result.transitionDefIDs, placementDef.id);
+			const LevelDefinition::TransitionDefID transitionDefID = result.transitionDefIDs[placementDef.id];
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addTransition(transitionDefID, position);
+			}
+		}
+
+		for (int i = 0; i < localLevelDef.getDoorPlacementDefCount(); i++)
+		{
+			const LevelDefinition::DoorPlacementDef &placementDef = localLevelDef.getDoorPlacementDef(i);
+			DebugAssertIndex(result.doorDefIDs, placementDef.id);
+			const LevelDefinition::DoorDefID doorDefID = result.doorDefIDs[placementDef.id];
+			for (const LevelInt3 &position : placementDef.positions)
+			{
+				outLevelDef->addDoor(doorDefID, position);
+			}
+		}
+
+		// Building names are generated after levels are merged.
+		DebugAssert(localLevelDef.getBuildingNamePlacementDefCount() == 0);
+	}
+
+	// Determines the packed *LEVELUP/*LEVELDOWN block coordinates for each dungeon level. Consecutive
+	// levels never use the same block.
+	std::vector<int> generateArenaDungeonTransitions(int levelCount, WEInt widthChunks, SNInt depthChunks,
+		ArenaRandom &random)
+	{
+		auto getNextTransBlock = [widthChunks, depthChunks, &random]()
+		{
+			const SNInt tY = random.next() % depthChunks;
+			const WEInt tX = random.next() % widthChunks;
+			return ArenaInteriorUtils::packLevelChangeVoxel(tX, tY);
+		};
+
+		// Packed coordinates for transition blocks.
+		// @todo: maybe this could be an int pair so packing is not required.
+		std::vector<int> transitions;
+
+		// Handle initial case where transitions list is empty (for i == 0).
+		transitions.push_back(getNextTransBlock());
+
+		// Handle general case for transitions list additions.
+		for (int i = 1; i < levelCount; i++)
+		{
+			int transBlock;
+			do
+			{
+				transBlock = getNextTransBlock();
+			} while (transBlock == transitions.back());
+
+			transitions.push_back(transBlock);
+		}
+
+		return transitions;
+	}
+
+	// Gets the level up block of a dungeon level, and its level down block if it's not the lowest level.
+	void getArenaDungeonLevelBlocks(const std::vector<int> &transitions, int levelIndex, int *outLevelUpBlock,
+		std::optional<int> *outLevelDownBlock)
+	{
+		DebugAssertIndex(transitions, levelIndex);
+		*outLevelUpBlock = transitions[levelIndex];
+
+		const int levelCount = static_cast<int>(transitions.size());
+		if (levelIndex < (levelCount - 1))
+		{
+			*outLevelDownBlock = transitions[levelIndex + 1];
+		}
+		else
+		{
+			// No *LEVELDOWN block on the lowest level.
+			*outLevelDownBlock = std::nullopt;
+		}
+	}
+
+	// The start point depends on where the level up voxel is on the first level.
+	LevelInt2 getArenaDungeonStartPoint(const std::vector<int> &transitions)
+	{
+		DebugAssertIndex(transitions, 0);
+		const int firstTransition = transitions[0];
+		WEInt firstTransitionChunkX;
+		SNInt firstTransitionChunkZ;
+		ArenaInteriorUtils::unpackLevelChangeVoxel(
+			firstTransition, &firstTransitionChunkX, &firstTransitionChunkZ);
+
+		// Convert it from the old coordinate system to the new one.
+		const OriginalInt2 startPoint(
+			ArenaInteriorUtils::offsetLevelChangeVoxel(firstTransitionChunkX),
+			ArenaInteriorUtils::offsetLevelChangeVoxel(firstTransitionChunkZ));
+		return VoxelUtils::originalVoxelToNewVoxel(startPoint);
+	}
+
 	void generateArenaCityBuildingNames(uint32_t citySeed, int raceID, bool coastal,
 		const std::string_view &cityTypeName,
 		const LocationDefinition::CityDefinition::MainQuestTempleOverride *mainQuestTempleOverride,
@@ -1867,6 +2252,78 @@ namespace MapGeneration
 		tryGenerateChunkBuildingName(ArenaTypes::InteriorType::Tavern);
 		tryGenerateChunkBuildingName(ArenaTypes::InteriorType::Temple);
 	}
+
+	// Copies the wild block's .RMD voxels into the temp buffers, replacing the placeholder city block
+	// if it is one.
+	void writeArenaWildBlockVoxels(ArenaWildUtils::WildBlockID wildBlockID,
+		const LocationDefinition::CityDefinition &cityDef, const BinaryAssetLibrary &binaryAssetLibrary,
+		Buffer2D<ArenaTypes::VoxelID> &tempFlor, Buffer2D<ArenaTypes::VoxelID> &tempMap1,
+		Buffer2D<ArenaTypes::VoxelID> &tempMap2)
+	{
+		const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
+		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
+		const RMDFile &rmd = rmdFiles[rmdIndex];
+		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
+		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
+		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
+
+		// Copy .RMD voxels into temp buffers.
+		for (int y = 0; y < tempFlor.getHeight(); y++)
+		{
+			for (int x = 0; x < tempFlor.getWidth(); x++)
+			{
+				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
+				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
+				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
+				tempFlor.set(x, y, rmdFlorID);
+				tempMap1.set(x, y, rmdMap1ID);
+				tempMap2.set(x, y, rmdMap2ID);
+			}
+		}
+
+		if (ArenaWildUtils::isWildCityBlock(wildBlockID))
+		{
+			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
+			BufferView2D<ArenaTypes::VoxelID> tempFlorView(
+				tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
+			BufferView2D<ArenaTypes::VoxelID> tempMap1View(
+				tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
+			BufferView2D<ArenaTypes::VoxelID> tempMap2View(
+				tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
+
+			ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View,
+				cityDef, binaryAssetLibrary);
+		}
+	}
+
+	// Generates chunk-wise building names for the wilderness once all the blocks are converted.
+	void generateArenaWildBuildingNames(const BufferView2D<const int> &levelDefIndices,
+		const BufferView<LevelDefinition> &levelDefs, const BinaryAssetLibrary &binaryAssetLibrary,
+		LevelInfoDefinition *outLevelInfoDef, std::vector<WildChunkBuildingNameInfo> *outBuildingNameInfos)
+	{
+		ArenaBuildingNameMappingCache buildingNameMappings;
+		for (WEInt z = 0; z < levelDefIndices.getHeight(); z++)
+		{
+			for (SNInt x = 0; x < levelDefIndices.getWidth(); x++)
+			{
+				const int levelDefIndex = levelDefIndices.get(x, z);
+				const LevelDefinition &levelDef = levelDefs.get(levelDefIndex);
+				const ChunkInt2 chunk(x, z);
+				const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y);
+				WildChunkBuildingNameInfo buildingNameInfo;
+				buildingNameInfo.init(chunk);
+
+				MapGeneration::generateArenaWildChunkBuildingNames(chunkSeed, levelDef, binaryAssetLibrary,
+					&buildingNameInfo, outLevelInfoDef, &buildingNameMappings);
+
+				// Register the chunk if it has any buildings with names.
+				if (buildingNameInfo.hasBuildingNames())
+				{
+					outBuildingNameInfos->emplace_back(std::move(buildingNameInfo));
+				}
+			}
+		}
+	}
 }
 
 void MapGeneration::InteriorGenInfo::Prefab::init(std::string &&mifName, ArenaTypes::InteriorType interiorType,
@@ -2056,11 +2513,11 @@ void MapGeneration::readMifVoxels(const BufferView<const MIFFile::Level> &levels
 		LevelDefinition &levelDef = outLevelDefs.get(i);
 		MapGeneration::readArenaFLOR(level.getFLOR(), mapType, interiorType, rulerIsMale, inf,
 			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
-			outLevelInfoDef, &florMappings, &entityMappings);
+			outLevelInfoDef, &florMappings, &entityMappings, nullptr);
 		MapGeneration::readArenaMAP1(level.getMAP1(), mapType, interiorType, rulerSeed, rulerIsMale,
 			palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon, inf, charClassLibrary,
 			entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, outLevelInfoDef, &map1Mappings,
-			&entityMappings, &transitionMappings, &doorMappings);
+			&entityMappings, &transitionMappings, &doorMappings, nullptr);
 
 		// If there is MAP2 data, use it for the ceiling layer, otherwise replicate a single ceiling
 		// block across the whole ceiling if not in an outdoor dungeon.
@@ -2099,75 +2556,95 @@ void MapGeneration::generateMifDungeon(const MIFFile &mif, int levelCount, WEInt
 	}
 
 	// Determine transition blocks (*LEVELUP/*LEVELDOWN) that will appear in the dungeon.
-	auto getNextTransBlock = [widthChunks, depthChunks, &random]()
+	const std::vector<int> transitions = MapGeneration::generateArenaDungeonTransitions(
+		levelCount, widthChunks, depthChunks, random);
+
+	// Generate each level on worker threads, deciding which dungeon blocks to use. Each level has its own
+	// random seed so levels don't depend on each other. Every level uses the same .INF, so entity
+	// definitions are shared instead of each level making its own while holding the texture manager lock.
+	std::vector<MapGeneration::ArenaLevelGenResult> levelResults(levelCount);
+	ArenaFlatEntityDefCache flatEntityDefCache;
+	ArenaRandom lastLevelRandom = random;
+	ThreadUtils::parallelFor(levelCount, [&](int i)
 	{
-		const SNInt tY = random.next() % depthChunks;
-		const WEInt tX = random.next() % widthChunks;
-		return ArenaInteriorUtils::packLevelChangeVoxel(tX, tY);
-	};
+		ArenaRandom levelRandom(seed2 + i);
 
-	// Packed coordinates for transition blocks.
-	// @todo: maybe this could be an int pair so packing is not required.
-	std::vector<int> transitions;
+		// Determine level up/down blocks.
+		int levelUpBlock;
+		std::optional<int> levelDownBlock;
+		MapGeneration::getArenaDungeonLevelBlocks(transitions, i, &levelUpBlock, &levelDownBlock);
 
-	// Handle initial case where transitions list is empty (for i == 0).
-	transitions.push_back(getNextTransBlock());
+		MapGeneration::ArenaLevelGenResult &levelResult = levelResults[i];
+		levelResult.init(outLevelDefs.get(i));
+		MapGeneration::generateArenaDungeonLevel(mif, widthChunks, depthChunks, levelUpBlock,
+			levelDownBlock, levelRandom, mapType, interiorType, rulerIsMale, isArtifactDungeon,
+			inf, charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelResult.levelDef,
+			&levelResult.levelInfoDef, &levelResult.florMappings, &levelResult.map1Mappings,
+			&levelResult.entityMappings, &levelResult.lockMappings, &levelResult.triggerMappings,
+			&levelResult.transitionMappings, &levelResult.doorMappings, &flatEntityDefCache);
 
-	// Handle general case for transitions list additions.
-	for (int i = 1; i < levelCount; i++)
-	{
-		int transBlock;
-		do
+		if (i == (levelCount - 1))
 		{
-			transBlock = getNextTransBlock();
-		} while (transBlock == transitions.back());
+			lastLevelRandom = levelRandom;
+		}
+	});
+
+	// Leave the random generator as if the levels were generated one after another.
+	random = lastLevelRandom;
 
-		transitions.push_back(transBlock);
+	// Definition IDs depend on which definitions earlier levels added, so merging is done in order.
+	ArenaVoxelMappingCache map2Mappings; // Dungeons don't have MAP2 data.
+	for (MapGeneration::ArenaLevelGenResult &levelResult : levelResults)
+	{
+		MapGeneration::mergeArenaLevelDefs(levelResult, outLevelInfoDef, &florMappings, &map1Mappings,
+			&map2Mappings, &entityMappings, &lockMappings, &triggerMappings, &transitionMappings, &doorMappings);
 	}
 
-	// Generate each level, deciding which dungeon blocks to use.
+	ThreadUtils::parallelFor(levelCount, [&levelResults, &outLevelDefs](int i)
+	{
+		MapGeneration::writeArenaLevel(levelResults[i], &outLevelDefs.get(i));
+	});
+
+	*outStartPoint = MapGeneration::getArenaDungeonStartPoint(transitions);
+}
+
+void MapGeneration::generateMifDungeonReference(const MIFFile &mif, int levelCount, WEInt widthChunks,
+	SNInt depthChunks, const INFFile &inf, ArenaRandom &random, MapType mapType,
+	ArenaTypes::InteriorType interiorType, const std::optional<bool> &rulerIsMale,
+	const std::optional<bool> &isArtifactDungeon, const CharacterClassLibrary &charClassLibrary,
+	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+	TextureManager &textureManager, BufferView<LevelDefinition> &outLevelDefs,
+	LevelInfoDefinition *outLevelInfoDef, LevelInt2 *outStartPoint)
+{
+	ArenaVoxelMappingCache florMappings, map1Mappings;
+	ArenaEntityMappingCache entityMappings;
+	ArenaLockMappingCache lockMappings;
+	ArenaTriggerMappingCache triggerMappings;
+	ArenaTransitionMappingCache transitionMappings;
+	ArenaDoorMappingCache doorMappings;
+
+	const uint32_t seed2 = random.getSeed();
+	const std::vector<int> transitions = MapGeneration::generateArenaDungeonTransitions(
+		levelCount, widthChunks, depthChunks, random);
+
+	// Generate each level directly into the shared level info definition.
 	for (int i = 0; i < levelCount; i++)
 	{
 		random.srand(seed2 + i);
 
-		// Determine level up/down blocks.
-		DebugAssertIndex(transitions, i);
-		const int levelUpBlock = transitions[i];
-		const std::optional<int> levelDownBlock = [&transitions, levelCount, i]() -> std::optional<int>
-		{
-			if (i < (levelCount - 1))
-			{
-				const int index = DebugMakeIndex(transitions, i + 1);
-				return transitions[index];
-			}
-			else
-			{
-				// No *LEVELDOWN block on the lowest level.
-				return std::nullopt;
-			}
-		}();
+		int levelUpBlock;
+		std::optional<int> levelDownBlock;
+		MapGeneration::getArenaDungeonLevelBlocks(transitions, i, &levelUpBlock, &levelDownBlock);
 
 		LevelDefinition &levelDef = outLevelDefs.get(i);
 		MapGeneration::generateArenaDungeonLevel(mif, widthChunks, depthChunks, levelUpBlock,
 			levelDownBlock, random, mapType, interiorType, rulerIsMale, isArtifactDungeon,
 			inf, charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
 			outLevelInfoDef, &florMappings, &map1Mappings, &entityMappings, &lockMappings, &triggerMappings,
-			&transitionMappings, &doorMappings);
+			&transitionMappings, &doorMappings, nullptr);
 	}
 
-	// The start point depends on where the level up voxel is on the first level.
-	DebugAssertIndex(transitions, 0);
-	const int firstTransition = transitions[0];
-	WEInt firstTransitionChunkX;
-	SNInt firstTransitionChunkZ;
-	ArenaInteriorUtils::unpackLevelChangeVoxel(
-		firstTransition, &firstTransitionChunkX, &firstTransitionChunkZ);
-
-	// Convert it from the old coordinate system to the new one.
-	const OriginalInt2 startPoint(
-		ArenaInteriorUtils::offsetLevelChangeVoxel(firstTransitionChunkX),
-		ArenaInteriorUtils::offsetLevelChangeVoxel(firstTransitionChunkZ));
-	*outStartPoint = VoxelUtils::originalVoxelToNewVoxel(startPoint);
+	*outStartPoint = MapGeneration::getArenaDungeonStartPoint(transitions);
 }
 
 void MapGeneration::generateMifCity(const MIFFile &mif, uint32_t citySeed, uint32_t rulerSeed, int raceID,
@@ -2226,11 +2703,11 @@ void MapGeneration::generateMifCity(const MIFFile &mif, uint32_t citySeed, uint3
 
 	MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, rulerIsMale, inf,
 		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef,
-		outLevelInfoDef, &florMappings, &entityMappings);
+		outLevelInfoDef, &florMappings, &entityMappings, nullptr);
 	MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, rulerSeed, rulerIsMale,
 		palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon, inf, charClassLibrary,
 		entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef, outLevelInfoDef, &map1Mappings,
-		&entityMappings, &transitionMappings, &doorMappings);
+		&entityMappings, &transitionMappings, &doorMappings, nullptr);
 	MapGeneration::readArenaMAP2(tempMap2ConstView, inf, outLevelDef, outLevelInfoDef, &map2Mappings);
 	MapGeneration::generateArenaCityBuildingNames(citySeed, raceID, coastal, cityTypeName,
 		mainQuestTempleOverride, random, binaryAssetLibrary, textAssetLibrary, outLevelDef,
@@ -2249,7 +2726,88 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 	ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
 	ArenaEntityMappingCache entityMappings;
 	ArenaTransitionMappingCache transitionMappings;
-	ArenaBuildingNameMappingCache buildingNameMappings;
+	ArenaDoorMappingCache doorMappings;
+	ArenaFlatEntityDefCache flatEntityDefCache;
+
+	// Convert each unique block on worker threads with their own definitions, then merge them in block
+	// order so definition IDs are the same as converting the blocks one after another.
+	const int blockCount = uniqueWildBlockIDs.getCount();
+	std::vector<MapGeneration::ArenaLevelGenResult> blockResults(blockCount);
+	ThreadUtils::parallelFor(blockCount, [&](int i)
+	{
+		// Temp voxel data buffers for the wilderness chunk.
+		constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
+		Buffer2D<ArenaTypes::VoxelID> tempFlor(chunkDim, chunkDim);
+		Buffer2D<ArenaTypes::VoxelID> tempMap1(chunkDim, chunkDim);
+		Buffer2D<ArenaTypes::VoxelID> tempMap2(chunkDim, chunkDim);
+
+		const ArenaWildUtils::WildBlockID wildBlockID = uniqueWildBlockIDs.get(i);
+		MapGeneration::writeArenaWildBlockVoxels(wildBlockID, cityDef, binaryAssetLibrary, tempFlor, tempMap1,
+			tempMap2);
+
+		MapGeneration::ArenaLevelGenResult &blockResult = blockResults[i];
+		blockResult.init(outLevelDefs.get(i));
+
+		const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(
+			tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
+		const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(
+			tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
+		const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(
+			tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
+
+		constexpr MapType mapType = MapType::Wilderness;
+		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
+		
+		// Dungeon definition if this chunk has any dungeons.
+		const uint32_t dungeonSeed = cityDef.provinceSeed;
+		LocationDefinition::DungeonDefinition dungeonDef;
+		dungeonDef.init(dungeonSeed, ArenaWildUtils::WILD_DUNGEON_WIDTH_CHUNKS, ArenaWildUtils::WILD_DUNGEON_HEIGHT_CHUNKS);
+
+		constexpr std::optional<bool> isArtifactDungeon = false; // No artifacts in wild dungeons.
+
+		MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, cityDef.rulerIsMale, inf,
+			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &blockResult.levelDef,
+			&blockResult.levelInfoDef, &blockResult.florMappings, &blockResult.entityMappings, &flatEntityDefCache);
+		MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
+			cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
+			entityDefLibrary, binaryAssetLibrary, textureManager, &blockResult.levelDef, &blockResult.levelInfoDef,
+			&blockResult.map1Mappings, &blockResult.entityMappings, &blockResult.transitionMappings,
+			&blockResult.doorMappings, &flatEntityDefCache);
+		MapGeneration::readArenaMAP2(tempMap2ConstView, inf, &blockResult.levelDef, &blockResult.levelInfoDef,
+			&blockResult.map2Mappings);
+	});
+
+	// The wilderness has no locks or triggers.
+	ArenaLockMappingCache lockMappings;
+	ArenaTriggerMappingCache triggerMappings;
+	for (MapGeneration::ArenaLevelGenResult &blockResult : blockResults)
+	{
+		MapGeneration::mergeArenaLevelDefs(blockResult, outLevelInfoDef, &florMappings, &map1Mappings,
+			&map2Mappings, &entityMappings, &lockMappings, &triggerMappings, &transitionMappings, &doorMappings);
+	}
+
+	ThreadUtils::parallelFor(blockCount, [&blockResults, &outLevelDefs](int i)
+	{
+		MapGeneration::writeArenaLevel(blockResults[i], &outLevelDefs.get(i));
+	});
+
+	MapGeneration::generateArenaWildBuildingNames(levelDefIndices, outLevelDefs, binaryAssetLibrary,
+		outLevelInfoDef, outBuildingNameInfos);
+}
+
+void MapGeneration::generateRmdWildernessReference(
+	const BufferView<const ArenaWildUtils::WildBlockID> &uniqueWildBlockIDs,
+	const BufferView2D<const int> &levelDefIndices, const LocationDefinition::CityDefinition &cityDef,
+	const INFFile &inf, const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager,
+	BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef,
+	std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos)
+{
+	DebugAssert(uniqueWildBlockIDs.getCount() == outLevelDefs.getCount());
+
+	ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
+	ArenaEntityMappingCache entityMappings;
+	ArenaTransitionMappingCache transitionMappings;
 	ArenaDoorMappingCache doorMappings;
 
 	// Create temp voxel data buffers to be used by each wilderness chunk.
@@ -2261,40 +2819,8 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 	for (int i = 0; i < uniqueWildBlockIDs.getCount(); i++)
 	{
 		const ArenaWildUtils::WildBlockID wildBlockID = uniqueWildBlockIDs.get(i);
-		const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
-		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
-		const RMDFile &rmd = rmdFiles[rmdIndex];
-		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
-
-		// Copy .RMD voxels into temp buffers.
-		for (int y = 0; y < tempFlor.getHeight(); y++)
-		{
-			for (int x = 0; x < tempFlor.getWidth(); x++)
-			{
-				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
-				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
-				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
-				tempFlor.set(x, y, rmdFlorID);
-				tempMap1.set(x, y, rmdMap1ID);
-				tempMap2.set(x, y, rmdMap2ID);
-			}
-		}
-
-		if (ArenaWildUtils::isWildCityBlock(wildBlockID))
-		{
-			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
-			BufferView2D<ArenaTypes::VoxelID> tempFlorView(
-				tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap1View(
-				tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap2View(
-				tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-
-			ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View,
-				cityDef, binaryAssetLibrary);
-		}
+		MapGeneration::writeArenaWildBlockVoxels(wildBlockID, cityDef, binaryAssetLibrary, tempFlor, tempMap1,
+			tempMap2);
 
 		LevelDefinition &levelDef = outLevelDefs.get(i);
 
@@ -2307,7 +2833,7 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 
 		constexpr MapType mapType = MapType::Wilderness;
 		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
-		
+
 		// Dungeon definition if this chunk has any dungeons.
 		const uint32_t dungeonSeed = cityDef.provinceSeed;
 		LocationDefinition::DungeonDefinition dungeonDef;
@@ -2317,36 +2843,16 @@ void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils:
 
 		MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, cityDef.rulerIsMale, inf,
 			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
-			outLevelInfoDef, &florMappings, &entityMappings);
+			outLevelInfoDef, &florMappings, &entityMappings, nullptr);
 		MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
 			cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
 			entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, outLevelInfoDef, &map1Mappings,
-			&entityMappings, &transitionMappings, &doorMappings);
+			&entityMappings, &transitionMappings, &doorMappings, nullptr);
 		MapGeneration::readArenaMAP2(tempMap2ConstView, inf, &levelDef, outLevelInfoDef, &map2Mappings);
 	}
 
-	// Generate chunk-wise building names for the wilderness.
-	for (WEInt z = 0; z < levelDefIndices.getHeight(); z++)
-	{
-		for (SNInt x = 0; x < levelDefIndices.getWidth(); x++)
-		{
-			const int levelDefIndex = levelDefIndices.get(x, z);
-			const LevelDefinition &levelDef = outLevelDefs.get(levelDefIndex);
-			const ChunkInt2 chunk(x, z);
-			const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y);
-			MapGeneration::WildChunkBuildingNameInfo buildingNameInfo;
-			buildingNameInfo.init(chunk);
-
-			MapGeneration::generateArenaWildChunkBuildingNames(chunkSeed, levelDef, binaryAssetLibrary,
-				&buildingNameInfo, outLevelInfoDef, &buildingNameMappings);
-
-			// Register the chunk if it has any buildings with names.
-			if (buildingNameInfo.hasBuildingNames())
-			{
-				outBuildingNameInfos->emplace_back(std::move(buildingNameInfo));
-			}
-		}
-	}
+	MapGeneration::generateArenaWildBuildingNames(levelDefIndices, outLevelDefs, binaryAssetLibrary,
+		outLevelInfoDef, outBuildingNameInfos);
 }
 
 void MapGeneration::readMifLocks(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
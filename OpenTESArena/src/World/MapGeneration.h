@@ -5,6 +5,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 #include "ArenaWildUtils.h"
 #include "DoorDefinition.h"
@@ -189,6 +190,16 @@ namespace MapGeneration
 		TextureManager &textureManager, BufferView<LevelDefinition> &outLevelDefs,
 		LevelInfoDefinition *outLevelInfoDef, LevelInt2 *outStartPoint);
 
+	// Serial version of generateMifDungeon() that generates levels one after another straight into the
+	// shared level info definition, for verifying it.
+	void generateMifDungeonReference(const MIFFile &mif, int levelCount, WEInt widthChunks,
+		SNInt depthChunks, const INFFile &inf, ArenaRandom &random, MapType mapType,
+		ArenaTypes::InteriorType interiorType, const std::optional<bool> &rulerIsMale,
+		const std::optional<bool> &isArtifactDungeon, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager, BufferView<LevelDefinition> &outLevelDefs,
+		LevelInfoDefinition *outLevelInfoDef, LevelInt2 *outStartPoint);
+
 	// Generates a level from the city .MIF file, optionally generating random city blocks if it
 	// is not a premade city, and converts the level to the modern format.
 	void generateMifCity(const MIFFile &mif, uint32_t citySeed, uint32_t rulerSeed, int raceID,
@@ -211,6 +222,16 @@ namespace MapGeneration
 		LevelInfoDefinition *outLevelInfoDef,
 		std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos);
 
+	// Serial version of generateRmdWilderness() that converts blocks one after another straight into the
+	// shared level info definition, for verifying it.
+	void generateRmdWildernessReference(const BufferView<const ArenaWildUtils::WildBlockID> &uniqueWildBlockIDs,
+		const BufferView2D<const int> &levelDefIndices, const LocationDefinition::CityDefinition &cityDef,
+		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager, BufferView<LevelDefinition> &outLevelDefs,
+		LevelInfoDefinition *outLevelInfoDef,
+		std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos);
+
 	void readMifLocks(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
 		BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef);
 	void readMifTriggers(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
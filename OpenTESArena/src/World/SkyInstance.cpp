@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 
 #include "ArenaSkyUtils.h"
@@ -129,6 +130,10 @@ SkyInstance::SkyInstance()
 	this->starEnd = -1;
 	this->lightningStart = -1;
 	this->lightningEnd = -1;
+	this->generalAnimStart = 0;
+	this->generalAnimEnd = 0;
+	this->lightningAnimStart = 0;
+	this->lightningAnimEnd = 0;
 }
 
 void SkyInstance::init(const SkyDefinition &skyDefinition, const SkyInfoDefinition &skyInfoDefinition,
@@ -398,12 +403,40 @@ void SkyInstance::init(const SkyDefinition &skyDefinition, const SkyInfoDefiniti
 	this->starStart = this->sunEnd;
 	this->starEnd = this->starStart + starInstCount;
 
+	// Only land has general animations.
+	this->generalAnimStart = 0;
+	this->generalAnimEnd = static_cast<int>(this->animInsts.size());
+
+	DebugAssert(this->moonEnd == this->sunStart);
+	DebugAssert(this->sunEnd == this->starStart);
+	const int rotatingInstCount = this->starEnd - this->moonStart;
+	this->baseRotatingDirectionXs.init(rotatingInstCount);
+	this->baseRotatingDirectionYs.init(rotatingInstCount);
+	this->baseRotatingDirectionZs.init(rotatingInstCount);
+	for (int i = 0; i < rotatingInstCount; i++)
+	{
+		const ObjectInstance &objectInst = this->objectInsts[this->moonStart + i];
+		const Double3 &baseDirection = objectInst.getBaseDirection();
+		this->baseRotatingDirectionXs.set(i, baseDirection.x);
+		this->baseRotatingDirectionYs.set(i, baseDirection.y);
+		this->baseRotatingDirectionZs.set(i, baseDirection.z);
+	}
+
+	this->rotatingDirectionXs.init(rotatingInstCount);
+	this->rotatingDirectionYs.init(rotatingInstCount);
+	this->rotatingDirectionZs.init(rotatingInstCount);
+	if (rotatingInstCount > 0)
+	{
+		std::copy(this->baseRotatingDirectionXs.get(), this->baseRotatingDirectionXs.end(), this->rotatingDirectionXs.get());
+		std::copy(this->baseRotatingDirectionYs.get(), this->baseRotatingDirectionYs.end(), this->rotatingDirectionYs.get());
+		std::copy(this->baseRotatingDirectionZs.get(), this->baseRotatingDirectionZs.end(), this->rotatingDirectionZs.get());
+	}
+
 	// Populate lightning bolt assets for random selection.
 	const int lightningBoltDefCount = skyInfoDefinition.getLightningCount();
+	this->lightningAnimStart = static_cast<int>(this->animInsts.size());
 	if (lightningBoltDefCount > 0)
 	{
-		this->lightningAnimIndices.init(lightningBoltDefCount);
-
 		for (int i = 0; i < lightningBoltDefCount; i++)
 		{
 			const SkyLightningDefinition &skyLightningDef = skyInfoDefinition.getLightning(i);
@@ -433,13 +466,22 @@ void SkyInstance::init(const SkyDefinition &skyDefinition, const SkyInfoDefiniti
 
 			addGeneralObjectInst(Double3::Zero, width, height, idGroup.getID(0), true);
 			addAnimInst(static_cast<int>(this->objectInsts.size()) - 1, idGroup, skyLightningDef.getAnimationSeconds());
-
-			this->lightningAnimIndices.set(i, static_cast<int>(this->animInsts.size()) - 1);
 		}
 
 		this->lightningStart = this->starEnd;
 		this->lightningEnd = this->lightningStart + lightningBoltDefCount;
 	}
+
+	this->lightningAnimEnd = static_cast<int>(this->animInsts.size());
+
+	// Map each object to its animation so look-ups don't search the animation list.
+	this->objectAnimIndices.init(static_cast<int>(this->objectInsts.size()));
+	this->objectAnimIndices.fill(-1);
+	for (int i = 0; i < static_cast<int>(this->animInsts.size()); i++)
+	{
+		const AnimInstance &animInst = this->animInsts[i];
+		this->objectAnimIndices.set(animInst.objectIndex, i);
+	}
 }
 
 int SkyInstance::getLandStartIndex() const
@@ -514,12 +556,38 @@ bool SkyInstance::isLightningVisible(int objectIndex) const
 	return this->currentLightningBoltObjectIndex == objectIndex;
 }
 
+Double3 SkyInstance::getObjectDirection(int index) const
+{
+	if ((index >= this->moonStart) && (index < this->starEnd))
+	{
+		const int rotatingIndex = index - this->moonStart;
+		return Double3(this->rotatingDirectionXs.get(rotatingIndex), this->rotatingDirectionYs.get(rotatingIndex),
+			this->rotatingDirectionZs.get(rotatingIndex));
+	}
+
+	DebugAssertIndex(this->objectInsts, index);
+	const ObjectInstance &objectInst = this->objectInsts[index];
+	return objectInst.getTransformedDirection();
+}
+
+const SkyInstance::AnimInstance *SkyInstance::tryGetObjectAnim(int index) const
+{
+	const int animIndex = this->objectAnimIndices.get(index);
+	if (animIndex < 0)
+	{
+		return nullptr;
+	}
+
+	DebugAssertIndex(this->animInsts, animIndex);
+	return &this->animInsts[animIndex];
+}
+
 void SkyInstance::getObject(int index, Double3 *outDirection, TextureBuilderID *outTextureBuilderID,
 	bool *outEmissive, double *outWidth, double *outHeight) const
 {
 	DebugAssertIndex(this->objectInsts, index);
 	const ObjectInstance &objectInst = this->objectInsts[index];
-	*outDirection = objectInst.getTransformedDirection();
+	*outDirection = this->getObjectDirection(index);
 
 	DebugAssert(objectInst.getType() == SkyInstance::ObjectInstance::Type::General);
 	const SkyInstance::ObjectInstance::General &generalInst = objectInst.getGeneral();
@@ -535,7 +603,7 @@ void SkyInstance::getObjectSmallStar(int index, Double3 *outDirection, uint8_t *
 {
 	DebugAssertIndex(this->objectInsts, index);
 	const ObjectInstance &objectInst = this->objectInsts[index];
-	*outDirection = objectInst.getTransformedDirection();
+	*outDirection = this->getObjectDirection(index);
 
 	DebugAssert(objectInst.getType() == SkyInstance::ObjectInstance::Type::SmallStar);
 	*outPaletteIndex = objectInst.getSmallStar().paletteIndex;
@@ -544,18 +612,25 @@ void SkyInstance::getObjectSmallStar(int index, Double3 *outDirection, uint8_t *
 	*outHeight = objectInst.getHeight();
 }
 
+void SkyInstance::getStarDirections(BufferView<const double> *outXs, BufferView<const double> *outYs,
+	BufferView<const double> *outZs) const
+{
+	const int starCount = this->starEnd - this->starStart;
+	const int starOffset = this->starStart - this->moonStart;
+	*outXs = BufferView<const double>(this->rotatingDirectionXs.get() + starOffset, starCount);
+	*outYs = BufferView<const double>(this->rotatingDirectionYs.get() + starOffset, starCount);
+	*outZs = BufferView<const double>(this->rotatingDirectionZs.get() + starOffset, starCount);
+}
+
 TextureBuilderIdGroup SkyInstance::getObjectTextureBuilderIDs(int index) const
 {
 	DebugAssert(!this->isObjectSmallStar(index));
 
 	// See if there's an animation with the texture builder IDs.
-	for (int i = 0; i < static_cast<int>(this->animInsts.size()); i++)
+	const SkyInstance::AnimInstance *animInst = this->tryGetObjectAnim(index);
+	if (animInst != nullptr)
 	{
-		const SkyInstance::AnimInstance &animInst = this->animInsts[i];
-		if (animInst.objectIndex == index)
-		{
-			return animInst.textureBuilderIDs;
-		}
+		return animInst->textureBuilderIDs;
 	}
 
 	// Just get the object's texture builder ID directly.
@@ -570,17 +645,13 @@ std::optional<double> SkyInstance::tryGetObjectAnimPercent(int index) const
 	DebugAssert(!this->isObjectSmallStar(index));
 
 	// See if the object has an animation.
-	for (int i = 0; i < static_cast<int>(this->animInsts.size()); i++)
+	const SkyInstance::AnimInstance *animInst = this->tryGetObjectAnim(index);
+	if (animInst == nullptr)
 	{
-		const SkyInstance::AnimInstance &animInst = this->animInsts[i];
-		if (animInst.objectIndex == index)
-		{
-			return animInst.currentSeconds / animInst.targetSeconds;
-		}
+		return std::nullopt;
 	}
 
-	// No animation for the object.
-	return std::nullopt;
+	return animInst->currentSeconds / animInst->targetSeconds;
 }
 
 bool SkyInstance::trySetActive(const std::optional<int> &activeLevelIndex, const MapDefinition &mapDefinition,
@@ -653,7 +724,7 @@ void SkyInstance::update(double dt, double latitude, double daytimePercent, cons
 		const std::optional<WeatherInstance::RainInstance::Thunderstorm> &thunderstorm = rainInst.thunderstorm;
 		if (thunderstorm.has_value() && thunderstorm->active)
 		{
-			DebugAssert(this->lightningAnimIndices.getCount() > 0);
+			DebugAssert(this->lightningAnimEnd > this->lightningAnimStart);
 
 			const std::optional<double> lightningBoltPercent = thunderstorm->getLightningBoltPercent();
 			const bool visibilityChanged = this->currentLightningBoltObjectIndex.has_value() != lightningBoltPercent.has_value();
@@ -672,7 +743,8 @@ void SkyInstance::update(double dt, double latitude, double daytimePercent, cons
 
 			if (lightningBoltPercent.has_value())
 			{
-				const int animInstIndex = this->lightningAnimIndices.get(*this->currentLightningBoltObjectIndex - this->lightningStart);
+				const int animInstIndex = this->lightningAnimStart + (*this->currentLightningBoltObjectIndex - this->lightningStart);
+				DebugAssertIndex(this->animInsts, animInstIndex);
 				AnimInstance &lightningAnimInst = this->animInsts[animInstIndex];
 				lightningAnimInst.currentSeconds = *lightningBoltPercent * lightningAnimInst.targetSeconds;
 			}
@@ -687,35 +759,9 @@ void SkyInstance::update(double dt, double latitude, double daytimePercent, cons
 		}
 	}
 
-	// Update animations.
-	const int animInstCount = static_cast<int>(this->animInsts.size());
-	for (int i = 0; i < animInstCount; i++)
+	// Advances an animation and points its object at the current frame.
+	auto updateAnim = [this, dt](AnimInstance &animInst)
 	{
-		AnimInstance &animInst = this->animInsts[i];
-
-		// Small stars don't have animations.
-		if (this->isObjectSmallStar(animInst.objectIndex))
-		{
-			continue;
-		}
-
-		// Don't update if it's an inactive lightning bolt.
-		const bool isLightningAnim = [this, i]()
-		{
-			if (this->lightningAnimIndices.getCount() == 0)
-			{
-				return false;
-			}
-
-			const auto iter = std::find(this->lightningAnimIndices.get(), this->lightningAnimIndices.end(), i);
-			return iter != this->lightningAnimIndices.end();
-		}();
-
-		if (isLightningAnim && !this->isLightningVisible(animInst.objectIndex))
-		{
-			continue;
-		}
-
 		animInst.currentSeconds += dt;
 		if (animInst.currentSeconds >= animInst.targetSeconds)
 		{
@@ -734,31 +780,32 @@ void SkyInstance::update(double dt, double latitude, double daytimePercent, cons
 		DebugAssert(objectInst.getType() == SkyInstance::ObjectInstance::Type::General);
 		ObjectInstance::General &objectInstGeneral = objectInst.getGeneral();
 		objectInstGeneral.textureBuilderID = newTextureBuilderID;
+	};
+
+	// Update general animations.
+	for (int i = this->generalAnimStart; i < this->generalAnimEnd; i++)
+	{
+		updateAnim(this->animInsts[i]);
+	}
+
+	// Only the visible lightning bolt (if any) is animated.
+	if (this->currentLightningBoltObjectIndex.has_value())
+	{
+		const int animInstIndex = this->lightningAnimStart + (*this->currentLightningBoltObjectIndex - this->lightningStart);
+		DebugAssert(animInstIndex < this->lightningAnimEnd);
+		updateAnim(this->animInsts[animInstIndex]);
 	}
 
 	const Matrix4d timeOfDayRotation = RendererUtils::getTimeOfDayRotation(daytimePercent);
 	const Matrix4d latitudeRotation = RendererUtils::getLatitudeRotation(latitude);
 
-	auto transformObjectsInRange = [this, &timeOfDayRotation, &latitudeRotation](int start, int end)
-	{
-		for (int i = start; i < end; i++)
-		{
-			DebugAssertIndex(this->objectInsts, i);
-			ObjectInstance &objectInst = this->objectInsts[i];
-			const Double3 baseDirection = objectInst.getBaseDirection();
-			Double4 dir(baseDirection.x, baseDirection.y, baseDirection.z, 0.0);
-			dir = timeOfDayRotation * dir;
-			dir = latitudeRotation * dir;
-
-			// @temp: flip X and Z.
-			// @todo: figure out why. Distant stars should rotate counter-clockwise when facing south,
-			// and the sun and moons should rise from the west.
-			objectInst.setTransformedDirection(Double3(-dir.x, dir.y, -dir.z));
-		}
-	};
-
-	// Update transformed sky positions of moons, suns, and stars.
-	transformObjectsInRange(this->moonStart, this->moonEnd);
-	transformObjectsInRange(this->sunStart, this->sunEnd);
-	transformObjectsInRange(this->starStart, this->starEnd);
+	// Rotate all moons, suns, and stars at once.
+	// @temp: flip X and Z.
+	// @todo: figure out why. Distant stars should rotate counter-clockwise when facing south,
+	// and the sun and moons should rise from the west.
+	const Matrix4d rotatingTransform = Matrix4d::scale(-1.0, 1.0, -1.0) * latitudeRotation * timeOfDayRotation;
+	SkyUtils::transformDirections(rotatingTransform, this->baseRotatingDirectionXs.get(),
+		this->baseRotatingDirectionYs.get(), this->baseRotatingDirectionZs.get(),
+		this->baseRotatingDirectionXs.getCount(), this->rotatingDirectionXs.get(),
+		this->rotatingDirectionYs.get(), this->rotatingDirectionZs.get());
 }
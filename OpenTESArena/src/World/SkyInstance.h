@@ -8,6 +8,9 @@
 #include "../Math/Vector3.h"
 #include "../Media/TextureUtils.h"
 
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+
 // Contains distant sky object instances and their state.
 
 // The renderer should only care about 1) current direction, 2) current texture ID, 3) anchor,
@@ -93,11 +96,28 @@ private:
 	};
 
 	std::vector<ObjectInstance> objectInsts; // Each sky object instance.
-	std::vector<AnimInstance> animInsts; // Data for each sky object with an animation.
 	int landStart, landEnd, airStart, airEnd, moonStart, moonEnd, sunStart, sunEnd, starStart, starEnd,
 		lightningStart, lightningEnd;
-	Buffer<int> lightningAnimIndices; // Non-empty during thunderstorm so animations can be updated.
+
+	// Animations are grouped by type. General animations (i.e., land) are always updated, and lightning
+	// animations are in the same order as lightning objects so the active bolt's animation can be found
+	// directly. End indices are exclusive.
+	std::vector<AnimInstance> animInsts;
+	int generalAnimStart, generalAnimEnd, lightningAnimStart, lightningAnimEnd;
+	Buffer<int> objectAnimIndices; // Animation index of each sky object, or -1 if it isn't animated.
 	std::optional<int> currentLightningBoltObjectIndex; // Updated by WeatherInstance.
+
+	// Moons, suns, and stars are contiguous and are the only objects that rotate with the time of day and
+	// latitude, so their directions are packed per component and rotated in one pass. Their object instances
+	// don't store their own transformed direction.
+	Buffer<double> baseRotatingDirectionXs, baseRotatingDirectionYs, baseRotatingDirectionZs;
+	Buffer<double> rotatingDirectionXs, rotatingDirectionYs, rotatingDirectionZs;
+
+	// Gets the animation of a sky object, or null if it isn't animated.
+	const AnimInstance *tryGetObjectAnim(int index) const;
+
+	// Gets the current direction of any sky object.
+	Double3 getObjectDirection(int index) const;
 public:
 	SkyInstance();
 
@@ -132,6 +152,11 @@ public:
 	void getObjectSmallStar(int index, Double3 *outDirection, uint8_t *outPaletteIndex, double *outWidth,
 		double *outHeight) const;
 
+	// Gets the current directions of all stars, indexed relative to the star start index. Intended for
+	// batch processing of the star field.
+	void getStarDirections(BufferView<const double> *outXs, BufferView<const double> *outYs,
+		BufferView<const double> *outZs) const;
+
 	// @todo: this is public for the renderer for now. Remove this once public texture handles are being allocated.
 	// Gets the texture builder ID(s) for a non-small-star object. If it doesn't have an animation then there is only
 	// one ID.
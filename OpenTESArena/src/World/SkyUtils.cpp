@@ -6,6 +6,11 @@
 
 #include "components/debug/Debug.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SKY_UTILS_SSE2
+#endif
+
 int SkyUtils::getOctantIndex(bool posX, bool posY, bool posZ)
 {
 	// Use lowest 3 bits to represent 0-7.
@@ -51,3 +56,51 @@ int SkyUtils::getStarCountFromDensity(int starDensity)
 		DebugUnhandledReturnMsg(int, std::to_string(starDensity));
 	}
 }
+
+void SkyUtils::transformDirections(const Matrix4d &transform, const double *srcXs, const double *srcYs,
+	const double *srcZs, int count, double *dstXs, double *dstYs, double *dstZs)
+{
+	DebugAssert(count >= 0);
+
+	int i = 0;
+
+#if defined(SKY_UTILS_SSE2)
+	// Directions have a W of zero so the translation column is ignored.
+	const __m128d xxs = _mm_set1_pd(transform.x.x);
+	const __m128d xys = _mm_set1_pd(transform.x.y);
+	const __m128d xzs = _mm_set1_pd(transform.x.z);
+	const __m128d yxs = _mm_set1_pd(transform.y.x);
+	const __m128d yys = _mm_set1_pd(transform.y.y);
+	const __m128d yzs = _mm_set1_pd(transform.y.z);
+	const __m128d zxs = _mm_set1_pd(transform.z.x);
+	const __m128d zys = _mm_set1_pd(transform.z.y);
+	const __m128d zzs = _mm_set1_pd(transform.z.z);
+
+	constexpr int stride = sizeof(__m128d) / sizeof(double);
+	for (; i < (count - (stride - 1)); i += stride)
+	{
+		const __m128d xs = _mm_loadu_pd(srcXs + i);
+		const __m128d ys = _mm_loadu_pd(srcYs + i);
+		const __m128d zs = _mm_loadu_pd(srcZs + i);
+
+		const __m128d newXs = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xxs, xs), _mm_mul_pd(yxs, ys)), _mm_mul_pd(zxs, zs));
+		const __m128d newYs = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xys, xs), _mm_mul_pd(yys, ys)), _mm_mul_pd(zys, zs));
+		const __m128d newZs = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xzs, xs), _mm_mul_pd(yzs, ys)), _mm_mul_pd(zzs, zs));
+
+		_mm_storeu_pd(dstXs + i, newXs);
+		_mm_storeu_pd(dstYs + i, newYs);
+		_mm_storeu_pd(dstZs + i, newZs);
+	}
+#endif
+
+	// Remaining directions (or all of them without SIMD).
+	for (; i < count; i++)
+	{
+		const double x = srcXs[i];
+		const double y = srcYs[i];
+		const double z = srcZs[i];
+		dstXs[i] = (transform.x.x * x) + (transform.y.x * y) + (transform.z.x * z);
+		dstYs[i] = (transform.x.y * x) + (transform.y.y * y) + (transform.z.y * z);
+		dstZs[i] = (transform.x.z * x) + (transform.y.z * y) + (transform.z.z * z);
+	}
+}
@@ -3,6 +3,7 @@
 
 #include "VoxelUtils.h"
 #include "../Math/MathUtils.h"
+#include "../Math/Matrix4.h"
 
 namespace SkyUtils
 {
@@ -17,6 +18,11 @@ namespace SkyUtils
 
 	// Gets the number of stars to generate based on the given star density (new to this engine).
 	int getStarCountFromDensity(int starDensity);
+
+	// Transforms directions stored as separate X, Y, and Z arrays by the given matrix, two at a time
+	// when SIMD is available. The source and destination arrays may be the same.
+	void transformDirections(const Matrix4d &transform, const double *srcXs, const double *srcYs,
+		const double *srcZs, int count, double *dstXs, double *dstYs, double *dstZs);
 }
 
 #endif
@@ -35,16 +35,30 @@ namespace
 		return random.nextReal() * Constants::TwoPi;
 	}
 
-	bool MakeSnowflakeDirection(Random &random)
+	double MakeSnowflakeDirectionX(CounterRandom &random)
 	{
-		return (random.next() % 2) != 0;
+		return ((random.next() % 2) != 0) ? 1.0 : -1.0;
 	}
 }
 
-void WeatherInstance::Particle::init(double xPercent, double yPercent)
+void WeatherInstance::Particles::init(int count, uint64_t seed)
 {
-	this->xPercent = xPercent;
-	this->yPercent = yPercent;
+	this->xPercents.init(count);
+	this->yPercents.init(count);
+	this->restarts.init(count);
+	this->restarts.fill(0);
+
+	for (int i = 0; i < count; i++)
+	{
+		CounterRandom particleRandom(seed, i);
+		this->xPercents.set(i, particleRandom.nextReal());
+		this->yPercents.set(i, particleRandom.nextReal());
+	}
+}
+
+int WeatherInstance::Particles::getCount() const
+{
+	return this->xPercents.getCount();
 }
 
 void WeatherInstance::FogInstance::init(Random &random, TextureManager &textureManager)
@@ -113,7 +127,7 @@ void WeatherInstance::RainInstance::Thunderstorm::update(double dt, const Clock
 			this->lightningBoltAngle = MakeLightningBoltAngle(random);
 
 			const std::string &soundFilename = ArenaSoundName::Thunder;
-			audioManager.playSound(soundFilename);
+			audioManager.playSound(soundFilename, std::nullopt, AudioManager::SoundCategory::Ambient);
 		}
 	}
 }
@@ -121,12 +135,7 @@ void WeatherInstance::RainInstance::Thunderstorm::update(double dt, const Clock
 void WeatherInstance::RainInstance::init(bool isThunderstorm, const Clock &clock,
 	Buffer<uint8_t> &&flashColors, Random &random, TextureManager &textureManager)
 {
-	this->particles.init(ArenaWeatherUtils::RAINDROP_TOTAL_COUNT);
-	for (int i = 0; i < this->particles.getCount(); i++)
-	{
-		Particle &particle = this->particles.get(i);
-		particle.init(random.nextReal(), random.nextReal());
-	}
+	this->particles.init(ArenaWeatherUtils::RAINDROP_TOTAL_COUNT, static_cast<uint64_t>(random.next()));
 
 	if (isThunderstorm)
 	{
@@ -142,40 +151,57 @@ void WeatherInstance::RainInstance::init(bool isThunderstorm, const Clock &clock
 void WeatherInstance::RainInstance::update(double dt, const Clock &clock, double aspectRatio,
 	Random &random, AudioManager &audioManager)
 {
-	auto animateRaindropRange = [this, dt, aspectRatio, &random](int startIndex, int endIndex,
+	// Each raindrop that restarts this frame gets its own random stream from this seed, so the result
+	// doesn't depend on the order raindrops are processed in.
+	const uint64_t frameSeed = static_cast<uint64_t>(random.next());
+
+	auto animateRaindropRange = [this, dt, aspectRatio, frameSeed](int startIndex, int endIndex,
 		double velocityPercentX, double velocityPercentY)
 	{
+		double *xPercents = this->particles.xPercents.get();
+		double *yPercents = this->particles.yPercents.get();
+		uint8_t *restarts = this->particles.restarts.get();
+
+		// The particle's horizontal movement is aspect-ratio-dependent.
+		const double aspectRatioMultiplierX = ArenaRenderUtils::ASPECT_RATIO / aspectRatio;
+		const double deltaPercentX = (velocityPercentX * aspectRatioMultiplierX) * dt;
+		const double deltaPercentY = velocityPercentY * dt;
+
+		// Move raindrops that are still on-screen. Branchless so it can be vectorized.
 		for (int i = startIndex; i < endIndex; i++)
 		{
-			Particle &particle = this->particles.get(i);
-			const bool canBeRestarted = (particle.xPercent < 0.0) || (particle.yPercent >= 1.0);
-			if (canBeRestarted)
+			const double xPercent = xPercents[i];
+			const double yPercent = yPercents[i];
+			const bool canBeRestarted = (xPercent < 0.0) || (yPercent >= 1.0);
+			restarts[i] = canBeRestarted ? 1 : 0;
+			xPercents[i] = canBeRestarted ? xPercent : (xPercent + deltaPercentX);
+			yPercents[i] = canBeRestarted ? yPercent : (yPercent + deltaPercentY);
+		}
+
+		// Pick a screen edge to spawn at. This involves the aspect ratio so drops are properly distributed.
+		const double topEdgeLength = aspectRatio;
+		constexpr double rightEdgeLength = 1.0;
+		const double topEdgePercent = topEdgeLength / (topEdgeLength + rightEdgeLength);
+
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			if (restarts[i] == 0)
 			{
-				// Pick a screen edge to spawn at. This involves the aspect ratio so drops are properly distributed.
-				const double topEdgeLength = aspectRatio;
-				constexpr double rightEdgeLength = 1.0;
-				const double topEdgePercent = topEdgeLength / (topEdgeLength + rightEdgeLength);
-				if (random.nextReal() <= topEdgePercent)
-				{
-					// Top edge.
-					particle.xPercent = random.nextReal();
-					particle.yPercent = 0.0;
-				}
-				else
-				{
-					// Right edge.
-					particle.xPercent = 1.0;
-					particle.yPercent = random.nextReal();
-				}
+				continue;
+			}
+
+			CounterRandom particleRandom(frameSeed, i);
+			if (particleRandom.nextReal() <= topEdgePercent)
+			{
+				// Top edge.
+				xPercents[i] = particleRandom.nextReal();
+				yPercents[i] = 0.0;
 			}
 			else
 			{
-				// The particle's horizontal movement is aspect-ratio-dependent.
-				const double aspectRatioMultiplierX = ArenaRenderUtils::ASPECT_RATIO / aspectRatio;
-				const double deltaPercentX = (velocityPercentX * aspectRatioMultiplierX) * dt;
-				const double deltaPercentY = velocityPercentY * dt;
-				particle.xPercent += deltaPercentX;
-				particle.yPercent += deltaPercentY;
+				// Right edge.
+				xPercents[i] = 1.0;
+				yPercents[i] = particleRandom.nextReal();
 			}
 		}
 	};
@@ -216,17 +242,17 @@ void WeatherInstance::RainInstance::update(double dt, const Clock &clock, double
 
 void WeatherInstance::SnowInstance::init(Random &random)
 {
-	this->particles.init(ArenaWeatherUtils::SNOWFLAKE_TOTAL_COUNT);
-	for (int i = 0; i < this->particles.getCount(); i++)
-	{
-		Particle &particle = this->particles.get(i);
-		particle.init(random.nextReal(), random.nextReal());
-	}
+	const uint64_t seed = static_cast<uint64_t>(random.next());
+	this->particles.init(ArenaWeatherUtils::SNOWFLAKE_TOTAL_COUNT, seed);
 
-	this->directions.init(this->particles.getCount());
-	for (int i = 0; i < this->directions.getCount(); i++)
+	// Continue each snowflake's stream from where the particle placement left off.
+	this->directionXs.init(this->particles.getCount());
+	for (int i = 0; i < this->directionXs.getCount(); i++)
 	{
-		this->directions.set(i, MakeSnowflakeDirection(random));
+		CounterRandom particleRandom(seed, i);
+		particleRandom.nextReal();
+		particleRandom.nextReal();
+		this->directionXs.set(i, MakeSnowflakeDirectionX(particleRandom));
 	}
 
 	this->lastDirectionChangeSeconds.init(this->particles.getCount());
@@ -235,53 +261,74 @@ void WeatherInstance::SnowInstance::init(Random &random)
 
 void WeatherInstance::SnowInstance::update(double dt, double aspectRatio, Random &random)
 {
-	auto animateSnowflakeRange = [this, dt, aspectRatio, &random](int startIndex, int endIndex,
+	// Each snowflake gets its own random stream for the frame, so the result doesn't depend on the
+	// order snowflakes are processed in.
+	const uint64_t frameSeed = static_cast<uint64_t>(random.next());
+
+	auto animateSnowflakeRange = [this, dt, aspectRatio, frameSeed](int startIndex, int endIndex,
 		double velocityPercentX, double velocityPercentY)
 	{
+		double *xPercents = this->particles.xPercents.get();
+		double *yPercents = this->particles.yPercents.get();
+		uint8_t *restarts = this->particles.restarts.get();
+		double *directionXs = this->directionXs.get();
+		double *lastDirectionChangeSeconds = this->lastDirectionChangeSeconds.get();
+
+		// The particle's horizontal movement is aspect-ratio-dependent.
+		const double aspectRatioMultiplierX = ArenaRenderUtils::ASPECT_RATIO / aspectRatio;
+
+		// This seems to make snowflakes move at a closer speed to the original game.
+		constexpr double velocityCorrectionX = 0.50;
+
+		const double deltaPercentX = (velocityPercentX * aspectRatioMultiplierX * velocityCorrectionX) * dt;
+		const double deltaPercentY = velocityPercentY * dt;
+		constexpr double directionChangeSeconds = ArenaWeatherUtils::SNOWFLAKE_MIN_SECONDS_BEFORE_DIRECTION_CHANGE;
+
+		// Move snowflakes that are still on-screen and flag ones that can change direction. Branchless so
+		// it can be vectorized.
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			const double xPercent = xPercents[i];
+			const double yPercent = yPercents[i];
+			const bool canBeRestarted = yPercent >= 1.0;
+			const double secondsSinceDirectionChange = lastDirectionChangeSeconds[i] + dt;
+			const bool canChangeDirection = !canBeRestarted && (secondsSinceDirectionChange >= directionChangeSeconds);
+			restarts[i] = canBeRestarted ? 1 : (canChangeDirection ? 2 : 0);
+			lastDirectionChangeSeconds[i] = canBeRestarted ? lastDirectionChangeSeconds[i] : secondsSinceDirectionChange;
+			xPercents[i] = canBeRestarted ? xPercent : (xPercent + (deltaPercentX * directionXs[i]));
+			yPercents[i] = canBeRestarted ? yPercent : (yPercent + deltaPercentY);
+		}
+
+		// Random events. Direction changes apply starting next frame.
 		for (int i = startIndex; i < endIndex; i++)
 		{
-			Particle &particle = this->particles.get(i);
-			const bool canBeRestarted = particle.yPercent >= 1.0;
-			if (canBeRestarted)
+			const uint8_t restart = restarts[i];
+			if (restart == 0)
+			{
+				continue;
+			}
+
+			CounterRandom particleRandom(frameSeed, i);
+			if (restart == 1)
 			{
 				// Pick somewhere on the top edge to spawn.
-				particle.xPercent = random.nextReal();
+				xPercents[i] = particleRandom.nextReal();
 
 				// Don't set Y to 0 since it can result in snowflakes stacking up on the same horizontal
 				// line if multiple ones cross the bottom of the screen on the same frame.
-				particle.yPercent = -(particle.yPercent - 1.0);
+				yPercents[i] = -(yPercents[i] - 1.0);
 
-				this->directions.set(i, MakeSnowflakeDirection(random));
+				directionXs[i] = MakeSnowflakeDirectionX(particleRandom);
 			}
 			else
 			{
-				double &secondsSinceDirectionChange = this->lastDirectionChangeSeconds.get(i);
-				secondsSinceDirectionChange += dt;
-
 				// The snowflake gets a chance to change direction a few times a second.
-				if (secondsSinceDirectionChange >= ArenaWeatherUtils::SNOWFLAKE_MIN_SECONDS_BEFORE_DIRECTION_CHANGE)
-				{
-					secondsSinceDirectionChange = std::fmod(
-						secondsSinceDirectionChange, ArenaWeatherUtils::SNOWFLAKE_MIN_SECONDS_BEFORE_DIRECTION_CHANGE);
+				lastDirectionChangeSeconds[i] = std::fmod(lastDirectionChangeSeconds[i], directionChangeSeconds);
 
-					if (ArenaWeatherUtils::shouldSnowflakeChangeDirection(random))
-					{
-						this->directions.set(i, !this->directions.get(i));
-					}
+				if (ArenaWeatherUtils::shouldSnowflakeChangeDirection(particleRandom))
+				{
+					directionXs[i] = -directionXs[i];
 				}
-
-				const double directionX = this->directions.get(i) ? 1.0 : -1.0;
-
-				// The particle's horizontal movement is aspect-ratio-dependent.
-				const double aspectRatioMultiplierX = ArenaRenderUtils::ASPECT_RATIO / aspectRatio;
-
-				// This seems to make snowflakes move at a closer speed to the original game.
-				constexpr double velocityCorrectionX = 0.50;
-
-				const double deltaPercentX = (velocityPercentX * directionX * aspectRatioMultiplierX * velocityCorrectionX) * dt;
-				const double deltaPercentY = velocityPercentY * dt;
-				particle.xPercent += deltaPercentX;
-				particle.yPercent += deltaPercentY;
 			}
 		}
 	};
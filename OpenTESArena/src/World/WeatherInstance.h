@@ -17,13 +17,20 @@ class WeatherDefinition;
 class WeatherInstance
 {
 public:
-	struct Particle
+	// Rain and snow particles stored per component so they can be updated in bulk.
+	struct Particles
 	{
 		// Percent positions on the screen, where (0, 0) is the top left. This should work for any
 		// resolution/aspect ratio. The particle's anchor is also at the top left.
-		double xPercent, yPercent;
+		Buffer<double> xPercents, yPercents;
 
-		void init(double xPercent, double yPercent);
+		// Set during updates for particles that need a new spawn position.
+		Buffer<uint8_t> restarts;
+
+		// Places each particle randomly on-screen.
+		void init(int count, uint64_t seed);
+
+		int getCount() const;
 	};
 
 	struct FogInstance
@@ -58,7 +65,7 @@ public:
 			void update(double dt, const Clock &clock, Random &random, AudioManager &audioManager);
 		};
 
-		Buffer<Particle> particles;
+		Particles particles;
 		std::optional<Thunderstorm> thunderstorm;
 
 		void init(bool isThunderstorm, const Clock &clock, Buffer<uint8_t> &&flashColors, Random &random,
@@ -69,8 +76,8 @@ public:
 
 	struct SnowInstance
 	{
-		Buffer<Particle> particles;
-		Buffer<bool> directions;
+		Particles particles;
+		Buffer<double> directionXs; // -1 or 1 for left or right.
 		Buffer<double> lastDirectionChangeSeconds;
 
 		void init(Random &random);
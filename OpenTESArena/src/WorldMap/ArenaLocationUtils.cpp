@@ -183,9 +183,8 @@ int ArenaLocationUtils::getMapDistance(const Int2 &globalSrc, const Int2 &global
 	return std::max(dx, dy) + (std::min(dx, dy) / 4);
 }
 
-int ArenaLocationUtils::getTravelDays(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint,
-	int month, const std::array<ArenaTypes::WeatherType, 36> &weathers, ArenaRandom &random,
-	const BinaryAssetLibrary &binaryAssetLibrary)
+int ArenaLocationUtils::getTravelTime(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint,
+	int month, const std::array<ArenaTypes::WeatherType, 36> &weathers, const BinaryAssetLibrary &binaryAssetLibrary)
 {
 	const auto &cityData = binaryAssetLibrary.getCityDataFile();
 
@@ -231,22 +230,30 @@ int ArenaLocationUtils::getTravelDays(const Int2 &startGlobalPoint, const Int2 &
 		totalTime += pixelTravelTime;
 	}
 
-	// Calculate the actual travel days based on the total time.
-	const int travelDays = [&random, totalTime]()
-	{
-		const int minDays = 1;
-		const int maxDays = 2000;
-		int days = std::clamp(totalTime / 100, minDays, maxDays);
+	return totalTime;
+}
 
-		if (days > 20)
-		{
-			days += (random.next() % 10) - 5;
-		}
+int ArenaLocationUtils::getTravelDays(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint,
+	int month, const std::array<ArenaTypes::WeatherType, 36> &weathers, ArenaRandom &random,
+	const BinaryAssetLibrary &binaryAssetLibrary)
+{
+	const int totalTime = ArenaLocationUtils::getTravelTime(startGlobalPoint, endGlobalPoint, month, weathers,
+		binaryAssetLibrary);
+	return ArenaLocationUtils::getTravelDaysFromTime(totalTime, random);
+}
 
-		return days;
-	}();
+int ArenaLocationUtils::getTravelDaysFromTime(int totalTravelTime, ArenaRandom &random)
+{
+	const int minDays = 1;
+	const int maxDays = 2000;
+	int days = std::clamp(totalTravelTime / 100, minDays, maxDays);
+
+	if (days > 20)
+	{
+		days += (random.next() % 10) - 5;
+	}
 
-	return travelDays;
+	return days;
 }
 
 uint32_t ArenaLocationUtils::getCitySeed(int localCityID, const CityDataFile::ProvinceData &province)
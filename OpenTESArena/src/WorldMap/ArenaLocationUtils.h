@@ -70,11 +70,21 @@ namespace ArenaLocationUtils
 	// used to display the distance in kilometers.
 	int getMapDistance(const Int2 &globalSrc, const Int2 &globalDst);
 
+	// Gets the accumulated travel time of each pixel on the Bresenham line between two global points.
+	// Reference implementation; TravelCostMap gives the same results with precomputed lookups.
+	int getTravelTime(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint, int month,
+		const std::array<ArenaTypes::WeatherType, 36> &weathers, const BinaryAssetLibrary &binaryAssetLibrary);
+
 	// Gets the number of days required to travel from one province's local point to another.
+	// Reference implementation; TravelCostMap gives the same results with precomputed lookups.
 	int getTravelDays(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint,
 		int month, const std::array<ArenaTypes::WeatherType, 36> &weathers, ArenaRandom &random,
 		const BinaryAssetLibrary &binaryAssetLibrary);
 
+	// Converts the accumulated pixel travel time of a journey to days, with some randomness for
+	// longer trips.
+	int getTravelDaysFromTime(int totalTravelTime, ArenaRandom &random);
+
 	// Gets the 32-bit seed for a city in the given province.
 	uint32_t getCitySeed(int localCityID, const CityDataFile::ProvinceData &province);
 
@@ -11,11 +11,11 @@ private:
 	std::string nameOverride; // Useful for quest dungeons.
 	int locationDefIndex; // Index in province location definitions.
 	bool visible;
+public:
+	void init(int locationDefIndex, const LocationDefinition &locationDef);
 
 	// Whether the location instance's name overrides the location definition's.
 	bool hasNameOverride() const;
-public:
-	void init(int locationDefIndex, const LocationDefinition &locationDef);
 
 	// Gets the index of the location's definition in its province definition.
 	int getLocationDefIndex() const;
@@ -0,0 +1,390 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+
+#include "LocationNameIndex.h"
+#include "ProvinceDefinition.h"
+
+namespace
+{
+	// Longest string the edit distance is calculated for. Location names are well below this.
+	constexpr int MAX_EDIT_DISTANCE_LENGTH = 32;
+
+	// Most bigrams a single edit (insertion, deletion, substitution, or adjacent transposition) can
+	// remove from a string. A transposition of "ab" in "xaby" changes "xa", "ab", and "by".
+	constexpr int MAX_BIGRAMS_PER_EDIT = 3;
+
+	uint16_t MakeBigram(char first, char second)
+	{
+		return static_cast<uint16_t>((static_cast<unsigned char>(first) << 8) | static_cast<unsigned char>(second));
+	}
+
+	// Gets each distinct bigram in the string with how many times it occurs, sorted by bigram.
+	void GetBigramCounts(const std::string_view &str, std::vector<std::pair<uint16_t, int>> &outCounts)
+	{
+		outCounts.clear();
+		for (size_t i = 1; i < str.size(); i++)
+		{
+			outCounts.emplace_back(MakeBigram(str[i - 1], str[i]), 1);
+		}
+
+		std::sort(outCounts.begin(), outCounts.end());
+
+		// Merge duplicates.
+		size_t writeIndex = 0;
+		for (size_t i = 0; i < outCounts.size(); i++)
+		{
+			if ((writeIndex > 0) && (outCounts[writeIndex - 1].first == outCounts[i].first))
+			{
+				outCounts[writeIndex - 1].second++;
+			}
+			else
+			{
+				outCounts[writeIndex] = outCounts[i];
+				writeIndex++;
+			}
+		}
+
+		outCounts.resize(writeIndex);
+	}
+}
+
+LocationNameIndex::Match::Match(int locationIndex, MatchType type, int distance)
+{
+	this->locationIndex = locationIndex;
+	this->type = type;
+	this->distance = distance;
+}
+
+std::string_view LocationNameIndex::getName(int locationIndex) const
+{
+	const int begin = this->nameOffsets.get(locationIndex);
+	const int end = this->nameOffsets.get(locationIndex + 1);
+	return std::string_view(this->names.data() + begin, end - begin);
+}
+
+void LocationNameIndex::init(const std::vector<std::string> &locationNames)
+{
+	const int locationCount = static_cast<int>(locationNames.size());
+	this->names.clear();
+	this->nameOffsets.init(locationCount + 1);
+
+	std::string key;
+	for (int i = 0; i < locationCount; i++)
+	{
+		LocationNameIndex::makeKey(locationNames[i], key);
+		this->nameOffsets.set(i, static_cast<int>(this->names.size()));
+		this->names.append(key);
+	}
+
+	this->nameOffsets.set(locationCount, static_cast<int>(this->names.size()));
+
+	this->sortedIndices.init(locationCount);
+	for (int i = 0; i < locationCount; i++)
+	{
+		this->sortedIndices.set(i, i);
+	}
+
+	std::sort(this->sortedIndices.get(), this->sortedIndices.end(),
+		[this](int a, int b)
+	{
+		return this->getName(a) < this->getName(b);
+	});
+
+	this->sortedRanks.init(locationCount);
+	for (int i = 0; i < locationCount; i++)
+	{
+		this->sortedRanks.set(this->sortedIndices.get(i), i);
+	}
+
+	// Locations are visited in index order, so a stable sort by bigram keeps them ordered within each one.
+	this->bigramEntries.clear();
+	std::vector<std::pair<uint16_t, int>> bigramCounts;
+	for (int i = 0; i < locationCount; i++)
+	{
+		GetBigramCounts(this->getName(i), bigramCounts);
+		for (const auto &pair : bigramCounts)
+		{
+			this->bigramEntries.push_back(BigramEntry { pair.first, i, pair.second });
+		}
+	}
+
+	std::stable_sort(this->bigramEntries.begin(), this->bigramEntries.end(),
+		[](const BigramEntry &a, const BigramEntry &b)
+	{
+		return a.bigram < b.bigram;
+	});
+}
+
+void LocationNameIndex::init(const ProvinceDefinition &provinceDef)
+{
+	std::vector<std::string> locationNames(provinceDef.getLocationCount());
+	for (int i = 0; i < provinceDef.getLocationCount(); i++)
+	{
+		const LocationDefinition &locationDef = provinceDef.getLocationDef(i);
+		locationNames[i] = locationDef.getName();
+	}
+
+	this->init(locationNames);
+}
+
+int LocationNameIndex::getLocationCount() const
+{
+	return this->sortedIndices.getCount();
+}
+
+void LocationNameIndex::makeKey(const std::string_view &str, std::string &outKey)
+{
+	outKey.resize(str.size());
+	for (size_t i = 0; i < str.size(); i++)
+	{
+		outKey[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(str[i])));
+	}
+}
+
+int LocationNameIndex::getMaxTypoDistance(int queryLength)
+{
+	if (queryLength < 4)
+	{
+		return 0;
+	}
+	else if (queryLength < 8)
+	{
+		return 1;
+	}
+	else
+	{
+		return 2;
+	}
+}
+
+int LocationNameIndex::getEditDistance(const std::string_view &a, const std::string_view &b, int maxDistance)
+{
+	const int aLength = static_cast<int>(a.size());
+	const int bLength = static_cast<int>(b.size());
+	if (std::abs(aLength - bLength) > maxDistance)
+	{
+		return maxDistance + 1;
+	}
+
+	if ((aLength > MAX_EDIT_DISTANCE_LENGTH) || (bLength > MAX_EDIT_DISTANCE_LENGTH))
+	{
+		return maxDistance + 1;
+	}
+
+	// Only the last three rows of the distance matrix are needed for adjacent transpositions.
+	std::array<std::array<int, MAX_EDIT_DISTANCE_LENGTH + 1>, 3> rows;
+	for (int j = 0; j <= bLength; j++)
+	{
+		rows[0][j] = j;
+	}
+
+	for (int i = 1; i <= aLength; i++)
+	{
+		const auto &prevPrevRow = rows[(i + 1) % 3];
+		const auto &prevRow = rows[(i + 2) % 3];
+		auto &row = rows[i % 3];
+		row[0] = i;
+
+		int rowMin = row[0];
+		for (int j = 1; j <= bLength; j++)
+		{
+			const int cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+			int distance = std::min({ prevRow[j] + 1, row[j - 1] + 1, prevRow[j - 1] + cost });
+			if ((i > 1) && (j > 1) && (a[i - 1] == b[j - 2]) && (a[i - 2] == b[j - 1]))
+			{
+				distance = std::min(distance, prevPrevRow[j - 2] + 1);
+			}
+
+			row[j] = distance;
+			rowMin = std::min(rowMin, distance);
+		}
+
+		// Every path through this row already costs too much.
+		if (rowMin > maxDistance)
+		{
+			return maxDistance + 1;
+		}
+	}
+
+	return std::min(rows[aLength % 3][bLength], maxDistance + 1);
+}
+
+bool LocationNameIndex::tryMatchName(const std::string_view &queryKey, const std::string_view &nameKey,
+	MatchType *outType, int *outDistance)
+{
+	*outDistance = 0;
+
+	if (queryKey == nameKey)
+	{
+		*outType = MatchType::Exact;
+		return true;
+	}
+
+	const size_t findIndex = nameKey.find(queryKey);
+	if (findIndex != std::string_view::npos)
+	{
+		*outType = (findIndex == 0) ? MatchType::Prefix : MatchType::Substring;
+		return true;
+	}
+
+	// Typo-tolerant match against the whole name or the start of it, so a mistyped partial name still works.
+	const int queryLength = static_cast<int>(queryKey.size());
+	const int maxDistance = LocationNameIndex::getMaxTypoDistance(queryLength);
+	if (maxDistance == 0)
+	{
+		return false;
+	}
+
+	int bestDistance = LocationNameIndex::getEditDistance(queryKey, nameKey, maxDistance);
+	const int nameLength = static_cast<int>(nameKey.size());
+	const int minPrefixLength = std::max(queryLength - maxDistance, 1);
+	const int maxPrefixLength = std::min(queryLength + maxDistance, nameLength - 1);
+	for (int prefixLength = minPrefixLength; prefixLength <= maxPrefixLength; prefixLength++)
+	{
+		const int distance = LocationNameIndex::getEditDistance(queryKey, nameKey.substr(0, prefixLength), maxDistance);
+		bestDistance = std::min(bestDistance, distance);
+	}
+
+	if (bestDistance > maxDistance)
+	{
+		return false;
+	}
+
+	*outType = MatchType::Approximate;
+	*outDistance = bestDistance;
+	return true;
+}
+
+void LocationNameIndex::sortMatches(std::vector<Match> &matches) const
+{
+	std::sort(matches.begin(), matches.end(),
+		[this](const Match &a, const Match &b)
+	{
+		if (a.type != b.type)
+		{
+			return a.type < b.type;
+		}
+
+		if (a.distance != b.distance)
+		{
+			return a.distance < b.distance;
+		}
+
+		return this->sortedRanks.get(a.locationIndex) < this->sortedRanks.get(b.locationIndex);
+	});
+}
+
+void LocationNameIndex::findMatches(const std::string_view &queryKey, std::vector<Match> &outMatches) const
+{
+	outMatches.clear();
+
+	const int locationCount = this->getLocationCount();
+	const int *sortedBegin = this->sortedIndices.get();
+	const int *sortedEnd = this->sortedIndices.end();
+
+	// Names starting with the query are one contiguous range in sorted order. They're all exact or
+	// prefix matches, and no other name can be.
+	const int *prefixBegin = std::lower_bound(sortedBegin, sortedEnd, queryKey,
+		[this](int locationIndex, const std::string_view &key)
+	{
+		return this->getName(locationIndex) < key;
+	});
+
+	const int *prefixEnd = std::partition_point(prefixBegin, sortedEnd,
+		[this, &queryKey](int locationIndex)
+	{
+		return this->getName(locationIndex).substr(0, queryKey.size()) == queryKey;
+	});
+
+	std::vector<bool> isPrefixMatch(locationCount, false);
+	for (const int *iter = prefixBegin; iter != prefixEnd; ++iter)
+	{
+		const int locationIndex = *iter;
+		const MatchType type = (this->getName(locationIndex) == queryKey) ? MatchType::Exact : MatchType::Prefix;
+		outMatches.emplace_back(locationIndex, type, 0);
+		isPrefixMatch[locationIndex] = true;
+	}
+
+	// A name containing the query shares all of its bigrams, and each allowed typo can only remove a
+	// few of them, so names sharing fewer can't be a substring or approximate match. Comparing against
+	// the start of a name only shares fewer bigrams than the whole name.
+	const int queryLength = static_cast<int>(queryKey.size());
+	const int maxDistance = LocationNameIndex::getMaxTypoDistance(queryLength);
+	const int minSharedBigrams = (queryLength - 1) - (maxDistance * MAX_BIGRAMS_PER_EDIT);
+
+	std::vector<int> sharedBigrams;
+	if (minSharedBigrams > 0)
+	{
+		sharedBigrams.resize(locationCount, 0);
+
+		std::vector<std::pair<uint16_t, int>> queryBigramCounts;
+		GetBigramCounts(queryKey, queryBigramCounts);
+		for (const auto &pair : queryBigramCounts)
+		{
+			const uint16_t bigram = pair.first;
+			const auto entriesRange = std::equal_range(this->bigramEntries.begin(), this->bigramEntries.end(),
+				BigramEntry { bigram, 0, 0 },
+				[](const BigramEntry &a, const BigramEntry &b)
+			{
+				return a.bigram < b.bigram;
+			});
+
+			for (auto iter = entriesRange.first; iter != entriesRange.second; ++iter)
+			{
+				sharedBigrams[iter->locationIndex] += std::min(iter->count, pair.second);
+			}
+		}
+	}
+
+	for (int i = 0; i < locationCount; i++)
+	{
+		if (isPrefixMatch[i])
+		{
+			continue;
+		}
+
+		if ((minSharedBigrams > 0) && (sharedBigrams[i] < minSharedBigrams))
+		{
+			continue;
+		}
+
+		MatchType type;
+		int distance;
+		if (LocationNameIndex::tryMatchName(queryKey, this->getName(i), &type, &distance))
+		{
+			outMatches.emplace_back(i, type, distance);
+		}
+	}
+
+	this->sortMatches(outMatches);
+}
+
+void LocationNameIndex::findMatchesReference(const std::string_view &queryKey, std::vector<Match> &outMatches) const
+{
+	outMatches.clear();
+
+	// Visiting names in sorted order keeps matches of equal quality alphabetical.
+	for (int i = 0; i < this->sortedIndices.getCount(); i++)
+	{
+		const int locationIndex = this->sortedIndices.get(i);
+		MatchType type;
+		int distance;
+		if (LocationNameIndex::tryMatchName(queryKey, this->getName(locationIndex), &type, &distance))
+		{
+			outMatches.emplace_back(locationIndex, type, distance);
+		}
+	}
+
+	std::stable_sort(outMatches.begin(), outMatches.end(),
+		[](const Match &a, const Match &b)
+	{
+		if (a.type != b.type)
+		{
+			return a.type < b.type;
+		}
+
+		return a.distance < b.distance;
+	});
+}
@@ -0,0 +1,86 @@
+#ifndef LOCATION_NAME_INDEX_H
+#define LOCATION_NAME_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "components/utilities/Buffer.h"
+
+class ProvinceDefinition;
+
+// Case-insensitive look-up of a province's location names for the province search. Names are lowercased
+// once and kept in one string. Exact and prefix matches are found by binary search over the names in
+// sorted order. Substring and approximate (small edit distance) matches are found by counting shared
+// letter pairs in a sorted bigram index, and only names sharing enough of them are compared in full.
+
+class LocationNameIndex
+{
+public:
+	// Lower values are better matches.
+	enum class MatchType
+	{
+		Exact,
+		Prefix,
+		Substring,
+		Approximate
+	};
+
+	struct Match
+	{
+		int locationIndex; // Index in province location definitions.
+		MatchType type;
+		int distance; // Edit distance for approximate matches, otherwise 0.
+
+		Match(int locationIndex, MatchType type, int distance);
+	};
+private:
+	// Occurrences of one bigram (two adjacent characters) in one location's name.
+	struct BigramEntry
+	{
+		uint16_t bigram;
+		int locationIndex;
+		int count;
+	};
+
+	std::string names; // All lowercase names back to back.
+	Buffer<int> nameOffsets; // Start of each location's name in the names string, plus one for the end.
+	Buffer<int> sortedIndices; // Location indices sorted by lowercase name.
+	Buffer<int> sortedRanks; // Each location's position in sortedIndices, for ordering matches.
+	std::vector<BigramEntry> bigramEntries; // Sorted by bigram, then location index.
+
+	std::string_view getName(int locationIndex) const;
+
+	// Sorts matches best first, then by name.
+	void sortMatches(std::vector<Match> &matches) const;
+public:
+	void init(const std::vector<std::string> &locationNames);
+	void init(const ProvinceDefinition &provinceDef);
+
+	int getLocationCount() const;
+
+	// Lowercases the given string for comparison with indexed names.
+	static void makeKey(const std::string_view &str, std::string &outKey);
+
+	// Max number of typos allowed for an approximate match with a query of the given length. Short
+	// queries don't get any since almost everything would match.
+	static int getMaxTypoDistance(int queryLength);
+
+	// Gets the optimal string alignment distance between the two strings (insertions, deletions,
+	// substitutions, and adjacent transpositions), or maxDistance + 1 if it's greater than maxDistance.
+	static int getEditDistance(const std::string_view &a, const std::string_view &b, int maxDistance);
+
+	// Classifies how well an already-lowercased query matches a lowercased name. Returns false if
+	// it isn't a match at all.
+	static bool tryMatchName(const std::string_view &queryKey, const std::string_view &nameKey,
+		MatchType *outType, int *outDistance);
+
+	// Finds all locations whose names match the lowercased query, best matches first (then by name).
+	void findMatches(const std::string_view &queryKey, std::vector<Match> &outMatches) const;
+
+	// Linear scan version of findMatches() that tries every name, for verifying it.
+	void findMatchesReference(const std::string_view &queryKey, std::vector<Match> &outMatches) const;
+};
+
+#endif
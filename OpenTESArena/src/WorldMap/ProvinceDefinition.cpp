@@ -124,6 +124,8 @@ void ProvinceDefinition::init(int provinceID, const BinaryAssetLibrary &binaryAs
 		tryAddMainQuestDungeon(std::nullopt, provinceID,
 			LocationDefinition::MainQuestDungeonDefinition::Type::Start, startDungeonLocation);
 	}
+
+	this->locationNameIndex.init(*this);
 }
 
 int ProvinceDefinition::getLocationCount() const
@@ -137,6 +139,11 @@ const LocationDefinition &ProvinceDefinition::getLocationDef(int index) const
 	return this->locations[index];
 }
 
+const LocationNameIndex &ProvinceDefinition::getLocationNameIndex() const
+{
+	return this->locationNameIndex;
+}
+
 const std::string &ProvinceDefinition::getName() const
 {
 	return this->name;
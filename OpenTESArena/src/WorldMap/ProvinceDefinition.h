@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "LocationDefinition.h"
+#include "LocationNameIndex.h"
 #include "../Math/Rect.h"
 
 class BinaryAssetLibrary;
@@ -12,6 +13,7 @@ class ProvinceDefinition
 {
 private:
 	std::vector<LocationDefinition> locations;
+	LocationNameIndex locationNameIndex;
 	std::string name;
 	int globalX, globalY, globalW, globalH; // Province-to-world-map projection.
 	int raceID;
@@ -27,6 +29,9 @@ public:
 	// Gets the location definition at the given index.
 	const LocationDefinition &getLocationDef(int index) const;
 
+	// Gets the search index of location definition names.
+	const LocationNameIndex &getLocationNameIndex() const;
+
 	// Gets the display name of the province.
 	const std::string &getName() const;
 	
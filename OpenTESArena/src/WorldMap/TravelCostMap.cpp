@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "ArenaLocationUtils.h"
+#include "TravelCostMap.h"
+#include "../Assets/BinaryAssetLibrary.h"
+#include "../Math/Random.h"
+#include "../Math/Rect.h"
+
+#include "components/debug/Debug.h"
+
+TravelCostMap::TravelCostMap()
+{
+	for (auto &weatherTimes : this->pixelTravelTimes)
+	{
+		for (auto &terrainTimes : weatherTimes)
+		{
+			terrainTimes.fill(0);
+		}
+	}
+}
+
+void TravelCostMap::init(const BinaryAssetLibrary &binaryAssetLibrary)
+{
+	const auto &cityData = binaryAssetLibrary.getCityDataFile();
+	const auto &worldMapTerrain = binaryAssetLibrary.getWorldMapTerrain();
+
+	this->pixels.init(TravelCostMap::WIDTH, TravelCostMap::HEIGHT);
+	for (int y = 0; y < TravelCostMap::HEIGHT; y++)
+	{
+		for (int x = 0; x < TravelCostMap::WIDTH; x++)
+		{
+			const Int2 point(x, y);
+			const bool inProvince = [&cityData, &point]()
+			{
+				for (int i = 0; i < CityDataFile::PROVINCE_COUNT; i++)
+				{
+					const CityDataFile::ProvinceData &province = cityData.getProvinceData(i);
+					if (province.getGlobalRect().containsInclusive(point))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}();
+
+			Pixel &pixel = this->pixels.get(x, y);
+			pixel.terrainIndex = BinaryAssetLibrary::WorldMapTerrain::getNormalizedIndex(
+				worldMapTerrain.getAt(x, y));
+			pixel.quarterIndex = inProvince ?
+				static_cast<uint8_t>(ArenaLocationUtils::getGlobalQuarter(point, cityData)) : NO_QUARTER;
+		}
+	}
+
+	this->initRunLengths();
+
+	const auto &exeData = binaryAssetLibrary.getExeData();
+	const auto &climateSpeedTables = exeData.locations.climateSpeedTables;
+	const auto &weatherSpeedTables = exeData.locations.weatherSpeedTables;
+	for (int month = 0; month < TravelCostMap::MONTH_COUNT; month++)
+	{
+		for (int weather = 0; weather < TravelCostMap::WEATHER_COUNT; weather++)
+		{
+			for (int terrain = 0; terrain < TravelCostMap::TERRAIN_COUNT; terrain++)
+			{
+				const int climateSpeed = climateSpeedTables[terrain][month];
+				const int weatherSpeed = weatherSpeedTables[terrain][weather];
+
+				// Special case: 0 equals 100.
+				const int weatherMod = (weatherSpeed == 0) ? 100 : weatherSpeed;
+				const int travelSpeed = (climateSpeed * weatherMod) / 100;
+
+				// Combinations that can't be travelled through in the original game are left at zero.
+				const int pixelTravelTime = (travelSpeed > 0) ? (2000 / travelSpeed) : 0;
+				this->pixelTravelTimes[month][weather][terrain] = static_cast<uint16_t>(pixelTravelTime);
+			}
+		}
+	}
+}
+
+void TravelCostMap::initRunLengths()
+{
+	// Built from the far edge of each direction back toward the near edge.
+	auto isSameCost = [this](int x1, int y1, int x2, int y2)
+	{
+		const Pixel &pixel1 = this->pixels.get(x1, y1);
+		const Pixel &pixel2 = this->pixels.get(x2, y2);
+		return (pixel1.terrainIndex == pixel2.terrainIndex) && (pixel1.quarterIndex == pixel2.quarterIndex);
+	};
+
+	auto getNextRunLength = [this](int x, int y, int runDirection)
+	{
+		const Pixel &nextPixel = this->pixels.get(x, y);
+		return static_cast<uint8_t>(std::min(nextPixel.runLengths[runDirection] + 1, 255));
+	};
+
+	for (int y = 0; y < TravelCostMap::HEIGHT; y++)
+	{
+		for (int x = TravelCostMap::WIDTH - 1; x >= 0; x--)
+		{
+			const bool continues = (x < (TravelCostMap::WIDTH - 1)) && isSameCost(x, y, x + 1, y);
+			Pixel &pixel = this->pixels.get(x, y);
+			pixel.runLengths[RUN_POSITIVE_X] = continues ? getNextRunLength(x + 1, y, RUN_POSITIVE_X) : 1;
+		}
+
+		for (int x = 0; x < TravelCostMap::WIDTH; x++)
+		{
+			const bool continues = (x > 0) && isSameCost(x, y, x - 1, y);
+			Pixel &pixel = this->pixels.get(x, y);
+			pixel.runLengths[RUN_NEGATIVE_X] = continues ? getNextRunLength(x - 1, y, RUN_NEGATIVE_X) : 1;
+		}
+	}
+
+	for (int x = 0; x < TravelCostMap::WIDTH; x++)
+	{
+		for (int y = TravelCostMap::HEIGHT - 1; y >= 0; y--)
+		{
+			const bool continues = (y < (TravelCostMap::HEIGHT - 1)) && isSameCost(x, y, x, y + 1);
+			Pixel &pixel = this->pixels.get(x, y);
+			pixel.runLengths[RUN_POSITIVE_Y] = continues ? getNextRunLength(x, y + 1, RUN_POSITIVE_Y) : 1;
+		}
+
+		for (int y = 0; y < TravelCostMap::HEIGHT; y++)
+		{
+			const bool continues = (y > 0) && isSameCost(x, y, x, y - 1);
+			Pixel &pixel = this->pixels.get(x, y);
+			pixel.runLengths[RUN_NEGATIVE_Y] = continues ? getNextRunLength(x, y - 1, RUN_NEGATIVE_Y) : 1;
+		}
+	}
+}
+
+bool TravelCostMap::isValid() const
+{
+	return this->pixels.isValid();
+}
+
+void TravelCostMap::addSpanTravelTime(const Int2 &startPoint, int runDirection, int pixelCount, int month,
+	const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers, int *totalTime) const
+{
+	const Int2 step = [runDirection]()
+	{
+		switch (runDirection)
+		{
+		case RUN_POSITIVE_X:
+			return Int2(1, 0);
+		case RUN_NEGATIVE_X:
+			return Int2(-1, 0);
+		case RUN_POSITIVE_Y:
+			return Int2(0, 1);
+		case RUN_NEGATIVE_Y:
+			return Int2(0, -1);
+		default:
+			DebugUnhandledReturnMsg(Int2, std::to_string(runDirection));
+		}
+	}();
+
+	Int2 point = startPoint;
+	while (pixelCount > 0)
+	{
+		const Pixel &pixel = this->pixels.get(point.x, point.y);
+		DebugAssertMsg(pixel.quarterIndex != NO_QUARTER, "No matching province for global point (" +
+			std::to_string(point.x) + ", " + std::to_string(point.y) + ").");
+		DebugAssertMsg(pixel.terrainIndex < TravelCostMap::TERRAIN_COUNT, "Invalid terrain at global point (" +
+			std::to_string(point.x) + ", " + std::to_string(point.y) + ").");
+
+		const int runLength = std::min(static_cast<int>(pixel.runLengths[runDirection]), pixelCount);
+		const int weatherIndex = static_cast<int>(weathers[pixel.quarterIndex]);
+
+		// Every pixel in the run costs the same until the month changes partway through.
+		int remaining = runLength;
+		while (remaining > 0)
+		{
+			const int monthIndex = (month + (*totalTime / 3000)) % TravelCostMap::MONTH_COUNT;
+			const int pixelTravelTime = this->pixelTravelTimes[monthIndex][weatherIndex][pixel.terrainIndex];
+			if (pixelTravelTime == 0)
+			{
+				break;
+			}
+
+			const int nextMonthTime = ((*totalTime / 3000) + 1) * 3000;
+			const int monthPixelCount = ((nextMonthTime - *totalTime) + (pixelTravelTime - 1)) / pixelTravelTime;
+			const int count = std::min(monthPixelCount, remaining);
+			*totalTime += count * pixelTravelTime;
+			remaining -= count;
+		}
+
+		point = point + (step * runLength);
+		pixelCount -= runLength;
+	}
+}
+
+int TravelCostMap::getTravelTime(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint, int month,
+	const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers) const
+{
+	DebugAssert(this->isValid());
+
+	// Walks the same pixels as MathUtils::bresenhamLine(), but as straight spans. A shallow line moves
+	// one pixel in X every step and a steep one in Y, so the span lengths follow from the error term.
+	const int dx = std::abs(endGlobalPoint.x - startGlobalPoint.x);
+	const int dy = std::abs(endGlobalPoint.y - startGlobalPoint.y);
+	const int dirX = (startGlobalPoint.x < endGlobalPoint.x) ? 1 : -1;
+	const int dirY = (startGlobalPoint.y < endGlobalPoint.y) ? 1 : -1;
+
+	int totalTime = 0;
+	Int2 point = startGlobalPoint;
+	if (dx > dy)
+	{
+		const int runDirection = (dirX > 0) ? RUN_POSITIVE_X : RUN_NEGATIVE_X;
+		int error = dx / 2;
+		int remaining = dx + 1;
+		while (remaining > 0)
+		{
+			// Number of X-only steps before the next diagonal step.
+			const int straightCount = (dy == 0) ? remaining : ((error >= dy) ? (((error - dy) / dy) + 1) : 0);
+			const int spanCount = std::min(straightCount + 1, remaining);
+			this->addSpanTravelTime(point, runDirection, spanCount, month, weathers, &totalTime);
+
+			remaining -= spanCount;
+			point.x += dirX * spanCount;
+			point.y += dirY;
+			error += dx - (dy * (straightCount + 1));
+		}
+	}
+	else
+	{
+		const int runDirection = (dirY > 0) ? RUN_POSITIVE_Y : RUN_NEGATIVE_Y;
+		int error = -dy / 2;
+		int remaining = dy + 1;
+		while (remaining > 0)
+		{
+			// Number of Y-only steps before the next diagonal step.
+			const int straightCount = (dx == 0) ? remaining : ((error <= -dx) ? (((-dx - error) / dx) + 1) : 0);
+			const int spanCount = std::min(straightCount + 1, remaining);
+			this->addSpanTravelTime(point, runDirection, spanCount, month, weathers, &totalTime);
+
+			remaining -= spanCount;
+			point.y += dirY * spanCount;
+			point.x += dirX;
+			error += (dx * (straightCount + 1)) - dy;
+		}
+	}
+
+	return totalTime;
+}
+
+int TravelCostMap::getTravelDays(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint, int month,
+	const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers, ArenaRandom &random) const
+{
+	const int totalTime = this->getTravelTime(startGlobalPoint, endGlobalPoint, month, weathers);
+	return ArenaLocationUtils::getTravelDaysFromTime(totalTime, random);
+}
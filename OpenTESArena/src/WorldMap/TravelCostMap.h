@@ -0,0 +1,80 @@
+#ifndef TRAVEL_COST_MAP_H
+#define TRAVEL_COST_MAP_H
+
+#include <array>
+#include <cstdint>
+
+#include "../Assets/ArenaTypes.h"
+#include "../Math/Vector2.h"
+
+#include "components/utilities/Buffer2D.h"
+
+class ArenaRandom;
+class BinaryAssetLibrary;
+
+// Precomputed world map travel costs so the travel pop-up doesn't have to search province rectangles
+// and index into the climate and weather speed tables for every pixel of a journey. Each world map
+// pixel stores its normalized terrain and global quarter, and the travel time of one pixel is looked
+// up by (month, weather, terrain). Pixels also store how far the same terrain and quarter continue in
+// each direction, so a journey is summed a run of same-cost pixels at a time instead of pixel by pixel.
+// Gives the same results as ArenaLocationUtils::getTravelDays().
+
+class TravelCostMap
+{
+public:
+	static constexpr int WIDTH = 320;
+	static constexpr int HEIGHT = 200;
+	static constexpr int MONTH_COUNT = 12;
+	static constexpr int WEATHER_COUNT = 8;
+	static constexpr int TERRAIN_COUNT = 7;
+	static constexpr int QUARTER_COUNT = 36;
+private:
+	static constexpr uint8_t NO_QUARTER = 0xFF;
+
+	// Directions for same-cost run lengths.
+	static constexpr int RUN_POSITIVE_X = 0;
+	static constexpr int RUN_NEGATIVE_X = 1;
+	static constexpr int RUN_POSITIVE_Y = 2;
+	static constexpr int RUN_NEGATIVE_Y = 3;
+	static constexpr int RUN_DIRECTION_COUNT = 4;
+
+	struct Pixel
+	{
+		uint8_t terrainIndex; // Normalized so sea = 0.
+		uint8_t quarterIndex; // Global quarter for weather look-up, or NO_QUARTER if outside all provinces.
+
+		// Number of pixels starting at this one with the same terrain and quarter in each direction,
+		// capped at 255.
+		std::array<uint8_t, RUN_DIRECTION_COUNT> runLengths;
+	};
+
+	Buffer2D<Pixel> pixels;
+
+	// Travel time of one pixel, indexed by [month][weather][terrain].
+	std::array<std::array<std::array<uint16_t, TERRAIN_COUNT>, WEATHER_COUNT>, MONTH_COUNT> pixelTravelTimes;
+
+	// Counts how far each pixel's terrain and quarter continue in each direction.
+	void initRunLengths();
+
+	// Adds the travel time of a straight span of pixels along the given run direction.
+	void addSpanTravelTime(const Int2 &startPoint, int runDirection, int pixelCount, int month,
+		const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers, int *totalTime) const;
+public:
+	TravelCostMap();
+
+	// Builds the map from the world map terrain, province rectangles, and speed tables.
+	void init(const BinaryAssetLibrary &binaryAssetLibrary);
+
+	bool isValid() const;
+
+	// Gets the accumulated travel time along the line between two global points, starting in the
+	// given month. The month advances as the journey goes on, same as the original game.
+	int getTravelTime(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint, int month,
+		const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers) const;
+
+	// Gets the number of days required to travel between two global points.
+	int getTravelDays(const Int2 &startGlobalPoint, const Int2 &endGlobalPoint, int month,
+		const std::array<ArenaTypes::WeatherType, QUARTER_COUNT> &weathers, ArenaRandom &random) const;
+};
+
+#endif
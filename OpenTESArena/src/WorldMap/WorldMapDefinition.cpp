@@ -11,6 +11,8 @@ void WorldMapDefinition::init(const BinaryAssetLibrary &binaryAssetLibrary)
 		provinceDef.init(i, binaryAssetLibrary);
 		this->provinces.push_back(std::move(provinceDef));
 	}
+
+	this->travelCostMap.init(binaryAssetLibrary);
 }
 
 int WorldMapDefinition::getProvinceCount() const
@@ -39,3 +41,8 @@ bool WorldMapDefinition::tryGetProvinceIndex(const ProvinceDefinition &provinceD
 
 	return false;
 }
+
+const TravelCostMap &WorldMapDefinition::getTravelCostMap() const
+{
+	return this->travelCostMap;
+}
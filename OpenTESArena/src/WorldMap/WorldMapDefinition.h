@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "ProvinceDefinition.h"
+#include "TravelCostMap.h"
 
 class BinaryAssetLibrary;
 
@@ -11,6 +12,7 @@ class WorldMapDefinition
 {
 private:
 	std::vector<ProvinceDefinition> provinces;
+	TravelCostMap travelCostMap;
 public:
 	// Initialize from original game data.
 	void init(const BinaryAssetLibrary &binaryAssetLibrary);
@@ -24,6 +26,9 @@ public:
 
 	// Attempts to get the index of the given province definition in the world map.
 	bool tryGetProvinceIndex(const ProvinceDefinition &provinceDef, int *outProvinceIndex) const;
+
+	// Gets the precomputed travel costs for the world map's pixels.
+	const TravelCostMap &getTravelCostMap() const;
 };
 
 #endif
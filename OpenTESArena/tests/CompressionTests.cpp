@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TestFramework.h"
+#include "../src/Assets/CFAFile.h"
+#include "../src/Assets/Compression.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/Bytes.h"
+#include "components/vfs/manager.hpp"
+
+namespace
+{
+	// Makes a random RLE byte stream that decodes to exactly the given number of bytes.
+	std::vector<uint8_t> MakeRandomRLE(std::mt19937 &rng, int decodedSize)
+	{
+		std::vector<uint8_t> encoded;
+		std::uniform_int_distribution<int> byteDist(0, 255);
+		int o = 0;
+		while (o < decodedSize)
+		{
+			const int maxCount = std::min(128, decodedSize - o);
+			const int count = std::uniform_int_distribution<int>(1, maxCount)(rng);
+			if ((count >= 2) && (byteDist(rng) < 128))
+			{
+				encoded.push_back(static_cast<uint8_t>(0x7F + count));
+				encoded.push_back(static_cast<uint8_t>(byteDist(rng)));
+			}
+			else
+			{
+				encoded.push_back(static_cast<uint8_t>(count - 1));
+				for (int i = 0; i < count; i++)
+				{
+					encoded.push_back(static_cast<uint8_t>(byteDist(rng)));
+				}
+			}
+
+			o += count;
+		}
+
+		return encoded;
+	}
+
+	// Makes a random RLE word stream that decodes to exactly the given number of words.
+	std::vector<uint8_t> MakeRandomRLEWords(std::mt19937 &rng, int decodedWordCount)
+	{
+		std::vector<uint8_t> encoded;
+		std::uniform_int_distribution<int> byteDist(0, 255);
+		auto pushWord = [&encoded](int value)
+		{
+			encoded.push_back(static_cast<uint8_t>(value & 0xFF));
+			encoded.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+		};
+
+		int o = 0;
+		while (o < decodedWordCount)
+		{
+			const int maxCount = std::min(300, decodedWordCount - o);
+			const int count = std::uniform_int_distribution<int>(1, maxCount)(rng);
+			if (byteDist(rng) < 128)
+			{
+				// Repeated word, sometimes with both bytes equal (the memset path).
+				pushWord(-count);
+				const int lowByte = byteDist(rng);
+				const int highByte = (byteDist(rng) < 64) ? lowByte : byteDist(rng);
+				encoded.push_back(static_cast<uint8_t>(lowByte));
+				encoded.push_back(static_cast<uint8_t>(highByte));
+			}
+			else
+			{
+				pushWord(count);
+				for (int i = 0; i < count * 2; i++)
+				{
+					encoded.push_back(static_cast<uint8_t>(byteDist(rng)));
+				}
+			}
+
+			o += count;
+		}
+
+		return encoded;
+	}
+
+	// Number of pixels per line the CFA per-group demuxers produced before demuxLine() existed.
+	int GetReferenceCfaPixelCount(int bitsPerPixel, int widthCompressed, int widthUncompressed)
+	{
+		const bool isFourPixelGroup = (bitsPerPixel == 2) || (bitsPerPixel == 4) || (bitsPerPixel == 6);
+		const int groupPixelCount = isFourPixelGroup ? 4 : 8;
+		const int groupByteCount = (groupPixelCount * bitsPerPixel) / 8;
+		const int groupCount = (widthCompressed + groupByteCount - 1) / groupByteCount;
+		return std::min(widthUncompressed, groupCount * groupPixelCount);
+	}
+
+	bool ReadDataFile(const std::string &filename, Buffer<std::byte> &dst)
+	{
+		return VFS::Manager::get().readCaseInsensitive(filename.c_str(), &dst);
+	}
+
+	// Decodes every CFA with the reference decoders and compares against CFAFile.
+	void CheckCfaFile(const std::string &filename)
+	{
+		Buffer<std::byte> src;
+		REQUIRE(ReadDataFile(filename, src));
+		const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+
+		const int widthUncompressed = Bytes::getLE16(srcPtr);
+		const int height = Bytes::getLE16(srcPtr + 2);
+		const int widthCompressed = Bytes::getLE16(srcPtr + 4);
+		const int bitsPerPixel = *(srcPtr + 10);
+		const int frameCount = *(srcPtr + 11);
+		const int headerSize = Bytes::getLE16(srcPtr + 12);
+		const uint8_t *lookUpTable = srcPtr + 76;
+
+		// Same buffer sizing as CFAFile::init().
+		const int stopCount = widthCompressed * height * frameCount;
+		const size_t decompSize = (stopCount * sizeof(uint32_t)) + (widthUncompressed * 16);
+		std::vector<uint8_t> decomp(decompSize, 0);
+		std::vector<uint8_t> decompReference(decompSize, 0);
+		Compression::decodeRLE(srcPtr + headerSize, stopCount, decomp.data(), static_cast<int>(decomp.size()));
+		Compression::decodeRLEReference(srcPtr + headerSize, stopCount, decompReference.data(),
+			static_cast<int>(decompReference.size()));
+		CHECK_MSG(decomp == decompReference, filename);
+
+		CFAFile cfa;
+		REQUIRE(cfa.init(filename.c_str()));
+		REQUIRE(cfa.getImageCount() == frameCount);
+		REQUIRE(cfa.getWidth() == widthUncompressed);
+		REQUIRE(cfa.getHeight() == height);
+
+		const int pixelCount = (bitsPerPixel == 8) ? widthCompressed :
+			GetReferenceCfaPixelCount(bitsPerPixel, widthCompressed, widthUncompressed);
+
+		// Zero-padded line like the original scratch buffer so trailing group bytes are defined.
+		std::vector<uint8_t> encoded(widthUncompressed + 16, 0);
+		std::vector<uint8_t> referenceLine(widthUncompressed + 16, 0);
+		int offset = 0;
+		for (int i = 0; i < frameCount; i++)
+		{
+			const uint8_t *pixels = cfa.getPixels(i);
+			for (int y = 0; y < height; y++)
+			{
+				std::copy(decompReference.begin() + offset, decompReference.begin() + offset + widthCompressed,
+					encoded.begin());
+
+				if (bitsPerPixel == 8)
+				{
+					std::copy(encoded.begin(), encoded.begin() + widthCompressed, referenceLine.begin());
+				}
+				else
+				{
+					CFAFile::demuxLineReference(encoded.data(), bitsPerPixel, pixelCount, lookUpTable,
+						referenceLine.data());
+				}
+
+				const uint8_t *line = pixels + (y * widthUncompressed);
+				const bool isLineEqual = std::equal(line, line + pixelCount, referenceLine.begin());
+				CHECK_MSG(isLineEqual, filename + " frame " + std::to_string(i) + " line " + std::to_string(y));
+				if (!isLineEqual)
+				{
+					return;
+				}
+
+				offset += widthCompressed;
+			}
+		}
+	}
+
+	void CheckDfaFile(const std::string &filename)
+	{
+		Buffer<std::byte> src;
+		REQUIRE(ReadDataFile(filename, src));
+		const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+
+		const int width = Bytes::getLE16(srcPtr + 6);
+		const int height = Bytes::getLE16(srcPtr + 8);
+		std::vector<uint8_t> decoded(width * height, 0);
+		std::vector<uint8_t> decodedReference(width * height, 0);
+		Compression::decodeRLE(srcPtr + 12, width * height, decoded.data(), static_cast<int>(decoded.size()));
+		Compression::decodeRLEReference(srcPtr + 12, width * height, decodedReference.data(),
+			static_cast<int>(decodedReference.size()));
+		CHECK_MSG(decoded == decodedReference, filename);
+	}
+
+	void CheckCifFile(const std::string &filename)
+	{
+		Buffer<std::byte> src;
+		REQUIRE(ReadDataFile(filename, src));
+		const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+		const uint8_t *srcEnd = reinterpret_cast<const uint8_t*>(src.end());
+
+		// Only type 2 .CIFs are RLE-compressed. Raw ones (no header) are too short or fail the
+		// frame length check below.
+		constexpr int headerSize = 12;
+		if ((src.getCount() < headerSize) || ((Bytes::getLE16(srcPtr + 8) & 0x00FF) != 0x0002))
+		{
+			return;
+		}
+
+		int offset = 0;
+		while ((srcPtr + offset + headerSize) <= srcEnd)
+		{
+			const uint8_t *header = srcPtr + offset;
+			const int width = Bytes::getLE16(header + 4);
+			const int height = Bytes::getLE16(header + 6);
+			const int len = Bytes::getLE16(header + 10);
+			if ((header + headerSize + len) > srcEnd)
+			{
+				break;
+			}
+
+			std::vector<uint8_t> decoded(width * height, 0);
+			std::vector<uint8_t> decodedReference(width * height, 0);
+			Compression::decodeRLE(header + headerSize, width * height, decoded.data(),
+				static_cast<int>(decoded.size()));
+			Compression::decodeRLEReference(header + headerSize, width * height, decodedReference.data(),
+				static_cast<int>(decodedReference.size()));
+			CHECK_MSG(decoded == decodedReference, filename + " offset " + std::to_string(offset));
+
+			offset += headerSize + len;
+		}
+	}
+
+	void CheckRmdFile(const std::string &filename)
+	{
+		Buffer<std::byte> src;
+		REQUIRE(ReadDataFile(filename, src));
+		const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.get());
+
+		const int uncompLen = Bytes::getLE16(srcPtr);
+		if (uncompLen == 0)
+		{
+			// Uncompressed.
+			return;
+		}
+
+		std::vector<uint8_t> decoded(uncompLen * 2, 0);
+		std::vector<uint8_t> decodedReference(uncompLen * 2, 0);
+		Compression::decodeRLEWords(srcPtr + 2, uncompLen, decoded);
+		Compression::decodeRLEWordsReference(srcPtr + 2, uncompLen, decodedReference);
+		CHECK_MSG(decoded == decodedReference, filename);
+	}
+}
+
+TEST_CASE(DecodeRLEMatchesReferenceFuzz)
+{
+	std::mt19937 rng(39);
+	for (int iteration = 0; iteration < 20000; iteration++)
+	{
+		const int decodedSize = std::uniform_int_distribution<int>(1, 4096)(rng);
+		const std::vector<uint8_t> encoded = MakeRandomRLE(rng, decodedSize);
+
+		std::vector<uint8_t> decoded(decodedSize, 0xCD);
+		std::vector<uint8_t> decodedReference(decodedSize, 0xCD);
+		Compression::decodeRLE(encoded.data(), decodedSize, decoded.data(), decodedSize);
+		Compression::decodeRLEReference(encoded.data(), decodedSize, decodedReference.data(), decodedSize);
+		REQUIRE(decoded == decodedReference);
+	}
+}
+
+TEST_CASE(DecodeRLEWordsMatchesReferenceFuzz)
+{
+	std::mt19937 rng(3939);
+	for (int iteration = 0; iteration < 20000; iteration++)
+	{
+		const int decodedWordCount = std::uniform_int_distribution<int>(1, 4096)(rng);
+		const std::vector<uint8_t> encoded = MakeRandomRLEWords(rng, decodedWordCount);
+
+		std::vector<uint8_t> decoded(decodedWordCount * 2, 0xCD);
+		std::vector<uint8_t> decodedReference(decodedWordCount * 2, 0xCD);
+		Compression::decodeRLEWords(encoded.data(), decodedWordCount, decoded);
+		Compression::decodeRLEWordsReference(encoded.data(), decodedWordCount, decodedReference);
+		REQUIRE(decoded == decodedReference);
+	}
+}
+
+TEST_CASE(DecodeRLEWordsStopsOnOverflowingRun)
+{
+	// A literal run of 4 words, then a repeat run of 4 words that doesn't fit in the 6-word output.
+	const uint8_t literalThenRepeat[] = { 0x04, 0x00, 1, 2, 3, 4, 5, 6, 7, 8, 0xFC, 0xFF, 9, 9 };
+	std::vector<uint8_t> decoded(12, 0);
+	Compression::decodeRLEWords(literalThenRepeat, 8, decoded);
+
+	const std::vector<uint8_t> expected = { 1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0 };
+	CHECK(decoded == expected);
+
+	// A literal run longer than the whole output.
+	std::fill(decoded.begin(), decoded.end(), 0);
+	const uint8_t longLiteral[] = { 0x07, 0x00, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 };
+	Compression::decodeRLEWords(longLiteral, 7, decoded);
+	CHECK(std::all_of(decoded.begin(), decoded.end(), [](uint8_t value) { return value == 0; }));
+}
+
+TEST_CASE(CFADemuxLineMatchesReferenceFuzz)
+{
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+
+	std::vector<uint8_t> lookUpTable(256);
+	for (uint8_t &value : lookUpTable)
+	{
+		value = static_cast<uint8_t>(byteDist(rng));
+	}
+
+	for (int iteration = 0; iteration < 20000; iteration++)
+	{
+		const int bitsPerPixel = std::uniform_int_distribution<int>(1, 7)(rng);
+		const int count = std::uniform_int_distribution<int>(1, 320)(rng);
+
+		// Enough for the reference's last whole group plus the one-byte read past the last index.
+		std::vector<uint8_t> src(((count * bitsPerPixel) / 8) + 16);
+		for (uint8_t &value : src)
+		{
+			value = static_cast<uint8_t>(byteDist(rng));
+		}
+
+		std::vector<uint8_t> line(count, 0);
+		std::vector<uint8_t> lineReference(count, 0);
+		CFAFile::demuxLine(src.data(), bitsPerPixel, count, lookUpTable.data(), line.data());
+		CFAFile::demuxLineReference(src.data(), bitsPerPixel, count, lookUpTable.data(), lineReference.data());
+		REQUIRE(line == lineReference);
+	}
+}
+
+TEST_CASE(CompressedAssetsMatchReference)
+{
+	TestFramework::initVfsOrSkip();
+
+	const std::vector<std::string> cfaFilenames = TestFramework::listDataFiles("CFA");
+	const std::vector<std::string> dfaFilenames = TestFramework::listDataFiles("DFA");
+	const std::vector<std::string> cifFilenames = TestFramework::listDataFiles("CIF");
+	const std::vector<std::string> rmdFilenames = TestFramework::listDataFiles("RMD");
+	CHECK(!cfaFilenames.empty());
+	CHECK(!rmdFilenames.empty());
+
+	for (const std::string &filename : cfaFilenames)
+	{
+		CheckCfaFile(filename);
+	}
+
+	for (const std::string &filename : dfaFilenames)
+	{
+		CheckDfaFile(filename);
+	}
+
+	for (const std::string &filename : cifFilenames)
+	{
+		CheckCifFile(filename);
+	}
+
+	for (const std::string &filename : rmdFilenames)
+	{
+		CheckRmdFile(filename);
+	}
+}
+
+BENCHMARK_CASE(RLEDecodeThroughput)
+{
+	constexpr int decodedSize = 1 << 20;
+	constexpr int iterations = 64;
+
+	std::mt19937 rng(1);
+	const std::vector<uint8_t> encoded = MakeRandomRLE(rng, decodedSize);
+	const std::vector<uint8_t> encodedWords = MakeRandomRLEWords(rng, decodedSize / 2);
+	std::vector<uint8_t> decoded(decodedSize);
+
+	auto time = [](auto &&func)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			func();
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(endTime - startTime).count();
+	};
+
+	const double totalBytes = static_cast<double>(decodedSize) * iterations;
+	TestFramework::reportBenchmark("decodeRLE", time([&]()
+	{
+		Compression::decodeRLE(encoded.data(), decodedSize, decoded.data(), decodedSize);
+	}), totalBytes, "B");
+
+	TestFramework::reportBenchmark("decodeRLEReference", time([&]()
+	{
+		Compression::decodeRLEReference(encoded.data(), decodedSize, decoded.data(), decodedSize);
+	}), totalBytes, "B");
+
+	TestFramework::reportBenchmark("decodeRLEWords", time([&]()
+	{
+		Compression::decodeRLEWords(encodedWords.data(), decodedSize / 2, decoded);
+	}), totalBytes, "B");
+
+	TestFramework::reportBenchmark("decodeRLEWordsReference", time([&]()
+	{
+		Compression::decodeRLEWordsReference(encodedWords.data(), decodedSize / 2, decoded);
+	}), totalBytes, "B");
+}
+
+BENCHMARK_CASE(CFADemuxThroughput)
+{
+	constexpr int lineWidth = 320;
+	constexpr int lineCount = 1 << 14;
+
+	std::mt19937 rng(2);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+	std::vector<uint8_t> lookUpTable(256);
+	std::vector<uint8_t> src(lineWidth + 16);
+	for (uint8_t &value : lookUpTable)
+	{
+		value = static_cast<uint8_t>(byteDist(rng));
+	}
+
+	for (uint8_t &value : src)
+	{
+		value = static_cast<uint8_t>(byteDist(rng));
+	}
+
+	std::vector<uint8_t> dst(lineWidth);
+	const double totalPixels = static_cast<double>(lineWidth) * lineCount;
+	for (int bitsPerPixel = 1; bitsPerPixel <= 7; bitsPerPixel++)
+	{
+		using DemuxFunction = void(*)(const uint8_t*, int, int, const uint8_t*, uint8_t*);
+		auto time = [&](DemuxFunction demux)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < lineCount; i++)
+			{
+				demux(src.data(), bitsPerPixel, lineWidth, lookUpTable.data(), dst.data());
+			}
+
+			const auto endTime = std::chrono::steady_clock::now();
+			return std::chrono::duration<double>(endTime - startTime).count();
+		};
+
+		const std::string bppString = std::to_string(bitsPerPixel) + " bpp";
+		TestFramework::reportBenchmark("demuxLine " + bppString, time(CFAFile::demuxLine), totalPixels, "px");
+		TestFramework::reportBenchmark("demuxLineReference " + bppString, time(CFAFile::demuxLineReference),
+			totalPixels, "px");
+	}
+}
+
+BENCHMARK_CASE(CFAAssetDecodeThroughput)
+{
+	TestFramework::initVfsOrSkip();
+
+	const std::vector<std::string> cfaFilenames = TestFramework::listDataFiles("CFA");
+	double totalPixels = 0.0;
+	const auto startTime = std::chrono::steady_clock::now();
+	for (const std::string &filename : cfaFilenames)
+	{
+		CFAFile cfa;
+		if (cfa.init(filename.c_str()))
+		{
+			totalPixels += static_cast<double>(cfa.getWidth()) * cfa.getHeight() * cfa.getImageCount();
+		}
+	}
+
+	const auto endTime = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+	TestFramework::reportBenchmark("CFAFile::init (" + std::to_string(cfaFilenames.size()) + " files)",
+		seconds, totalPixels, "px");
+}
@@ -0,0 +1,221 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestFramework.h"
+#include "components/debug/Debug.h"
+
+namespace
+{
+	constexpr int DebugStressThreadCount = 8;
+	constexpr int DebugStressMessageCount = 2000; // Per thread and flooding site.
+
+	// Sites 0 to 3 are flooded by every thread, site 4 only gets one message per thread.
+	constexpr int DebugStressFloodSiteCount = 4;
+	constexpr int DebugStressQuietSite = DebugStressFloodSiteCount;
+	constexpr int DebugStressSiteCount = DebugStressFloodSiteCount + 1;
+
+	// Each case is its own call site as far as the rate limit is concerned.
+	void LogFromSite(int site, const std::string &text)
+	{
+		switch (site)
+		{
+		case 0:
+			DebugLog(text);
+			break;
+		case 1:
+			DebugLogWarning(text);
+			break;
+		case 2:
+			DebugLogError(text);
+			break;
+		case 3:
+			DebugLogWarning(text);
+			break;
+		case DebugStressQuietSite:
+			DebugLog(text);
+			break;
+		default:
+			break;
+		}
+	}
+
+	std::string MakeStressText(int site, int thread, int index)
+	{
+		return "stress s" + std::to_string(site) + " t" + std::to_string(thread) + " n" + std::to_string(index);
+	}
+
+	// A line from this file in the log, i.e. "[tests/DebugTests.cpp(29)] Warning: stress s1 t0 n5".
+	struct LoggedLine
+	{
+		int lineNumber;
+		int site; // -1 for summaries.
+		int thread, index;
+		int suppressedCount;
+	};
+
+	std::vector<LoggedLine> ReadLoggedLines(const std::filesystem::path &logPath)
+	{
+		const std::string prefix = "[" + Debug::getShorterPath(DebugShortFile) + "(";
+		const std::string summaryPrefix = "(Suppressed ";
+
+		std::vector<LoggedLine> lines;
+		std::ifstream stream(logPath);
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			if (line.compare(0, prefix.size(), prefix) != 0)
+			{
+				continue;
+			}
+
+			const size_t lineNumberEnd = line.find(")] ", prefix.size());
+			if (lineNumberEnd == std::string::npos)
+			{
+				continue;
+			}
+
+			LoggedLine loggedLine;
+			loggedLine.lineNumber = std::stoi(line.substr(prefix.size(), lineNumberEnd - prefix.size()));
+			loggedLine.site = -1;
+			loggedLine.thread = -1;
+			loggedLine.index = -1;
+			loggedLine.suppressedCount = 0;
+
+			const size_t summaryIndex = line.find(summaryPrefix, lineNumberEnd);
+			const size_t stressIndex = line.find("stress s", lineNumberEnd);
+			if (summaryIndex != std::string::npos)
+			{
+				loggedLine.suppressedCount = std::stoi(line.substr(summaryIndex + summaryPrefix.size()));
+			}
+			else if (stressIndex != std::string::npos)
+			{
+				const size_t threadIndex = line.find(" t", stressIndex + 8);
+				const size_t indexIndex = line.find(" n", threadIndex);
+				loggedLine.site = std::stoi(line.substr(stressIndex + 8));
+				loggedLine.thread = std::stoi(line.substr(threadIndex + 2));
+				loggedLine.index = std::stoi(line.substr(indexIndex + 2));
+			}
+			else
+			{
+				continue;
+			}
+
+			lines.push_back(loggedLine);
+		}
+
+		return lines;
+	}
+}
+
+TEST_CASE(DebugLogRateLimitsEachCallSiteUnderContention)
+{
+	const std::filesystem::path folderPath = std::filesystem::temp_directory_path() / "TESArenaTests_Debug";
+	std::filesystem::create_directories(folderPath);
+	const std::filesystem::path logPath = folderPath / "log.txt";
+	REQUIRE(Debug::initLogFile(folderPath.string() + "/"));
+
+	const auto startTime = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < DebugStressThreadCount; thread++)
+	{
+		threads.emplace_back([thread]()
+		{
+			for (int index = 0; index < DebugStressMessageCount; index++)
+			{
+				for (int site = 0; site < DebugStressFloodSiteCount; site++)
+				{
+					LogFromSite(site, MakeStressText(site, thread, index));
+				}
+			}
+
+			LogFromSite(DebugStressQuietSite, MakeStressText(DebugStressQuietSite, thread, 0));
+		});
+	}
+
+	for (std::thread &thread : threads)
+	{
+		thread.join();
+	}
+
+	const auto endTime = std::chrono::steady_clock::now();
+	Debug::flush();
+
+	// Every site has written at least one message before any summary of it, so summaries can be matched
+	// to their site by line number.
+	const std::vector<LoggedLine> lines = ReadLoggedLines(logPath);
+	std::map<int, int> lineNumberSites;
+	std::vector<int> writtenCounts(DebugStressSiteCount, 0);
+	std::vector<int> suppressedCounts(DebugStressSiteCount, 0);
+	std::vector<int> summaryCounts(DebugStressSiteCount, 0);
+	std::vector<std::vector<int>> lastIndices(DebugStressSiteCount, std::vector<int>(DebugStressThreadCount, -1));
+	for (const LoggedLine &line : lines)
+	{
+		if (line.site >= 0)
+		{
+			REQUIRE((line.site < DebugStressSiteCount) && (line.thread >= 0) && (line.thread < DebugStressThreadCount));
+			lineNumberSites.emplace(line.lineNumber, line.site);
+			writtenCounts[line.site]++;
+
+			// Each thread's messages from one site stay in the order they were logged.
+			int &lastIndex = lastIndices[line.site][line.thread];
+			CHECK_MSG(line.index > lastIndex, MakeStressText(line.site, line.thread, line.index));
+			lastIndex = line.index;
+		}
+		else
+		{
+			const auto iter = lineNumberSites.find(line.lineNumber);
+			REQUIRE(iter != lineNumberSites.end());
+			suppressedCounts[iter->second] += line.suppressedCount;
+			summaryCounts[iter->second]++;
+		}
+	}
+
+	// Windows start at a site's first message, so no more than this many can fit in the time it took.
+	const double elapsedSeconds = std::chrono::duration<double>(endTime - startTime).count();
+	const double windowSeconds = static_cast<double>(Debug::RATE_LIMIT_WINDOW_MILLISECONDS) / 1000.0;
+	const int maxWindowCount = static_cast<int>(elapsedSeconds / windowSeconds) + 1;
+
+	for (int site = 0; site < DebugStressFloodSiteCount; site++)
+	{
+		const std::string siteName = "site " + std::to_string(site) + ", " + std::to_string(writtenCounts[site]) +
+			" written, " + std::to_string(suppressedCounts[site]) + " suppressed";
+
+		// Nothing is lost, only counted instead of written.
+		CHECK_MSG((writtenCounts[site] + suppressedCounts[site]) == (DebugStressThreadCount * DebugStressMessageCount),
+			siteName);
+		CHECK_MSG(writtenCounts[site] >= Debug::RATE_LIMIT_COUNT, siteName);
+		CHECK_MSG(writtenCounts[site] <= (Debug::RATE_LIMIT_COUNT * maxWindowCount), siteName);
+		CHECK_MSG((summaryCounts[site] > 0) && (summaryCounts[site] <= maxWindowCount), siteName);
+	}
+
+	// The flooding doesn't crowd out a site under its limit.
+	CHECK(writtenCounts[DebugStressQuietSite] == DebugStressThreadCount);
+	CHECK(summaryCounts[DebugStressQuietSite] == 0);
+
+	// Once the window has passed, the same site is written again. The flush above already summarized
+	// everything suppressed so far, so only the one over the limit here gets a summary.
+	std::this_thread::sleep_for(std::chrono::milliseconds(Debug::RATE_LIMIT_WINDOW_MILLISECONDS + 50));
+	for (int index = 0; index <= Debug::RATE_LIMIT_COUNT; index++)
+	{
+		LogFromSite(0, MakeStressText(0, 0, DebugStressMessageCount + index));
+	}
+
+	Debug::flush();
+
+	const std::vector<LoggedLine> newLines = ReadLoggedLines(logPath);
+	REQUIRE(newLines.size() == (lines.size() + Debug::RATE_LIMIT_COUNT + 1));
+	for (int index = 0; index < Debug::RATE_LIMIT_COUNT; index++)
+	{
+		const LoggedLine &line = newLines[lines.size() + index];
+		CHECK((line.site == 0) && (line.thread == 0) && (line.index == (DebugStressMessageCount + index)));
+	}
+
+	const LoggedLine &summaryLine = newLines.back();
+	CHECK((summaryLine.site == -1) && (summaryLine.suppressedCount == 1));
+	CHECK(lineNumberSites[summaryLine.lineNumber] == 0);
+}
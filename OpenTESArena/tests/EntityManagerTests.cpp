@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "TestFramework.h"
+#include "../src/Entities/DynamicEntity.h"
+#include "../src/Entities/EntityManager.h"
+#include "../src/Entities/EntityType.h"
+
+namespace
+{
+	// What the entity manager should contain, tracked the slow way.
+	struct ModelEntity
+	{
+		EntityType type;
+		DynamicEntityType dynamicType;
+		ChunkInt2 chunk;
+	};
+
+	struct Model
+	{
+		std::vector<ChunkInt2> chunks; // Same order as the entity manager's chunks.
+		std::unordered_map<EntityID, ModelEntity> entities;
+
+		int countIf(const ChunkInt2 *chunk, const EntityType *type, const DynamicEntityType *dynamicType) const
+		{
+			int count = 0;
+			for (const auto &pair : this->entities)
+			{
+				const ModelEntity &entity = pair.second;
+				if ((chunk != nullptr) && (entity.chunk != *chunk))
+				{
+					continue;
+				}
+
+				if ((type != nullptr) && (entity.type != *type))
+				{
+					continue;
+				}
+
+				if ((dynamicType != nullptr) &&
+					((entity.type != EntityType::Dynamic) || (entity.dynamicType != *dynamicType)))
+				{
+					continue;
+				}
+
+				count++;
+			}
+
+			return count;
+		}
+	};
+
+	constexpr EntityType EntityTypes[] = { EntityType::Static, EntityType::Dynamic };
+	constexpr DynamicEntityType DynamicEntityTypes[] =
+	{
+		DynamicEntityType::Citizen, DynamicEntityType::Creature, DynamicEntityType::Projectile
+	};
+
+	void CheckAgainstModel(const EntityManager &entityManager, const Model &model)
+	{
+		REQUIRE(entityManager.getCount() == static_cast<int>(model.entities.size()));
+
+		for (const EntityType type : EntityTypes)
+		{
+			CHECK(entityManager.getCountOfType(type) == model.countIf(nullptr, &type, nullptr));
+		}
+
+		for (const DynamicEntityType dynamicType : DynamicEntityTypes)
+		{
+			CHECK(entityManager.getCountOfType(dynamicType) == model.countIf(nullptr, nullptr, &dynamicType));
+		}
+
+		std::vector<const Entity*> chunkEntities;
+		for (const ChunkInt2 &chunk : model.chunks)
+		{
+			const int chunkCount = entityManager.getCountInChunk(chunk);
+			REQUIRE(chunkCount == model.countIf(&chunk, nullptr, nullptr));
+
+			for (const DynamicEntityType dynamicType : DynamicEntityTypes)
+			{
+				CHECK(entityManager.getCountInChunk(chunk, dynamicType) == model.countIf(&chunk, nullptr, &dynamicType));
+			}
+
+			// Callers size the buffer from the live count, so every live entity must fit in it.
+			chunkEntities.resize(chunkCount);
+			const int writtenCount = entityManager.getEntitiesInChunk(chunk, chunkEntities.data(), chunkCount);
+			REQUIRE(writtenCount == chunkCount);
+
+			for (const Entity *entity : chunkEntities)
+			{
+				REQUIRE(entity != nullptr);
+				const auto iter = model.entities.find(entity->getID());
+				REQUIRE(iter != model.entities.end());
+				CHECK(iter->second.chunk == chunk);
+				CHECK(iter->second.type == entity->getEntityType());
+			}
+		}
+
+		std::vector<const Entity*> allEntities(model.entities.size());
+		const int allCount = entityManager.getEntities(allEntities.data(), static_cast<int>(allEntities.size()));
+		REQUIRE(allCount == static_cast<int>(model.entities.size()));
+
+		std::vector<EntityID> ids;
+		for (const Entity *entity : allEntities)
+		{
+			REQUIRE(entity != nullptr);
+			ids.push_back(entity->getID());
+		}
+
+		std::sort(ids.begin(), ids.end());
+		CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+	}
+}
+
+TEST_CASE(EntityManagerCountsMatchBruteForce)
+{
+	constexpr int chunkDim = 3;
+	constexpr int seedCount = 16;
+	constexpr int stepCount = 2000;
+
+	for (int seed = 0; seed < seedCount; seed++)
+	{
+		std::mt19937 rng(seed);
+		EntityManager entityManager;
+		Model model;
+
+		for (int y = 0; y < chunkDim; y++)
+		{
+			for (int x = 0; x < chunkDim; x++)
+			{
+				const ChunkInt2 chunk(x, y);
+				entityManager.addChunk(chunk);
+				model.chunks.push_back(chunk);
+			}
+		}
+
+		for (int step = 0; step < stepCount; step++)
+		{
+			const int op = std::uniform_int_distribution<int>(0, 99)(rng);
+			if ((op < 40) || model.entities.empty())
+			{
+				// Spawn in the entity manager's default (first) chunk.
+				const bool isStatic = std::uniform_int_distribution<int>(0, 2)(rng) == 0;
+				const int dynamicTypeIndex = std::uniform_int_distribution<int>(0, 2)(rng);
+				const DynamicEntityType dynamicType = DynamicEntityTypes[dynamicTypeIndex];
+				const EntityRef entityRef = isStatic ? entityManager.makeStaticEntity() :
+					entityManager.makeDynamicEntity(dynamicType);
+
+				ModelEntity modelEntity;
+				modelEntity.type = isStatic ? EntityType::Static : EntityType::Dynamic;
+				modelEntity.dynamicType = dynamicType;
+				modelEntity.chunk = model.chunks.front();
+				CHECK(model.entities.find(entityRef.getID()) == model.entities.end());
+				model.entities.emplace(entityRef.getID(), modelEntity);
+			}
+			else
+			{
+				// Pick a random live entity.
+				const int entityCount = static_cast<int>(model.entities.size());
+				auto iter = model.entities.begin();
+				std::advance(iter, std::uniform_int_distribution<int>(0, entityCount - 1)(rng));
+				const EntityID id = iter->first;
+
+				if (op < 75)
+				{
+					const ChunkInt2 &newChunk = model.chunks[std::uniform_int_distribution<int>(
+						0, static_cast<int>(model.chunks.size()) - 1)(rng)];
+					Entity *entity = entityManager.getEntityHandle(id);
+					REQUIRE(entity != nullptr);
+					entity->setPosition(CoordDouble2(newChunk, VoxelDouble2(0.50, 0.50)), entityManager);
+					iter->second.chunk = newChunk;
+				}
+				else if (op < 98)
+				{
+					entityManager.remove(id);
+					model.entities.erase(iter);
+				}
+				else
+				{
+					// Unload and reload a chunk, dropping its entities.
+					const int chunkIndex = std::uniform_int_distribution<int>(
+						0, static_cast<int>(model.chunks.size()) - 1)(rng);
+					const ChunkInt2 chunk = model.chunks[chunkIndex];
+					entityManager.removeChunk(chunk);
+					entityManager.addChunk(chunk);
+					model.chunks.erase(model.chunks.begin() + chunkIndex);
+					model.chunks.push_back(chunk);
+
+					for (auto entityIter = model.entities.begin(); entityIter != model.entities.end(); )
+					{
+						const bool isInChunk = entityIter->second.chunk == chunk;
+						entityIter = isInChunk ? model.entities.erase(entityIter) : std::next(entityIter);
+					}
+				}
+			}
+
+			CheckAgainstModel(entityManager, model);
+		}
+	}
+}
@@ -0,0 +1,330 @@
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TestFramework.h"
+#include "../src/Assets/INFFile.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+#include "components/vfs/manager.hpp"
+
+namespace
+{
+	// Highest *TEXT and sound ID checked when describing a file.
+	constexpr int MaxDescribedID = 1024;
+
+	std::string DescribeOptional(const std::optional<int> &value)
+	{
+		return value.has_value() ? std::to_string(*value) : std::string("-");
+	}
+
+	// Writes out everything the getters return so two parses can be compared with a string compare.
+	std::string DescribeINF(const INFFile &inf)
+	{
+		std::string description = std::string("name ") + inf.getName() + '\n';
+		for (const INFFile::VoxelTextureData &texture : inf.getVoxelTextures())
+		{
+			description += "voxel texture [" + texture.filename + "] " + DescribeOptional(texture.setIndex) + '\n';
+		}
+
+		for (const INFFile::FlatTextureData &texture : inf.getFlatTextures())
+		{
+			description += "flat texture [" + texture.filename + "]\n";
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			description += "box " + std::to_string(i) + ' ' + DescribeOptional(inf.getBoxCap(i)) + ' ' +
+				(inf.hasBoxSide(i) ? DescribeOptional(inf.getBoxSide(i)) : std::string("-")) + ' ' +
+				DescribeOptional(inf.getMenu(i)) + '\n';
+		}
+
+		for (int i = 0; i < static_cast<int>(inf.getFlatTextures().size()); i++)
+		{
+			const INFFile::FlatData &flat = inf.getFlat(i);
+			description += "flat " + std::to_string(flat.textureIndex) + ' ' +
+				DescribeOptional(flat.itemIndex.has_value() ? std::optional<int>(*flat.itemIndex) : std::nullopt) +
+				' ' + std::to_string(flat.yOffset) + ' ' + std::to_string(flat.health) + ' ' +
+				std::to_string(flat.collider) + std::to_string(flat.puddle) + std::to_string(flat.largeScale) +
+				std::to_string(flat.dark) + std::to_string(flat.transparent) + std::to_string(flat.ceiling) +
+				std::to_string(flat.mediumScale) + " [" + flat.nextFlat + "] " + DescribeOptional(flat.deathEffect) +
+				' ' + DescribeOptional(flat.lightIntensity) + '\n';
+		}
+
+		for (int i = 0; i < MaxDescribedID; i++)
+		{
+			if (inf.hasSoundIndex(i))
+			{
+				description += "sound " + std::to_string(i) + " [" + inf.getSound(i) + "]\n";
+			}
+
+			if (inf.hasKeyIndex(i))
+			{
+				description += "key " + std::to_string(i) + ' ' + std::to_string(inf.getKey(i).id) + '\n';
+			}
+
+			if (inf.hasRiddleIndex(i))
+			{
+				const INFFile::RiddleData &riddle = inf.getRiddle(i);
+				description += "riddle " + std::to_string(i) + ' ' + std::to_string(riddle.firstNumber) + ' ' +
+					std::to_string(riddle.secondNumber) + " [" + riddle.riddle + "] [" + riddle.correct + "] [" +
+					riddle.wrong + "]";
+				for (const std::string &answer : riddle.answers)
+				{
+					description += " <" + answer + '>';
+				}
+
+				description += '\n';
+			}
+
+			if (inf.hasTextIndex(i))
+			{
+				const INFFile::TextData &text = inf.getText(i);
+				description += "text " + std::to_string(i) + ' ' + std::to_string(text.displayedOnce) + " [" +
+					text.text + "]\n";
+			}
+		}
+
+		const INFFile::CeilingData &ceiling = inf.getCeiling();
+		description += "ceiling " + DescribeOptional(ceiling.textureIndex) + ' ' + std::to_string(ceiling.height) +
+			' ' + DescribeOptional(ceiling.boxScale) + ' ' + std::to_string(ceiling.outdoorDungeon) + '\n';
+		description += "chasms " + DescribeOptional(inf.getDryChasmIndex()) + ' ' +
+			DescribeOptional(inf.getLavaChasmIndex()) + ' ' + DescribeOptional(inf.getWetChasmIndex()) + '\n';
+		description += "levels " + DescribeOptional(inf.getLevelDownIndex()) + ' ' +
+			DescribeOptional(inf.getLevelUpIndex()) + '\n';
+		return description;
+	}
+
+	int RandomInt(std::mt19937 &rng, int min, int max)
+	{
+		return std::uniform_int_distribution<int>(min, max)(rng);
+	}
+
+	bool RandomChance(std::mt19937 &rng, double chance)
+	{
+		return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < chance;
+	}
+
+	// A run of spaces and tabs like the ones between flat tokens in the Arena data.
+	std::string MakeRandomWhitespace(std::mt19937 &rng)
+	{
+		constexpr const char *Runs[] = { " ", "\t", " \t", "\t\t", "  ", "\t \t", " \t " };
+		return Runs[RandomInt(rng, 0, static_cast<int>(std::size(Runs)) - 1)];
+	}
+
+	// Makes .INF text with every section and tag, loose filenames, .SET expansion, flats with any mix
+	// of whitespace between tokens (and inside names without modifiers), duplicate IDs, multi-line
+	// riddles, and either line ending.
+	std::string MakeRandomINFText(std::mt19937 &rng)
+	{
+		std::vector<std::string> lines =
+		{
+			"@FLOORS", "*BOXCAP 0", "FLOOR1.IMG", "*CEILING 120 150 1", "*BOXCAP 1", "CEIL.SET  #4", "",
+			"*TOP", "TOPX.IMG", "LOOSE.IMG", "",
+			"@WALLS", "*BOXSIDE 2", "*BOXSIDE 3", "WALL.SET #3", "*MENU 4", "DOOR.IMG", "*DRYCHASM",
+			"*BOXCAP 5", "CHASM.IMG", "*LEVELUP", "UP.IMG", "*LEVELDOWN", "DN.IMG", "*DOOR", "*WALKTHRU",
+			"*LAVACHASM", "LAVA.IMG", "*WETCHASM", "WET.IMG", "*TRANS", "T.IMG", "", "LOOSEW.SET #2", "",
+			"@FLATS NOSHOW"
+		};
+
+		for (int i = 0; i < 60; i++)
+		{
+			if (RandomChance(rng, 0.5))
+			{
+				lines.push_back("*ITEM " + std::to_string(RandomInt(rng, 0, 95)));
+			}
+
+			const bool hasSpacedName = RandomChance(rng, 0.25);
+			constexpr const char *Names[] = { "tree", "-barrel", "Chest", "crystal", "lamp" };
+			const std::string name = hasSpacedName ? ("crys" + MakeRandomWhitespace(rng) + "tal.img") :
+				(std::string(Names[RandomInt(rng, 0, static_cast<int>(std::size(Names)) - 1)]) + ".img");
+
+			std::string modifiers;
+			if (!hasSpacedName && !RandomChance(rng, 0.2))
+			{
+				const int modifierCount = RandomInt(rng, 0, 3);
+				for (int j = 0; j < modifierCount; j++)
+				{
+					constexpr char ModifierTypes[] = "FfSsYy";
+					modifiers += MakeRandomWhitespace(rng) + ModifierTypes[RandomInt(rng, 0, 5)] + ':' +
+						std::to_string(RandomInt(rng, -40, 127));
+				}
+			}
+
+			// Whitespace around a line without modifiers is kept as part of the texture name.
+			const bool canPad = modifiers.empty();
+			const std::string prefix = (canPad && RandomChance(rng, 0.3)) ? MakeRandomWhitespace(rng) : "";
+			const std::string suffix = (canPad && RandomChance(rng, 0.3)) ? MakeRandomWhitespace(rng) : "";
+			lines.push_back(prefix + name + modifiers + suffix);
+		}
+
+		lines.insert(lines.end(), { "", "@SOUND", "default.voc 0" });
+		for (int i = 0; i < 25; i++)
+		{
+			lines.push_back("sound" + std::to_string(i) + ".voc " + std::to_string(RandomInt(rng, 0, 30)));
+		}
+
+		lines.insert(lines.end(), { "", "@TEXT" });
+		for (int i = 0; i < 50; i++)
+		{
+			lines.push_back("*TEXT " + std::to_string(RandomInt(rng, 0, 70)));
+			switch (RandomInt(rng, 0, 4))
+			{
+			case 0:
+				lines.push_back("+" + std::to_string(RandomInt(rng, 0, 20)));
+				break;
+			case 1:
+				lines.insert(lines.end(), { "+" + std::to_string(RandomInt(rng, 0, 20)), "some text after key",
+					"second" });
+				break;
+			case 2:
+				lines.insert(lines.end(), { "^" + std::to_string(RandomInt(rng, 0, 9)) + ' ' +
+					std::to_string(RandomInt(rng, 0, 9)), "What is it?", "", "more riddle", ":answer", ":other",
+					"`CORRECT", "good", "`WRONG", "bad" });
+				break;
+			case 3:
+				lines.insert(lines.end(), { "~once text", "continues" });
+				break;
+			default:
+				lines.insert(lines.end(), { "plain text " + std::to_string(i), "line 2" });
+				break;
+			}
+
+			if (RandomChance(rng, 0.5))
+			{
+				lines.push_back("");
+			}
+		}
+
+		const std::string newline = RandomChance(rng, 0.5) ? "\r\n" : "\n";
+		std::string text;
+		for (size_t i = 0; i < lines.size(); i++)
+		{
+			text += lines[i];
+			if (((i + 1) < lines.size()) || RandomChance(rng, 0.5))
+			{
+				text += newline;
+			}
+		}
+
+		return text;
+	}
+
+	std::string ParseText(const std::string &name, const std::string &text, bool reference)
+	{
+		INFFile inf;
+		if (reference)
+		{
+			REQUIRE(inf.initFromTextReference(name.c_str(), BufferView<const char>(text.data(),
+				static_cast<int>(text.size()))));
+		}
+		else
+		{
+			std::string data = text;
+			REQUIRE(inf.initFromText(name.c_str(), BufferView<char>(data.data(), static_cast<int>(data.size()))));
+		}
+
+		return DescribeINF(inf);
+	}
+}
+
+TEST_CASE(INFParserMatchesReferenceOnGeneratedText)
+{
+	std::mt19937 rng(44);
+	for (int i = 0; i < 200; i++)
+	{
+		const std::string name = "GEN" + std::to_string(i) + ".INF";
+		const std::string text = MakeRandomINFText(rng);
+		const std::string description = ParseText(name, text, false);
+		const std::string referenceDescription = ParseText(name, text, true);
+		CHECK_MSG(description == referenceDescription, name);
+	}
+}
+
+TEST_CASE(INFParserMatchesReferenceOnArenaFiles)
+{
+	TestFramework::initVfsOrSkip();
+
+	const std::vector<std::string> filenames = TestFramework::listDataFiles("INF");
+	CHECK(!filenames.empty());
+	for (const std::string &filename : filenames)
+	{
+		INFFile inf, referenceInf;
+		REQUIRE(inf.init(filename.c_str()));
+		REQUIRE(referenceInf.initReference(filename.c_str()));
+		CHECK_MSG(DescribeINF(inf) == DescribeINF(referenceInf), filename);
+	}
+}
+
+BENCHMARK_CASE(INFParseTime)
+{
+	std::mt19937 rng(440);
+	std::vector<std::string> texts;
+	double totalBytes = 0.0;
+	for (int i = 0; i < 200; i++)
+	{
+		texts.push_back(MakeRandomINFText(rng));
+		totalBytes += static_cast<double>(texts.back().size());
+	}
+
+	auto timeGenerated = [&texts](bool reference)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		for (const std::string &text : texts)
+		{
+			INFFile inf;
+			if (reference)
+			{
+				const BufferView<const char> data(text.data(), static_cast<int>(text.size()));
+				inf.initFromTextReference("GEN.INF", data);
+			}
+			else
+			{
+				std::string data = text;
+				inf.initFromText("GEN.INF", BufferView<char>(data.data(), static_cast<int>(data.size())));
+			}
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(endTime - startTime).count();
+	};
+
+	TestFramework::reportBenchmark("initFromText (generated)", timeGenerated(false), totalBytes, "B");
+	TestFramework::reportBenchmark("initFromTextReference (generated)", timeGenerated(true), totalBytes, "B");
+
+	TestFramework::initVfsOrSkip();
+
+	// Both parsers read and decrypt the files the same way, so the difference between them is parsing.
+	const std::vector<std::string> filenames = TestFramework::listDataFiles("INF");
+
+	constexpr int iterationCount = 10;
+	auto timeArena = [&filenames](bool reference)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterationCount; i++)
+		{
+			for (const std::string &filename : filenames)
+			{
+				INFFile inf;
+				if (reference)
+				{
+					inf.initReference(filename.c_str());
+				}
+				else
+				{
+					inf.init(filename.c_str());
+				}
+			}
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(endTime - startTime).count();
+	};
+
+	const double fileCount = static_cast<double>(filenames.size() * iterationCount);
+	TestFramework::reportBenchmark("init (Arena .INFs)", timeArena(false), fileCount, "file");
+	TestFramework::reportBenchmark("initReference (Arena .INFs)", timeArena(true), fileCount, "file");
+}
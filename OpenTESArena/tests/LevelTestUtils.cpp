@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include "LevelTestUtils.h"
+#include "TestFramework.h"
+#include "../src/World/LevelDefinition.h"
+#include "../src/World/LevelInfoDefinition.h"
+
+namespace
+{
+	void AppendInt(std::string &out, int value)
+	{
+		out += std::to_string(value);
+		out += ' ';
+	}
+
+	void AppendBool(std::string &out, bool value)
+	{
+		out += value ? "1 " : "0 ";
+	}
+
+	void AppendDouble(std::string &out, double value)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%a ", value);
+		out += buffer;
+	}
+
+	void AppendString(std::string &out, const std::string &value)
+	{
+		out += '"';
+		out += value;
+		out += "\" ";
+	}
+
+	void AppendTextureAssetRef(std::string &out, const TextureAssetReference &textureAssetRef)
+	{
+		AppendString(out, textureAssetRef.filename);
+		AppendInt(out, textureAssetRef.index.has_value() ? *textureAssetRef.index : -1);
+	}
+
+	void AppendOptionalBool(std::string &out, const std::optional<bool> &value)
+	{
+		AppendInt(out, value.has_value() ? static_cast<int>(*value) : -1);
+	}
+
+	void AppendIntPositions(std::string &out, const std::vector<LevelInt3> &positions)
+	{
+		for (const LevelInt3 &position : positions)
+		{
+			AppendInt(out, position.x);
+			AppendInt(out, position.y);
+			AppendInt(out, position.z);
+		}
+
+		out += '\n';
+	}
+
+	void AppendVoxelDef(std::string &out, const VoxelDefinition &voxelDef)
+	{
+		AppendInt(out, static_cast<int>(voxelDef.type));
+		for (int i = 0; i < voxelDef.getTextureAssetReferenceCount(); i++)
+		{
+			AppendTextureAssetRef(out, voxelDef.getTextureAssetReference(i));
+		}
+
+		switch (voxelDef.type)
+		{
+		case ArenaTypes::VoxelType::Floor:
+			AppendBool(out, voxelDef.floor.isWildWallColored);
+			break;
+		case ArenaTypes::VoxelType::Raised:
+			AppendDouble(out, voxelDef.raised.yOffset);
+			AppendDouble(out, voxelDef.raised.ySize);
+			AppendDouble(out, voxelDef.raised.vTop);
+			AppendDouble(out, voxelDef.raised.vBottom);
+			break;
+		case ArenaTypes::VoxelType::Diagonal:
+			AppendBool(out, voxelDef.diagonal.type1);
+			break;
+		case ArenaTypes::VoxelType::TransparentWall:
+			AppendBool(out, voxelDef.transparentWall.collider);
+			break;
+		case ArenaTypes::VoxelType::Edge:
+			AppendDouble(out, voxelDef.edge.yOffset);
+			AppendBool(out, voxelDef.edge.collider);
+			AppendBool(out, voxelDef.edge.flipped);
+			AppendInt(out, static_cast<int>(voxelDef.edge.facing));
+			break;
+		case ArenaTypes::VoxelType::Chasm:
+			AppendInt(out, static_cast<int>(voxelDef.chasm.type));
+			break;
+		case ArenaTypes::VoxelType::Door:
+			AppendInt(out, static_cast<int>(voxelDef.door.type));
+			break;
+		default:
+			break;
+		}
+
+		out += '\n';
+	}
+
+	void AppendEntityAnimDef(std::string &out, const EntityAnimationDefinition &animDef)
+	{
+		for (int i = 0; i < animDef.getStateCount(); i++)
+		{
+			const EntityAnimationDefinition::State &state = animDef.getState(i);
+			AppendString(out, state.getName());
+			AppendDouble(out, state.getTotalSeconds());
+			AppendBool(out, state.isLooping());
+			for (int j = 0; j < state.getKeyframeListCount(); j++)
+			{
+				const EntityAnimationDefinition::KeyframeList &keyframeList = state.getKeyframeList(j);
+				AppendBool(out, keyframeList.isFlipped());
+				for (int k = 0; k < keyframeList.getKeyframeCount(); k++)
+				{
+					const EntityAnimationDefinition::Keyframe &keyframe = keyframeList.getKeyframe(k);
+					AppendTextureAssetRef(out, keyframe.getTextureAssetRef());
+					AppendDouble(out, keyframe.getWidth());
+					AppendDouble(out, keyframe.getHeight());
+				}
+			}
+		}
+	}
+
+	void AppendEntityDef(std::string &out, const EntityDefinition &entityDef)
+	{
+		const EntityDefinition::Type type = entityDef.getType();
+		AppendInt(out, static_cast<int>(type));
+		switch (type)
+		{
+		case EntityDefinition::Type::Enemy:
+		{
+			const EntityDefinition::EnemyDefinition &enemy = entityDef.getEnemy();
+			AppendInt(out, static_cast<int>(enemy.getType()));
+			if (enemy.getType() == EntityDefinition::EnemyDefinition::Type::Creature)
+			{
+				const EntityDefinition::EnemyDefinition::CreatureDefinition &creature = enemy.getCreature();
+				AppendString(out, creature.name);
+				AppendInt(out, creature.level);
+				AppendInt(out, creature.minHP);
+				AppendInt(out, creature.maxHP);
+				AppendString(out, creature.soundName);
+				AppendInt(out, creature.scale);
+				AppendInt(out, creature.yOffset);
+			}
+			else
+			{
+				const EntityDefinition::EnemyDefinition::HumanDefinition &human = enemy.getHuman();
+				AppendBool(out, human.male);
+				AppendInt(out, human.charClassID);
+			}
+
+			break;
+		}
+		case EntityDefinition::Type::Citizen:
+			AppendBool(out, entityDef.getCitizen().male);
+			AppendInt(out, static_cast<int>(entityDef.getCitizen().climateType));
+			break;
+		case EntityDefinition::Type::StaticNPC:
+			AppendInt(out, static_cast<int>(entityDef.getStaticNpc().getType()));
+			break;
+		case EntityDefinition::Type::Item:
+			AppendInt(out, static_cast<int>(entityDef.getItem().getType()));
+			break;
+		case EntityDefinition::Type::Container:
+			AppendInt(out, static_cast<int>(entityDef.getContainer().getType()));
+			break;
+		case EntityDefinition::Type::Projectile:
+			AppendBool(out, entityDef.getProjectile().hasGravity);
+			break;
+		case EntityDefinition::Type::Transition:
+			AppendInt(out, entityDef.getTransition().transitionDefID);
+			break;
+		case EntityDefinition::Type::Doodad:
+		{
+			const EntityDefinition::DoodadDefinition &doodad = entityDef.getDoodad();
+			AppendInt(out, doodad.yOffset);
+			AppendDouble(out, doodad.scale);
+			AppendBool(out, doodad.collider);
+			AppendBool(out, doodad.transparent);
+			AppendBool(out, doodad.ceiling);
+			AppendBool(out, doodad.streetlight);
+			AppendBool(out, doodad.puddle);
+			AppendInt(out, doodad.lightIntensity);
+			break;
+		}
+		}
+
+		AppendEntityAnimDef(out, entityDef.getAnimDef());
+		out += '\n';
+	}
+
+	void AppendTransitionDef(std::string &out, const TransitionDefinition &transitionDef)
+	{
+		const TransitionType type = transitionDef.getType();
+		AppendInt(out, static_cast<int>(type));
+		if (type == TransitionType::EnterInterior)
+		{
+			const MapGeneration::InteriorGenInfo &interiorGenInfo =
+				transitionDef.getInteriorEntrance().interiorGenInfo;
+			AppendInt(out, static_cast<int>(interiorGenInfo.getType()));
+			AppendInt(out, static_cast<int>(interiorGenInfo.getInteriorType()));
+			if (interiorGenInfo.getType() == MapGeneration::InteriorGenInfo::Type::Prefab)
+			{
+				const MapGeneration::InteriorGenInfo::Prefab &prefab = interiorGenInfo.getPrefab();
+				AppendString(out, prefab.mifName);
+				AppendOptionalBool(out, prefab.rulerIsMale);
+			}
+			else
+			{
+				const MapGeneration::InteriorGenInfo::Dungeon &dungeon = interiorGenInfo.getDungeon();
+				AppendInt(out, static_cast<int>(dungeon.dungeonDef.dungeonSeed));
+				AppendInt(out, dungeon.dungeonDef.widthChunkCount);
+				AppendInt(out, dungeon.dungeonDef.heightChunkCount);
+				AppendBool(out, dungeon.isArtifactDungeon);
+			}
+		}
+		else if (type == TransitionType::LevelChange)
+		{
+			AppendBool(out, transitionDef.getLevelChange().isLevelUp);
+		}
+
+		out += '\n';
+	}
+}
+
+LevelTestUtils::Libraries &LevelTestUtils::getLibrariesOrSkip()
+{
+	const std::string arenaPath = TestFramework::initVfsOrSkip();
+
+	static std::unique_ptr<Libraries> libraries;
+	if (libraries == nullptr)
+	{
+		auto newLibraries = std::make_unique<Libraries>();
+		if (!newLibraries->binaryAssetLibrary.init(TestFramework::isFloppyVersion(arenaPath)))
+		{
+			TestFramework::skip("couldn't load binary assets");
+		}
+
+		const ExeData &exeData = newLibraries->binaryAssetLibrary.getExeData();
+		newLibraries->charClassLibrary.init(exeData);
+		newLibraries->entityDefLibrary.init(exeData, newLibraries->textureManager);
+		libraries = std::move(newLibraries);
+	}
+
+	return *libraries;
+}
+
+const WorldMapDefinition &LevelTestUtils::getWorldMapDefinitionOrSkip()
+{
+	Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+
+	static std::unique_ptr<WorldMapDefinition> worldMapDef;
+	if (worldMapDef == nullptr)
+	{
+		worldMapDef = std::make_unique<WorldMapDefinition>();
+		worldMapDef->init(libraries.binaryAssetLibrary);
+	}
+
+	return *worldMapDef;
+}
+
+std::string LevelTestUtils::describeLevel(const LevelDefinition &levelDef)
+{
+	std::string out;
+	AppendInt(out, levelDef.getWidth());
+	AppendInt(out, levelDef.getHeight());
+	AppendInt(out, levelDef.getDepth());
+	out += "\nvoxels\n";
+	for (WEInt z = 0; z < levelDef.getDepth(); z++)
+	{
+		for (int y = 0; y < levelDef.getHeight(); y++)
+		{
+			for (SNInt x = 0; x < levelDef.getWidth(); x++)
+			{
+				AppendInt(out, levelDef.getVoxel(x, y, z));
+			}
+		}
+
+		out += '\n';
+	}
+
+	out += "entities\n";
+	for (int i = 0; i < levelDef.getEntityPlacementDefCount(); i++)
+	{
+		const LevelDefinition::EntityPlacementDef &placementDef = levelDef.getEntityPlacementDef(i);
+		AppendInt(out, placementDef.id);
+		for (const LevelDouble3 &position : placementDef.positions)
+		{
+			AppendDouble(out, position.x);
+			AppendDouble(out, position.y);
+			AppendDouble(out, position.z);
+		}
+
+		out += '\n';
+	}
+
+	out += "locks\n";
+	for (int i = 0; i < levelDef.getLockPlacementDefCount(); i++)
+	{
+		const LevelDefinition::LockPlacementDef &placementDef = levelDef.getLockPlacementDef(i);
+		AppendInt(out, placementDef.id);
+		AppendIntPositions(out, placementDef.positions);
+	}
+
+	out += "triggers\n";
+	for (int i = 0; i < levelDef.getTriggerPlacementDefCount(); i++)
+	{
+		const LevelDefinition::TriggerPlacementDef &placementDef = levelDef.getTriggerPlacementDef(i);
+		AppendInt(out, placementDef.id);
+		AppendIntPositions(out, placementDef.positions);
+	}
+
+	out += "transitions\n";
+	for (int i = 0; i < levelDef.getTransitionPlacementDefCount(); i++)
+	{
+		const LevelDefinition::TransitionPlacementDef &placementDef = levelDef.getTransitionPlacementDef(i);
+		AppendInt(out, placementDef.id);
+		AppendIntPositions(out, placementDef.positions);
+	}
+
+	out += "building names\n";
+	for (int i = 0; i < levelDef.getBuildingNamePlacementDefCount(); i++)
+	{
+		const LevelDefinition::BuildingNamePlacementDef &placementDef = levelDef.getBuildingNamePlacementDef(i);
+		AppendInt(out, placementDef.id);
+		AppendIntPositions(out, placementDef.positions);
+	}
+
+	out += "doors\n";
+	for (int i = 0; i < levelDef.getDoorPlacementDefCount(); i++)
+	{
+		const LevelDefinition::DoorPlacementDef &placementDef = levelDef.getDoorPlacementDef(i);
+		AppendInt(out, placementDef.id);
+		AppendIntPositions(out, placementDef.positions);
+	}
+
+	return out;
+}
+
+std::string LevelTestUtils::describeLevelInfo(const LevelInfoDefinition &levelInfoDef)
+{
+	std::string out;
+	AppendDouble(out, levelInfoDef.getCeilingScale());
+
+	out += "\nvoxel defs\n";
+	for (int i = 0; i < levelInfoDef.getVoxelDefCount(); i++)
+	{
+		AppendVoxelDef(out, levelInfoDef.getVoxelDef(i));
+	}
+
+	out += "entity defs\n";
+	for (int i = 0; i < levelInfoDef.getEntityDefCount(); i++)
+	{
+		AppendEntityDef(out, levelInfoDef.getEntityDef(i));
+	}
+
+	out += "lock defs\n";
+	for (int i = 0; i < levelInfoDef.getLockDefCount(); i++)
+	{
+		const LockDefinition &lockDef = levelInfoDef.getLockDef(i);
+		AppendInt(out, lockDef.getX());
+		AppendInt(out, lockDef.getY());
+		AppendInt(out, lockDef.getZ());
+		AppendInt(out, static_cast<int>(lockDef.getType()));
+		out += '\n';
+	}
+
+	out += "trigger defs\n";
+	for (int i = 0; i < levelInfoDef.getTriggerDefCount(); i++)
+	{
+		const TriggerDefinition &triggerDef = levelInfoDef.getTriggerDef(i);
+		AppendInt(out, triggerDef.getX());
+		AppendInt(out, triggerDef.getY());
+		AppendInt(out, triggerDef.getZ());
+		AppendString(out, triggerDef.hasSoundDef() ? triggerDef.getSoundDef().getFilename() : std::string());
+		AppendString(out, triggerDef.hasTextDef() ? triggerDef.getTextDef().getText() : std::string());
+		AppendBool(out, triggerDef.hasTextDef() && triggerDef.getTextDef().isDisplayedOnce());
+		out += '\n';
+	}
+
+	out += "transition defs\n";
+	for (int i = 0; i < levelInfoDef.getTransitionDefCount(); i++)
+	{
+		AppendTransitionDef(out, levelInfoDef.getTransitionDef(i));
+	}
+
+	out += "building names\n";
+	for (int i = 0; i < levelInfoDef.getBuildingNameCount(); i++)
+	{
+		AppendString(out, levelInfoDef.getBuildingName(i));
+		out += '\n';
+	}
+
+	out += "door defs\n";
+	for (int i = 0; i < levelInfoDef.getDoorDefCount(); i++)
+	{
+		const DoorDefinition &doorDef = levelInfoDef.getDoorDef(i);
+		AppendInt(out, static_cast<int>(doorDef.getType()));
+		AppendString(out, doorDef.getOpenSound().soundFilename);
+		AppendInt(out, static_cast<int>(doorDef.getCloseSound().closeType));
+		AppendString(out, doorDef.getCloseSound().soundFilename);
+		out += '\n';
+	}
+
+	return out;
+}
+
+std::string LevelTestUtils::describeFirstDifference(const std::string &a, const std::string &b)
+{
+	const size_t minSize = std::min(a.size(), b.size());
+	size_t index = 0;
+	while ((index < minSize) && (a[index] == b[index]))
+	{
+		index++;
+	}
+
+	if ((index == minSize) && (a.size() == b.size()))
+	{
+		return "no difference";
+	}
+
+	// Show the line the difference is on.
+	const size_t lineBegin = (index > 0) ? (a.rfind('\n', index - 1) + 1) : 0;
+	auto getExcerpt = [lineBegin](const std::string &str)
+	{
+		return str.substr(lineBegin, std::min<size_t>(str.find('\n', lineBegin) - lineBegin, 120));
+	};
+
+	return "offset " + std::to_string(index) + ": \"" + getExcerpt(a) + "\" vs. \"" + getExcerpt(b) + "\"";
+}
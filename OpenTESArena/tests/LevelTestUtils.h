@@ -0,0 +1,45 @@
+#ifndef LEVEL_TEST_UTILS_H
+#define LEVEL_TEST_UTILS_H
+
+#include <string>
+
+#include "../src/Assets/BinaryAssetLibrary.h"
+#include "../src/Entities/CharacterClassLibrary.h"
+#include "../src/Entities/EntityDefinitionLibrary.h"
+#include "../src/Media/TextureManager.h"
+#include "../src/WorldMap/WorldMapDefinition.h"
+
+class LevelDefinition;
+class LevelInfoDefinition;
+
+// Shared set-up and comparison helpers for tests that generate levels from the Arena data.
+
+namespace LevelTestUtils
+{
+	// The libraries level generation reads from, loaded the same way the game does.
+	struct Libraries
+	{
+		BinaryAssetLibrary binaryAssetLibrary;
+		CharacterClassLibrary charClassLibrary;
+		EntityDefinitionLibrary entityDefLibrary;
+		TextureManager textureManager;
+	};
+
+	// Loads the libraries from the Arena data (once), or skips the current test.
+	Libraries &getLibrariesOrSkip();
+
+	// Builds the world map definition from the libraries (once), or skips the current test.
+	const WorldMapDefinition &getWorldMapDefinitionOrSkip();
+
+	// Writes out everything in the definition as text so two generated levels can be compared byte
+	// for byte, and the first difference found with a string compare. Doubles are written in hex so
+	// they must match exactly.
+	std::string describeLevel(const LevelDefinition &levelDef);
+	std::string describeLevelInfo(const LevelInfoDefinition &levelInfoDef);
+
+	// Gets the index of the first character where the two strings differ along with some of the
+	// text around it, for failure messages.
+	std::string describeFirstDifference(const std::string &a, const std::string &b);
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TestFramework.h"
+#include "../src/WorldMap/LocationNameIndex.h"
+
+namespace
+{
+	const std::vector<std::string> ArenaLikeNames =
+	{
+		"Sentinel", "Daggerfall", "Wayrest", "Imperial City", "Solitude", "Windhelm", "Whiterun",
+		"Mournhold", "Ebonheart", "Firsthold", "Alinor", "Rimmen", "Senchal", "Gilane", "Stros M'Kai",
+		"Riverhold", "Stormhold", "Gideon", "Helstrom", "Blackrose", "Dune", "Corinth", "Skywatch",
+		"Old Keep", "Stonefalls", "Sentinel Hold", "Daggerfall Keep", "Fang Lair", "Labyrinthian",
+		"Elden Root", "Falinesti", "Silvenar", "Arenthia", "Cloud Ruler", "Ebonheart", "Dawnstar"
+	};
+
+	std::string MakeRandomName(std::mt19937 &rng)
+	{
+		static const char Letters[] = "aeiouaeiourstnlmkdghbcfpwy '";
+		const int length = std::uniform_int_distribution<int>(3, 18)(rng);
+		std::string name;
+		for (int i = 0; i < length; i++)
+		{
+			const int letterIndex = std::uniform_int_distribution<int>(0, sizeof(Letters) - 2)(rng);
+			const char letter = Letters[letterIndex];
+			name.push_back(((i == 0) && (letter >= 'a') && (letter <= 'z')) ? static_cast<char>(letter - 32) : letter);
+		}
+
+		return name;
+	}
+
+	// Applies a random insertion, deletion, substitution, or adjacent transposition.
+	void ApplyRandomTypo(std::mt19937 &rng, std::string &str)
+	{
+		if (str.empty())
+		{
+			str.push_back('a');
+			return;
+		}
+
+		const int index = std::uniform_int_distribution<int>(0, static_cast<int>(str.size()) - 1)(rng);
+		const char letter = static_cast<char>('a' + std::uniform_int_distribution<int>(0, 25)(rng));
+		switch (std::uniform_int_distribution<int>(0, 3)(rng))
+		{
+		case 0:
+			str.insert(str.begin() + index, letter);
+			break;
+		case 1:
+			str.erase(str.begin() + index);
+			break;
+		case 2:
+			str[index] = letter;
+			break;
+		default:
+			if ((index + 1) < static_cast<int>(str.size()))
+			{
+				std::swap(str[index], str[index + 1]);
+			}
+			break;
+		}
+	}
+
+	std::vector<std::string> MakeQueries(std::mt19937 &rng, const std::vector<std::string> &names, int queryCount)
+	{
+		std::vector<std::string> queries = { "", "a", "e", "s", "xq", "zzzz" };
+		while (static_cast<int>(queries.size()) < queryCount)
+		{
+			const int nameIndex = std::uniform_int_distribution<int>(0, static_cast<int>(names.size()) - 1)(rng);
+			const std::string &name = names[nameIndex];
+			std::string query;
+			switch (std::uniform_int_distribution<int>(0, 4)(rng))
+			{
+			case 0:
+				query = name;
+				break;
+			case 1:
+				query = name.substr(0, std::uniform_int_distribution<int>(1, static_cast<int>(name.size()))(rng));
+				break;
+			case 2:
+			{
+				const int begin = std::uniform_int_distribution<int>(0, static_cast<int>(name.size()) - 1)(rng);
+				const int length = std::uniform_int_distribution<int>(1, static_cast<int>(name.size()) - begin)(rng);
+				query = name.substr(begin, length);
+				break;
+			}
+			case 3:
+				query = MakeRandomName(rng);
+				break;
+			default:
+				query = name.substr(0, std::uniform_int_distribution<int>(1, static_cast<int>(name.size()))(rng));
+				const int typoCount = std::uniform_int_distribution<int>(1, 3)(rng);
+				for (int i = 0; i < typoCount; i++)
+				{
+					ApplyRandomTypo(rng, query);
+				}
+				break;
+			}
+
+			std::string queryKey;
+			LocationNameIndex::makeKey(query, queryKey);
+			queries.push_back(queryKey);
+		}
+
+		return queries;
+	}
+
+	std::vector<std::string> MakeNames(std::mt19937 &rng, int randomNameCount)
+	{
+		std::vector<std::string> names = ArenaLikeNames;
+		for (int i = 0; i < randomNameCount; i++)
+		{
+			names.push_back(MakeRandomName(rng));
+		}
+
+		std::shuffle(names.begin(), names.end(), rng);
+		return names;
+	}
+}
+
+TEST_CASE(LocationNameIndexMatchesLinearScan)
+{
+	std::mt19937 rng(34);
+	for (const int randomNameCount : { 0, 12, 200, 2000 })
+	{
+		const std::vector<std::string> names = MakeNames(rng, randomNameCount);
+		LocationNameIndex index;
+		index.init(names);
+		REQUIRE(index.getLocationCount() == static_cast<int>(names.size()));
+
+		const std::vector<std::string> queries = MakeQueries(rng, names, 3000);
+		std::vector<LocationNameIndex::Match> matches, referenceMatches;
+		for (const std::string &query : queries)
+		{
+			index.findMatches(query, matches);
+			index.findMatchesReference(query, referenceMatches);
+			CHECK_MSG(matches.size() == referenceMatches.size(), "\"" + query + "\"");
+			if (matches.size() != referenceMatches.size())
+			{
+				continue;
+			}
+
+			for (size_t i = 0; i < matches.size(); i++)
+			{
+				const LocationNameIndex::Match &match = matches[i];
+				const LocationNameIndex::Match &referenceMatch = referenceMatches[i];
+				const bool isSame = (match.locationIndex == referenceMatch.locationIndex) &&
+					(match.type == referenceMatch.type) && (match.distance == referenceMatch.distance);
+				CHECK_MSG(isSame, "\"" + query + "\" match " + std::to_string(i));
+			}
+		}
+	}
+}
+
+BENCHMARK_CASE(LocationNameIndexQueryTime)
+{
+	std::mt19937 rng(340);
+	for (const int randomNameCount : { 12, 2000 })
+	{
+		const std::vector<std::string> names = MakeNames(rng, randomNameCount);
+		LocationNameIndex index;
+		index.init(names);
+
+		const std::vector<std::string> queries = MakeQueries(rng, names, 20000);
+		std::vector<LocationNameIndex::Match> matches;
+		size_t matchCount = 0;
+
+		auto time = [&](auto findFunction)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (const std::string &query : queries)
+			{
+				(index.*findFunction)(query, matches);
+				matchCount += matches.size();
+			}
+
+			const auto endTime = std::chrono::steady_clock::now();
+			return std::chrono::duration<double>(endTime - startTime).count();
+		};
+
+		const std::string suffix = " (" + std::to_string(names.size()) + " names)";
+		const double queryCount = static_cast<double>(queries.size());
+		TestFramework::reportBenchmark("findMatches" + suffix, time(&LocationNameIndex::findMatches),
+			queryCount, "query");
+		TestFramework::reportBenchmark("findMatchesReference" + suffix, time(&LocationNameIndex::findMatchesReference),
+			queryCount, "query");
+		CHECK(matchCount > 0);
+	}
+}
@@ -0,0 +1,527 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "LevelTestUtils.h"
+#include "TestFramework.h"
+#include "../src/Assets/INFFile.h"
+#include "../src/Assets/MIFFile.h"
+#include "../src/Interface/MainMenuUiModel.h"
+#include "../src/Math/Random.h"
+#include "../src/Utilities/ThreadUtils.h"
+#include "../src/World/ArenaInteriorUtils.h"
+#include "../src/World/ArenaLevelUtils.h"
+#include "../src/World/ArenaWildUtils.h"
+#include "../src/World/ChunkUtils.h"
+#include "../src/World/LevelDefinition.h"
+#include "../src/World/LevelInfoDefinition.h"
+#include "../src/World/MapDefinition.h"
+#include "../src/World/MapGeneration.h"
+#include "../src/World/MapType.h"
+#include "../src/WorldMap/LocationDefinition.h"
+#include "../src/WorldMap/ProvinceDefinition.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/String.h"
+
+namespace
+{
+	enum class LevelGenMode
+	{
+		Reference, // Levels or blocks one after another straight into the shared definitions.
+		Serial, // Per-level definitions merged afterwards, without worker threads.
+		Parallel // Per-level definitions generated on worker threads.
+	};
+
+	constexpr LevelGenMode LevelGenModes[] = { LevelGenMode::Reference, LevelGenMode::Serial,
+		LevelGenMode::Parallel };
+
+	const char *GetLevelGenModeName(LevelGenMode mode)
+	{
+		switch (mode)
+		{
+		case LevelGenMode::Reference:
+			return "reference";
+		case LevelGenMode::Serial:
+			return "serial";
+		default:
+			return "parallel";
+		}
+	}
+
+	struct DungeonParams
+	{
+		uint32_t seed;
+		int widthChunks, depthChunks;
+		bool isArtifactDungeon;
+	};
+
+	struct DungeonAssets
+	{
+		MIFFile mif;
+		INFFile inf;
+	};
+
+	const DungeonAssets &GetDungeonAssetsOrSkip()
+	{
+		LevelTestUtils::getLibrariesOrSkip();
+
+		static DungeonAssets assets;
+		static bool isLoaded = false;
+		if (!isLoaded)
+		{
+			REQUIRE(assets.mif.init(ArenaInteriorUtils::DUNGEON_MIF_NAME.c_str()));
+			const std::string infName = String::toUppercase(assets.mif.getLevel(0).getInfo());
+			REQUIRE(assets.inf.init(infName.c_str()));
+			isLoaded = true;
+		}
+
+		return assets;
+	}
+
+	// Generates a dungeon the same way MapDefinition does and describes everything it produced,
+	// including the state the random generator is left in.
+	std::string GenerateDungeon(const DungeonParams &params, LevelGenMode mode)
+	{
+		LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+		const DungeonAssets &assets = GetDungeonAssetsOrSkip();
+		const MIFFile &mif = assets.mif;
+		const INFFile &inf = assets.inf;
+
+		ArenaRandom random(params.seed);
+		const int levelCount = ArenaInteriorUtils::generateDungeonLevelCount(params.isArtifactDungeon, random);
+
+		const INFFile::CeilingData &ceiling = inf.getCeiling();
+		Buffer<LevelDefinition> levelDefs(levelCount);
+		for (int i = 0; i < levelCount; i++)
+		{
+			levelDefs.get(i).init(mif.getDepth() * params.depthChunks, ceiling.outdoorDungeon ? 2 : 3,
+				mif.getWidth() * params.widthChunks);
+		}
+
+		BufferView<LevelDefinition> levelDefsView(levelDefs.get(), levelDefs.getCount());
+		LevelInfoDefinition levelInfoDef;
+		levelInfoDef.init(ArenaLevelUtils::convertCeilingHeightToScale(ceiling.height));
+
+		constexpr ArenaTypes::InteriorType interiorType = ArenaTypes::InteriorType::Dungeon;
+		constexpr std::optional<bool> rulerIsMale;
+		LevelInt2 startPoint;
+		if (mode == LevelGenMode::Reference)
+		{
+			MapGeneration::generateMifDungeonReference(mif, levelCount, params.widthChunks, params.depthChunks, inf,
+				random, MapType::Interior, interiorType, rulerIsMale, params.isArtifactDungeon,
+				libraries.charClassLibrary, libraries.entityDefLibrary, libraries.binaryAssetLibrary,
+				libraries.textureManager, levelDefsView, &levelInfoDef, &startPoint);
+		}
+		else
+		{
+			ThreadUtils::setParallelEnabled(mode == LevelGenMode::Parallel);
+			MapGeneration::generateMifDungeon(mif, levelCount, params.widthChunks, params.depthChunks, inf,
+				random, MapType::Interior, interiorType, rulerIsMale, params.isArtifactDungeon,
+				libraries.charClassLibrary, libraries.entityDefLibrary, libraries.binaryAssetLibrary,
+				libraries.textureManager, levelDefsView, &levelInfoDef, &startPoint);
+			ThreadUtils::setParallelEnabled(true);
+		}
+
+		std::string description = "random " + std::to_string(random.getSeed()) + "\nstart " +
+			std::to_string(startPoint.x) + ' ' + std::to_string(startPoint.y) + '\n';
+		for (int i = 0; i < levelCount; i++)
+		{
+			description += "level " + std::to_string(i) + '\n' + LevelTestUtils::describeLevel(levelDefs.get(i));
+		}
+
+		description += "level info\n" + LevelTestUtils::describeLevelInfo(levelInfoDef);
+		return description;
+	}
+
+	std::vector<DungeonParams> MakeDungeonParams(int seedCount)
+	{
+		// Named dungeons are 2x1 chunks and wild dungeons 2x2. Artifact dungeons have the most levels.
+		std::vector<DungeonParams> paramsList;
+		ArenaRandom seedRandom(48);
+		for (int i = 0; i < seedCount; i++)
+		{
+			const uint32_t seed = (static_cast<uint32_t>(seedRandom.next()) << 16) ^
+				static_cast<uint32_t>(seedRandom.next());
+			for (const bool isArtifactDungeon : { false, true })
+			{
+				paramsList.push_back(DungeonParams { seed, 2, 1, isArtifactDungeon });
+				paramsList.push_back(DungeonParams { seed, 2, 2, isArtifactDungeon });
+			}
+		}
+
+		return paramsList;
+	}
+
+	std::string DescribeInterior(const std::string &mifName, ArenaTypes::InteriorType interiorType, bool parallel)
+	{
+		LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+
+		MapGeneration::InteriorGenInfo interiorGenInfo;
+		interiorGenInfo.initPrefab(std::string(mifName), interiorType, std::nullopt);
+
+		ThreadUtils::setParallelEnabled(parallel);
+		MapDefinition mapDef;
+		const bool success = mapDef.initInterior(interiorGenInfo, libraries.charClassLibrary,
+			libraries.entityDefLibrary, libraries.binaryAssetLibrary, libraries.textureManager);
+		ThreadUtils::setParallelEnabled(true);
+		if (!success)
+		{
+			return "failed";
+		}
+
+		std::string description = "start level " +
+			std::to_string(mapDef.getStartLevelIndex().has_value() ? *mapDef.getStartLevelIndex() : -1) + '\n';
+		for (int i = 0; i < mapDef.getStartPointCount(); i++)
+		{
+			const LevelDouble2 &startPoint = mapDef.getStartPoint(i);
+			description += "start " + std::to_string(startPoint.x) + ' ' + std::to_string(startPoint.y) + '\n';
+		}
+
+		for (int i = 0; i < mapDef.getLevelCount(); i++)
+		{
+			description += "level " + std::to_string(i) + '\n' + LevelTestUtils::describeLevel(mapDef.getLevel(i));
+			description += "level info\n" + LevelTestUtils::describeLevelInfo(mapDef.getLevelInfoForLevel(i));
+		}
+
+		return description;
+	}
+
+	// Building interiors and the multi-level main quest dungeons.
+	std::vector<std::pair<std::string, ArenaTypes::InteriorType>> GetPrefabInteriors(const ExeData &exeData)
+	{
+		std::vector<std::pair<std::string, ArenaTypes::InteriorType>> interiors;
+		for (const auto &interiorLocation : MainMenuUiModel::InteriorLocations)
+		{
+			const std::string &prefix = std::get<0>(interiorLocation);
+			const std::pair<int, int> &idRange = std::get<1>(interiorLocation);
+			for (int i = idRange.first; i <= idRange.second; i++)
+			{
+				interiors.emplace_back(prefix + std::to_string(i) + ".MIF", std::get<2>(interiorLocation));
+			}
+		}
+
+		interiors.emplace_back(String::toUppercase(exeData.locations.startDungeonMifName),
+			ArenaTypes::InteriorType::Dungeon);
+		interiors.emplace_back(String::toUppercase(exeData.locations.finalDungeonMifName),
+			ArenaTypes::InteriorType::Dungeon);
+		return interiors;
+	}
+
+	struct WildParams
+	{
+		std::string infName;
+		std::string locationName;
+		const LocationDefinition::CityDefinition *cityDef;
+	};
+
+	// The wilderness around the first city of each climate in up to the given number of provinces, with
+	// every weather .INF of that climate.
+	std::vector<WildParams> MakeWildParams(int provinceCount)
+	{
+		const WorldMapDefinition &worldMapDef = LevelTestUtils::getWorldMapDefinitionOrSkip();
+		constexpr std::pair<ArenaTypes::ClimateType, const char*> Climates[] =
+		{
+			{ ArenaTypes::ClimateType::Temperate, "T" },
+			{ ArenaTypes::ClimateType::Desert, "D" },
+			{ ArenaTypes::ClimateType::Mountain, "M" }
+		};
+
+		std::vector<WildParams> paramsList;
+		for (const auto &climate : Climates)
+		{
+			// Deserts have no snow templates.
+			const std::string weatherLetters = (climate.first == ArenaTypes::ClimateType::Desert) ? "NR" : "NRS";
+			const int climateProvinceCount = std::min(provinceCount, worldMapDef.getProvinceCount());
+			for (int i = 0; i < climateProvinceCount; i++)
+			{
+				const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(i);
+				for (int j = 0; j < provinceDef.getLocationCount(); j++)
+				{
+					const LocationDefinition &locationDef = provinceDef.getLocationDef(j);
+					if ((locationDef.getType() != LocationDefinition::Type::City) ||
+						(locationDef.getCityDefinition().climateType != climate.first))
+					{
+						continue;
+					}
+
+					for (const char weatherLetter : weatherLetters)
+					{
+						const std::string infName = std::string(climate.second) + 'W' + weatherLetter + ".INF";
+						paramsList.push_back(WildParams { infName, locationDef.getName(),
+							&locationDef.getCityDefinition() });
+					}
+
+					break;
+				}
+			}
+		}
+
+		return paramsList;
+	}
+
+	std::string GetWildParamsName(const WildParams &params)
+	{
+		return params.locationName + ", " + params.infName;
+	}
+
+	// Generates a wilderness the same way MapDefinition does and describes every block, the shared
+	// level info definition and the per-chunk building names.
+	std::string GenerateWild(const WildParams &params, LevelGenMode mode)
+	{
+		LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+		const ExeData &exeData = libraries.binaryAssetLibrary.getExeData();
+		const LocationDefinition::CityDefinition &cityDef = *params.cityDef;
+
+		INFFile inf;
+		REQUIRE(inf.init(params.infName.c_str()));
+
+		const Buffer2D<ArenaWildUtils::WildBlockID> wildBlockIDs =
+			ArenaWildUtils::generateWildernessIndices(cityDef.wildSeed, exeData.wild);
+
+		std::vector<ArenaWildUtils::WildBlockID> uniqueWildBlockIDs;
+		Buffer2D<int> levelDefIndices(wildBlockIDs.getWidth(), wildBlockIDs.getHeight());
+		for (int y = 0; y < wildBlockIDs.getHeight(); y++)
+		{
+			for (int x = 0; x < wildBlockIDs.getWidth(); x++)
+			{
+				const ArenaWildUtils::WildBlockID blockID = wildBlockIDs.get(y, x);
+				const auto iter = std::find(uniqueWildBlockIDs.begin(), uniqueWildBlockIDs.end(), blockID);
+				if (iter != uniqueWildBlockIDs.end())
+				{
+					levelDefIndices.set(x, y, static_cast<int>(std::distance(uniqueWildBlockIDs.begin(), iter)));
+				}
+				else
+				{
+					uniqueWildBlockIDs.push_back(blockID);
+					levelDefIndices.set(x, y, static_cast<int>(uniqueWildBlockIDs.size()) - 1);
+				}
+			}
+		}
+
+		const int blockCount = static_cast<int>(uniqueWildBlockIDs.size());
+		Buffer<LevelDefinition> levelDefs(blockCount);
+		for (int i = 0; i < blockCount; i++)
+		{
+			levelDefs.get(i).init(ChunkUtils::CHUNK_DIM, 6, ChunkUtils::CHUNK_DIM);
+		}
+
+		LevelInfoDefinition levelInfoDef;
+		levelInfoDef.init(ArenaLevelUtils::convertCeilingHeightToScale(inf.getCeiling().height));
+
+		const BufferView<const ArenaWildUtils::WildBlockID> uniqueWildBlockIDsView(
+			uniqueWildBlockIDs.data(), blockCount);
+		const BufferView2D<const int> levelDefIndicesView(levelDefIndices.get(),
+			levelDefIndices.getWidth(), levelDefIndices.getHeight());
+		BufferView<LevelDefinition> levelDefsView(levelDefs.get(), levelDefs.getCount());
+		std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
+		if (mode == LevelGenMode::Reference)
+		{
+			MapGeneration::generateRmdWildernessReference(uniqueWildBlockIDsView, levelDefIndicesView, cityDef, inf,
+				libraries.charClassLibrary, libraries.entityDefLibrary, libraries.binaryAssetLibrary,
+				libraries.textureManager, levelDefsView, &levelInfoDef, &buildingNameInfos);
+		}
+		else
+		{
+			ThreadUtils::setParallelEnabled(mode == LevelGenMode::Parallel);
+			MapGeneration::generateRmdWilderness(uniqueWildBlockIDsView, levelDefIndicesView, cityDef, inf,
+				libraries.charClassLibrary, libraries.entityDefLibrary, libraries.binaryAssetLibrary,
+				libraries.textureManager, levelDefsView, &levelInfoDef, &buildingNameInfos);
+			ThreadUtils::setParallelEnabled(true);
+		}
+
+		std::string description;
+		for (int i = 0; i < blockCount; i++)
+		{
+			description += "block " + std::to_string(uniqueWildBlockIDs[i]) + '\n' +
+				LevelTestUtils::describeLevel(levelDefs.get(i));
+		}
+
+		description += "level info\n" + LevelTestUtils::describeLevelInfo(levelInfoDef);
+
+		constexpr ArenaTypes::InteriorType NamedInteriorTypes[] =
+		{
+			ArenaTypes::InteriorType::Equipment,
+			ArenaTypes::InteriorType::MagesGuild,
+			ArenaTypes::InteriorType::Tavern,
+			ArenaTypes::InteriorType::Temple
+		};
+
+		for (const MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo : buildingNameInfos)
+		{
+			const ChunkInt2 &chunk = buildingNameInfo.getChunk();
+			description += "building names " + std::to_string(chunk.x) + ' ' + std::to_string(chunk.y);
+			for (const ArenaTypes::InteriorType interiorType : NamedInteriorTypes)
+			{
+				LevelDefinition::BuildingNameID buildingNameID;
+				const bool hasName = buildingNameInfo.tryGetBuildingNameID(interiorType, &buildingNameID);
+				description += ' ' + (hasName ? std::to_string(buildingNameID) : std::string("-"));
+			}
+
+			description += '\n';
+		}
+
+		return description;
+	}
+}
+
+TEST_CASE(DungeonGenerationMatchesSerialReference)
+{
+	for (const DungeonParams &params : MakeDungeonParams(12))
+	{
+		const std::string referenceDescription = GenerateDungeon(params, LevelGenMode::Reference);
+		for (const LevelGenMode mode : { LevelGenMode::Serial, LevelGenMode::Parallel })
+		{
+			const std::string description = GenerateDungeon(params, mode);
+			CHECK_MSG(description == referenceDescription, std::string(GetLevelGenModeName(mode)) +
+				", seed " + std::to_string(params.seed) + ", " + std::to_string(params.widthChunks) + "x" +
+				std::to_string(params.depthChunks) + (params.isArtifactDungeon ? " artifact" : "") + ", " +
+				LevelTestUtils::describeFirstDifference(description, referenceDescription));
+		}
+	}
+}
+
+TEST_CASE(InteriorGenerationMatchesSerial)
+{
+	LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+	const ExeData &exeData = libraries.binaryAssetLibrary.getExeData();
+
+	int interiorCount = 0;
+	for (const auto &interior : GetPrefabInteriors(exeData))
+	{
+		const std::string &mifName = interior.first;
+		const std::string serialDescription = DescribeInterior(mifName, interior.second, false);
+		if (serialDescription == "failed")
+		{
+			continue;
+		}
+
+		const std::string parallelDescription = DescribeInterior(mifName, interior.second, true);
+		CHECK_MSG(parallelDescription == serialDescription, mifName + ", " +
+			LevelTestUtils::describeFirstDifference(parallelDescription, serialDescription));
+		interiorCount++;
+	}
+
+	CHECK(interiorCount > 0);
+}
+
+TEST_CASE(WildGenerationMatchesSerialReference)
+{
+	int wildCount = 0;
+	for (const WildParams &params : MakeWildParams(3))
+	{
+		const std::string referenceDescription = GenerateWild(params, LevelGenMode::Reference);
+		for (const LevelGenMode mode : { LevelGenMode::Serial, LevelGenMode::Parallel })
+		{
+			const std::string description = GenerateWild(params, mode);
+			CHECK_MSG(description == referenceDescription, std::string(GetLevelGenModeName(mode)) + ", " +
+				GetWildParamsName(params) + ", " +
+				LevelTestUtils::describeFirstDifference(description, referenceDescription));
+		}
+
+		wildCount++;
+	}
+
+	CHECK(wildCount > 0);
+}
+
+BENCHMARK_CASE(DungeonGenerationTime)
+{
+	constexpr int seedCount = 16;
+	const std::vector<DungeonParams> paramsList = MakeDungeonParams(seedCount);
+
+	// Load every texture first so the timings don't include file decoding.
+	for (const DungeonParams &params : paramsList)
+	{
+		GenerateDungeon(params, LevelGenMode::Reference);
+	}
+
+	for (const bool isArtifactDungeon : { false, true })
+	{
+		for (const LevelGenMode mode : LevelGenModes)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (const DungeonParams &params : paramsList)
+			{
+				if ((params.isArtifactDungeon == isArtifactDungeon) && (params.depthChunks == 2))
+				{
+					GenerateDungeon(params, mode);
+				}
+			}
+
+			const auto endTime = std::chrono::steady_clock::now();
+			const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+			const std::string name = std::string(isArtifactDungeon ? "Artifact" : "Random") + " dungeons 2x2 (" +
+				GetLevelGenModeName(mode) + ")";
+			TestFramework::reportBenchmark(name, seconds, seedCount, "dungeon");
+		}
+	}
+}
+
+BENCHMARK_CASE(MainQuestDungeonGenerationTime)
+{
+	LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+	const ExeData &exeData = libraries.binaryAssetLibrary.getExeData();
+	const std::string mifNames[] =
+	{
+		String::toUppercase(exeData.locations.startDungeonMifName),
+		String::toUppercase(exeData.locations.finalDungeonMifName)
+	};
+
+	constexpr int iterationCount = 8;
+	for (const std::string &mifName : mifNames)
+	{
+		DescribeInterior(mifName, ArenaTypes::InteriorType::Dungeon, false);
+
+		for (const bool parallel : { false, true })
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < iterationCount; i++)
+			{
+				MapGeneration::InteriorGenInfo interiorGenInfo;
+				interiorGenInfo.initPrefab(std::string(mifName), ArenaTypes::InteriorType::Dungeon, std::nullopt);
+
+				ThreadUtils::setParallelEnabled(parallel);
+				MapDefinition mapDef;
+				mapDef.initInterior(interiorGenInfo, libraries.charClassLibrary, libraries.entityDefLibrary,
+					libraries.binaryAssetLibrary, libraries.textureManager);
+				ThreadUtils::setParallelEnabled(true);
+			}
+
+			const auto endTime = std::chrono::steady_clock::now();
+			const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+			TestFramework::reportBenchmark(mifName + (parallel ? " (parallel)" : " (serial)"), seconds,
+				iterationCount, "map");
+		}
+	}
+}
+
+BENCHMARK_CASE(WildGenerationTime)
+{
+	const std::vector<WildParams> paramsList = MakeWildParams(1);
+
+	// Load every texture first so the timings don't include file decoding.
+	for (const WildParams &params : paramsList)
+	{
+		GenerateWild(params, LevelGenMode::Reference);
+	}
+
+	constexpr int iterationCount = 4;
+	for (const WildParams &params : paramsList)
+	{
+		for (const LevelGenMode mode : LevelGenModes)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < iterationCount; i++)
+			{
+				GenerateWild(params, mode);
+			}
+
+			const auto endTime = std::chrono::steady_clock::now();
+			const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+			TestFramework::reportBenchmark(GetWildParamsName(params) + " (" + GetLevelGenModeName(mode) + ")",
+				seconds, iterationCount, "wilderness");
+		}
+	}
+}
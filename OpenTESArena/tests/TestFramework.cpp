@@ -0,0 +1,189 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <set>
+#include <vector>
+
+#include "TestFramework.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/String.h"
+#include "components/vfs/manager.hpp"
+
+namespace
+{
+	struct TestEntry
+	{
+		const char *name;
+		TestFramework::TestKind kind;
+		TestFramework::TestFunction function;
+	};
+
+	// Function-local so registration from other translation units' static initializers is safe.
+	std::vector<TestEntry> &GetTests()
+	{
+		static std::vector<TestEntry> tests;
+		return tests;
+	}
+
+	int CurrentFailureCount = 0;
+}
+
+bool TestFramework::registerTest(const char *name, TestKind kind, TestFunction function)
+{
+	GetTests().push_back(TestEntry { name, kind, function });
+	return true;
+}
+
+void TestFramework::reportFailure(const char *filePath, int lineNumber, const std::string &message)
+{
+	std::fprintf(stderr, "  %s(%d): check failed: %s\n", filePath, lineNumber, message.c_str());
+	CurrentFailureCount++;
+}
+
+void TestFramework::skip(const std::string &reason)
+{
+	throw SkipException { reason };
+}
+
+std::string TestFramework::getArenaPathOrSkip()
+{
+	const char *arenaPath = std::getenv("ARENA_PATH");
+	if ((arenaPath == nullptr) || (arenaPath[0] == '\0'))
+	{
+		TestFramework::skip("ARENA_PATH not set");
+	}
+
+	std::string path(arenaPath);
+	if ((path.back() != '/') && (path.back() != '\\'))
+	{
+		path.push_back('/');
+	}
+
+	return path;
+}
+
+std::string TestFramework::initVfsOrSkip()
+{
+	const std::string arenaPath = TestFramework::getArenaPathOrSkip();
+
+	static bool isVfsInitialized = false;
+	if (!isVfsInitialized)
+	{
+		VFS::Manager::get().initialize(std::string(arenaPath));
+		isVfsInitialized = true;
+	}
+
+	return arenaPath;
+}
+
+std::vector<std::string> TestFramework::listDataFiles(const std::string &extension)
+{
+	// Sorted and without duplicates so loose files shadowing BSA entries are only listed once.
+	std::set<std::string> uniqueFilenames;
+	for (const std::string &ext : { String::toUppercase(extension), String::toLowercase(extension) })
+	{
+		const std::string pattern = "*." + ext;
+		for (const std::string &filename : VFS::Manager::get().list(pattern.c_str()))
+		{
+			uniqueFilenames.insert(filename);
+		}
+	}
+
+	return std::vector<std::string>(uniqueFilenames.begin(), uniqueFilenames.end());
+}
+
+bool TestFramework::isFloppyVersion(const std::string &arenaPath)
+{
+	return !std::filesystem::exists(arenaPath + "ACD.EXE") && !std::filesystem::exists(arenaPath + "acd.exe");
+}
+
+void TestFramework::reportBenchmark(const std::string &name, double seconds, double bytesOrItems, const char *unit)
+{
+	const double perSecond = (seconds > 0.0) ? (bytesOrItems / seconds) : 0.0;
+	std::printf("  %-48s %10.3f ms  %14.1f %s/s\n", name.c_str(), seconds * 1000.0, perSecond, unit);
+}
+
+int main(int argc, char *argv[])
+{
+	// Usage: TESArenaTests [--bench] [name filter]
+	bool runBenchmarks = false;
+	const char *filter = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--bench") == 0)
+		{
+			runBenchmarks = true;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+
+	int passedCount = 0;
+	int failedCount = 0;
+	int skippedCount = 0;
+	for (const TestEntry &entry : GetTests())
+	{
+		const bool isBenchmark = entry.kind == TestFramework::TestKind::Benchmark;
+		if (isBenchmark != runBenchmarks)
+		{
+			continue;
+		}
+
+		if ((filter != nullptr) && (std::strstr(entry.name, filter) == nullptr))
+		{
+			continue;
+		}
+
+		std::printf("[ RUN  ] %s\n", entry.name);
+		std::fflush(stdout);
+
+		CurrentFailureCount = 0;
+		const auto startTime = std::chrono::steady_clock::now();
+		bool skipped = false;
+		try
+		{
+			entry.function();
+		}
+		catch (const TestFramework::SkipException &e)
+		{
+			std::printf("[ SKIP ] %s (%s)\n", entry.name, e.reason.c_str());
+			skipped = true;
+		}
+		catch (const TestFramework::RequireException&)
+		{
+			// Failure already reported.
+		}
+		catch (const std::exception &e)
+		{
+			TestFramework::reportFailure(__FILE__, __LINE__, std::string("exception: ") + e.what());
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		const double milliseconds = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+		if (skipped)
+		{
+			skippedCount++;
+		}
+		else if (CurrentFailureCount > 0)
+		{
+			std::printf("[ FAIL ] %s (%d failed checks)\n", entry.name, CurrentFailureCount);
+			failedCount++;
+		}
+		else
+		{
+			std::printf("[  OK  ] %s (%.1f ms)\n", entry.name, milliseconds);
+			passedCount++;
+		}
+	}
+
+	std::printf("%d passed, %d failed, %d skipped.\n", passedCount, failedCount, skippedCount);
+	Debug::flush();
+	return (failedCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
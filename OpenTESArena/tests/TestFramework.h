@@ -0,0 +1,71 @@
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <string>
+#include <vector>
+
+// Minimal test runner for checking optimized code paths against their reference implementations.
+// Tests are always run; benchmarks only run when "--bench" is given on the command line. Tests that
+// need the original game data read it from the folder in the ARENA_PATH environment variable and
+// are skipped when it isn't set.
+
+namespace TestFramework
+{
+	using TestFunction = void(*)();
+
+	enum class TestKind
+	{
+		Test,
+		Benchmark
+	};
+
+	// Thrown by skip() to end the current test without failing it.
+	struct SkipException
+	{
+		std::string reason;
+	};
+
+	// Thrown by REQUIRE() to end the current test after a failure.
+	struct RequireException { };
+
+	bool registerTest(const char *name, TestKind kind, TestFunction function);
+
+	void reportFailure(const char *filePath, int lineNumber, const std::string &message);
+
+	[[noreturn]] void skip(const std::string &reason);
+
+	// Gets the Arena data folder from the environment, or skips the current test if it isn't set.
+	std::string getArenaPathOrSkip();
+
+	// Points the virtual file system at the Arena data folder (once), or skips the current test.
+	std::string initVfsOrSkip();
+
+	// Lists files in the Arena data (loose or in GLOBAL.BSA) with the given extension in either case,
+	// i.e. "CFA" matches both "FOO.CFA" and "foo.cfa".
+	std::vector<std::string> listDataFiles(const std::string &extension);
+
+	// Gets whether the Arena data is the floppy version (no ACD.EXE in the data folder).
+	bool isFloppyVersion(const std::string &arenaPath);
+
+	// Prints a line of benchmark output.
+	void reportBenchmark(const std::string &name, double seconds, double bytesOrItems, const char *unit);
+}
+
+#define TEST_CASE_INTERNAL(name, kind) \
+	static void name(); \
+	static const bool name##Registered = TestFramework::registerTest(#name, kind, name); \
+	static void name()
+
+#define TEST_CASE(name) TEST_CASE_INTERNAL(name, TestFramework::TestKind::Test)
+#define BENCHMARK_CASE(name) TEST_CASE_INTERNAL(name, TestFramework::TestKind::Benchmark)
+
+#define CHECK(condition) \
+	do { if (!(condition)) TestFramework::reportFailure(__FILE__, __LINE__, #condition); } while (false)
+#define CHECK_MSG(condition, message) \
+	do { if (!(condition)) TestFramework::reportFailure(__FILE__, __LINE__, \
+		std::string(#condition) + ": " + (message)); } while (false)
+#define REQUIRE(condition) \
+	do { if (!(condition)) { TestFramework::reportFailure(__FILE__, __LINE__, #condition); \
+		throw TestFramework::RequireException(); } } while (false)
+
+#endif
@@ -0,0 +1,46 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "TestFramework.h"
+#include "../src/Media/TexturePackFile.h"
+
+namespace
+{
+	void WriteTextFile(const std::filesystem::path &path, const std::string &text)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << text;
+	}
+}
+
+TEST_CASE(TexturePackSourceKeyTracksFolderContents)
+{
+	const std::filesystem::path folderPath = std::filesystem::temp_directory_path() / "TESArenaTests_TexturePack";
+	std::filesystem::remove_all(folderPath);
+	std::filesystem::create_directories(folderPath / "SUB");
+	WriteTextFile(folderPath / "GLOBAL.BSA", "abcd");
+	WriteTextFile(folderPath / "SUB" / "A.IMG", "1234");
+
+	const std::string folderString = folderPath.string() + '/';
+	const uint64_t originalHash = TexturePackFile::hashSourceFolder(folderString);
+	CHECK(TexturePackFile::hashSourceFolder(folderString) == originalHash);
+
+	// Same size, different modification time.
+	const auto originalWriteTime = std::filesystem::last_write_time(folderPath / "GLOBAL.BSA");
+	std::filesystem::last_write_time(folderPath / "GLOBAL.BSA", originalWriteTime + std::chrono::hours(1));
+	const uint64_t touchedHash = TexturePackFile::hashSourceFolder(folderString);
+	CHECK(touchedHash != originalHash);
+
+	// Different size in a subfolder.
+	WriteTextFile(folderPath / "SUB" / "A.IMG", "12345");
+	const uint64_t resizedHash = TexturePackFile::hashSourceFolder(folderString);
+	CHECK(resizedHash != touchedHash);
+
+	// New file.
+	WriteTextFile(folderPath / "B.CIF", "");
+	CHECK(TexturePackFile::hashSourceFolder(folderString) != resizedHash);
+
+	std::filesystem::remove_all(folderPath);
+}
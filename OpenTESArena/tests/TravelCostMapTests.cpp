@@ -0,0 +1,148 @@
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "LevelTestUtils.h"
+#include "TestFramework.h"
+#include "../src/Math/Random.h"
+#include "../src/Math/Vector2.h"
+#include "../src/WorldMap/ArenaLocationUtils.h"
+#include "../src/WorldMap/LocationDefinition.h"
+#include "../src/WorldMap/ProvinceDefinition.h"
+#include "../src/WorldMap/TravelCostMap.h"
+
+namespace
+{
+	using WeatherArray = std::array<ArenaTypes::WeatherType, TravelCostMap::QUARTER_COUNT>;
+
+	struct TravelLocation
+	{
+		std::string name;
+		Int2 globalPoint;
+	};
+
+	// Every location on the world map, with its global point computed the same way as the province map.
+	std::vector<TravelLocation> GetTravelLocations(const WorldMapDefinition &worldMapDef)
+	{
+		std::vector<TravelLocation> locations;
+		for (int i = 0; i < worldMapDef.getProvinceCount(); i++)
+		{
+			const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(i);
+			for (int j = 0; j < provinceDef.getLocationCount(); j++)
+			{
+				const LocationDefinition &locationDef = provinceDef.getLocationDef(j);
+				const Int2 localPoint(locationDef.getScreenX(), locationDef.getScreenY());
+				const Int2 globalPoint = ArenaLocationUtils::getGlobalPoint(localPoint, provinceDef.getGlobalRect());
+				locations.push_back(TravelLocation { locationDef.getName(), globalPoint });
+			}
+		}
+
+		return locations;
+	}
+
+	WeatherArray MakeRandomWeathers(ArenaRandom &random)
+	{
+		WeatherArray weathers;
+		for (ArenaTypes::WeatherType &weather : weathers)
+		{
+			weather = static_cast<ArenaTypes::WeatherType>(random.next() % TravelCostMap::WEATHER_COUNT);
+		}
+
+		return weathers;
+	}
+}
+
+TEST_CASE(TravelCostMapMatchesBresenhamReference)
+{
+	LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+	const WorldMapDefinition &worldMapDef = LevelTestUtils::getWorldMapDefinitionOrSkip();
+	const TravelCostMap &travelCostMap = worldMapDef.getTravelCostMap();
+	const std::vector<TravelLocation> locations = GetTravelLocations(worldMapDef);
+	REQUIRE(!locations.empty());
+
+	// Every pair of locations in both directions. The start month cycles so each pair length is seen
+	// with the month rolling over at different points, and the weathers change per start location.
+	ArenaRandom weatherRandom(32);
+	int pairIndex = 0;
+	int longTripCount = 0;
+	for (const TravelLocation &src : locations)
+	{
+		const WeatherArray weathers = MakeRandomWeathers(weatherRandom);
+		for (const TravelLocation &dst : locations)
+		{
+			const int month = pairIndex % TravelCostMap::MONTH_COUNT;
+			const std::string pairName = src.name + " -> " + dst.name + ", month " + std::to_string(month);
+			pairIndex++;
+
+			const int time = travelCostMap.getTravelTime(src.globalPoint, dst.globalPoint, month, weathers);
+			const int referenceTime = ArenaLocationUtils::getTravelTime(src.globalPoint, dst.globalPoint, month,
+				weathers, libraries.binaryAssetLibrary);
+			CHECK_MSG(time == referenceTime, pairName + ": " + std::to_string(time) + " vs " +
+				std::to_string(referenceTime));
+
+			// Days use the random generator for long trips, so it must be left in the same state too.
+			const uint32_t seed = static_cast<uint32_t>(pairIndex) * 2654435761u;
+			ArenaRandom random(seed), referenceRandom(seed);
+			const int days = travelCostMap.getTravelDays(src.globalPoint, dst.globalPoint, month, weathers, random);
+			const int referenceDays = ArenaLocationUtils::getTravelDays(src.globalPoint, dst.globalPoint, month,
+				weathers, referenceRandom, libraries.binaryAssetLibrary);
+			CHECK_MSG(days == referenceDays, pairName + ": " + std::to_string(days) + " vs " +
+				std::to_string(referenceDays) + " days");
+			CHECK_MSG(random.getSeed() == referenceRandom.getSeed(), pairName);
+
+			if (referenceDays > 20)
+			{
+				longTripCount++;
+			}
+		}
+	}
+
+	// Trips long enough for the month to roll over and the random day adjustment to apply.
+	CHECK(longTripCount > 0);
+}
+
+BENCHMARK_CASE(TravelDaysTime)
+{
+	LevelTestUtils::Libraries &libraries = LevelTestUtils::getLibrariesOrSkip();
+	const WorldMapDefinition &worldMapDef = LevelTestUtils::getWorldMapDefinitionOrSkip();
+	const TravelCostMap &travelCostMap = worldMapDef.getTravelCostMap();
+	const std::vector<TravelLocation> locations = GetTravelLocations(worldMapDef);
+
+	ArenaRandom weatherRandom(320);
+	const WeatherArray weathers = MakeRandomWeathers(weatherRandom);
+	const double pairCount = static_cast<double>(locations.size() * locations.size());
+
+	int totalDays = 0;
+	auto time = [&](auto getDays)
+	{
+		ArenaRandom random(32);
+		const auto startTime = std::chrono::steady_clock::now();
+		for (const TravelLocation &src : locations)
+		{
+			for (const TravelLocation &dst : locations)
+			{
+				totalDays += getDays(src.globalPoint, dst.globalPoint, weathers, random);
+			}
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(endTime - startTime).count();
+	};
+
+	const double mapSeconds = time([&travelCostMap](const Int2 &src, const Int2 &dst, const WeatherArray &weathers,
+		ArenaRandom &random)
+	{
+		return travelCostMap.getTravelDays(src, dst, 0, weathers, random);
+	});
+
+	const double referenceSeconds = time([&libraries](const Int2 &src, const Int2 &dst,
+		const WeatherArray &weathers, ArenaRandom &random)
+	{
+		return ArenaLocationUtils::getTravelDays(src, dst, 0, weathers, random, libraries.binaryAssetLibrary);
+	});
+
+	TestFramework::reportBenchmark("TravelCostMap::getTravelDays", mapSeconds, pairCount, "trip");
+	TestFramework::reportBenchmark("ArenaLocationUtils::getTravelDays", referenceSeconds, pairCount, "trip");
+	CHECK(totalDays > 0);
+}
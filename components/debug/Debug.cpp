@@ -1,7 +1,14 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
-#include <vector>
 
 #include "Debug.h"
 #include "../utilities/String.h"
@@ -14,60 +21,419 @@ namespace
 		{ Debug::MessageType::Warning, "Warning: " },
 		{ Debug::MessageType::Error, "Error: " },
 	};
-}
 
-const std::string Debug::LOG_FILENAME = "log.txt";
+	// How long the writer thread sleeps if it misses a wake-up from a producer.
+	constexpr std::chrono::milliseconds DebugWriterWaitTime(100);
 
-std::string Debug::getShorterPath(const char *__file__)
-{
-	// Replace back-slashes with forward slashes, then split.
-	const std::string path = String::replace(std::string(__file__), '\\', '/');
-	const std::vector<std::string> tokens = String::split(path, '/');
+	constexpr std::chrono::milliseconds DebugRateLimitWindow(Debug::RATE_LIMIT_WINDOW_MILLISECONDS);
+
+	struct DebugMessage
+	{
+		std::atomic<DebugMessage*> next;
+		Debug::MessageType type;
+		const char *filePath; // Points into a __FILE__ string literal.
+		int lineNumber;
+		std::string text;
+		std::chrono::steady_clock::time_point time; // When it was pushed.
 
-	std::string shortPath;
+		DebugMessage()
+		{
+			this->next = nullptr;
+			this->type = Debug::MessageType::Status;
+			this->filePath = "";
+			this->lineNumber = 0;
+		}
+	};
 
-	if (tokens.size() >= 2)
+	// The source line a message was logged from. The same line in a header can end up in several
+	// __FILE__ literals, so paths are compared by their contents.
+	struct DebugCallSite
 	{
-		shortPath = tokens.at(tokens.size() - 2) + '/' + tokens.back();
-	}
-	else if (tokens.size() == 1)
+		std::string_view filePath;
+		int lineNumber;
+
+		bool operator==(const DebugCallSite &other) const
+		{
+			return (this->lineNumber == other.lineNumber) && (this->filePath == other.filePath);
+		}
+	};
+
+	struct DebugCallSiteHash
+	{
+		size_t operator()(const DebugCallSite &callSite) const
+		{
+			return (std::hash<std::string_view>()(callSite.filePath) * 31) + static_cast<size_t>(callSite.lineNumber);
+		}
+	};
+
+	struct DebugCallSiteState
+	{
+		std::chrono::steady_clock::time_point windowStartTime;
+		int windowMessageCount; // Written or suppressed since the window started.
+		int suppressedCount; // Not summarized yet.
+		Debug::MessageType suppressedType; // Of the last suppressed message.
+
+		DebugCallSiteState()
+		{
+			this->windowMessageCount = 0;
+			this->suppressedCount = 0;
+			this->suppressedType = Debug::MessageType::Status;
+		}
+	};
+
+	// Intrusive multi-producer single-consumer queue. Pushing is one atomic exchange instead of a lock,
+	// though the caller still allocates the message and its text. Only one thread at a time may pop.
+	class DebugMessageQueue
+	{
+	private:
+		DebugMessage stub;
+		std::atomic<DebugMessage*> head; // Most recently pushed.
+		DebugMessage *tail; // Next to pop.
+	public:
+		DebugMessageQueue()
+		{
+			this->head = &this->stub;
+			this->tail = &this->stub;
+		}
+
+		void push(DebugMessage *message)
+		{
+			message->next.store(nullptr, std::memory_order_relaxed);
+			DebugMessage *prev = this->head.exchange(message, std::memory_order_acq_rel);
+			prev->next.store(message, std::memory_order_release);
+		}
+
+		// Returns null if empty, or if the next message is still being pushed.
+		DebugMessage *pop()
+		{
+			DebugMessage *tail = this->tail;
+			DebugMessage *next = tail->next.load(std::memory_order_acquire);
+			if (tail == &this->stub)
+			{
+				if (next == nullptr)
+				{
+					return nullptr;
+				}
+
+				this->tail = next;
+				tail = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+
+			if (next != nullptr)
+			{
+				this->tail = next;
+				return tail;
+			}
+
+			if (tail != this->head.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+
+			// The tail is the only message left, so put the stub behind it to be able to pop it.
+			this->push(&this->stub);
+			next = tail->next.load(std::memory_order_acquire);
+			if (next != nullptr)
+			{
+				this->tail = next;
+				return tail;
+			}
+
+			return nullptr;
+		}
+	};
+
+	// Writes queued messages on its own thread so the render and audio threads don't stall on
+	// console I/O. Each call site is rate-limited so one line logging every frame doesn't drown out the
+	// rest; what's over the limit is written as a count once the site's window ends.
+	class DebugLogSink
 	{
-		shortPath = tokens.front();
+	private:
+		DebugMessageQueue queue;
+
+		// Messages counted before they're pushed, and messages written. Counting before pushing means
+		// every message ahead of a given one in the queue is already counted when it's pushed.
+		std::atomic<uint64_t> pushedCount, writtenCount;
+		std::thread thread;
+		std::once_flag threadFlag;
+		std::mutex wakeMutex;
+		std::condition_variable wakeCondVar;
+		std::atomic<bool> quit, stopped;
+
+		// Held by whoever is writing messages, either the writer thread or a thread flushing.
+		std::mutex writeMutex;
+		std::ofstream logFile;
+		std::string buffer;
+
+		// Every call site seen so far, and how many of them have suppressed messages not summarized yet.
+		std::unordered_map<DebugCallSite, DebugCallSiteState, DebugCallSiteHash> callSites;
+		int suppressingCallSiteCount;
+
+		void appendMessage(Debug::MessageType type, const char *filePath, int lineNumber, const std::string &text)
+		{
+			const std::string &messageType = DebugMessageTypeNames.at(type);
+			const std::string path = String::replace(std::string(filePath), '\\', '/');
+			this->buffer += "[" + path + "(" + std::to_string(lineNumber) + ")] " + messageType + text + "\n";
+		}
+
+		void appendSuppressedSummary(const DebugCallSite &callSite, DebugCallSiteState &state)
+		{
+			if (state.suppressedCount > 0)
+			{
+				// The path view is the tail of a __FILE__ literal, so it's null-terminated.
+				this->appendMessage(state.suppressedType, callSite.filePath.data(), callSite.lineNumber,
+					"(Suppressed " + std::to_string(state.suppressedCount) + " more message(s) from here.)");
+				state.suppressedCount = 0;
+				this->suppressingCallSiteCount--;
+			}
+		}
+
+		// Must be called with the write mutex held.
+		void writeMessage(const DebugMessage &message)
+		{
+			const DebugCallSite callSite { message.filePath, message.lineNumber };
+			auto iter = this->callSites.find(callSite);
+			if (iter == this->callSites.end())
+			{
+				iter = this->callSites.emplace(callSite, DebugCallSiteState()).first;
+				iter->second.windowStartTime = message.time;
+			}
+
+			DebugCallSiteState &state = iter->second;
+			if ((message.time - state.windowStartTime) >= DebugRateLimitWindow)
+			{
+				this->appendSuppressedSummary(callSite, state);
+				state.windowStartTime = message.time;
+				state.windowMessageCount = 0;
+			}
+
+			state.windowMessageCount++;
+			if (state.windowMessageCount > Debug::RATE_LIMIT_COUNT)
+			{
+				if (state.suppressedCount == 0)
+				{
+					this->suppressingCallSiteCount++;
+				}
+
+				state.suppressedCount++;
+				state.suppressedType = message.type;
+				return;
+			}
+
+			this->appendMessage(message.type, message.filePath, message.lineNumber, message.text);
+		}
+
+		// Writes every message currently in the queue. Call sites with suppressed messages are summarized
+		// once their window ends, or always if forced.
+		void drain(bool forceSummaries)
+		{
+			std::lock_guard<std::mutex> lock(this->writeMutex);
+
+			DebugMessage *message;
+			while ((message = this->queue.pop()) != nullptr)
+			{
+				this->writeMessage(*message);
+				this->writtenCount++;
+				delete message;
+			}
+
+			if (this->suppressingCallSiteCount > 0)
+			{
+				const auto now = std::chrono::steady_clock::now();
+				for (auto &pair : this->callSites)
+				{
+					DebugCallSiteState &state = pair.second;
+					if (forceSummaries || ((now - state.windowStartTime) >= DebugRateLimitWindow))
+					{
+						this->appendSuppressedSummary(pair.first, state);
+					}
+				}
+			}
+
+			if (!this->buffer.empty())
+			{
+				std::cerr << this->buffer;
+				std::cerr.flush();
+
+				if (this->logFile.is_open())
+				{
+					this->logFile << this->buffer;
+					this->logFile.flush();
+				}
+
+				this->buffer.clear();
+			}
+		}
+
+		void writerProc()
+		{
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(this->wakeMutex);
+					this->wakeCondVar.wait_for(lock, DebugWriterWaitTime, [this]()
+					{
+						return this->quit || (this->pushedCount != this->writtenCount);
+					});
+				}
+
+				const bool shouldQuit = this->quit;
+				const uint64_t prevWrittenCount = this->writtenCount;
+				this->drain(shouldQuit);
+
+				if (shouldQuit)
+				{
+					return;
+				}
+
+				// A message was counted but isn't linked into the queue yet, so give its thread a chance.
+				if (this->writtenCount == prevWrittenCount)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+	public:
+		DebugLogSink()
+		{
+			this->pushedCount = 0;
+			this->writtenCount = 0;
+			this->quit = false;
+			this->stopped = false;
+			this->suppressingCallSiteCount = 0;
+		}
+
+		bool openLogFile(const std::string &filename)
+		{
+			std::lock_guard<std::mutex> lock(this->writeMutex);
+			this->logFile.open(filename, std::ios::out | std::ios::trunc);
+			return this->logFile.is_open();
+		}
+
+		void push(Debug::MessageType type, const char *filePath, int lineNumber, const std::string &text)
+		{
+			DebugMessage *message = new DebugMessage();
+			message->type = type;
+			message->filePath = filePath;
+			message->lineNumber = lineNumber;
+			message->text = text;
+			message->time = std::chrono::steady_clock::now();
+			this->pushedCount++;
+			this->queue.push(message);
+
+			if (this->stopped)
+			{
+				// Program is exiting. Write it on this thread instead.
+				this->flush();
+				return;
+			}
+
+			std::call_once(this->threadFlag, [this]()
+			{
+				this->thread = std::thread(&DebugLogSink::writerProc, this);
+			});
+
+			this->wakeCondVar.notify_one();
+		}
+
+		// Writes every message pushed before this call, including the calling thread's own. A message
+		// being pushed by another thread can hold up the ones behind it for a moment, so this keeps
+		// draining until they're all written.
+		void flush()
+		{
+			const uint64_t targetCount = this->pushedCount;
+			while (true)
+			{
+				this->drain(true);
+				if (this->writtenCount >= targetCount)
+				{
+					break;
+				}
+
+				std::this_thread::yield();
+			}
+		}
+
+		// Stops the writer thread and writes anything left. Messages after this are written immediately.
+		void shutdown()
+		{
+			this->stopped = true;
+			this->quit = true;
+			this->wakeCondVar.notify_one();
+
+			if (this->thread.joinable())
+			{
+				this->thread.join();
+			}
+
+			this->flush();
+		}
+	};
+
+	DebugLogSink &getDebugLogSink()
+	{
+		// Never freed so messages from static destructors still have somewhere to go. Queued messages
+		// are written when the program exits.
+		static DebugLogSink *sink = []()
+		{
+			DebugLogSink *newSink = new DebugLogSink();
+			std::atexit([]()
+			{
+				getDebugLogSink().shutdown();
+			});
+
+			return newSink;
+		}();
+
+		return *sink;
 	}
+}
+
+const std::string Debug::LOG_FILENAME = "log.txt";
 
-	return shortPath;
+std::string Debug::getShorterPath(const char *__file__)
+{
+	const size_t offset = Debug::getShorterPathOffset(__file__);
+	return String::replace(std::string(__file__ + offset), '\\', '/');
+}
+
+bool Debug::initLogFile(const std::string &folderPath)
+{
+	return getDebugLogSink().openLogFile(folderPath + Debug::LOG_FILENAME);
 }
 
-void Debug::write(Debug::MessageType type, const std::string &filePath,
-	int lineNumber, const std::string &message)
+void Debug::flush()
 {
-	const std::string &messageType = DebugMessageTypeNames.at(type);
-	std::cerr << "[" << filePath << "(" << std::to_string(lineNumber) << ")] " <<
-		messageType << message << "\n";
+	getDebugLogSink().flush();
+}
+
+void Debug::write(Debug::MessageType type, const char *filePath, int lineNumber, const std::string &message)
+{
+	getDebugLogSink().push(type, filePath, lineNumber, message);
 }
 
 void Debug::log(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(Debug::MessageType::Status, Debug::getShorterPath(__file__),
-		lineNumber, message);
+	Debug::write(Debug::MessageType::Status, __file__, lineNumber, message);
 }
 
 void Debug::logWarning(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(Debug::MessageType::Warning, Debug::getShorterPath(__file__),
-		lineNumber, message);
+	Debug::write(Debug::MessageType::Warning, __file__, lineNumber, message);
 }
 
 void Debug::logError(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(Debug::MessageType::Error, Debug::getShorterPath(__file__),
-		lineNumber, message);
+	Debug::write(Debug::MessageType::Error, __file__, lineNumber, message);
 }
 
 void Debug::crash(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(Debug::MessageType::Error, Debug::getShorterPath(__file__),
-		lineNumber, message);
+	Debug::write(Debug::MessageType::Error, __file__, lineNumber, message);
+
+	// Make sure the reason is visible before waiting or exiting.
+	Debug::flush();
 
 #if defined(__APPLE__) && defined(__MACH__)
 	// @todo: implement proper logging alternative to SDL message box.
@@ -1,6 +1,7 @@
 #ifndef DEBUG_H
 #define DEBUG_H
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -23,13 +24,44 @@ private:
 	Debug() = delete;
 	~Debug() = delete;
 
-	// Writes a debug message to the console with the file path and line number.
-	static void write(Debug::MessageType type, const std::string &filePath,
-		int lineNumber, const std::string &message);
+	// Queues a debug message for the writer thread, which writes it to the console and the log file
+	// (if any) with the file path and line number. Does not block on I/O.
+	static void write(Debug::MessageType type, const char *filePath, int lineNumber, const std::string &message);
 public:
+	// At most this many messages from one source line are written per window. The rest are counted and
+	// written as one summary line when the window ends.
+	static constexpr int RATE_LIMIT_COUNT = 10;
+	static constexpr int RATE_LIMIT_WINDOW_MILLISECONDS = 1000;
+
+	// Gets the offset of the last folder in the given path so only it and the filename are shown.
+	// Evaluated at compile time by DebugShortFile.
+	static constexpr size_t getShorterPathOffset(const char *path)
+	{
+		size_t offset = 0;
+		size_t filenameOffset = 0;
+		for (size_t i = 0; path[i] != '\0'; i++)
+		{
+			if ((path[i] == '/') || (path[i] == '\\'))
+			{
+				offset = filenameOffset;
+				filenameOffset = i + 1;
+			}
+		}
+
+		return offset;
+	}
+
 	// Shortens the __FILE__ macro so it only includes a couple parent folders.
 	static std::string getShorterPath(const char *__file__);
 
+	// Starts writing messages to the log file in the given folder as well as the console.
+	static bool initLogFile(const std::string &folderPath);
+
+	// Blocks until every queued message has been written.
+	static void flush();
+
+	// The log functions below take a path already shortened by DebugShortFile.
+
 	// Use DebugLog() instead. Helper method for mentioning something about program state.
 	static void log(const char *__file__, int lineNumber, const std::string &message);
 
@@ -42,13 +74,17 @@ public:
 	// Use DebugCrash() instead. Helper method for crashing the program with a reason.
 	[[noreturn]] static void crash(const char *__file__, int lineNumber, const std::string &message);
 
+	// Current source file with only its parent folder, i.e. "World/Chunk.cpp".
+#define DebugShortFile \
+	(__FILE__ + std::integral_constant<size_t, Debug::getShorterPathOffset(__FILE__)>::value)
+
 	// General logging defines.
-#define DebugLog(message) Debug::log(__FILE__, __LINE__, message)
-#define DebugLogWarning(message) Debug::logWarning(__FILE__, __LINE__, message)
-#define DebugLogError(message) Debug::logError(__FILE__, __LINE__, message)
+#define DebugLog(message) Debug::log(DebugShortFile, __LINE__, message)
+#define DebugLogWarning(message) Debug::logWarning(DebugShortFile, __LINE__, message)
+#define DebugLogError(message) Debug::logError(DebugShortFile, __LINE__, message)
 
 	// Crash define, when the program simply cannot continue.
-#define DebugCrash(message) Debug::crash(__FILE__, __LINE__, message)
+#define DebugCrash(message) Debug::crash(DebugShortFile, __LINE__, message)
 
 	// Assertions.
 #define DebugAssertMsg(condition, message) \
@@ -58,7 +94,7 @@ public:
 
 	// Exception generator with file and line.
 #define DebugException(message) \
-	std::runtime_error(std::string(message) + " (" + Debug::getShorterPath(__FILE__) + "(" + std::to_string(__LINE__) + "))")
+	std::runtime_error(std::string(message) + " (" + Debug::getShorterPath(DebugShortFile) + "(" + std::to_string(__LINE__) + "))")
 
 	// Various error handlers:
 	// Unhandled return.
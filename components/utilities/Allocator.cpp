@@ -0,0 +1,140 @@
+#include <algorithm>
+
+#include "Allocator.h"
+
+FrameAllocator::Stats::Stats()
+{
+	this->clear();
+}
+
+void FrameAllocator::Stats::clear()
+{
+	this->allocCount = 0;
+	this->byteCount = 0;
+	this->peakByteCount = 0;
+	this->heapAllocCount = 0;
+}
+
+FrameAllocator::FrameAllocator()
+{
+	this->blockIndex = 0;
+	this->byteIndex = 0;
+	this->blockByteCount = 0;
+}
+
+void FrameAllocator::init(int blockByteCount)
+{
+	DebugAssert(blockByteCount > 0);
+	this->blocks.clear();
+	this->blocks.emplace_back(Buffer<std::byte>(blockByteCount));
+	this->blockIndex = 0;
+	this->byteIndex = 0;
+	this->blockByteCount = blockByteCount;
+	this->ownerThreadID = std::this_thread::get_id();
+	this->stats.clear();
+	this->lastFrameStats.clear();
+}
+
+bool FrameAllocator::isInited() const
+{
+	return this->blockByteCount > 0;
+}
+
+void FrameAllocator::setOwnerThread()
+{
+	this->ownerThreadID = std::this_thread::get_id();
+}
+
+std::byte *FrameAllocator::allocBytes(int byteCount, int alignment)
+{
+	DebugAssert(this->isInited());
+	DebugAssertMsg(std::this_thread::get_id() == this->ownerThreadID,
+		"Frame allocator used from a thread that doesn't own it.");
+
+	auto getAlignedIndex = [alignment](const Buffer<std::byte> &block, int index)
+	{
+		const uintptr_t address = reinterpret_cast<uintptr_t>(block.get()) + index;
+		const int modulo = static_cast<int>(address % static_cast<uintptr_t>(alignment));
+		return (modulo != 0) ? (index + (alignment - modulo)) : index;
+	};
+
+	// Find the first block with enough room, starting at the current one.
+	while (this->blockIndex < static_cast<int>(this->blocks.size()))
+	{
+		const Buffer<std::byte> &block = this->blocks[this->blockIndex];
+		const int alignedIndex = getAlignedIndex(block, this->byteIndex);
+		if ((alignedIndex + byteCount) <= block.getCount())
+		{
+			break;
+		}
+
+		this->blockIndex++;
+		this->byteIndex = 0;
+	}
+
+	// Out of blocks. Add one big enough for this allocation (this is the only heap allocation).
+	if (this->blockIndex == static_cast<int>(this->blocks.size()))
+	{
+		const int newBlockByteCount = std::max(this->blockByteCount, byteCount + alignment);
+		this->blocks.emplace_back(Buffer<std::byte>(newBlockByteCount));
+		this->byteIndex = 0;
+		this->stats.heapAllocCount++;
+	}
+
+	Buffer<std::byte> &block = this->blocks[this->blockIndex];
+	const int alignedIndex = getAlignedIndex(block, this->byteIndex);
+	DebugAssert((alignedIndex + byteCount) <= block.getCount());
+	this->byteIndex = alignedIndex + byteCount;
+
+	this->stats.allocCount++;
+	this->stats.byteCount += byteCount;
+	this->stats.peakByteCount = std::max(this->stats.peakByteCount, this->stats.byteCount);
+	return block.get() + alignedIndex;
+}
+
+FrameAllocator::Marker FrameAllocator::getMarker() const
+{
+	Marker marker;
+	marker.blockIndex = this->blockIndex;
+	marker.byteIndex = this->byteIndex;
+	marker.byteCount = this->stats.byteCount;
+	return marker;
+}
+
+void FrameAllocator::rewind(const Marker &marker)
+{
+	DebugAssert(marker.blockIndex <= this->blockIndex);
+	DebugAssert((marker.blockIndex < this->blockIndex) || (marker.byteIndex <= this->byteIndex));
+	this->blockIndex = marker.blockIndex;
+	this->byteIndex = marker.byteIndex;
+	this->stats.byteCount = marker.byteCount;
+}
+
+const FrameAllocator::Stats &FrameAllocator::getStats() const
+{
+	return this->stats;
+}
+
+const FrameAllocator::Stats &FrameAllocator::getLastFrameStats() const
+{
+	return this->lastFrameStats;
+}
+
+int FrameAllocator::getCapacity() const
+{
+	int capacity = 0;
+	for (const Buffer<std::byte> &block : this->blocks)
+	{
+		capacity += block.getCount();
+	}
+
+	return capacity;
+}
+
+void FrameAllocator::clear()
+{
+	this->blockIndex = 0;
+	this->byteIndex = 0;
+	this->lastFrameStats = this->stats;
+	this->stats.clear();
+}
@@ -2,7 +2,11 @@
 #define ALLOCATOR_H
 
 #include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "Buffer.h"
 #include "BufferView.h"
@@ -116,4 +120,91 @@ public:
 	}
 };
 
+// Frame-lifetime bump allocator for temporary arrays that are thrown away at the end of a frame.
+// Memory comes from a list of blocks that is kept when clearing, so once the blocks are big enough
+// for a frame's workload, later frames don't touch the heap. Only for types that don't need destruction.
+// Not thread-safe. Each thread that needs one should own its own, and it must only be used from the
+// thread that owns it.
+
+class FrameAllocator
+{
+public:
+	// Position in the allocator for releasing everything allocated after it.
+	struct Marker
+	{
+		int blockIndex;
+		int byteIndex;
+		int byteCount;
+	};
+
+	// Counters for one frame (between calls to clear()).
+	struct Stats
+	{
+		int allocCount; // Number of alloc() calls.
+		int byteCount; // Bytes handed out, not counting alignment padding.
+		int peakByteCount; // Most bytes in use at once.
+		int heapAllocCount; // Blocks that had to be allocated. Zero once warmed up.
+
+		Stats();
+
+		void clear();
+	};
+private:
+	std::vector<Buffer<std::byte>> blocks;
+	int blockIndex; // Block currently being allocated from.
+	int byteIndex; // Next free byte in the current block.
+	int blockByteCount; // Size of new blocks unless an allocation needs more.
+	std::thread::id ownerThreadID;
+	Stats stats, lastFrameStats;
+
+	// Reserves the given number of bytes at the given alignment, allocating a new block if needed.
+	std::byte *allocBytes(int byteCount, int alignment);
+public:
+	FrameAllocator();
+
+	void init(int blockByteCount);
+
+	bool isInited() const;
+
+	// Makes the calling thread the owner of this allocator, i.e. when handing it to a worker thread.
+	void setOwnerThread();
+
+	template <typename T>
+	BufferView<T> alloc(int count, const T &defaultValue)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		static_assert(std::is_trivially_destructible_v<T>);
+		DebugAssert(count >= 0);
+
+		const int byteCount = static_cast<int>(count * sizeof(T));
+		T *ptr = reinterpret_cast<T*>(this->allocBytes(byteCount, static_cast<int>(alignof(T))));
+		for (int i = 0; i < count; i++)
+		{
+			new (ptr + i) T(defaultValue);
+		}
+
+		return BufferView<T>(ptr, count);
+	}
+
+	template <typename T>
+	BufferView<T> alloc(int count)
+	{
+		return this->alloc(count, T());
+	}
+
+	// Gets the current position so temporaries allocated after it can be released early with rewind().
+	Marker getMarker() const;
+	void rewind(const Marker &marker);
+
+	// Counters for the frame in progress and for the most recently cleared frame.
+	const Stats &getStats() const;
+	const Stats &getLastFrameStats() const;
+
+	// Total bytes owned by the allocator's blocks.
+	int getCapacity() const;
+
+	// Releases all allocations for the next frame. Blocks are kept.
+	void clear();
+};
+
 #endif
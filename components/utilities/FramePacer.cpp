@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "FramePacer.h"
+#include "../debug/Debug.h"
+
+namespace
+{
+	// Shortest amount of spinning at the end of a wait, in case the sleep overshoot estimate is low.
+	constexpr std::chrono::microseconds MIN_SPIN_TIME(200);
+
+	// How quickly the sleep overshoot estimate decays when sleeps become more accurate (per sleep).
+	constexpr int SLEEP_OVERSHOOT_DECAY = 64;
+
+	double toSeconds(FramePacer::Clock::duration duration)
+	{
+		return std::chrono::duration<double>(duration).count();
+	}
+}
+
+FramePacer::FramePacer()
+{
+	this->frameTimeErrors.fill(0.0);
+	this->frameTimeErrorIndex = 0;
+	this->frameTimeErrorCount = 0;
+	this->framePeriod = Clock::duration::zero();
+	this->sleepOvershoot = Clock::duration::zero();
+	this->maxFrameTime = Clock::duration::zero();
+}
+
+void FramePacer::init(int targetFPS, int minFPS)
+{
+	DebugAssert(minFPS > 0);
+	this->maxFrameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / minFPS;
+	this->setTargetFPS(targetFPS);
+
+	this->frameStartTime = Clock::now();
+	this->nextFrameTime = this->frameStartTime + this->framePeriod;
+}
+
+void FramePacer::setTargetFPS(int targetFPS)
+{
+	DebugAssert(targetFPS > 0);
+	const Clock::duration newFramePeriod =
+		std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / targetFPS;
+	if (newFramePeriod != this->framePeriod)
+	{
+		this->framePeriod = newFramePeriod;
+		this->nextFrameTime = this->frameStartTime + this->framePeriod;
+		this->frameTimeErrors.fill(0.0);
+		this->frameTimeErrorIndex = 0;
+		this->frameTimeErrorCount = 0;
+	}
+}
+
+void FramePacer::waitUntil(Clock::time_point time)
+{
+	// Sleep while there's more time left than a sleep might overshoot by.
+	const Clock::duration spinTime = std::max<Clock::duration>(this->sleepOvershoot, MIN_SPIN_TIME);
+	Clock::time_point now = Clock::now();
+	if ((time - now) > spinTime)
+	{
+		const Clock::duration sleepTime = (time - now) - spinTime;
+		std::this_thread::sleep_for(sleepTime);
+
+		// Track how late the sleep woke up. Grows immediately and decays slowly.
+		const Clock::time_point wakeTime = Clock::now();
+		const Clock::duration overshoot = std::max((wakeTime - now) - sleepTime, Clock::duration::zero());
+		if (overshoot > this->sleepOvershoot)
+		{
+			this->sleepOvershoot = overshoot;
+		}
+		else
+		{
+			this->sleepOvershoot -= (this->sleepOvershoot - overshoot) / SLEEP_OVERSHOOT_DECAY;
+		}
+
+		now = wakeTime;
+	}
+
+	// Spin for the rest.
+	while (now < time)
+	{
+		std::this_thread::yield();
+		now = Clock::now();
+	}
+}
+
+double FramePacer::waitForNextFrame(double *outClampedDt)
+{
+	DebugAssert(outClampedDt != nullptr);
+
+	this->waitUntil(this->nextFrameTime);
+
+	const Clock::time_point now = Clock::now();
+	const Clock::duration frameTime = now - this->frameStartTime;
+	this->frameStartTime = now;
+
+	// Schedule against the deadline so frames average out to the target rate. If the frame ran long,
+	// start over from now instead of rushing to catch up.
+	this->nextFrameTime += this->framePeriod;
+	if (this->nextFrameTime < now)
+	{
+		this->nextFrameTime = now + this->framePeriod;
+	}
+
+	const double frameTimeError = toSeconds(frameTime - this->framePeriod);
+	this->frameTimeErrors[this->frameTimeErrorIndex] = frameTimeError;
+	this->frameTimeErrorIndex = (this->frameTimeErrorIndex + 1) % static_cast<int>(this->frameTimeErrors.size());
+	this->frameTimeErrorCount = std::min(this->frameTimeErrorCount + 1, static_cast<int>(this->frameTimeErrors.size()));
+
+	*outClampedDt = toSeconds(std::min(frameTime, this->maxFrameTime));
+	return toSeconds(frameTime);
+}
+
+double FramePacer::getAverageJitter() const
+{
+	if (this->frameTimeErrorCount == 0)
+	{
+		return 0.0;
+	}
+
+	double sum = 0.0;
+	for (int i = 0; i < this->frameTimeErrorCount; i++)
+	{
+		sum += std::abs(this->frameTimeErrors[i]);
+	}
+
+	return sum / static_cast<double>(this->frameTimeErrorCount);
+}
+
+double FramePacer::getMaxJitter() const
+{
+	double maxJitter = 0.0;
+	for (int i = 0; i < this->frameTimeErrorCount; i++)
+	{
+		maxJitter = std::max(maxJitter, std::abs(this->frameTimeErrors[i]));
+	}
+
+	return maxJitter;
+}
+
+double FramePacer::getSleepOvershoot() const
+{
+	return toSeconds(this->sleepOvershoot);
+}
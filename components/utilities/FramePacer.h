@@ -0,0 +1,49 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <array>
+#include <chrono>
+
+// Holds frames to a target frame rate. Waits are a sleep for most of the remaining time followed by a
+// short spin, since thread sleeping alone can overshoot by a millisecond or more on some platforms.
+// Frame start times are scheduled against a running deadline so rounding errors don't add up.
+
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+private:
+	// Frame time deviations kept for jitter statistics.
+	std::array<double, 120> frameTimeErrors;
+	int frameTimeErrorIndex, frameTimeErrorCount;
+
+	Clock::time_point frameStartTime; // Start of the current frame.
+	Clock::time_point nextFrameTime; // Deadline for the next frame to start.
+	Clock::duration framePeriod; // Time per frame at the target frame rate.
+	Clock::duration sleepOvershoot; // Recent worst-case sleep overshoot, used to decide when to spin.
+	Clock::duration maxFrameTime; // Longest frame time reported to the game.
+
+	// Sleeps and spins until the given time.
+	void waitUntil(Clock::time_point time);
+public:
+	FramePacer();
+
+	void init(int targetFPS, int minFPS);
+
+	// Changes the target frame rate, i.e. when the option changes.
+	void setTargetFPS(int targetFPS);
+
+	// Waits until the next frame should start and returns the time since the previous frame started,
+	// in seconds. Also returns the frame time clamped to the min frame rate.
+	double waitForNextFrame(double *outClampedDt);
+
+	// Frame time jitter over recent frames, in seconds. The mean absolute deviation from the target
+	// frame time and the worst deviation.
+	double getAverageJitter() const;
+	double getMaxJitter() const;
+
+	// Recent worst-case amount thread sleeping overshot by, in seconds.
+	double getSleepOvershoot() const;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include <string>
+
+#include "MappedFile.h"
+#include "../debug/Debug.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	this->data = nullptr;
+	this->size = 0;
+
+#if defined(_WIN32)
+	this->fileHandle = nullptr;
+	this->mappingHandle = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	this->clear();
+}
+
+bool MappedFile::init(const char *filename)
+{
+	this->clear();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(file, &fileSize) == 0) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		DebugLogWarning("CreateFileMappingA() failed for \"" + std::string(filename) + "\".");
+		CloseHandle(file);
+		return false;
+	}
+
+	const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		DebugLogWarning("MapViewOfFile() failed for \"" + std::string(filename) + "\".");
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	this->data = static_cast<const uint8_t*>(view);
+	this->size = static_cast<size_t>(fileSize.QuadPart);
+	this->fileHandle = file;
+	this->mappingHandle = mapping;
+	return true;
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	const int fd = open(filename, O_RDONLY);
+	if (fd == -1)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if ((fstat(fd, &st) == -1) || (st.st_size == 0))
+	{
+		close(fd);
+		return false;
+	}
+
+	void *view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps its own reference to the file.
+	close(fd);
+
+	if (view == MAP_FAILED)
+	{
+		DebugLogWarning("mmap() failed for \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	this->data = static_cast<const uint8_t*>(view);
+	this->size = static_cast<size_t>(st.st_size);
+	return true;
+#else
+#error Unknown platform.
+#endif
+}
+
+bool MappedFile::isValid() const
+{
+	return this->data != nullptr;
+}
+
+const uint8_t *MappedFile::get() const
+{
+	return this->data;
+}
+
+size_t MappedFile::getSize() const
+{
+	return this->size;
+}
+
+void MappedFile::clear()
+{
+	if (this->data == nullptr)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(this->data);
+	CloseHandle(this->mappingHandle);
+	CloseHandle(this->fileHandle);
+	this->fileHandle = nullptr;
+	this->mappingHandle = nullptr;
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	munmap(const_cast<uint8_t*>(this->data), this->size);
+#endif
+
+	this->data = nullptr;
+	this->size = 0;
+}
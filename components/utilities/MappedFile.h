@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Read-only memory-mapped view of a file on disk. Pages are loaded by the OS on first access,
+// so only the parts of the file that are actually read cost any I/O.
+
+class MappedFile
+{
+private:
+	const uint8_t *data;
+	size_t size;
+
+#if defined(_WIN32)
+	void *fileHandle, *mappingHandle;
+#endif
+public:
+	MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	~MappedFile();
+
+	MappedFile &operator=(const MappedFile&) = delete;
+	MappedFile &operator=(MappedFile&&) = delete;
+
+	// Maps the entire file into memory. Returns false if the file doesn't exist or is empty.
+	bool init(const char *filename);
+
+	bool isValid() const;
+
+	const uint8_t *get() const;
+	size_t getSize() const;
+
+	// Unmaps the file. Must be called before the file is overwritten on disk.
+	void clear();
+};
+
+#endif
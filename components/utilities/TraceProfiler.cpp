@@ -0,0 +1,214 @@
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TraceProfiler.h"
+#include "../debug/Debug.h"
+
+namespace
+{
+	struct TraceEvent
+	{
+		const char *name;
+		int64_t startTime, endTime;
+	};
+
+	// Written only by its owning thread. The write index is published after each event so a reader
+	// can see how many events are valid.
+	struct ThreadEventBuffer
+	{
+		std::unique_ptr<TraceEvent[]> events;
+		std::atomic<uint64_t> writeIndex;
+		int threadID;
+		bool isInUse; // False once the owning thread exits, so another thread can take it.
+
+		ThreadEventBuffer(int threadID)
+			: events(std::make_unique<TraceEvent[]>(TraceProfiler::EVENTS_PER_THREAD)), writeIndex(0), threadID(threadID),
+			isInUse(true) { }
+	};
+
+	static_assert((TraceProfiler::EVENTS_PER_THREAD & (TraceProfiler::EVENTS_PER_THREAD - 1)) == 0);
+	constexpr uint64_t EventIndexMask = static_cast<uint64_t>(TraceProfiler::EVENTS_PER_THREAD) - 1;
+
+	const auto Epoch = std::chrono::steady_clock::now();
+
+	// A thread's buffer is kept after the thread exits so its events can still be written out, and is
+	// handed to the next thread that starts recording. Memory is bounded by the most threads recording
+	// at once rather than by how many threads were ever started.
+	std::mutex ThreadBuffersMutex;
+	std::vector<std::unique_ptr<ThreadEventBuffer>> ThreadBuffers;
+	int NextThreadID = 0;
+
+	ThreadEventBuffer *acquireThreadBuffer()
+	{
+		std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+		const int threadID = NextThreadID;
+		NextThreadID++;
+
+		for (const std::unique_ptr<ThreadEventBuffer> &threadBuffer : ThreadBuffers)
+		{
+			if (!threadBuffer->isInUse)
+			{
+				// The previous owner's events are dropped so they aren't attributed to this thread.
+				threadBuffer->writeIndex.store(0, std::memory_order_relaxed);
+				threadBuffer->threadID = threadID;
+				threadBuffer->isInUse = true;
+				return threadBuffer.get();
+			}
+		}
+
+		ThreadBuffers.emplace_back(std::make_unique<ThreadEventBuffer>(threadID));
+		return ThreadBuffers.back().get();
+	}
+
+	void releaseThreadBuffer(ThreadEventBuffer *threadBuffer)
+	{
+		std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+		threadBuffer->isInUse = false;
+	}
+
+	// Gives the calling thread's buffer back when the thread exits.
+	class ThreadBufferOwner
+	{
+	private:
+		ThreadEventBuffer *threadBuffer;
+	public:
+		ThreadBufferOwner()
+		{
+			this->threadBuffer = acquireThreadBuffer();
+		}
+
+		ThreadBufferOwner(const ThreadBufferOwner&) = delete;
+
+		~ThreadBufferOwner()
+		{
+			releaseThreadBuffer(this->threadBuffer);
+		}
+
+		ThreadBufferOwner &operator=(const ThreadBufferOwner&) = delete;
+
+		ThreadEventBuffer &get()
+		{
+			return *this->threadBuffer;
+		}
+	};
+
+	ThreadEventBuffer &getThreadBuffer()
+	{
+		thread_local ThreadBufferOwner threadBufferOwner;
+		return threadBufferOwner.get();
+	}
+
+	void appendJsonString(const char *str, std::string &out)
+	{
+		out += '"';
+		for (const char *c = str; *c != '\0'; c++)
+		{
+			if ((*c == '"') || (*c == '\\'))
+			{
+				out += '\\';
+			}
+
+			out += *c;
+		}
+
+		out += '"';
+	}
+}
+
+std::atomic<bool> TraceProfiler::enabled(false);
+
+void TraceProfiler::setEnabled(bool value)
+{
+	TraceProfiler::enabled.store(value, std::memory_order_relaxed);
+}
+
+int64_t TraceProfiler::getTime()
+{
+	const auto now = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(now - Epoch).count();
+}
+
+void TraceProfiler::addEvent(const char *name, int64_t startTime, int64_t endTime)
+{
+	ThreadEventBuffer &threadBuffer = getThreadBuffer();
+	const uint64_t writeIndex = threadBuffer.writeIndex.load(std::memory_order_relaxed);
+	TraceEvent &event = threadBuffer.events[writeIndex & EventIndexMask];
+	event.name = name;
+	event.startTime = startTime;
+	event.endTime = endTime;
+	threadBuffer.writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+bool TraceProfiler::writeChromeTrace(const char *filename)
+{
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool isFirstEvent = true;
+	int eventCount = 0;
+
+	auto appendEventPrefix = [&json, &isFirstEvent]()
+	{
+		if (!isFirstEvent)
+		{
+			json += ",\n";
+		}
+
+		isFirstEvent = false;
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+		for (const std::unique_ptr<ThreadEventBuffer> &threadBuffer : ThreadBuffers)
+		{
+			const std::string threadIDString = std::to_string(threadBuffer->threadID);
+			appendEventPrefix();
+			json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + threadIDString +
+				",\"args\":{\"name\":\"Thread " + threadIDString + "\"}}";
+
+			const uint64_t writeIndex = threadBuffer->writeIndex.load(std::memory_order_acquire);
+			const uint64_t eventsPerThread = static_cast<uint64_t>(TraceProfiler::EVENTS_PER_THREAD);
+			const uint64_t readIndex = (writeIndex > eventsPerThread) ? (writeIndex - eventsPerThread) : 0;
+			for (uint64_t i = readIndex; i < writeIndex; i++)
+			{
+				const TraceEvent &event = threadBuffer->events[i & EventIndexMask];
+
+				// Chrome trace times are in microseconds.
+				const double startMicroseconds = static_cast<double>(event.startTime) / 1000.0;
+				const double durationMicroseconds = static_cast<double>(event.endTime - event.startTime) / 1000.0;
+
+				appendEventPrefix();
+				json += "{\"name\":";
+				appendJsonString(event.name, json);
+				json += ",\"ph\":\"X\",\"pid\":0,\"tid\":" + threadIDString +
+					",\"ts\":" + std::to_string(startMicroseconds) +
+					",\"dur\":" + std::to_string(durationMicroseconds) + "}";
+				eventCount++;
+			}
+		}
+	}
+
+	json += "\n]}\n";
+
+	std::ofstream ofs(filename, std::ios::binary);
+	if (!ofs.is_open())
+	{
+		DebugLogWarning("Couldn't open \"" + std::string(filename) + "\" for writing trace.");
+		return false;
+	}
+
+	ofs.write(json.data(), json.size());
+	DebugLog("Wrote " + std::to_string(eventCount) + " trace events to \"" + std::string(filename) + "\".");
+	return true;
+}
+
+void TraceProfiler::clear()
+{
+	std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+	for (const std::unique_ptr<ThreadEventBuffer> &threadBuffer : ThreadBuffers)
+	{
+		threadBuffer->writeIndex.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Hierarchical timing zones for finding out where frame time goes. Each thread records finished zones
+// into its own fixed-size ring buffer without locking, and the buffers can be written out as a Chrome
+// trace (viewable in chrome://tracing or Perfetto). Zones nest by their time ranges, so a zone inside
+// another zone's scope shows up as its child.
+//
+// Recording is off by default. A disabled zone costs one relaxed atomic load.
+
+namespace TraceProfiler
+{
+	// Events kept per thread before the oldest are overwritten.
+	constexpr int EVENTS_PER_THREAD = 1 << 16;
+
+	extern std::atomic<bool> enabled;
+
+	inline bool isEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	void setEnabled(bool value);
+
+	// Gets the current time in nanoseconds since the profiler's epoch.
+	int64_t getTime();
+
+	// Adds a finished zone to the calling thread's ring buffer. The name must outlive the profiler
+	// (i.e., a string literal).
+	void addEvent(const char *name, int64_t startTime, int64_t endTime);
+
+	// Writes all recorded zones as Chrome trace event JSON. Recording should be disabled or other threads
+	// should be idle so their ring buffers aren't changing while being read.
+	bool writeChromeTrace(const char *filename);
+
+	// Empties all threads' ring buffers.
+	void clear();
+
+	// Records the time between construction and destruction if recording was enabled at construction.
+	class Zone
+	{
+	private:
+		const char *name; // Null if not recording.
+		int64_t startTime;
+	public:
+		Zone(const char *name)
+		{
+			if (TraceProfiler::isEnabled())
+			{
+				this->name = name;
+				this->startTime = TraceProfiler::getTime();
+			}
+			else
+			{
+				this->name = nullptr;
+			}
+		}
+
+		Zone(const Zone&) = delete;
+		Zone(Zone&&) = delete;
+
+		~Zone()
+		{
+			if (this->name != nullptr)
+			{
+				TraceProfiler::addEvent(this->name, this->startTime, TraceProfiler::getTime());
+			}
+		}
+
+		Zone &operator=(const Zone&) = delete;
+		Zone &operator=(Zone&&) = delete;
+	};
+}
+
+#define TraceProfilerConcatInner(a, b) a##b
+#define TraceProfilerConcat(a, b) TraceProfilerConcatInner(a, b)
+
+// Times the rest of the enclosing scope.
+#define TraceZone(name) const TraceProfiler::Zone TraceProfilerConcat(traceZone, __LINE__)(name)
+
+#endif